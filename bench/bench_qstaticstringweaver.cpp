@@ -0,0 +1,249 @@
+#include "qsocbussignals.h"
+
+#include "common/qstaticstringweaver.h"
+
+#include <QtCore>
+#include <QtTest>
+
+#include <functional>
+
+namespace {
+using namespace QSocBusSignals;
+
+/* Port name of a bus signal, for the given interface instance */
+using PortStyle = std::function<QString(int, const QString &)>;
+
+/* Interfaces of one bus in one naming style */
+struct Family
+{
+    const char             *name;       /* Family name */
+    const char             *marker;     /* Marker of the first interface, the matching hint */
+    const QVector<QString> *busSignals; /* Signals of the bus */
+    PortStyle               portOf;     /* Naming style of the ports */
+};
+
+/* Naming styles met in real IP, the corpus cycles through them */
+const QVector<Family> kFamilies = {
+    {"apb snake case",
+     "s_apb0",
+     &kApbSignals,
+     [](int instance, const QString &busSignal) {
+         return QString("s_apb%1_").arg(instance) + busSignal;
+     }},
+    {"ahb upper case",
+     "AHB0",
+     &kAhbSignals,
+     [](int instance, const QString &busSignal) {
+         return QString("AHB%1_").arg(instance) + busSignal.toUpper();
+     }},
+    {"axi4 xilinx",
+     "m0_axi",
+     &kAxi4Signals,
+     [](int instance, const QString &busSignal) {
+         return QString("m%1_axi_").arg(instance) + busSignal;
+     }},
+    {"axi4 chisel",
+     "io_mem0",
+     &kAxi4Signals,
+     [](int instance, const QString &busSignal) {
+         /* The channel is split from the signal */
+         const int channel = busSignal.startsWith("aw") || busSignal.startsWith("ar") ? 2 : 1;
+         return QString("io_mem%1_").arg(instance) + busSignal.left(channel) + "_"
+                + busSignal.mid(channel);
+     }},
+    {"chi",
+     "chi0_rn",
+     &kChiSignals,
+     [](int instance, const QString &busSignal) {
+         return QString("chi%1_rn_").arg(instance) + busSignal;
+     }},
+    {"phy phase suffix",
+     "dfi",
+     &kDfiSignals,
+     [](int instance, const QString &busSignal) {
+         return "dfi_" + busSignal + QString("_p%1").arg(instance);
+     }},
+    {"apb camel case",
+     "apb0",
+     &kApbSignals,
+     [](int instance, const QString &busSignal) {
+         return QString("apb%1").arg(instance) + busSignal.left(1).toUpper() + busSignal.mid(1);
+     }},
+};
+
+/* Scales of the corpus benchmarks */
+const QVector<int> kScales = {10, 100, 1000, 10000};
+
+/* Largest scale of the assignment benchmark, the algorithm is cubic */
+constexpr int kMaxAssignmentScale = 1000;
+
+/* Marker that removeCommonString strips, as addModuleBus passes it */
+const QString kCommonMarker = "m_axi";
+
+/**
+ * @brief Make a corpus of port names.
+ * @details Interfaces of every family in turn, each interface with all the
+ *          signals of its bus, until the corpus is full.
+ * @param count Number of port names.
+ * @return QVector<QString> The port names, the same for every run.
+ */
+QVector<QString> portCorpus(int count)
+{
+    QVector<QString> result;
+    for (int instance = 0; result.size() < count; instance++) {
+        for (const Family &family : kFamilies) {
+            for (const QString &busSignal : *family.busSignals) {
+                if (result.size() == count) {
+                    return result;
+                }
+                result.append(family.portOf(instance, busSignal));
+            }
+        }
+    }
+    return result;
+}
+
+/* Add a row for each scale up to a limit */
+void addScaleRows(int limit = kScales.last())
+{
+    QTest::addColumn<int>("count");
+    for (const int count : kScales) {
+        if (count <= limit) {
+            QTest::newRow(qPrintable(QString::number(count))) << count;
+        }
+    }
+}
+} // namespace
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void levenshteinDistance_data() { addScaleRows(); }
+
+    void levenshteinDistance()
+    {
+        QFETCH(int, count);
+        const QVector<QString> corpus = portCorpus(count);
+
+        /* Neighbours share a prefix or a signal, like ports of one module */
+        qint64 total = 0;
+        QBENCHMARK {
+            total = 0;
+            for (int index = 1; index < corpus.size(); index++) {
+                total += QStaticStringWeaver::levenshteinDistance(corpus[index - 1], corpus[index]);
+            }
+        }
+        QVERIFY(total > 0);
+    }
+
+    void extractCandidateSubstrings_data() { addScaleRows(); }
+
+    void extractCandidateSubstrings()
+    {
+        QFETCH(int, count);
+        const QVector<QString> corpus = portCorpus(count);
+
+        QMap<QString, int> candidateSubstrings;
+        QBENCHMARK {
+            candidateSubstrings = QStaticStringWeaver::extractCandidateSubstrings(corpus, 3, 2);
+        }
+        QVERIFY(!candidateSubstrings.isEmpty());
+    }
+
+    void clusterStrings_data() { addScaleRows(); }
+
+    void clusterStrings()
+    {
+        QFETCH(int, count);
+        const QVector<QString>   corpus = portCorpus(count);
+        const QMap<QString, int> candidateSubstrings
+            = QStaticStringWeaver::extractCandidateSubstrings(corpus, 3, 2);
+
+        QMap<QString, QVector<QString>> groups;
+        QBENCHMARK {
+            groups = QStaticStringWeaver::clusterStrings(corpus, candidateSubstrings);
+        }
+        QVERIFY(!groups.isEmpty());
+    }
+
+    void removeCommonString_data() { addScaleRows(); }
+
+    void removeCommonString()
+    {
+        QFETCH(int, count);
+        const QVector<QString> corpus = portCorpus(count);
+
+        /* Most names lack the marker and take the fuzzy search */
+        qint64 removed = 0;
+        QBENCHMARK {
+            removed = 0;
+            for (const QString &port : corpus) {
+                removed += port.size()
+                           - QStaticStringWeaver::removeCommonString(port, kCommonMarker).size();
+            }
+        }
+        /* Removal never adds characters */
+        QVERIFY(removed >= 0);
+    }
+
+    void hungarianAlgorithm_data() { addScaleRows(kMaxAssignmentScale); }
+
+    void hungarianAlgorithm()
+    {
+        QFETCH(int, count);
+        const QVector<QString> corpus = portCorpus(count);
+
+        /* Costs as findOptimalMatching makes them, against a permuted corpus */
+        QVector<QVector<double>> costMatrix(count, QVector<double>(count));
+        for (int row = 0; row < count; row++) {
+            for (int column = 0; column < count; column++) {
+                const QString &permuted   = corpus[(column * 7 + 3) % count];
+                const double   similarity = QStaticStringWeaver::similarity(corpus[row], permuted);
+                costMatrix[row][column]   = 1.0 - similarity;
+            }
+        }
+
+        QVector<int> assignment;
+        QBENCHMARK {
+            assignment = QStaticStringWeaver::hungarianAlgorithm(costMatrix);
+        }
+        QCOMPARE(assignment.size(), corpus.size());
+    }
+
+    void findOptimalMatching_data()
+    {
+        QTest::addColumn<QVector<QString>>("modulePorts");
+        QTest::addColumn<QVector<QString>>("busSignals");
+        QTest::addColumn<QString>("commonSubstr");
+
+        /* One interface of each family, sized like the real buses */
+        for (const Family &family : kFamilies) {
+            QVector<QString> modulePorts;
+            for (const QString &busSignal : *family.busSignals) {
+                modulePorts.append(family.portOf(0, busSignal));
+            }
+            QTest::newRow(family.name)
+                << modulePorts << *family.busSignals << QString(family.marker);
+        }
+    }
+
+    void findOptimalMatching()
+    {
+        QFETCH(QVector<QString>, modulePorts);
+        QFETCH(QVector<QString>, busSignals);
+        QFETCH(QString, commonSubstr);
+
+        QMap<QString, QString> matching;
+        QBENCHMARK {
+            matching = QStaticStringWeaver::findOptimalMatching(
+                modulePorts, busSignals, commonSubstr);
+        }
+        QCOMPARE(matching.size(), busSignals.size());
+    }
+};
+
+QTEST_APPLESS_MAIN(Test)
+
+#include "bench_qstaticstringweaver.moc"
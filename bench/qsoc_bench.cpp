@@ -0,0 +1,316 @@
+#include "qsocbenchdesign.h"
+
+#include "common/config.h"
+#include "common/qllmservice.h"
+#include "common/qsocbusmanager.h"
+#include "common/qsocconfig.h"
+#include "common/qsocgeneratemanager.h"
+#include "common/qsocmodulemanager.h"
+#include "common/qsocprojectmanager.h"
+#include "common/qstaticyamlcache.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+namespace {
+/* Modules imported into one library, like the IP of one vendor */
+constexpr int kModulesPerLibrary = 16;
+
+/* Name of the generated netlist, also the name of the generated Verilog */
+const QString kNetlistName = "bench_top";
+
+/* Keep errors only, the other qsoc messages would swamp the progress */
+void filterMessage(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    Q_UNUSED(context);
+    if (type == QtCriticalMsg || type == QtFatalMsg) {
+        std::cerr << message.toStdString() << std::endl;
+    }
+}
+
+/* Read a positive integer option */
+bool readCount(const QCommandLineParser &parser, const QString &name, int &value)
+{
+    bool      valid  = false;
+    const int parsed = parser.value(name).toInt(&valid);
+    if (!valid || parsed < 1) {
+        std::cerr << "Error: invalid --" << name.toStdString() << ": "
+                  << parser.value(name).toStdString() << std::endl;
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+/* One benchmark, the setup before each run is not timed */
+struct Benchmark
+{
+    QString               name;  /* Benchmark name */
+    qint64                items; /* Items handled by one run, for the throughput */
+    std::function<bool()> setup; /* Preparation, may be empty */
+    std::function<bool()> run;   /* Timed work */
+};
+
+/**
+ * @brief Time a benchmark.
+ * @param benchmark The benchmark.
+ * @param repeat Number of runs.
+ * @param result Receives the timings.
+ * @retval true Every run succeeded.
+ * @retval false The setup or a run failed.
+ */
+bool measure(const Benchmark &benchmark, int repeat, QJsonObject &result)
+{
+    std::vector<double> samples;
+    for (int index = 0; index < repeat; index++) {
+        if (benchmark.setup && !benchmark.setup()) {
+            std::cerr << "Error: setup failed: " << benchmark.name.toStdString() << std::endl;
+            return false;
+        }
+        QElapsedTimer timer;
+        timer.start();
+        const bool   success      = benchmark.run();
+        const double milliseconds = static_cast<double>(timer.nsecsElapsed()) / 1e6;
+        if (!success) {
+            std::cerr << "Error: benchmark failed: " << benchmark.name.toStdString() << std::endl;
+            return false;
+        }
+        samples.push_back(milliseconds);
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const double median     = samples[samples.size() / 2];
+    const double throughput = median > 0.0 ? static_cast<double>(benchmark.items) * 1000.0 / median
+                                           : 0.0;
+    result = QJsonObject{
+        {"name", benchmark.name},
+        {"repeat", repeat},
+        {"items", benchmark.items},
+        {"min_ms", samples.front()},
+        {"median_ms", median},
+        {"max_ms", samples.back()},
+        {"items_per_second", throughput}};
+    std::cerr << benchmark.name.toStdString() << ": " << median << " ms" << std::endl;
+    return true;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("qsoc_bench");
+    QCoreApplication::setApplicationVersion(QSOC_VERSION);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Benchmark qsoc on a synthetic SoC design. Results are printed as JSON, progress goes to "
+        "stderr.");
+    parser.addHelpOption();
+    parser.addOptions({
+        {"modules", "Module definitions of the design.", "count", "100"},
+        {"ports", "Data ports per module.", "count", "16"},
+        {"instances", "Module instances of the netlist.", "count", "200"},
+        {"nets", "Data nets of the netlist.", "count", "400"},
+        {"seed", "Seed of the design generator.", "seed", "1"},
+        {"repeat", "Runs of each benchmark, the median is reported.", "count", "5"},
+        {"jobs", "Verilog parse threads, 0 for one per core.", "count", "1"},
+        {"directory", "Work directory, a temporary one by default.", "path"},
+        {"output", "Write the results to a file instead of stdout.", "file"},
+        {"verbose", "Show qsoc messages."},
+    });
+    parser.process(app);
+
+    QSocBenchDesign::Scale scale;
+    int                    repeat = 0;
+    if (!readCount(parser, "modules", scale.modules) || !readCount(parser, "ports", scale.ports)
+        || !readCount(parser, "instances", scale.instances)
+        || !readCount(parser, "nets", scale.nets) || !readCount(parser, "repeat", repeat)) {
+        return 1;
+    }
+    scale.seed          = parser.value("seed").toUInt();
+    const int parseJobs = qMax(0, parser.value("jobs").toInt());
+    if (!parser.isSet("verbose")) {
+        qInstallMessageHandler(filterMessage);
+    }
+
+    /* Project in the work directory */
+    const QTemporaryDir tempDir;
+    const QString workPath = parser.isSet("directory") ? parser.value("directory") : tempDir.path();
+    if (workPath.isEmpty() || !QDir().mkpath(workPath)) {
+        std::cerr << "Error: invalid work directory" << std::endl;
+        return 1;
+    }
+    QSocProjectManager projectManager;
+    projectManager.setProjectPath(workPath);
+    projectManager.setBusPath(workPath + "/bus");
+    projectManager.setModulePath(workPath + "/module");
+    projectManager.setSchematicPath(workPath + "/schematic");
+    projectManager.setOutputPath(workPath + "/output");
+    if (!projectManager.save("bench") || !QDir().mkpath(workPath + "/rtl")) {
+        std::cerr << "Error: failed to create project in " << workPath.toStdString() << std::endl;
+        return 1;
+    }
+
+    QSocConfig          socConfig(nullptr, &projectManager);
+    QLLMService         llmService(nullptr, &socConfig);
+    QSocBusManager      busManager(nullptr, &projectManager);
+    QSocModuleManager   moduleManager(nullptr, &projectManager, &busManager, &llmService);
+    QSoCGenerateManager generateManager(nullptr, &projectManager, &moduleManager, &busManager);
+
+    const QSocBenchDesign    design(scale);
+    const QString            busCsvPath  = QDir(workPath).filePath("bench_apb.csv");
+    const QString            netlistPath = QDir(workPath).filePath(kNetlistName + ".soc_net");
+    const QRegularExpression libraryRegex("bench_lib_\\d+");
+    QStringList              verilogFiles;
+
+    /* Imports merge into existing libraries, each run starts from scratch */
+    const auto removeModuleLibraries = [&]() {
+        QDir moduleDir(projectManager.getModulePath());
+        for (const QString &fileName : moduleDir.entryList({"bench_lib_*.soc_mod"}, QDir::Files)) {
+            if (!moduleDir.remove(fileName)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    const auto removeBusLibrary = [&]() {
+        const QString filePath = QDir(projectManager.getBusPath())
+                                     .filePath(QSocBenchDesign::busName() + ".soc_bus");
+        return !QFile::exists(filePath) || QFile::remove(filePath);
+    };
+
+    /* One CLI command on the design: fresh managers load every library and list the modules */
+    const auto runCommand = [&]() {
+        QSocBusManager    commandBusManager(nullptr, &projectManager);
+        QSocModuleManager commandModuleManager(nullptr, &projectManager, &commandBusManager);
+        return commandBusManager.load(QSocBenchDesign::busName())
+               && commandModuleManager.load(libraryRegex)
+               && commandModuleManager.listModule().size() == scale.modules;
+    };
+
+    /* Each benchmark works on what the ones before it produced */
+    const std::vector<Benchmark> benchmarks = {
+        {"design.generate",
+         scale.modules,
+         {},
+         [&]() {
+             return design.writeVerilog(workPath + "/rtl", verilogFiles)
+                    && design.writeBusCsv(busCsvPath) && design.writeNetlist(netlistPath);
+         }},
+        {"module.import",
+         scale.modules,
+         removeModuleLibraries,
+         [&]() {
+             for (int first = 0; first < verilogFiles.size(); first += kModulesPerLibrary) {
+                 if (!moduleManager.importFromFileList(
+                         QString("bench_lib_%1").arg(first / kModulesPerLibrary),
+                         QRegularExpression(".*"),
+                         QString(),
+                         verilogFiles.mid(first, kModulesPerLibrary),
+                         parseJobs)) {
+                     return false;
+                 }
+             }
+             return true;
+         }},
+        {"bus.import",
+         1,
+         removeBusLibrary,
+         [&]() {
+             return busManager.importFromFileList(
+                 QSocBenchDesign::busName(), QSocBenchDesign::busName(), {busCsvPath});
+         }},
+        {"module.load", scale.modules, {}, [&]() { return moduleManager.load(libraryRegex); }},
+        {"bus.load", 1, {}, [&]() { return busManager.load(QSocBenchDesign::busName()); }},
+        {"module.save", scale.modules, {}, [&]() { return moduleManager.save(libraryRegex); }},
+        {"bus.bind",
+         scale.modules,
+         {},
+         [&]() {
+             for (int module = 0; module < scale.modules; module++) {
+                 if (!moduleManager.addModuleBus(
+                         QSocBenchDesign::moduleName(module),
+                         QSocBenchDesign::busName(),
+                         "slave",
+                         QSocBenchDesign::busInterface())) {
+                     return false;
+                 }
+             }
+             return true;
+         }},
+        {"netlist.load",
+         scale.instances,
+         {},
+         [&]() { return generateManager.loadNetlist(netlistPath); }},
+        {"netlist.expand",
+         scale.instances,
+         [&]() { return generateManager.loadNetlist(netlistPath); },
+         [&]() { return generateManager.processNetlist(); }},
+        {"verilog.generate",
+         scale.instances,
+         [&]() {
+             return generateManager.loadNetlist(netlistPath) && generateManager.processNetlist();
+         },
+         [&]() { return generateManager.generateVerilog(kNetlistName); }},
+        {"command.latency",
+         scale.modules,
+         []() {
+             QStaticYamlCache::setEnabled(false);
+             return true;
+         },
+         runCommand},
+        /* As in `qsoc serve`, the first run parses and later runs reuse the libraries */
+        {"session.latency",
+         scale.modules,
+         []() {
+             QStaticYamlCache::setEnabled(true);
+             return true;
+         },
+         runCommand},
+    };
+
+    QJsonArray results;
+    for (const Benchmark &benchmark : benchmarks) {
+        QJsonObject result;
+        if (!measure(benchmark, repeat, result)) {
+            return 1;
+        }
+        results.append(result);
+    }
+
+    const QJsonObject report{
+        {"version", QSOC_VERSION},
+        {"design",
+         QJsonObject{
+             {"modules", design.getScale().modules},
+             {"ports", design.getScale().ports},
+             {"instances", design.getScale().instances},
+             {"nets", design.getScale().nets},
+             {"seed", static_cast<qint64>(design.getScale().seed)},
+             {"jobs", parseJobs}}},
+        {"benchmarks", results}};
+    const QByteArray json = QJsonDocument(report).toJson();
+    if (!parser.isSet("output")) {
+        std::cout << json.toStdString();
+        return 0;
+    }
+    QFile file(parser.value("output"));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(json) != json.size()) {
+        std::cerr << "Error: failed to write " << parser.value("output").toStdString() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,216 @@
+#include "qsocbenchdesign.h"
+
+#include <QDir>
+#include <QFile>
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+/* Signal of the APB bus */
+struct BusSignal
+{
+    const char *name;       /* Signal name */
+    int         width;      /* Bit width */
+    bool        slaveInput; /* Driven by the master */
+    const char *qualifier;  /* Bus qualifier, may be empty */
+};
+
+/* Signals of the APB bus, in the order modules declare them */
+const BusSignal kBusSignals[] = {
+    {"paddr", 32, true, "address"},
+    {"psel", 1, true, ""},
+    {"penable", 1, true, ""},
+    {"pwrite", 1, true, ""},
+    {"pwdata", 32, true, "data"},
+    {"prdata", 32, false, "data"},
+    {"pready", 1, false, ""},
+    {"pslverr", 1, false, ""},
+};
+
+/* Widths a data port can have */
+const int kDataWidths[] = {1, 8, 16, 32, 64};
+
+/* Number of data port widths */
+constexpr int kDataWidthCount = static_cast<int>(std::size(kDataWidths));
+
+/* Every this many instances one overrides a parameter */
+constexpr int kParameterStride = 4;
+
+/* Instances that share one bus segment */
+constexpr int kSegmentSize = 4;
+
+/* Most loads of one data net */
+constexpr int kMaxLoads = 3;
+
+/* Verilog range of a width, empty for one bit */
+QString range(int width)
+{
+    return width > 1 ? QString("[%1:0] ").arg(width - 1) : QString();
+}
+} // namespace
+
+QSocBenchDesign::QSocBenchDesign(const Scale &scale)
+    : scale(scale)
+{
+    this->scale.modules   = std::max(1, this->scale.modules);
+    this->scale.ports     = std::max(2, this->scale.ports);
+    this->scale.instances = std::max(1, this->scale.instances);
+    this->scale.nets      = std::max(0, this->scale.nets);
+
+    std::mt19937 engine(this->scale.seed);
+    widths.resize(this->scale.modules);
+    for (std::vector<int> &moduleWidths : widths) {
+        moduleWidths.resize(this->scale.ports);
+        for (int &width : moduleWidths) {
+            width = kDataWidths[draw(engine, kDataWidthCount)];
+        }
+    }
+}
+
+const QSocBenchDesign::Scale &QSocBenchDesign::getScale() const
+{
+    return scale;
+}
+
+QString QSocBenchDesign::moduleName(int module)
+{
+    return QString("bench_mod_%1").arg(module);
+}
+
+QString QSocBenchDesign::busName()
+{
+    return "bench_apb";
+}
+
+QString QSocBenchDesign::busInterface()
+{
+    return "s_apb";
+}
+
+bool QSocBenchDesign::writeVerilog(const QString &dirPath, QStringList &filePathList) const
+{
+    const QDir dir(dirPath);
+    const int  inputs = inputCount();
+    filePathList.clear();
+    for (int module = 0; module < scale.modules; module++) {
+        QStringList ports = {"input  wire clk", "input  wire rst_n"};
+        for (const BusSignal &signal : kBusSignals) {
+            ports.append(QString("%1 wire %2%3_%4")
+                             .arg(signal.slaveInput ? "input " : "output")
+                             .arg(range(signal.width))
+                             .arg(busInterface())
+                             .arg(signal.name));
+        }
+        for (int port = 0; port < scale.ports; port++) {
+            const bool input = port < inputs;
+            ports.append(QString("%1 wire %2data_%3_%4")
+                             .arg(input ? "input " : "output")
+                             .arg(range(widths[module][port]))
+                             .arg(input ? "in" : "out")
+                             .arg(input ? port : port - inputs));
+        }
+
+        const QString text = QString("module %1 #(\n"
+                                     "    parameter WIDTH = 8\n"
+                                     ") (\n"
+                                     "    %2\n"
+                                     ");\n"
+                                     "endmodule\n")
+                                 .arg(moduleName(module))
+                                 .arg(ports.join(",\n    "));
+        const QString filePath = dir.filePath(moduleName(module) + ".v");
+        if (!writeFile(filePath, text)) {
+            return false;
+        }
+        filePathList.append(filePath);
+    }
+    return true;
+}
+
+bool QSocBenchDesign::writeBusCsv(const QString &filePath) const
+{
+    QString text = "name,mode,direction,width,qualifier,description\n";
+    for (const BusSignal &signal : kBusSignals) {
+        for (const bool master : {true, false}) {
+            const bool input = master != signal.slaveInput;
+            text += QString("%1,%2,%3,%4,%5,APB %1\n")
+                        .arg(signal.name)
+                        .arg(master ? "master" : "slave")
+                        .arg(input ? "input" : "output")
+                        .arg(signal.width)
+                        .arg(signal.qualifier);
+        }
+    }
+    return writeFile(filePath, text);
+}
+
+bool QSocBenchDesign::writeNetlist(const QString &filePath) const
+{
+    /* Drawn separately from the widths, so changing the netlist scale keeps the modules */
+    std::mt19937 engine(scale.seed ^ 0x9e3779b9U);
+    const int    inputs  = inputCount();
+    const int    outputs = scale.ports - inputs;
+    QString      text;
+
+    text += "instance:\n";
+    for (int instance = 0; instance < scale.instances; instance++) {
+        text += QString("  u_%1:\n    module: %2\n")
+                    .arg(instance)
+                    .arg(moduleName(instance % scale.modules));
+        if (instance % kParameterStride == 0) {
+            text += QString("    parameter:\n      WIDTH: %1\n")
+                        .arg(kDataWidths[draw(engine, kDataWidthCount)]);
+        }
+    }
+
+    text += "net:\n";
+    for (const char *global : {"clk", "rst_n"}) {
+        text += QString("  %1:\n").arg(global);
+        for (int instance = 0; instance < scale.instances; instance++) {
+            text += QString("    - instance: u_%1\n      port: %2\n").arg(instance).arg(global);
+        }
+    }
+    for (int net = 0; net < scale.nets; net++) {
+        text += QString("  n_%1:\n    - instance: u_%2\n      port: data_out_%3\n")
+                    .arg(net)
+                    .arg(draw(engine, scale.instances))
+                    .arg(draw(engine, outputs));
+        const int loads = 1 + draw(engine, kMaxLoads);
+        for (int load = 0; load < loads; load++) {
+            text += QString("    - instance: u_%1\n      port: data_in_%2\n")
+                        .arg(draw(engine, scale.instances))
+                        .arg(draw(engine, inputs));
+        }
+    }
+
+    text += "bus:\n";
+    for (int instance = 0; instance < scale.instances; instance++) {
+        if (instance % kSegmentSize == 0) {
+            text += QString("  apb_%1:\n").arg(instance / kSegmentSize);
+        }
+        text += QString("    u_%1:\n      port: %2\n").arg(instance).arg(busInterface());
+    }
+
+    return writeFile(filePath, text);
+}
+
+int QSocBenchDesign::inputCount() const
+{
+    return (scale.ports + 1) / 2;
+}
+
+bool QSocBenchDesign::writeFile(const QString &filePath, const QString &text)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    const QByteArray content = text.toUtf8();
+    return file.write(content) == content.size();
+}
+
+int QSocBenchDesign::draw(std::mt19937 &engine, int bound)
+{
+    return static_cast<int>(engine() % static_cast<uint32_t>(bound));
+}
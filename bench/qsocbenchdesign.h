@@ -0,0 +1,132 @@
+#ifndef QSOCBENCHDESIGN_H
+#define QSOCBENCHDESIGN_H
+
+#include <QString>
+#include <QStringList>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/**
+ * @brief The QSocBenchDesign class.
+ * @details This class generates a synthetic SoC for benchmarks: Verilog
+ *          modules, an APB bus definition as CSV and a netlist that
+ *          instantiates the modules, wires their data ports together and
+ *          connects their APB slave interfaces in bus segments. The design
+ *          only depends on the scale and the seed, the same settings give
+ *          byte identical files on every platform.
+ */
+class QSocBenchDesign
+{
+public:
+    /**
+     * @brief The Scale struct.
+     * @details Size of the generated design.
+     */
+    struct Scale
+    {
+        int      modules   = 100; /* Module definitions */
+        int      ports     = 16;  /* Data ports per module, besides clock, reset and APB */
+        int      instances = 200; /* Module instances in the netlist */
+        int      nets      = 400; /* Point to point data nets in the netlist */
+        uint32_t seed      = 1;   /* Generator seed */
+    };
+
+    /**
+     * @brief Constructor.
+     * @details Draws the port widths of every module, the files are written
+     *          by the write functions.
+     * @param scale Size of the design, ports is raised to at least two.
+     */
+    explicit QSocBenchDesign(const Scale &scale);
+
+    /**
+     * @brief Get the scale of the design.
+     * @return const Scale & The scale.
+     */
+    const Scale &getScale() const;
+
+    /**
+     * @brief Get the name of a module.
+     * @param module Module index.
+     * @return QString The module name.
+     */
+    static QString moduleName(int module);
+
+    /**
+     * @brief Get the name of the bus.
+     * @return QString The bus name, also the bus library name.
+     */
+    static QString busName();
+
+    /**
+     * @brief Get the name of the bus interface of every module.
+     * @return QString The bus interface name.
+     */
+    static QString busInterface();
+
+    /**
+     * @brief Write one Verilog file per module.
+     * @param dirPath Directory of the files, it must exist.
+     * @param filePathList Receives the file paths in module order.
+     * @retval true All files were written.
+     * @retval false A file could not be written.
+     */
+    bool writeVerilog(const QString &dirPath, QStringList &filePathList) const;
+
+    /**
+     * @brief Write the bus definition.
+     * @details The CSV has the columns the bus import maps, with a master
+     *          and a slave row for every signal.
+     * @param filePath Path of the CSV file.
+     * @retval true The file was written.
+     * @retval false The file could not be written.
+     */
+    bool writeBusCsv(const QString &filePath) const;
+
+    /**
+     * @brief Write the netlist.
+     * @details Clock and reset reach every instance, every data net has one
+     *          driver and up to three loads, and groups of four instances
+     *          share a bus segment.
+     * @param filePath Path of the netlist file.
+     * @retval true The file was written.
+     * @retval false The file could not be written.
+     */
+    bool writeNetlist(const QString &filePath) const;
+
+private:
+    /* Size of the design. */
+    Scale scale;
+
+    /* Data port widths of each module, inputs first, then outputs. */
+    std::vector<std::vector<int>> widths;
+
+    /**
+     * @brief Get the number of data inputs of a module.
+     * @return int Data inputs, the rest of the data ports are outputs.
+     */
+    int inputCount() const;
+
+    /**
+     * @brief Write a text file.
+     * @param filePath Path of the file.
+     * @param text File content.
+     * @retval true The file was written.
+     * @retval false The file could not be written.
+     */
+    static bool writeFile(const QString &filePath, const QString &text);
+
+    /**
+     * @brief Draw a number below a bound.
+     * @details Plain modulo of the raw engine output, the standard
+     *          distributions differ between library implementations.
+     * @param engine Random engine.
+     * @param bound Exclusive upper bound, at least one.
+     * @return int The number.
+     */
+    static int draw(std::mt19937 &engine, int bound);
+};
+
+#endif // QSOCBENCHDESIGN_H
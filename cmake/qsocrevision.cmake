@@ -0,0 +1,44 @@
+# Write qsocrevision.h with the source revision of the generator.
+#
+# Run with cmake -P on every build, configure_file() only touches the header
+# when the revision changed, so nothing is recompiled otherwise.
+#
+# Inputs:
+#   SOURCE_DIR     Source tree root
+#   OUTPUT_FILE    Header to write
+#   GIT_EXECUTABLE Git, optional
+
+# Commit of the tree, empty outside a git checkout
+set(QSOC_COMMIT "")
+if(GIT_EXECUTABLE)
+    execute_process(
+        COMMAND ${GIT_EXECUTABLE} rev-parse --short=12 HEAD
+        WORKING_DIRECTORY "${SOURCE_DIR}"
+        OUTPUT_VARIABLE QSOC_COMMIT
+        OUTPUT_STRIP_TRAILING_WHITESPACE
+        ERROR_QUIET
+    )
+endif()
+
+# Sources that shape the generated output, uncommitted edits change the hash too
+file(GLOB QSOC_GENERATOR_SOURCES
+    "${SOURCE_DIR}/src/common/qsocgeneratemanager.*"
+    "${SOURCE_DIR}/src/common/qsocnetlist*.*"
+    "${SOURCE_DIR}/src/common/qsocporttype.*"
+)
+list(SORT QSOC_GENERATOR_SOURCES)
+set(QSOC_GENERATOR_DIGESTS "")
+foreach(QSOC_GENERATOR_SOURCE ${QSOC_GENERATOR_SOURCES})
+    file(SHA256 "${QSOC_GENERATOR_SOURCE}" QSOC_GENERATOR_DIGEST)
+    string(APPEND QSOC_GENERATOR_DIGESTS "${QSOC_GENERATOR_DIGEST}")
+endforeach()
+string(SHA256 QSOC_SOURCES_HASH "${QSOC_GENERATOR_DIGESTS}")
+string(SUBSTRING "${QSOC_SOURCES_HASH}" 0 12 QSOC_SOURCES_HASH)
+
+if(QSOC_COMMIT)
+    set(QSOC_REVISION "${QSOC_COMMIT}-${QSOC_SOURCES_HASH}")
+else()
+    set(QSOC_REVISION "${QSOC_SOURCES_HASH}")
+endif()
+
+configure_file("${CMAKE_CURRENT_LIST_DIR}/qsocrevision.h.in" "${OUTPUT_FILE}" @ONLY)
@@ -0,0 +1,117 @@
+#include "cli/qsoccliworker.h"
+
+#include "common/qsocresidentlibraries.h"
+#include "common/qstaticlog.h"
+#include "common/qstaticyamlcache.h"
+
+#include <QFile>
+#include <QProcess>
+#include <QTextStream>
+
+#include <cstdio>
+
+bool QSocCliWorker::parseBatch(const QStringList &appArguments)
+{
+    /* Clear upstream positional arguments and setup subcommand */
+    parser.clearPositionalArguments();
+    parser.addOptions({
+        {{"k", "keep-going"},
+         QCoreApplication::translate(
+             "main", "Continue with the next command when a command fails.")},
+    });
+    parser.addPositionalArgument(
+        "file",
+        QCoreApplication::translate(
+            "main",
+            "The script file, one qsoc command per line, '#' starts a comment.\n"
+            "Standard input is read if the file is omitted or '-'."),
+        "[<script file>]");
+
+    parser.parse(appArguments);
+
+    if (parser.isSet("help")) {
+        return showHelp(0);
+    }
+
+    const QStringList cmdArguments = parser.positionalArguments();
+    if (cmdArguments.size() > 1) {
+        return showErrorWithHelp(
+            1, QCoreApplication::translate("main", "Error: too many script files."));
+    }
+    const QString scriptPath = cmdArguments.isEmpty() ? QString("-") : cmdArguments.first();
+    const bool    keepGoing  = parser.isSet("keep-going");
+
+    /* Open the script, lines are read as they come so stdin can be a pipe */
+    QFile      scriptFile(scriptPath);
+    const bool opened = scriptPath == "-"
+                            ? scriptFile.open(stdin, QIODevice::ReadOnly | QIODevice::Text)
+                            : scriptFile.open(QIODevice::ReadOnly | QIODevice::Text);
+    if (!opened) {
+        return showError(
+            1,
+            QCoreApplication::translate("main", "Error: failed to open script file: %1")
+                .arg(scriptPath));
+    }
+
+    /* Keep libraries parsed across commands and write them once at the end */
+    QStaticYamlCache::setDeferred(true);
+    const QStaticLog::Level level       = QStaticLog::getLevel();
+    int                     failedCount = 0;
+    int                     lineNumber  = 0;
+
+    QTextStream scriptStream(&scriptFile);
+    while (!scriptStream.atEnd()) {
+        const QString line = scriptStream.readLine().trimmed();
+        lineNumber++;
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        /* Scripts may spell out the program name or leave it out */
+        QStringList commandArguments = QProcess::splitCommand(line);
+        if (!commandArguments.isEmpty() && commandArguments.first() == "qsoc") {
+            commandArguments.removeFirst();
+        }
+        commandArguments.prepend(appArguments.first());
+
+        /* A fresh worker per command, its parser keeps the options it was given, the
+           libraries its managers loaded stay resident for the next command */
+        int commandExitCode;
+        {
+            QSocCliWorker worker;
+            commandExitCode = worker.execute(commandArguments);
+        }
+        QStaticLog::setLevel(level);
+
+        if (commandExitCode != 0) {
+            /* A failed command may leave loaded libraries changed but not saved */
+            QSocResidentLibraries::clear();
+            failedCount++;
+            qCritical().noquote()
+                << QCoreApplication::translate("main", "Error: command at line %1 failed: %2")
+                       .arg(lineNumber)
+                       .arg(line);
+            if (!keepGoing) {
+                break;
+            }
+        }
+    }
+    scriptFile.close();
+
+    /* Commands before a failure keep their effect, as if run one by one */
+    const bool flushed = QStaticYamlCache::flush();
+    QStaticYamlCache::setEnabled(false);
+    QSocResidentLibraries::clear();
+    if (!flushed) {
+        return showError(
+            1, QCoreApplication::translate("main", "Error: failed to write libraries."));
+    }
+    if (failedCount > 0) {
+        return showError(
+            1,
+            QCoreApplication::translate("main", "Error: %1 batch command(s) failed.")
+                .arg(failedCount));
+    }
+
+    return true;
+}
@@ -2,6 +2,7 @@
 
 #include "common/qslangdriver.h"
 #include "common/qsocbusmanager.h"
+#include "common/qsocnamematcher.h"
 #include "common/qsocprojectmanager.h"
 #include "common/qstaticdatasedes.h"
 #include "common/qstaticlog.h"
@@ -198,24 +199,13 @@ bool QSocCliWorker::parseBusRemove(const QStringList &appArguments)
             QCoreApplication::translate("main", "Error: invalid regular expression of library name: %1")
                 .arg(libraryName));
     }
-    /* Check if all bus names in list is valid */
-    bool    invalidBusNameFound = false;
-    QString invalidBusName;
-    /* Iterate through all bus names */
-    for (const QString &busName : busNameList) {
-        const QRegularExpression busNameRegex(busName);
-        if (!busNameRegex.isValid()) {
-            invalidBusNameFound = true;
-            invalidBusName      = busName;
-            break;
-        }
-    }
-    /* Show error if invalid bus name is found */
-    if (invalidBusNameFound) {
+    /* Check if all bus names in list is valid, they are matched together */
+    const QSocNameMatcher busNameMatcher(busNameList);
+    if (!busNameMatcher.isValid()) {
         return showErrorWithHelp(
             1,
             QCoreApplication::translate("main", "Error: invalid regular expression of bus name: %1")
-                .arg(invalidBusName));
+                .arg(busNameMatcher.getInvalidPattern()));
     }
     /* Setup bus manager */
     QSocBusManager busManager(this, &projectManager);
@@ -227,13 +217,11 @@ bool QSocCliWorker::parseBusRemove(const QStringList &appArguments)
                 .arg(libraryName));
     }
     /* Remove buses */
-    for (const QString &busName : busNameList) {
-        const QRegularExpression busNameRegex(busName);
-        if (!busManager.removeBus(busNameRegex)) {
-            return showErrorWithHelp(
-                1,
-                QCoreApplication::translate("main", "Error: could not remove bus: %1").arg(busName));
-        }
+    if (!busManager.removeBus(busNameMatcher)) {
+        return showErrorWithHelp(
+            1,
+            QCoreApplication::translate("main", "Error: could not remove bus: %1")
+                .arg(busNameList.join(" ")));
     }
 
     return true;
@@ -310,24 +298,13 @@ bool QSocCliWorker::parseBusList(const QStringList &appArguments)
             QCoreApplication::translate("main", "Error: invalid regular expression of library name: %1")
                 .arg(libraryName));
     }
-    /* Check if all bus names in list is valid */
-    bool    invalidBusNameFound = false;
-    QString invalidBusName;
-    /* Iterate through all bus names */
-    for (const QString &busName : busNameList) {
-        const QRegularExpression busNameRegex(busName);
-        if (!busNameRegex.isValid()) {
-            invalidBusNameFound = true;
-            invalidBusName      = busName;
-            break;
-        }
-    }
-    /* Show error if invalid bus name is found */
-    if (invalidBusNameFound) {
+    /* Check if all bus names in list is valid, they are matched together */
+    const QSocNameMatcher busNameMatcher(busNameList);
+    if (!busNameMatcher.isValid()) {
         return showErrorWithHelp(
             1,
             QCoreApplication::translate("main", "Error: invalid regular expression of bus name: %1")
-                .arg(invalidBusName));
+                .arg(busNameMatcher.getInvalidPattern()));
     }
     /* Setup bus manager */
     QSocBusManager busManager(this, &projectManager);
@@ -339,11 +316,7 @@ bool QSocCliWorker::parseBusList(const QStringList &appArguments)
                 .arg(libraryName));
     }
     /* list buses */
-    for (const QString &busName : busNameList) {
-        const QRegularExpression busNameRegex(busName);
-        const QStringList        result = busManager.listBus(busNameRegex);
-        showInfo(0, result.join("\n"));
-    }
+    showInfo(0, busManager.listBus(busNameMatcher).join("\n"));
 
     return true;
 }
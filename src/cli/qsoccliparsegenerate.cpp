@@ -45,6 +45,19 @@ bool QSocCliWorker::parseGenerateVerilog(const QStringList &appArguments)
          QCoreApplication::translate("main", "The path to the project directory."),
          "project directory"},
         {{"p", "project"}, QCoreApplication::translate("main", "The project name."), "project name"},
+        {{"f", "force"},
+         QCoreApplication::translate(
+             "main", "Regenerate even if the netlist and its libraries are unchanged.")},
+        {"check-only",
+         QCoreApplication::translate(
+             "main",
+             "Run design-rule checks and print the report without generating code.\n"
+             "Exits with a non-zero status if any errors are found.")},
+        {"dump-expanded",
+         QCoreApplication::translate(
+             "main",
+             "Also write the bus-expanded netlist to <name>.expanded.yaml\n"
+             "in the output directory.")},
     });
 
     parser.addPositionalArgument(
@@ -114,6 +127,9 @@ bool QSocCliWorker::parseGenerateVerilog(const QStringList &appArguments)
     }
 
     /* Generate Verilog code for each netlist file  */
+    const bool checkOnly    = parser.isSet("check-only");
+    const bool dumpExpanded = parser.isSet("dump-expanded");
+    bool       checkPassed  = true;
     for (const QString &netlistFilePath : filePathList) {
         /* Load the netlist file */
         if (!generateManager.loadNetlist(netlistFilePath)) {
@@ -123,6 +139,48 @@ bool QSocCliWorker::parseGenerateVerilog(const QStringList &appArguments)
                     .arg(netlistFilePath));
         }
 
+        QFileInfo     fileInfo(netlistFilePath);
+        QString       outputFileName = fileInfo.baseName();
+        const QString expandedPath   = QDir(projectManager.getOutputPath())
+                                         .filePath(outputFileName + ".expanded.yaml");
+
+        /* Only run design-rule checks, all files are checked before failing */
+        if (checkOnly) {
+            if (!generateManager.processNetlist()) {
+                return showError(
+                    1,
+                    QCoreApplication::translate("main", "Error: failed to process netlist file: %1")
+                        .arg(netlistFilePath));
+            }
+            if (dumpExpanded && !generateManager.saveExpandedNetlist(expandedPath)) {
+                return showError(
+                    1,
+                    QCoreApplication::translate(
+                        "main", "Error: failed to save expanded netlist: %1")
+                        .arg(expandedPath));
+            }
+            YAML::Node report;
+            if (!generateManager.checkNetlist(report)) {
+                checkPassed = false;
+            }
+            YAML::Node document;
+            document["file"]      = netlistFilePath.toStdString();
+            document["summary"]   = report["summary"];
+            document["violation"] = report["violation"];
+            showInfo(0, QString::fromStdString(YAML::Dump(document)));
+            continue;
+        }
+
+        /* Skip netlists whose inputs are unchanged since the last generation */
+        if (!parser.isSet("force") && !dumpExpanded
+            && generateManager.isVerilogUpToDate(outputFileName)) {
+            showInfo(
+                0,
+                QCoreApplication::translate("main", "Verilog code is up to date: %1")
+                    .arg(QDir(projectManager.getOutputPath()).filePath(outputFileName + ".v")));
+            continue;
+        }
+
         /* Process the netlist */
         if (!generateManager.processNetlist()) {
             return showError(
@@ -131,9 +189,15 @@ bool QSocCliWorker::parseGenerateVerilog(const QStringList &appArguments)
                     .arg(netlistFilePath));
         }
 
+        /* Dump the expanded netlist on request only, it can be huge */
+        if (dumpExpanded && !generateManager.saveExpandedNetlist(expandedPath)) {
+            return showError(
+                1,
+                QCoreApplication::translate("main", "Error: failed to save expanded netlist: %1")
+                    .arg(expandedPath));
+        }
+
         /* Generate Verilog code */
-        QFileInfo fileInfo(netlistFilePath);
-        QString   outputFileName = fileInfo.baseName();
         if (!generateManager.generateVerilog(outputFileName)) {
             return showError(
                 1,
@@ -147,5 +211,9 @@ bool QSocCliWorker::parseGenerateVerilog(const QStringList &appArguments)
                 .arg(QDir(projectManager.getOutputPath()).filePath(outputFileName + ".v")));
     }
 
+    if (!checkPassed) {
+        return showError(1, QCoreApplication::translate("main", "Error: design-rule check failed"));
+    }
+
     return true;
 }
@@ -2,10 +2,13 @@
 
 #include "common/qslangdriver.h"
 #include "common/qsocmodulemanager.h"
+#include "common/qsocnamematcher.h"
 #include "common/qsocprojectmanager.h"
 #include "common/qstaticdatasedes.h"
 #include "common/qstaticlog.h"
 
+#include <QFile>
+
 bool QSocCliWorker::parseModule(const QStringList &appArguments)
 {
     /* Clear upstream positional arguments and setup subcommand */
@@ -82,6 +85,17 @@ bool QSocCliWorker::parseModuleImport(const QStringList &appArguments)
              "The path where the file list is located, including a list of "
              "verilog files in order."),
          "filelist"},
+        {{"j", "jobs"},
+         QCoreApplication::translate(
+             "main",
+             "Parse verilog files that do not share macros in parallel on\n"
+             "this many threads, 0 uses all cores. Default is 1, a single\n"
+             "compilation unit."),
+         "count"},
+        {"diagnostics",
+         QCoreApplication::translate(
+             "main", "Write the verilog parser diagnostics to this file as JSON."),
+         "file"},
     });
     parser.addPositionalArgument(
         "files",
@@ -136,7 +150,30 @@ bool QSocCliWorker::parseModuleImport(const QStringList &appArguments)
             1,
             QCoreApplication::translate("main", "Error: invalid regular expression of module name."));
     }
-    if (!moduleManager.importFromFileList(libraryName, moduleNameRegex, filelistPath, filePathList)) {
+    bool      jobsValid = true;
+    const int parseJobs = parser.isSet("jobs") ? parser.value("jobs").toInt(&jobsValid) : 1;
+    if (!jobsValid || parseJobs < 0) {
+        return showErrorWithHelp(
+            1,
+            QCoreApplication::translate("main", "Error: invalid number of jobs: %1")
+                .arg(parser.value("jobs")));
+    }
+    QList<QSlangDriver::Diagnostic> diagnostics;
+    const bool                      imported = moduleManager.importFromFileList(
+        libraryName, moduleNameRegex, filelistPath, filePathList, parseJobs, &diagnostics);
+    /* Diagnostics are written on failure too, that is when they matter */
+    if (parser.isSet("diagnostics")) {
+        QFile diagnosticsFile(parser.value("diagnostics"));
+        if (!diagnosticsFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            return showError(
+                1,
+                QCoreApplication::translate("main", "Error: failed to write diagnostics: %1")
+                    .arg(parser.value("diagnostics")));
+        }
+        diagnosticsFile.write(
+            QByteArray::fromStdString(QSlangDriver::diagnosticsToJson(diagnostics).dump(4)));
+    }
+    if (!imported) {
         return showErrorWithHelp(1, QCoreApplication::translate("main", "Error: import failed."));
     }
 
@@ -213,24 +250,13 @@ bool QSocCliWorker::parseModuleRemove(const QStringList &appArguments)
             QCoreApplication::translate("main", "Error: invalid regular expression of library name: %1")
                 .arg(libraryName));
     }
-    /* Check if all module names in list is valid */
-    bool    invalidModuleNameFound = false;
-    QString invalidModuleName;
-    /* Iterate through all module names */
-    for (const QString &moduleName : moduleNameList) {
-        const QRegularExpression moduleNameRegex(moduleName);
-        if (!moduleNameRegex.isValid()) {
-            invalidModuleNameFound = true;
-            invalidModuleName      = moduleName;
-            break;
-        }
-    }
-    /* Show error if invalid module name is found */
-    if (invalidModuleNameFound) {
+    /* Check if all module names in list is valid, they are matched together */
+    const QSocNameMatcher moduleNameMatcher(moduleNameList);
+    if (!moduleNameMatcher.isValid()) {
         return showErrorWithHelp(
             1,
             QCoreApplication::translate("main", "Error: invalid regular expression of module name: %1")
-                .arg(invalidModuleName));
+                .arg(moduleNameMatcher.getInvalidPattern()));
     }
     /* Setup module manager */
     QSocBusManager    busManager(this, &projectManager);
@@ -243,14 +269,11 @@ bool QSocCliWorker::parseModuleRemove(const QStringList &appArguments)
                 .arg(libraryName));
     }
     /* Remove modules */
-    for (const QString &moduleName : moduleNameList) {
-        const QRegularExpression moduleNameRegex(moduleName);
-        if (!moduleManager.removeModule(moduleNameRegex)) {
-            return showErrorWithHelp(
-                1,
-                QCoreApplication::translate("main", "Error: could not remove module: %1")
-                    .arg(moduleName));
-        }
+    if (!moduleManager.removeModule(moduleNameMatcher)) {
+        return showErrorWithHelp(
+            1,
+            QCoreApplication::translate("main", "Error: could not remove module: %1")
+                .arg(moduleNameList.join(" ")));
     }
 
     return true;
@@ -327,24 +350,13 @@ bool QSocCliWorker::parseModuleList(const QStringList &appArguments)
             QCoreApplication::translate("main", "Error: invalid regular expression of library name: %1")
                 .arg(libraryName));
     }
-    /* Check if all module names in list is valid */
-    bool    invalidModuleNameFound = false;
-    QString invalidModuleName;
-    /* Iterate through all module names */
-    for (const QString &moduleName : moduleNameList) {
-        const QRegularExpression moduleNameRegex(moduleName);
-        if (!moduleNameRegex.isValid()) {
-            invalidModuleNameFound = true;
-            invalidModuleName      = moduleName;
-            break;
-        }
-    }
-    /* Show error if invalid module name is found */
-    if (invalidModuleNameFound) {
+    /* Check if all module names in list is valid, they are matched together */
+    const QSocNameMatcher moduleNameMatcher(moduleNameList);
+    if (!moduleNameMatcher.isValid()) {
         return showErrorWithHelp(
             1,
             QCoreApplication::translate("main", "Error: invalid regular expression of module name: %1")
-                .arg(invalidModuleName));
+                .arg(moduleNameMatcher.getInvalidPattern()));
     }
     /* Setup module manager */
     QSocBusManager    busManager(this, &projectManager);
@@ -357,11 +369,7 @@ bool QSocCliWorker::parseModuleList(const QStringList &appArguments)
                 .arg(libraryName));
     }
     /* list modules */
-    for (const QString &moduleName : moduleNameList) {
-        const QRegularExpression moduleNameRegex(moduleName);
-        const QStringList        result = moduleManager.listModule(moduleNameRegex);
-        showInfo(0, result.join("\n"));
-    }
+    showInfo(0, moduleManager.listModule(moduleNameMatcher).join("\n"));
 
     return true;
 }
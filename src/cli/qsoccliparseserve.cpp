@@ -0,0 +1,47 @@
+#include "cli/qsoccliworker.h"
+
+#include "cli/qsoccliserver.h"
+#include "common/qstaticyamlcache.h"
+
+bool QSocCliWorker::parseServe(const QStringList &appArguments)
+{
+    /* Clear upstream positional arguments and setup subcommand */
+    parser.clearPositionalArguments();
+    parser.addOptions({
+        {{"n", "name"},
+         QCoreApplication::translate(
+             "main",
+             "The local socket name or path to listen on, default is\n"
+             "$QSOC_SERVER or qsoc. Commands are forwarded to the server\n"
+             "when QSOC_SERVER is set to the same name."),
+         "name"},
+    });
+
+    parser.parse(appArguments);
+
+    if (parser.isSet("help")) {
+        return showHelp(0);
+    }
+
+    const QString serverName = parser.isSet("name")
+                                   ? parser.value("name")
+                                   : qEnvironmentVariable("QSOC_SERVER", "qsoc");
+
+    /* Start listening, the server lives as long as the worker */
+    auto *server = new QSocCliServer(this);
+    if (!server->listen(serverName)) {
+        return showError(
+            1,
+            QCoreApplication::translate("main", "Error: failed to listen on %1: %2")
+                .arg(serverName, server->errorString()));
+    }
+
+    /* Keep parsed project and library files resident between commands */
+    QStaticYamlCache::setEnabled(true);
+    serving = true;
+
+    return showInfo(
+        0,
+        QCoreApplication::translate("main", "Serving qsoc commands on %1")
+            .arg(server->fullServerName()));
+}
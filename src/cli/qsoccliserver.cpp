@@ -0,0 +1,270 @@
+#include "cli/qsoccliserver.h"
+
+#include "cli/qsoccliworker.h"
+#include "common/qsocresidentlibraries.h"
+#include "common/qstaticlog.h"
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDir>
+#include <QProcessEnvironment>
+
+namespace {
+/* Bumped whenever the request or reply layout changes */
+constexpr quint32 kProtocolVersion = 1;
+/* Time to wait for a server before running the command locally */
+constexpr int kConnectTimeout = 1000;
+/* Stream version shared by client and server */
+constexpr QDataStream::Version kStreamVersion = QDataStream::Qt_5_15;
+/* Root options that take a value, as QSocCliWorker::parseRoot declares them */
+const QStringList kRootValueOptions = {"--verbose", "--log-file", "--trace", "--stats-json"};
+/* Commands that must run in the process that was started */
+const QStringList kLocalCommands = {"gui", "batch", "serve"};
+/* Root options that act on the whole process, a session refuses them */
+const QStringList kProcessOptions = {"--log-file", "--trace", "--stats", "--stats-json"};
+} // namespace
+
+QList<QPair<int, QString>> *QSocCliServer::capturedMessages = nullptr;
+
+QSocCliServer::QSocCliServer(QObject *parent)
+    : QObject(parent)
+    , server(new QLocalServer(this))
+{
+    server->setSocketOptions(QLocalServer::UserAccessOption);
+    connect(server, &QLocalServer::newConnection, this, &QSocCliServer::acceptConnections);
+}
+
+bool QSocCliServer::listen(const QString &serverName)
+{
+    /* Never take the socket of a live server, its clients would be cut off */
+    QLocalSocket probe;
+    probe.connectToServer(serverName);
+    if (probe.waitForConnected(kConnectTimeout)) {
+        probe.disconnectFromServer();
+        errorMessage = QCoreApplication::translate("main", "server already running");
+        return false;
+    }
+
+    /* Nobody answers, a server that crashed left its socket file behind */
+    errorMessage.clear();
+    QLocalServer::removeServer(serverName);
+    return server->listen(serverName);
+}
+
+QString QSocCliServer::fullServerName() const
+{
+    return server->fullServerName();
+}
+
+QString QSocCliServer::errorString() const
+{
+    return errorMessage.isEmpty() ? server->errorString() : errorMessage;
+}
+
+bool QSocCliServer::forward(const QStringList &appArguments, int &exitCode)
+{
+    const QString serverName = qEnvironmentVariable("QSOC_SERVER");
+    if (serverName.isEmpty()) {
+        return false;
+    }
+    if (kLocalCommands.contains(subcommand(appArguments)) || hasProcessOption(appArguments)) {
+        return false;
+    }
+
+    QLocalSocket socket;
+    socket.connectToServer(serverName);
+    if (!socket.waitForConnected(kConnectTimeout)) {
+        return false;
+    }
+
+    /* Send the request */
+    QDataStream stream(&socket);
+    stream.setVersion(kStreamVersion);
+    stream << kProtocolVersion << QDir::currentPath() << appArguments << processEnvironment();
+    if (!socket.waitForBytesWritten(kConnectTimeout)) {
+        return false;
+    }
+
+    /* Wait for the complete reply, commands may take a while */
+    qint32                     replyExitCode = 0;
+    QList<QPair<int, QString>> messages;
+    while (true) {
+        stream.startTransaction();
+        stream >> replyExitCode >> messages;
+        if (stream.commitTransaction()) {
+            break;
+        }
+        if (!socket.waitForReadyRead(-1)) {
+            qCritical().noquote() << "Error: lost connection to qsoc server:" << serverName;
+            exitCode = 1;
+            return true;
+        }
+    }
+
+    /* Replay the messages as if the command ran here */
+    for (const QPair<int, QString> &message : messages) {
+        switch (message.first) {
+        case QtDebugMsg:
+            qDebug().noquote() << message.second;
+            break;
+        case QtInfoMsg:
+            qInfo().noquote() << message.second;
+            break;
+        case QtWarningMsg:
+            qWarning().noquote() << message.second;
+            break;
+        default:
+            qCritical().noquote() << message.second;
+            break;
+        }
+    }
+    exitCode = replyExitCode;
+    return true;
+}
+
+void QSocCliServer::acceptConnections()
+{
+    while (QLocalSocket *socket = server->nextPendingConnection()) {
+        connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() { readRequest(socket); });
+    }
+}
+
+void QSocCliServer::readRequest(QLocalSocket *socket)
+{
+    QDataStream stream(socket);
+    stream.setVersion(kStreamVersion);
+
+    /* Wait for more data until the request is complete */
+    quint32                version = 0;
+    QString                workingDirectory;
+    QStringList            appArguments;
+    QMap<QString, QString> environment;
+    stream.startTransaction();
+    stream >> version >> workingDirectory >> appArguments >> environment;
+    if (!stream.commitTransaction()) {
+        return;
+    }
+
+    QList<QPair<int, QString>> messages;
+    qint32                     exitCode = 1;
+    if (version != kProtocolVersion) {
+        messages.append(
+            {QtCriticalMsg,
+             QCoreApplication::translate("main", "Error: qsoc server protocol mismatch.")});
+    } else {
+        exitCode = execute(appArguments, workingDirectory, environment, messages);
+    }
+
+    /* Pending data is flushed before the socket closes */
+    stream << exitCode << messages;
+    socket->disconnectFromServer();
+}
+
+int QSocCliServer::execute(
+    const QStringList            &appArguments,
+    const QString                &workingDirectory,
+    const QMap<QString, QString> &environment,
+    QList<QPair<int, QString>>   &messages)
+{
+    /* Run in the context of the client */
+    const QString previousDirectory = QDir::currentPath();
+    if (!QDir::setCurrent(workingDirectory)) {
+        messages.append(
+            {QtCriticalMsg,
+             QCoreApplication::translate("main", "Error: invalid working directory: %1")
+                 .arg(workingDirectory)});
+        return 1;
+    }
+    const QMap<QString, QString> previousEnvironment = processEnvironment();
+    setProcessEnvironment(environment);
+    const QStaticLog::Level previousLevel = QStaticLog::getLevel();
+
+    /* A fresh worker per command, its parser keeps the options it was given, the
+       libraries its managers loaded stay resident for the next command */
+    capturedMessages               = &messages;
+    const QtMessageHandler handler = qInstallMessageHandler(captureMessage);
+    int                    exitCode;
+    {
+        QSocCliWorker worker;
+        exitCode = worker.execute(appArguments);
+    }
+    qInstallMessageHandler(handler);
+    capturedMessages = nullptr;
+
+    /* A failed command may leave loaded libraries changed but not saved */
+    if (exitCode != 0) {
+        QSocResidentLibraries::clear();
+    }
+
+    /* Restore the server context for the next command */
+    QStaticLog::setLevel(previousLevel);
+    setProcessEnvironment(previousEnvironment);
+    QDir::setCurrent(previousDirectory);
+
+    return exitCode;
+}
+
+void QSocCliServer::captureMessage(
+    QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    Q_UNUSED(context);
+    if (capturedMessages) {
+        capturedMessages->append({type, message});
+    }
+}
+
+QString QSocCliServer::subcommand(const QStringList &appArguments)
+{
+    /* The first argument that is neither an option nor an option value */
+    for (int index = 1; index < appArguments.size(); index++) {
+        const QString &argument = appArguments[index];
+        if (argument == "--") {
+            return appArguments.value(index + 1);
+        }
+        if (!argument.startsWith('-') || argument == "-") {
+            return argument;
+        }
+        if (kRootValueOptions.contains(argument)) {
+            index++;
+        }
+    }
+    return QString();
+}
+
+bool QSocCliServer::hasProcessOption(const QStringList &appArguments)
+{
+    /* Root options are parsed anywhere before "--", also as --option=value */
+    for (int index = 1; index < appArguments.size(); index++) {
+        const QString &argument = appArguments[index];
+        if (argument == "--") {
+            return false;
+        }
+        if (kProcessOptions.contains(argument.section('=', 0, 0))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QMap<QString, QString> QSocCliServer::processEnvironment()
+{
+    QMap<QString, QString>    result;
+    const QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    for (const QString &key : environment.keys()) {
+        result.insert(key, environment.value(key));
+    }
+    return result;
+}
+
+void QSocCliServer::setProcessEnvironment(const QMap<QString, QString> &environment)
+{
+    for (const QString &key : processEnvironment().keys()) {
+        if (!environment.contains(key)) {
+            qunsetenv(key.toLocal8Bit().constData());
+        }
+    }
+    for (auto iterator = environment.cbegin(); iterator != environment.cend(); ++iterator) {
+        qputenv(iterator.key().toLocal8Bit().constData(), iterator.value().toLocal8Bit());
+    }
+}
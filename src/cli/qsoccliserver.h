@@ -0,0 +1,150 @@
+#ifndef QSOCCLISERVER_H
+#define QSOCCLISERVER_H
+
+#include <QList>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief The QSocCliServer class.
+ * @details This class serves qsoc commands on a local socket, so scripts
+ *          that call qsoc many times do not pay for process startup and
+ *          library parsing on every call. Commands run one at a time in the
+ *          server process, each in a fresh QSocCliWorker with the working
+ *          directory and QSOC_* environment of the client. Parsed project,
+ *          module and bus files stay resident in QStaticYamlCache and are
+ *          reparsed only when they change on disk. The module and bus
+ *          libraries a command loaded are handed to the managers of the next
+ *          command by QSocResidentLibraries, so an unchanged library is not
+ *          even copied again; a failed command drops them. The client side
+ *          is forward(), used by the CLI whenever QSOC_SERVER is set.
+ */
+class QSocCliServer : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief Constructor.
+     * @param[in] parent parent object.
+     */
+    explicit QSocCliServer(QObject *parent = nullptr);
+
+    /**
+     * @brief Start listening for commands.
+     * @details Fails if a server already answers on the name, otherwise
+     *          removes the stale socket a crashed server may have left. Only
+     *          the current user may connect.
+     * @param serverName The local socket name or path.
+     * @retval true Server is listening.
+     * @retval false Failed to listen.
+     */
+    bool listen(const QString &serverName);
+
+    /**
+     * @brief Get the full socket path of the server.
+     * @return QString The socket path, empty if not listening.
+     */
+    QString fullServerName() const;
+
+    /**
+     * @brief Get the error message of the last failed operation.
+     * @return QString The error message.
+     */
+    QString errorString() const;
+
+    /**
+     * @brief Forward a command line to a running server.
+     * @details Does nothing unless QSOC_SERVER names a server. Subcommands
+     *          that must run locally (gui, batch and serve) are never
+     *          forwarded, neither are command lines with the process wide
+     *          options --log-file, --trace, --stats and --stats-json. The
+     *          working directory and the whole environment of this process
+     *          are sent along, the server runs the command with them, so
+     *          ${VAR} paths expand as they would here. The messages of the
+     *          command are replayed to the local message handler in their
+     *          original order and severity.
+     * @param appArguments The command line arguments, program name first.
+     * @param exitCode Set to the exit code of the command if forwarded.
+     * @retval true The command was executed by the server.
+     * @retval false No server is configured or reachable, run it locally.
+     */
+    static bool forward(const QStringList &appArguments, int &exitCode);
+
+private:
+    /** Local socket server. */
+    QLocalServer *server = nullptr;
+    /** Error of the last listen() that failed before reaching the server. */
+    QString errorMessage;
+    /** Messages of the command being executed, nullptr when idle. */
+    static QList<QPair<int, QString>> *capturedMessages;
+
+    /**
+     * @brief Accept pending client connections.
+     */
+    void acceptConnections();
+
+    /**
+     * @brief Read a request from a client and reply once it is complete.
+     * @param socket The client socket.
+     */
+    void readRequest(QLocalSocket *socket);
+
+    /**
+     * @brief Execute one command line in this process.
+     * @param appArguments The command line arguments, program name first.
+     * @param workingDirectory The working directory of the client.
+     * @param environment The environment of the client.
+     * @param messages Filled with the messages of the command.
+     * @return int The exit code of the command.
+     */
+    int execute(
+        const QStringList            &appArguments,
+        const QString                &workingDirectory,
+        const QMap<QString, QString> &environment,
+        QList<QPair<int, QString>>   &messages);
+
+    /**
+     * @brief Message handler that records messages of the running command.
+     * @param type The message type.
+     * @param context The message context.
+     * @param message The message.
+     */
+    static void captureMessage(
+        QtMsgType type, const QMessageLogContext &context, const QString &message);
+
+    /**
+     * @brief Get the subcommand of a command line.
+     * @details Skips the root options and their values.
+     * @param appArguments The command line arguments, program name first.
+     * @return QString The subcommand, empty if there is none.
+     */
+    static QString subcommand(const QStringList &appArguments);
+
+    /**
+     * @brief Check if a command line has a process wide root option.
+     * @details These options set up the log file, trace or metrics of the
+     *          process, a server cannot apply them to one command.
+     * @param appArguments The command line arguments, program name first.
+     * @retval true The command line has such an option.
+     * @retval false It has none.
+     */
+    static bool hasProcessOption(const QStringList &appArguments);
+
+    /**
+     * @brief Get the environment variables of this process.
+     * @return QMap<QString, QString> The variables by name.
+     */
+    static QMap<QString, QString> processEnvironment();
+
+    /**
+     * @brief Replace the environment variables of this process.
+     * @param environment The variables to set, others are unset.
+     */
+    static void setProcessEnvironment(const QMap<QString, QString> &environment);
+};
+
+#endif // QSOCCLISERVER_H
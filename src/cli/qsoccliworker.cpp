@@ -1,5 +1,6 @@
 #include "cli/qsoccliworker.h"
 
+#include "cli/qsoccliserver.h"
 #include "common/config.h"
 #include "common/qslangdriver.h"
 #include "common/qsocbusmanager.h"
@@ -7,6 +8,8 @@
 #include "common/qsocmodulemanager.h"
 #include "common/qsocprojectmanager.h"
 #include "common/qstaticlog.h"
+#include "common/qstaticmetrics.h"
+#include "common/qstatictrace.h"
 
 #include <QString>
 #include <QTimer>
@@ -54,8 +57,24 @@ void QSocCliWorker::setup(const QStringList &appArguments, bool isGui)
 
 void QSocCliWorker::run()
 {
+    /* Let a running server execute the command if one is configured */
+    if (QSocCliServer::forward(cmdArguments, exitCode)) {
+        emit exit(exitCode);
+        return;
+    }
     parseRoot(cmdArguments);
-    emit exit(exitCode);
+    /* A server keeps the application running until it is stopped */
+    if (!serving) {
+        emit exit(exitCode);
+    }
+}
+
+int QSocCliWorker::execute(const QStringList &appArguments)
+{
+    exitCode = 0;
+    embedded = true;
+    parseRoot(appArguments);
+    return exitCode;
 }
 
 bool QSocCliWorker::showVersion(int exitCode)
@@ -121,6 +140,20 @@ bool QSocCliWorker::parseRoot(const QStringList &appArguments)
              "Higher values increase output detail.\n"
              "0=silent, 1=error, 2=warning, 3=info, 4=debug, 5=verbose"),
          "level"},
+        {"log-file",
+         QCoreApplication::translate(
+             "main", "Also write log messages to a file, from a background thread."),
+         "path"},
+        {"trace",
+         QCoreApplication::translate(
+             "main", "Write a Chrome trace-event JSON file of the run."),
+         "file"},
+        {"stats",
+         QCoreApplication::translate(
+             "main", "Print a summary of runtime metrics when the run ends.")},
+        {"stats-json",
+         QCoreApplication::translate("main", "Write runtime metrics to a JSON file."),
+         "file"},
         {{"v", "version"}, QCoreApplication::translate("main", "Displays version information.")},
     });
     parser.addPositionalArgument(
@@ -132,7 +165,9 @@ bool QSocCliWorker::parseRoot(const QStringList &appArguments)
             "module      Import, update of module.\n"
             "bus         Import, update of bus.\n"
             "schematic   Processing of Schematic.\n"
-            "generate    Generate rtl, such as verilog, etc.\n"),
+            "generate    Generate rtl, such as verilog, etc.\n"
+            "batch       Run a script of commands in one process.\n"
+            "serve       Serve commands on a local socket.\n"),
         "<command> [command options]");
     parser.parse(appArguments);
     /* Set verbosity level as early as possible */
@@ -148,6 +183,31 @@ bool QSocCliWorker::parseRoot(const QStringList &appArguments)
         /* Set log level */
         QStaticLog::setLevel(static_cast<QStaticLog::Level>(level));
     }
+    /* The log file, trace and metrics are process wide, a session keeps what it started with */
+    if (embedded
+        && (parser.isSet("log-file") || parser.isSet("trace") || parser.isSet("stats")
+            || parser.isSet("stats-json"))) {
+        return showError(
+            1,
+            QCoreApplication::translate(
+                "main",
+                "Error: --log-file, --trace, --stats and --stats-json cannot be used inside a "
+                "qsoc session."));
+    }
+    if (parser.isSet("log-file") && !QStaticLog::setFile(parser.value("log-file"))) {
+        return showError(
+            1,
+            QCoreApplication::translate("main", "Error: failed to open log file: %1")
+                .arg(parser.value("log-file")));
+    }
+    /* The trace is written when the application exits */
+    if (parser.isSet("trace")) {
+        QStaticTrace::start(parser.value("trace"));
+    }
+    /* So are the metrics */
+    if (parser.isSet("stats") || parser.isSet("stats-json")) {
+        QStaticMetrics::start(parser.isSet("stats"), parser.value("stats-json"));
+    }
     /* version options have higher priority */
     if (parser.isSet("version")) {
         return showVersion(0);
@@ -159,8 +219,15 @@ bool QSocCliWorker::parseRoot(const QStringList &appArguments)
     /* Perform different operations according to different subcommands */
     const QString &command       = cmdArguments.first();
     QStringList    nextArguments = appArguments;
-    if (command == "gui") {
-        QStaticLog::logV(Q_FUNC_INFO, "Starting GUI ...");
+
+    const QStaticTrace::Span span("cli.command", command);
+    if (embedded && (command == "gui" || command == "batch" || command == "serve")) {
+        return showError(
+            1,
+            QCoreApplication::translate("main", "Error: %1 cannot run inside a qsoc session.")
+                .arg(command));
+    } else if (command == "gui") {
+        QSOC_LOG_V("Starting GUI ...");
     } else if (command == "project") {
         nextArguments.removeOne(command);
         if (!parseProject(nextArguments)) {
@@ -184,10 +251,23 @@ bool QSocCliWorker::parseRoot(const QStringList &appArguments)
         if (!parseGenerate(nextArguments)) {
             return false;
         }
+    } else if (command == "batch") {
+        nextArguments.removeOne(command);
+        if (!parseBatch(nextArguments)) {
+            return false;
+        }
+    } else if (command == "serve") {
+        nextArguments.removeOne(command);
+        if (!parseServe(nextArguments)) {
+            return false;
+        }
     } else {
         return showHelpOrError(
             1, QCoreApplication::translate("main", "Error: unknown subcommand: %1.").arg(command));
     }
-    parser.process(*QCoreApplication::instance());
+    /* Embedded commands have their own arguments, not the application ones */
+    if (!embedded) {
+        parser.process(*QCoreApplication::instance());
+    }
     return true;
 }
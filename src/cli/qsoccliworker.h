@@ -47,6 +47,17 @@ public:
      */
     void process();
 
+    /**
+     * @brief Execute a command line in the running process.
+     * @details Runs one command without touching the application event loop
+     *          or the application arguments, for commands served by
+     *          QSocCliServer. Use a fresh worker for every command, the parser
+     *          keeps the options of the previous command.
+     * @param appArguments command line arguments, program name first.
+     * @return int The exit code of the command.
+     */
+    int execute(const QStringList &appArguments);
+
 public slots:
     /**
      * @brief Run the command line parser.
@@ -64,6 +75,12 @@ private:
     /* ExitCode of the application. */
     int exitCode;
 
+    /* Command runs inside another qsoc session, not as the application. */
+    bool embedded = false;
+
+    /* Application keeps running to serve commands. */
+    bool serving = false;
+
     /**
      * @brief Parse the application command line arguments.
      * @details This function will parse the application command line arguments.
@@ -294,6 +311,27 @@ private:
      */
     bool parseGenerateVerilog(const QStringList &appArguments);
 
+    /**
+     * @brief Parse the batch command line arguments.
+     * @details This function will parse the batch command line arguments and
+     *          execute the commands of a script file or of standard input in
+     *          this process. Library writes are deferred until the end.
+     * @param appArguments command line arguments.
+     * @retval true Parse successfully.
+     * @retval false Parse failed.
+     */
+    bool parseBatch(const QStringList &appArguments);
+
+    /**
+     * @brief Parse the serve command line arguments.
+     * @details This function will parse the serve command line arguments and
+     *          start serving commands on a local socket.
+     * @param appArguments command line arguments.
+     * @retval true Parse successfully.
+     * @retval false Parse failed.
+     */
+    bool parseServe(const QStringList &appArguments);
+
     /**
      * @brief Show application name and version and emit exit with exitCode.
      * @details This function will show application name and version and emit
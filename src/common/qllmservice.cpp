@@ -1,8 +1,11 @@
 #include "common/qllmservice.h"
 
+#include "common/qstaticmetrics.h"
+
 #include <fstream>
 #include <QDebug>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QEventLoop>
 #include <QFile>
 #include <QFileInfo>
@@ -15,6 +18,14 @@
 
 #include <yaml-cpp/yaml.h>
 
+namespace {
+/* Round trip of each request, failed ones included */
+QStaticMetrics::Histogram requestLatency("llm.request.ms");
+
+/* Requests that returned no usable response */
+QStaticMetrics::Counter requestFailures("llm.request.failures");
+} // namespace
+
 /* Constructor and Destructor */
 
 QLLMService::QLLMService(QObject *parent, QSocConfig *config)
@@ -141,15 +152,21 @@ LLMResponse QLLMService::sendRequest(
     QJsonDocument payload = buildRequestPayload(prompt, systemPrompt, temperature, jsonMode);
 
     /* Send request and wait for response */
-    QEventLoop     loop;
+    QElapsedTimer timer;
+    QEventLoop    loop;
+    timer.start();
     QNetworkReply *reply = networkManager->post(request, payload.toJson());
 
     QObject::connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
     loop.exec();
+    requestLatency.record(timer.elapsed());
 
     /* Parse response */
     LLMResponse response = parseResponse(reply);
     reply->deleteLater();
+    if (!response.success) {
+        requestFailures.add();
+    }
 
     return response;
 }
@@ -178,12 +195,18 @@ void QLLMService::sendRequestAsync(
     QJsonDocument payload = buildRequestPayload(prompt, systemPrompt, temperature, jsonMode);
 
     /* Send asynchronous request */
+    QElapsedTimer timer;
+    timer.start();
     QNetworkReply *reply = networkManager->post(request, payload.toJson());
 
     /* Connect finished signal to handler function */
-    QObject::connect(reply, &QNetworkReply::finished, [this, reply, callback]() {
+    QObject::connect(reply, &QNetworkReply::finished, [this, reply, callback, timer]() {
+        requestLatency.record(timer.elapsed());
         LLMResponse response = parseResponse(reply);
         reply->deleteLater();
+        if (!response.success) {
+            requestFailures.add();
+        }
         callback(response);
     });
 }
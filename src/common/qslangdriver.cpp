@@ -1,29 +1,201 @@
 #include "common/qslangdriver.h"
 
 #include "common/qstaticlog.h"
+#include "common/qstaticmetrics.h"
+#include "common/qstaticregex.h"
+#include "common/qstatictrace.h"
 
+#include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
-#include <QProcess>
-#include <QRegularExpression>
-#include <QTemporaryFile>
-#include <QTextStream>
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <functional>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 
 #include <fmt/core.h>
 #include <slang/ast/ASTSerializer.h>
 #include <slang/ast/Compilation.h>
 #include <slang/ast/symbols/CompilationUnitSymbols.h>
+#include <slang/ast/symbols/InstanceSymbols.h>
+#include <slang/diagnostics/DiagnosticClient.h>
+#include <slang/diagnostics/DiagnosticEngine.h>
+#include <slang/diagnostics/Diagnostics.h>
 #include <slang/diagnostics/TextDiagnosticClient.h>
 #include <slang/driver/Driver.h>
+#include <slang/syntax/AllSyntax.h>
+#include <slang/syntax/SyntaxPrinter.h>
 #include <slang/syntax/SyntaxTree.h>
 #include <slang/text/Json.h>
+#include <slang/text/SourceManager.h>
+#include <slang/util/Bag.h>
 #include <slang/util/String.h>
 #include <slang/util/TimeTrace.h>
 #include <slang/util/VersionInfo.h>
 
+namespace {
+/* Source files parsed */
+QStaticMetrics::Counter sourceFilesParsed("slang.files.parsed");
+
+/* Parse time of each independent file */
+QStaticMetrics::Histogram sourceFileParseTime("slang.parseFile.ms");
+
+/* Options of every file list parse, sources come from the file list */
+const QStringList kFileListOptions
+    = {"--ignore-unknown-modules",
+       "--compat",
+       "vcs",
+       "--error-limit=0",
+       "-Wunknown-sys-name",
+       "--ignore-directive",
+       "delay_mode_path",
+       "--ignore-directive",
+       "suppress_faults",
+       "--ignore-directive",
+       "enable_portfaults",
+       "--ignore-directive",
+       "disable_portfaults",
+       "--ignore-directive",
+       "nosuppress_faults",
+       "--ignore-directive",
+       "delay_mode_distributed",
+       "--ignore-directive",
+       "delay_mode_unit"};
+
+/* Collects the diagnostics of one driver as records and logs them */
+class DiagnosticCollector : public slang::DiagnosticClient
+{
+public:
+    explicit DiagnosticCollector(QList<QSlangDriver::Diagnostic> &diagnostics)
+        : diagnostics(diagnostics)
+    {}
+
+    void report(const slang::ReportedDiagnostic &reported) override
+    {
+        QSlangDriver::Diagnostic diagnostic;
+        switch (reported.severity) {
+        case slang::DiagnosticSeverity::Ignored:
+            return;
+        case slang::DiagnosticSeverity::Note:
+            diagnostic.severity = "note";
+            break;
+        case slang::DiagnosticSeverity::Warning:
+            diagnostic.severity = "warning";
+            break;
+        case slang::DiagnosticSeverity::Error:
+            diagnostic.severity = "error";
+            break;
+        default:
+            diagnostic.severity = "fatal";
+            break;
+        }
+        const slang::DiagCode code = reported.originalDiagnostic.code;
+
+        diagnostic.code    = QString::fromStdString(std::string(slang::toString(code)));
+        diagnostic.option  = QString::fromStdString(std::string(engine->getOptionName(code)));
+        diagnostic.message = QString::fromStdString(std::string(reported.formattedMessage));
+        if (reported.location != slang::SourceLocation::NoLocation && sourceManager) {
+            const slang::SourceLocation location = sourceManager->getFullyOriginalLoc(
+                reported.location);
+            diagnostic.file = QString::fromStdString(
+                std::string(sourceManager->getFileName(location)));
+            diagnostic.line   = static_cast<int>(sourceManager->getLineNumber(location));
+            diagnostic.column = static_cast<int>(sourceManager->getColumnNumber(location));
+        }
+        diagnostics.append(diagnostic);
+
+        /* Notes are info, the text is built only if the level is logged */
+        QStaticLog::Level level = QStaticLog::Level::Error;
+        if (reported.severity == slang::DiagnosticSeverity::Note) {
+            level = QStaticLog::Level::Info;
+        } else if (reported.severity == slang::DiagnosticSeverity::Warning) {
+            level = QStaticLog::Level::Warning;
+        }
+        QSOC_LOG(
+            level,
+            QString("%1:%2:%3: %4: %5 [%6]")
+                .arg(diagnostic.file)
+                .arg(diagnostic.line)
+                .arg(diagnostic.column)
+                .arg(diagnostic.severity, diagnostic.message, diagnostic.code));
+    }
+
+private:
+    QList<QSlangDriver::Diagnostic> &diagnostics;
+};
+
+/* slang prints to process wide buffers, one driver at a time may capture them */
+std::mutex outputMutex;
+
+/* Run a slang step that may print, what it printed is logged if it fails */
+bool runCaptured(const std::function<bool()> &step)
+{
+    const std::lock_guard<std::mutex> lock(outputMutex);
+    slang::OS::setStderrColorsEnabled(false);
+    slang::OS::setStdoutColorsEnabled(false);
+    auto guard = slang::OS::captureOutput();
+    slang::OS::capturedStdout.clear();
+    slang::OS::capturedStderr.clear();
+
+    const bool result = step();
+    if (!result && !slang::OS::capturedStdout.empty()) {
+        QSOC_LOG_E(slang::OS::capturedStdout.c_str());
+    }
+    if (!result && !slang::OS::capturedStderr.empty()) {
+        QSOC_LOG_E(slang::OS::capturedStderr.c_str());
+    }
+    slang::OS::capturedStdout.clear();
+    slang::OS::capturedStderr.clear();
+    return result;
+}
+
+/* Log the macros defined by the sources sorted by name, as slang reportMacros() prints them */
+void logMacros(const slang::driver::Driver &driver)
+{
+    if (!QStaticLog::isEnabled(QStaticLog::Level::Info)) {
+        return;
+    }
+    std::vector<const slang::syntax::DefineDirectiveSyntax *> macros;
+    for (const auto &tree : driver.syntaxTrees) {
+        for (const auto *macro : tree->getDefinedMacros()) {
+            macros.push_back(macro);
+        }
+    }
+    std::stable_sort(macros.begin(), macros.end(), [](const auto *left, const auto *right) {
+        return left->name.valueText() < right->name.valueText();
+    });
+
+    std::string text;
+    for (const auto *macro : macros) {
+        slang::syntax::SyntaxPrinter printer;
+        printer.setIncludeComments(false);
+        printer.setIncludeTrivia(false);
+        printer.print(macro->name);
+        printer.setIncludeTrivia(true);
+        if (macro->formalArguments) {
+            printer.print(*macro->formalArguments);
+        }
+        if (!macro->body.empty() && macro->body[0].trivia().empty()) {
+            printer.append(" ");
+        }
+        printer.print(macro->body);
+        text += printer.str() + "\n";
+    }
+    if (!text.empty()) {
+        QSOC_LOG_I(text.c_str());
+    }
+}
+} // namespace
+
 QSlangDriver::QSlangDriver(QObject *parent, QSocProjectManager *projectManager)
     : QObject(parent)
 {
@@ -37,205 +209,493 @@ QSlangDriver::~QSlangDriver() {}
 
 bool QSlangDriver::parseArgs(const QString &args)
 {
-    slang::OS::setStderrColorsEnabled(false);
-    slang::OS::setStdoutColorsEnabled(false);
+    QSOC_LOG_V("Arguments:" + args);
+    const std::string commandLine = args.toStdString();
+    return parseDriver([&commandLine](slang::driver::Driver &driver) {
+        return driver.parseCommandLine(std::string_view(commandLine));
+    });
+}
 
-    auto guard = slang::OS::captureOutput();
+bool QSlangDriver::parseArgs(const QStringList &arguments)
+{
+    return parseArgumentList(arguments, {});
+}
+
+void QSlangDriver::setParseJobs(int jobs)
+{
+    parseJobs = jobs;
+}
+
+bool QSlangDriver::parseArgumentList(const QStringList &arguments, const QStringList &sourceFiles)
+{
+    QSOC_LOG_V("Arguments:" + arguments.join(" "));
+    /* Arguments are handed over as they are, nothing is tokenized again */
+    std::vector<std::string> argumentStrings;
+    argumentStrings.reserve(arguments.size() + 1);
+    argumentStrings.emplace_back("slang");
+    for (const QString &argument : arguments) {
+        argumentStrings.push_back(argument.toStdString());
+    }
+    std::vector<const char *> argv;
+    argv.reserve(argumentStrings.size());
+    for (const std::string &argument : argumentStrings) {
+        argv.push_back(argument.c_str());
+    }
+    return parseDriver(
+        [&argv](slang::driver::Driver &driver) {
+            return driver.parseCommandLine(static_cast<int>(argv.size()), argv.data());
+        },
+        sourceFiles);
+}
+
+bool QSlangDriver::parseDriver(
+    const std::function<bool(slang::driver::Driver &)> &parseCommandLine,
+    const QStringList                                  &sourceFiles)
+{
+    const QStaticTrace::Span span("slang.driver");
 
     slang::driver::Driver driver;
     driver.addStandardArgs();
+    diagnostics.clear();
 
     bool result = false;
     try {
-        QStaticLog::logV(Q_FUNC_INFO, "Arguments:" + args);
-        slang::OS::capturedStdout.clear();
-        slang::OS::capturedStderr.clear();
-        if (!driver.parseCommandLine(std::string_view(args.toStdString()))) {
-            if (!slang::OS::capturedStdout.empty()) {
-                QStaticLog::logE(Q_FUNC_INFO, slang::OS::capturedStdout.c_str());
-            }
-            if (!slang::OS::capturedStderr.empty()) {
-                QStaticLog::logE(Q_FUNC_INFO, slang::OS::capturedStderr.c_str());
-            }
+        if (!runCaptured([&]() { return parseCommandLine(driver); })) {
             throw std::runtime_error("Failed to parse command line");
         }
-        slang::OS::capturedStdout.clear();
-        slang::OS::capturedStderr.clear();
-        if (!driver.processOptions()) {
-            if (!slang::OS::capturedStdout.empty()) {
-                QStaticLog::logE(Q_FUNC_INFO, slang::OS::capturedStdout.c_str());
-            }
-            if (!slang::OS::capturedStderr.empty()) {
-                QStaticLog::logE(Q_FUNC_INFO, slang::OS::capturedStderr.c_str());
-            }
+        if (!runCaptured([&]() { return driver.processOptions(); })) {
             throw std::runtime_error("Failed to process options");
         }
-        slang::OS::capturedStdout.clear();
-        slang::OS::capturedStderr.clear();
-        if (!driver.parseAllSources()) {
-            if (!slang::OS::capturedStdout.empty()) {
-                QStaticLog::logE(Q_FUNC_INFO, slang::OS::capturedStdout.c_str());
-            }
-            if (!slang::OS::capturedStderr.empty()) {
-                QStaticLog::logE(Q_FUNC_INFO, slang::OS::capturedStderr.c_str());
-            }
+        driver.diagEngine.clearClients();
+        driver.diagEngine.addClient(std::make_shared<DiagnosticCollector>(diagnostics));
+
+        bool parsed = false;
+        {
+            /* Only the slang source loader prints, parseSources() needs no capture */
+            const QStaticTrace::Span parseSpan("slang.parse");
+            parsed = sourceFiles.isEmpty()
+                         ? runCaptured([&]() { return driver.parseAllSources(); })
+                         : parseSources(driver, sourceFiles);
+        }
+        if (!parsed) {
             throw std::runtime_error("Failed to parse sources");
         }
-        slang::OS::capturedStdout.clear();
-        slang::OS::capturedStderr.clear();
-        driver.reportMacros();
-        QStaticLog::logI(Q_FUNC_INFO, slang::OS::capturedStdout.c_str());
-        slang::OS::capturedStdout.clear();
-        slang::OS::capturedStderr.clear();
+        logMacros(driver);
         if (!driver.reportParseDiags()) {
-            if (!slang::OS::capturedStdout.empty()) {
-                QStaticLog::logE(Q_FUNC_INFO, slang::OS::capturedStdout.c_str());
-            }
-            if (!slang::OS::capturedStderr.empty()) {
-                QStaticLog::logE(Q_FUNC_INFO, slang::OS::capturedStderr.c_str());
-            }
             throw std::runtime_error("Failed to report parse diagnostics");
         }
-        slang::OS::capturedStdout.clear();
-        slang::OS::capturedStderr.clear();
+        /* Elaborate only the modules the caller asked for */
+        const std::vector<std::string> topModules = matchTopModules(driver);
+        if (!topModules.empty()) {
+            driver.options.topModules = topModules;
+        }
         auto compilation = driver.createCompilation();
-        if (!driver.reportCompilation(*compilation, false)) {
-            if (!slang::OS::capturedStdout.empty()) {
-                QStaticLog::logE(Q_FUNC_INFO, slang::OS::capturedStdout.c_str());
-            }
-            if (!slang::OS::capturedStderr.empty()) {
-                QStaticLog::logE(Q_FUNC_INFO, slang::OS::capturedStderr.c_str());
+        {
+            const QStaticTrace::Span elaborateSpan("slang.elaborate");
+            if (!driver.reportCompilation(*compilation, true)) {
+                throw std::runtime_error("Failed to report compilation");
             }
-            throw std::runtime_error("Failed to report compilation");
         }
         result = true;
-        QStaticLog::logI(Q_FUNC_INFO, slang::OS::capturedStdout.c_str());
 
-        slang::JsonWriter              writer;
-        const std::vector<std::string> astJsonScopes;
-        slang::ast::ASTSerializer      serializer(*compilation, writer);
+        slang::JsonWriter         writer;
+        slang::ast::ASTSerializer serializer(*compilation, writer);
 
-        if (astJsonScopes.empty()) {
+        if (topModules.empty()) {
+            const QStaticTrace::Span serializeSpan("slang.serialize");
             serializer.serialize(compilation->getRoot());
         } else {
-            for (const auto &scopeName : astJsonScopes) {
-                const auto *sym = compilation->getRoot().lookupName(scopeName);
-                if (sym)
-                    serializer.serialize(*sym);
+            /* Same layout as the root, with the requested instances only */
+            const QStaticTrace::Span serializeSpan("slang.serialize");
+            writer.startObject();
+            writer.writeProperty("members");
+            writer.startArray();
+            for (const slang::ast::InstanceSymbol *instance : compilation->getRoot().topInstances) {
+                serializer.serialize(*instance);
             }
+            writer.endArray();
+            writer.endObject();
         }
 
-        ast = json::parse(std::string(writer.view()).c_str());
-        QStaticLog::logV(Q_FUNC_INFO, ast.dump(4).c_str());
+        /* The AST lives in an arena that is dropped as a whole on the next parse */
+        ast = nullptr;
+        moduleAsts.clear();
+        astArena.clear();
+        {
+            const QStaticTrace::Span   jsonSpan("slang.jsonParse");
+            const QSocJsonArena::Scope scope(astArena);
+            const std::string_view     view = writer.view();
+            ast                             = AstJson::parse(view.begin(), view.end());
+        }
+        /* Dump member by member, the whole pretty printed AST is never built */
+        if (QStaticLog::isEnabled(QStaticLog::Level::Verbose) && ast.contains("members")) {
+            for (const AstJson &member : ast.at("members")) {
+                const QSocJsonArenaString text = member.dump(4);
+                QSOC_LOG_V(QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size())));
+            }
+        }
     } catch (const std::exception &e) {
         /* Handle error */
-        QStaticLog::logE(Q_FUNC_INFO, e.what());
+        QSOC_LOG_E(e.what());
     }
     return result;
 }
 
 bool QSlangDriver::parseFileList(const QString &fileListPath, const QStringList &filePathList)
 {
-    bool    result  = false;
-    QString content = "";
+    bool result = false;
     if (!QFileInfo::exists(fileListPath) && filePathList.isEmpty()) {
-        QStaticLog::logE(
-            Q_FUNC_INFO,
+        QSOC_LOG_E(
             "File path parameter is empty, also the file list path not exist:" + fileListPath);
     } else {
+        /* Only the variables referenced by the file list are looked up */
+        QSocFileList fileList(projectManager ? projectManager->getEnv() : QMap<QString, QString>());
         /* Process read file list path */
         if (QFileInfo::exists(fileListPath)) {
-            QStaticLog::logD(Q_FUNC_INFO, "Use file list path:" + fileListPath);
-            /* Read text from filelist */
-            QFile inputFile(fileListPath);
-            if (inputFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-                QTextStream inputStream(&inputFile);
-                content = inputStream.readAll();
-            } else {
-                QStaticLog::logE(Q_FUNC_INFO, "Failed to open file list:" + fileListPath);
-            }
+            QSOC_LOG_D("Use file list path:" + fileListPath);
+            fileList.addFileList(fileListPath);
         }
-        /* Process append of file path list */
+        /* Process append of file path list, relative to the working directory */
         if (!filePathList.isEmpty()) {
-            QStaticLog::logD(Q_FUNC_INFO, "Use file path list:" + filePathList.join(","));
-            /* Append file path list to the end of content */
-            content.append("\n" + filePathList.join("\n"));
-        }
-        /* Removes comments from the content */
-        content = contentCleanComment(content);
-        /* Substitute environment variables */
-        if (projectManager) {
-            const QMap<QString, QString>   env = projectManager->getEnv();
-            QMapIterator<QString, QString> iterator(env);
-            while (iterator.hasNext()) {
-                iterator.next();
-                /* Create pattern */
-                const QString pattern = QString("${%1}").arg(iterator.key());
-                /* Replace environment variable */
-                content = content.replace(pattern, iterator.value());
+            QSOC_LOG_D("Use file path list:" + filePathList.join(","));
+            fileList.addText(filePathList.join("\n"), QDir::current());
+        }
+        /* Drop files that do not exist */
+        fileList.resolve();
+        result = parseFileList(fileList);
+    }
+
+    return result;
+}
+
+bool QSlangDriver::parseFileList(const QSocFileList &fileList)
+{
+    if (fileList.getSourceFiles().isEmpty() && fileList.getLibraryFiles().isEmpty()) {
+        QSOC_LOG_E("No source file found in file list");
+        return false;
+    }
+
+    /* Library lookup needs the slang source loader, keep a single unit then */
+    if (parseJobs == 1 || !fileList.getLibraryDirs().isEmpty()
+        || !fileList.getLibraryFiles().isEmpty()) {
+        return parseArgs(kFileListOptions + QStringList{"--single-unit"} + fileList.toArguments());
+    }
+    return parseArgumentList(
+        kFileListOptions + fileList.toArguments(false), fileList.getSourceFiles());
+}
+
+bool QSlangDriver::parseSources(slang::driver::Driver &driver, const QStringList &sourceFiles)
+{
+    QElapsedTimer totalTimer;
+    totalTimer.start();
+
+    /* Read the sources, files that touch macro state are parsed together */
+    std::vector<SourceFile> files(static_cast<size_t>(sourceFiles.size()));
+    size_t                  timescaleCount = 0;
+    for (size_t index = 0; index < files.size(); index++) {
+        SourceFile &file = files[index];
+        file.path        = sourceFiles.at(static_cast<qsizetype>(index));
+        QFile inputFile(file.path);
+        if (!inputFile.open(QIODevice::ReadOnly)) {
+            QSOC_LOG_E("Failed to open source file:" + file.path);
+            return false;
+        }
+        const QByteArray content = inputFile.readAll();
+        file.text.assign(content.constData(), static_cast<size_t>(content.size()));
+        bool timescale = false;
+        file.shared    = isMacroStateShared(file.text, timescale);
+        if (timescale) {
+            timescaleCount++;
+        }
+    }
+
+    /* A `timescale carries into later files that have none, keep one unit then */
+    if (timescaleCount > 0 && timescaleCount < files.size()) {
+        for (SourceFile &file : files) {
+            file.shared = true;
+        }
+    }
+    const size_t independentCount = static_cast<size_t>(
+        std::count_if(files.begin(), files.end(), [](const SourceFile &file) {
+            return !file.shared;
+        }));
+
+    /* Buffers are assigned in file list order, the trees refer to them */
+    const slang::Bag                 options       = driver.createOptionBag();
+    slang::SourceManager            &sourceManager = driver.sourceManager;
+    std::vector<slang::SourceBuffer> buffers;
+    buffers.reserve(files.size());
+    for (const SourceFile &file : files) {
+        buffers.push_back(sourceManager.assignText(file.path.toStdString(), file.text));
+    }
+
+    /* Independent files get a syntax tree each, the source manager is thread safe */
+    std::atomic<size_t> nextIndex{0};
+    const auto          parseIndependent = [&]() {
+        for (size_t index = nextIndex++; index < files.size(); index = nextIndex++) {
+            SourceFile &file = files[index];
+            if (file.shared) {
+                continue;
             }
+            const QStaticTrace::Span fileSpan("slang.parseFile", file.path);
+            QElapsedTimer            timer;
+            timer.start();
+            file.tree = slang::syntax::SyntaxTree::fromBuffer(
+                buffers[index], sourceManager, options);
+            file.elapsed = timer.elapsed();
+            sourceFileParseTime.record(file.elapsed);
         }
-        /* Convert relative path to absolute path */
-        if (QFileInfo::exists(fileListPath)) {
-            content = contentValidFile(content, QFileInfo(fileListPath).absoluteDir());
-        }
-        /* Create a temporary file */
-        QTemporaryFile tempFile("qsoc.fl");
-        /* Do not remove file after close */
-        tempFile.setAutoRemove(false);
-        if (tempFile.open()) {
-            /* Write new content to temporary file */
-            QTextStream outputStream(&tempFile);
-            outputStream << content;
-            tempFile.flush();
-            tempFile.close();
-
-            const QString args
-                = "slang -f \"" + tempFile.fileName()
-                  + "\" --ignore-unknown-modules --single-unit --compat vcs --error-limit=0"
-                  + " -Wunknown-sys-name" + " --ignore-directive delay_mode_path"
-                  + " --ignore-directive suppress_faults" + " --ignore-directive enable_portfaults"
-                  + " --ignore-directive disable_portfaults"
-                  + " --ignore-directive nosuppress_faults"
-                  + " --ignore-directive delay_mode_distributed"
-                  + " --ignore-directive delay_mode_unit";
-
-            QStaticLog::logV(Q_FUNC_INFO, "TemporaryFile name:" + tempFile.fileName());
-            QStaticLog::logV(Q_FUNC_INFO, "Content list begin");
-            QStaticLog::logV(Q_FUNC_INFO, content.toStdString().c_str());
-            QStaticLog::logV(Q_FUNC_INFO, "Content list end");
-            result = parseArgs(args);
-            /* Delete temporary file */
-            tempFile.remove();
+    };
+    const size_t hardwareThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    const size_t threadCount     = std::min(
+        parseJobs > 0 ? static_cast<size_t>(parseJobs) : hardwareThreads,
+        std::max<size_t>(1, independentCount));
+    std::vector<std::thread> threads;
+    for (size_t index = 1; index < threadCount; index++) {
+        threads.emplace_back(parseIndependent);
+    }
+    parseIndependent();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    /* Files sharing macro state keep one compilation unit in file list order */
+    std::vector<slang::SourceBuffer> sharedBuffers;
+    for (size_t index = 0; index < files.size(); index++) {
+        if (files[index].shared) {
+            sharedBuffers.push_back(buffers[index]);
+        }
+    }
+    qint64                                     sharedElapsed = 0;
+    std::shared_ptr<slang::syntax::SyntaxTree> sharedTree;
+    if (!sharedBuffers.empty()) {
+        const QStaticTrace::Span sharedSpan("slang.parseShared");
+        QElapsedTimer            timer;
+        timer.start();
+        sharedTree = slang::syntax::SyntaxTree::fromBuffers(sharedBuffers, sourceManager, options);
+        sharedElapsed = timer.elapsed();
+    }
+
+    /* Declarations at $unit scope are only visible in their own unit, parse all as one then */
+    bool unitScope = false;
+    if (independentCount + (sharedTree ? 1 : 0) > 1) {
+        unitScope = sharedTree && hasUnitScopeItems(*sharedTree);
+        for (const SourceFile &file : files) {
+            if (!unitScope && file.tree) {
+                unitScope = hasUnitScopeItems(*file.tree);
+            }
         }
     }
+    if (unitScope) {
+        const QStaticTrace::Span sharedSpan("slang.parseShared");
+        QElapsedTimer            timer;
+        timer.start();
+        driver.syntaxTrees.push_back(
+            slang::syntax::SyntaxTree::fromBuffers(buffers, sourceManager, options));
+        sharedElapsed = timer.elapsed();
+        QSOC_LOG_I("Source files declare items at $unit scope, parsed as a single unit");
+    } else {
+        /* Trees in file list order, the shared unit at the place of its first file */
+        for (SourceFile &file : files) {
+            if (file.tree) {
+                driver.syntaxTrees.push_back(std::move(file.tree));
+            } else if (sharedTree) {
+                driver.syntaxTrees.push_back(std::move(sharedTree));
+            }
+        }
+    }
+
+    sourceFilesParsed.add(static_cast<qint64>(files.size()));
+
+    /* Report the parse time breakdown, slowest files first */
+    QSOC_LOG_I(QString("Parsed %1 files in %2 ms: %3 independent on %4 threads, %5 in a shared "
+                       "unit in %6 ms")
+                   .arg(files.size())
+                   .arg(totalTimer.elapsed())
+                   .arg(unitScope ? 0 : independentCount)
+                   .arg(threadCount)
+                   .arg(unitScope ? files.size() : sharedBuffers.size())
+                   .arg(sharedElapsed));
+    if (!QStaticLog::isEnabled(QStaticLog::Level::Debug)) {
+        return true;
+    }
+    std::stable_sort(
+        files.begin(), files.end(), [](const SourceFile &left, const SourceFile &right) {
+            return left.elapsed > right.elapsed;
+        });
+    for (const SourceFile &file : files) {
+        if (!file.shared) {
+            QSOC_LOG_D("Parsed file", {{"ms", file.elapsed}, {"path", file.path}});
+        }
+    }
+    return true;
+}
 
+void QSlangDriver::setModuleFilter(const QRegularExpression &moduleNameRegex)
+{
+    moduleFilter = moduleNameRegex;
+}
+
+std::vector<std::string> QSlangDriver::matchTopModules(const slang::driver::Driver &driver) const
+{
+    std::vector<std::string> result;
+    if (moduleFilter.pattern().isEmpty()) {
+        return result;
+    }
+
+    /* Module names come from the syntax trees, nothing is elaborated yet */
+    size_t moduleCount = 0;
+    for (const auto &tree : driver.syntaxTrees) {
+        const slang::syntax::SyntaxNode &root = tree->root();
+        if (root.kind != slang::syntax::SyntaxKind::CompilationUnit) {
+            continue;
+        }
+        for (const auto *member : root.as<slang::syntax::CompilationUnitSyntax>().members) {
+            if (member->kind != slang::syntax::SyntaxKind::ModuleDeclaration) {
+                continue;
+            }
+            const std::string_view name
+                = member->as<slang::syntax::ModuleDeclarationSyntax>().header->name.valueText();
+            moduleCount++;
+            if (QStaticRegex::isNameExactMatch(
+                    QString::fromStdString(std::string(name)), moduleFilter)) {
+                result.emplace_back(name);
+            }
+        }
+    }
+
+    /* A filter that keeps every module keeps the automatic top selection */
+    if (result.size() == moduleCount) {
+        result.clear();
+    }
     return result;
 }
 
-const json &QSlangDriver::getAst()
+bool QSlangDriver::isMacroStateShared(const std::string &text, bool &timescale)
+{
+    /* Directives that neither read nor write macros or state of later files */
+    static const std::unordered_set<std::string_view> localDirectives
+        = {"resetall",
+           "celldefine",
+           "endcelldefine",
+           "pragma",
+           "line",
+           "begin_keywords",
+           "end_keywords",
+           "__FILE__",
+           "__LINE__",
+           "protect",
+           "endprotect",
+           "delay_mode_path",
+           "delay_mode_distributed",
+           "delay_mode_unit",
+           "suppress_faults",
+           "nosuppress_faults",
+           "enable_portfaults",
+           "disable_portfaults"};
+
+    /* Backticks in comments and strings are counted too, which is safe */
+    bool shared = false;
+    for (size_t position = text.find('`'); position != std::string::npos && !(shared && timescale);
+         position        = text.find('`', position + 1)) {
+        size_t end = position + 1;
+        while (end < text.size()
+               && (std::isalnum(static_cast<unsigned char>(text[end])) || text[end] == '_')) {
+            end++;
+        }
+        const std::string_view name(text.data() + position + 1, end - position - 1);
+        if (name == "timescale") {
+            timescale = true;
+        } else if (!name.empty() && localDirectives.find(name) == localDirectives.end()) {
+            shared = true;
+        }
+    }
+    return shared;
+}
+
+bool QSlangDriver::hasUnitScopeItems(const slang::syntax::SyntaxTree &tree)
+{
+    const slang::syntax::SyntaxNode &root = tree.root();
+    if (root.kind != slang::syntax::SyntaxKind::CompilationUnit) {
+        return false;
+    }
+    /* Design units are global, anything else is declared in the compilation unit */
+    for (const auto *member : root.as<slang::syntax::CompilationUnitSyntax>().members) {
+        switch (member->kind) {
+        case slang::syntax::SyntaxKind::ModuleDeclaration:
+        case slang::syntax::SyntaxKind::InterfaceDeclaration:
+        case slang::syntax::SyntaxKind::ProgramDeclaration:
+        case slang::syntax::SyntaxKind::PackageDeclaration:
+        case slang::syntax::SyntaxKind::UdpDeclaration:
+        case slang::syntax::SyntaxKind::ConfigDeclaration:
+        case slang::syntax::SyntaxKind::EmptyMember:
+            break;
+        default:
+            return true;
+        }
+    }
+    return false;
+}
+
+const QList<QSlangDriver::Diagnostic> &QSlangDriver::getDiagnostics() const
+{
+    return diagnostics;
+}
+
+json QSlangDriver::diagnosticsToJson(const QList<Diagnostic> &diagnostics)
+{
+    json records  = json::array();
+    int  errors   = 0;
+    int  warnings = 0;
+    for (const Diagnostic &diagnostic : diagnostics) {
+        records.push_back(
+            {{"file", diagnostic.file.toStdString()},
+             {"line", diagnostic.line},
+             {"column", diagnostic.column},
+             {"severity", diagnostic.severity.toStdString()},
+             {"code", diagnostic.code.toStdString()},
+             {"option", diagnostic.option.toStdString()},
+             {"message", diagnostic.message.toStdString()}});
+        if (diagnostic.severity == "error" || diagnostic.severity == "fatal") {
+            errors++;
+        } else if (diagnostic.severity == "warning") {
+            warnings++;
+        }
+    }
+    return {{"errors", errors}, {"warnings", warnings}, {"diagnostics", records}};
+}
+
+const QSlangDriver::AstJson &QSlangDriver::getAst()
 {
     return ast;
 }
 
 const json &QSlangDriver::getModuleAst(const QString &moduleName)
 {
+    static const json emptyAst;
+    const std::string name = moduleName.toStdString();
+
+    const auto iterator = moduleAsts.find(name);
+    if (iterator != moduleAsts.end()) {
+        return iterator->second;
+    }
     if (ast.contains("members")) {
-        for (const json &member : ast["members"]) {
-            if (member.contains("kind") && member["kind"] == "Instance") {
-                if (member.contains("name") && member["name"] == moduleName.toStdString()) {
-                    return member;
+        for (const AstJson &member : ast.at("members")) {
+            if (member.contains("kind") && member.at("kind") == "Instance") {
+                if (member.contains("name") && member.at("name") == name) {
+                    /* Only the modules that are extracted leave the arena */
+                    return moduleAsts.emplace(name, json(member)).first->second;
                 }
             }
         }
     }
-    return ast;
+    return emptyAst;
 }
 
 const QStringList &QSlangDriver::getModuleList()
 {
     if (ast.contains("members")) {
-        for (const json &member : ast["members"]) {
+        for (const AstJson &member : ast["members"]) {
             if (member.contains("kind") && member["kind"] == "Instance") {
                 if (member.contains("name")) {
                     moduleList.append(QString::fromStdString(member["name"]));
@@ -245,42 +705,3 @@ const QStringList &QSlangDriver::getModuleList()
     }
     return moduleList;
 }
-
-QString QSlangDriver::contentCleanComment(const QString &content)
-{
-    QString result = content;
-    /* Normalize line endings to Unix-style */
-    result.replace(QRegularExpression(R"(\r\n|\r)"), "\n");
-    /* Remove single line comment */
-    result.remove(QRegularExpression(R"(\s*//[^\n]*\s*)"));
-    /* Remove multiline comments */
-    result.remove(QRegularExpression(R"(\s*/\*.*?\*/\s*)"));
-    /* Remove empty lines */
-    result.remove(QRegularExpression(R"(\n\s*\n)"));
-    return result;
-}
-
-QString QSlangDriver::contentValidFile(const QString &content, const QDir &baseDir)
-{
-    QStringList result;
-    /* Splitting content into lines, considering different newline characters */
-    const QStringList lines = content.split(QRegularExpression(R"(\r\n|\n|\r)"), Qt::KeepEmptyParts);
-
-    for (const QString &line : lines) {
-        QString absolutePath = line;
-        /* Check for relative path and convert it to absolute */
-        if (QDir::isRelativePath(line)) {
-            /* Convert relative path to absolute path */
-            absolutePath = baseDir.filePath(line);
-        } else {
-            /* Preserve absolute paths and non-path content as is */
-            absolutePath = line;
-        }
-        QFileInfo fileInfo(absolutePath);
-        /* Check if path exists and is a regular file (including valid symlinks to files) */
-        if (fileInfo.exists() && fileInfo.isFile()) {
-            result.append(absolutePath);
-        }
-    }
-    return result.join("\n");
-}
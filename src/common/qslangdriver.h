@@ -1,18 +1,36 @@
 #ifndef QSLANGDRIVER_H
 #define QSLANGDRIVER_H
 
+#include "common/qsocfilelist.h"
+#include "common/qsocjsonarena.h"
 #include "common/qsocprojectmanager.h"
 
-#include <QDir>
+#include <QList>
 #include <QMap>
 #include <QObject>
+#include <QRegularExpression>
 #include <QString>
 #include <QStringList>
 
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
 
+namespace slang::driver {
+class Driver;
+} // namespace slang::driver
+
+namespace slang::syntax {
+class SyntaxTree;
+} // namespace slang::syntax
+
 /**
  * @brief The QSlangDriver class.
  * @details This class is used to drive the slang verilog parser.
@@ -21,6 +39,35 @@ class QSlangDriver : public QObject
 {
     Q_OBJECT
 public:
+    /**
+     * @brief JSON type of the full AST, allocated in an arena.
+     * @details Use getModuleAst() for the AST of a module as plain json.
+     */
+    using AstJson = nlohmann::basic_json<
+        std::map,
+        std::vector,
+        QSocJsonArenaString,
+        bool,
+        std::int64_t,
+        std::uint64_t,
+        double,
+        QSocJsonArenaAllocator>;
+
+    /**
+     * @brief The Diagnostic struct.
+     * @details A diagnostic reported by slang during the last parse.
+     */
+    struct Diagnostic
+    {
+        QString file;       /* File name, empty if the diagnostic has no location */
+        int     line   = 0; /* Line number, starting at 1 */
+        int     column = 0; /* Column number, starting at 1 */
+        QString severity;   /* One of note, warning, error or fatal */
+        QString code;       /* Diagnostic code name, such as UnknownModule */
+        QString option;     /* Warning option name, such as unknown-sys-name */
+        QString message;    /* Formatted message */
+    };
+
     /**
      * @brief Constructor for QSlangDriver.
      * @details This constructor will initialize the resources.
@@ -35,6 +82,23 @@ public:
      */
     ~QSlangDriver();
 
+    /**
+     * @brief Get the diagnostics of the last parse.
+     * @details Diagnostics are collected per driver while slang reports
+     *          them, they are also logged as they come.
+     * @return const QList<Diagnostic> & Diagnostics in report order.
+     */
+    const QList<Diagnostic> &getDiagnostics() const;
+
+    /**
+     * @brief Convert diagnostics to JSON.
+     * @details The object has the error and warning counts and the
+     *          diagnostics array, with the fields of Diagnostic.
+     * @param diagnostics Diagnostics to convert.
+     * @return json The diagnostics report.
+     */
+    static json diagnosticsToJson(const QList<Diagnostic> &diagnostics);
+
 public slots:
     /**
      * @brief Parse command line arguments.
@@ -45,6 +109,17 @@ public slots:
      */
     bool parseArgs(const QString &args);
 
+    /**
+     * @brief Parse command line arguments.
+     * @details This function will parse command line arguments that are
+     *          already split, without a program name. Arguments are passed
+     *          to slang as they are, so paths need no quoting.
+     * @param arguments command line arguments.
+     * @retval true Parse successfully.
+     * @retval false Parse failed.
+     */
+    bool parseArgs(const QStringList &arguments);
+
     /**
      * @brief Parse file list.
      * @details This function will parse file list.
@@ -55,22 +130,64 @@ public slots:
      */
     bool parseFileList(const QString &fileListPath, const QStringList &filePathList);
 
+    /**
+     * @brief Parse a file list that is already read.
+     * @details This function will pass the source files, include
+     *          directories, defines and library options of the file list
+     *          straight to slang. No temporary file is written and the
+     *          console output of slang is captured one driver at a time, so
+     *          drivers may run concurrently.
+     * @param fileList file list, resolved by the caller.
+     * @retval true Parse successfully.
+     * @retval false Parse failed.
+     */
+    bool parseFileList(const QSocFileList &fileList);
+
+    /**
+     * @brief Set the number of threads that parse source files.
+     * @details With more than one thread, parseFileList() parses source
+     *          files that do not touch macro state in parallel, one syntax
+     *          tree per file. Files that define, undefine or use macros, or
+     *          include other files, are parsed together as a single unit in
+     *          file list order. File lists with library options, with a
+     *          `timescale in some files only, or with declarations at $unit
+     *          scope are parsed as a single unit.
+     * @param jobs Number of threads, 0 for one per core, 1 for a single
+     *        compilation unit.
+     */
+    void setParseJobs(int jobs);
+
+    /**
+     * @brief Set the modules to extract.
+     * @details Module declarations are matched by name before elaboration,
+     *          with the rules of QStaticRegex::isNameExactMatch(). When the
+     *          filter leaves some modules out, only the matching modules are
+     *          elaborated as top modules and only their instances are
+     *          serialized, so they are found even if other modules
+     *          instantiate them. An empty filter, or one that matches every
+     *          module, keeps the automatic top module selection.
+     * @param moduleNameRegex Regular expression of module names.
+     */
+    void setModuleFilter(const QRegularExpression &moduleNameRegex);
+
     /**
      * @brief Get Abstract Syntax Tree.
      * @details This function will return the Abstract Syntax Tree
      *          of the parsed files.
-     * @note The AST is in JSON format.
-     * @return json & Abstract Syntax Tree.
+     * @note The AST is in JSON format, it is valid until the next parse.
+     * @return AstJson & Abstract Syntax Tree.
      */
-    const json &getAst();
+    const AstJson &getAst();
 
     /**
      * @brief Get module Abstract Syntax Tree.
      * @details This function will return the Abstract Syntax Tree
      *          of the specified module.
-     * @note The AST is in JSON format.
+     * @note The AST is in JSON format, it is copied out of the full AST on
+     *       the first request and kept until the next parse.
      * @param moduleName module name.
-     * @return json & module Abstract Syntax Tree.
+     * @return json & module Abstract Syntax Tree, null if there is no such
+     *         module.
      */
     const json &getModuleAst(const QString &moduleName);
 
@@ -81,39 +198,112 @@ public slots:
      */
     const QStringList &getModuleList();
 
-    /**
-     * @brief Removes comments from the content.
-     * @details This function strips both single line and multiline comments
-     *          from the input string. It normalizes line endings to Unix-style
-     *          for cross-platform compatibility and removes empty lines.
-     * @param content The string containing the content with comments.
-     * @return QString The cleaned content string without comments.
-     */
-    QString contentCleanComment(const QString &content);
-
-    /**
-     * @brief Filters and validates file paths in content.
-     * @details This function processes each line of the input content as a file
-     *          path, verifies if it exists as a regular file or valid symbolic
-     *          link (not a directory), and returns absolute paths of valid
-     *          files. Paths are resolved relative to the specified base
-     *          directory.
-     * @param content String containing potential file paths (one per line)
-     * @param baseDir Base directory used for resolving relative paths
-     * @return QString containing newline-separated absolute paths of valid
-     *         files. Returns empty string if no valid files found.
-     */
-    QString contentValidFile(const QString &content, const QDir &baseDir);
-
 private:
     /* Pointer of project manager. */
     QSocProjectManager *projectManager = nullptr;
 
+    /* Arena of the Abstract Syntax Tree, declared first to outlive it. */
+    QSocJsonArena astArena;
+
     /* Abstract Syntax Tree JSON data. */
-    json ast;
+    AstJson ast;
+
+    /* Module Abstract Syntax Trees copied out of the arena, by name. */
+    std::map<std::string, json> moduleAsts;
 
     /* Module list. */
     QStringList moduleList;
+
+    /* Diagnostics of the last parse. */
+    QList<Diagnostic> diagnostics;
+
+    /* Number of threads that parse source files. */
+    int parseJobs = 1;
+
+    /* Modules to extract, empty for all top modules. */
+    QRegularExpression moduleFilter;
+
+    /**
+     * @brief The SourceFile struct.
+     * @details A source file of a parallel parse.
+     */
+    struct SourceFile
+    {
+        QString                                    path;            /* Absolute path */
+        std::string                                text;            /* File content */
+        bool                                       shared  = false; /* In the shared unit */
+        qint64                                     elapsed = 0;     /* Parse time in ms */
+        std::shared_ptr<slang::syntax::SyntaxTree> tree;            /* Syntax tree */
+    };
+
+    /**
+     * @brief Parse already split command line arguments.
+     * @param arguments command line arguments, without a program name.
+     * @param sourceFiles source files parsed by parseSources(), empty to let
+     *        slang parse the sources of the command line.
+     * @retval true Parse successfully.
+     * @retval false Parse failed.
+     */
+    bool parseArgumentList(const QStringList &arguments, const QStringList &sourceFiles);
+
+    /**
+     * @brief Run slang on the command line set up by a callback.
+     * @param parseCommandLine Callback that parses the command line into
+     *        the driver.
+     * @param sourceFiles source files parsed by parseSources(), empty to let
+     *        slang parse the sources of the command line.
+     * @retval true Parse successfully.
+     * @retval false Parse failed.
+     */
+    bool parseDriver(
+        const std::function<bool(slang::driver::Driver &)> &parseCommandLine,
+        const QStringList                                  &sourceFiles = {});
+
+    /**
+     * @brief Parse source files in parallel into the driver.
+     * @details Independent files are parsed on parseJobs threads, files
+     *          that share macro state are parsed as one unit. Syntax trees
+     *          are added in file list order, the shared unit at the place of
+     *          its first file. The parse time of every file is logged.
+     * @param driver slang driver with processed options.
+     * @param sourceFiles source files in file list order.
+     * @retval true Parse successfully.
+     * @retval false A source file could not be read.
+     */
+    bool parseSources(slang::driver::Driver &driver, const QStringList &sourceFiles);
+
+    /**
+     * @brief Match module declarations against the module filter.
+     * @param driver slang driver with parsed sources.
+     * @return std::vector<std::string> Names of the matching modules, empty
+     *         if the filter is empty or matches every module.
+     */
+    std::vector<std::string> matchTopModules(const slang::driver::Driver &driver) const;
+
+    /**
+     * @brief Check if a source file touches macro state.
+     * @details Any compiler directive other than those that only affect the
+     *          file itself counts, this includes macro uses, conditionals
+     *          and includes. A `timescale also applies to later files that
+     *          have none, it is reported to the caller instead. The whole
+     *          text is scanned so a `timescale after a macro is seen too.
+     * @param text source file content.
+     * @param timescale Set if the file has a `timescale directive.
+     * @retval true File must be parsed with the other shared files.
+     * @retval false File can be parsed on its own.
+     */
+    static bool isMacroStateShared(const std::string &text, bool &timescale);
+
+    /**
+     * @brief Check if a syntax tree declares items at $unit scope.
+     * @details Anything outside of a module, interface, program, package,
+     *          primitive or config, such as a typedef, parameter or
+     *          function, is only visible in its own compilation unit.
+     * @param tree syntax tree of a compilation unit.
+     * @retval true The tree has compilation unit scope items.
+     * @retval false The tree has design units only.
+     */
+    static bool hasUnitScopeItems(const slang::syntax::SyntaxTree &tree);
 };
 
 #endif // QSLANGDRIVER_H
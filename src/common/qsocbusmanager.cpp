@@ -1,12 +1,15 @@
 #include "common/qsocbusmanager.h"
 
+#include "common/qsocnamematcher.h"
+#include "common/qstaticdatasedes.h"
 #include "common/qstaticregex.h"
+#include "common/qstatictrace.h"
+#include "common/qstaticyamlcache.h"
 
 #include <QDebug>
 #include <QDir>
 #include <QFile>
 
-#include <fstream>
 #include <string>
 #include <vector>
 
@@ -14,11 +17,17 @@
 
 QSocBusManager::QSocBusManager(QObject *parent, QSocProjectManager *projectManager)
     : QObject{parent}
+    , residentLibraries("bus")
 {
     /* Set projectManager */
     setProjectManager(projectManager);
 }
 
+QSocBusManager::~QSocBusManager()
+{
+    residentLibraries.end(busData);
+}
+
 void QSocBusManager::setProjectManager(QSocProjectManager *projectManager)
 {
     /* Set projectManager */
@@ -50,6 +59,7 @@ bool QSocBusManager::isBusPathValid()
 bool QSocBusManager::importFromFileList(
     const QString &libraryName, const QString &busName, const QStringList &filePathList)
 {
+    const QStaticTrace::Span span("bus.import", libraryName);
     /* Check if libraryName is empty */
     if (libraryName.isEmpty()) {
         qCritical() << "Error: library name is empty.";
@@ -194,72 +204,6 @@ bool QSocBusManager::importFromFileList(
     return true;
 }
 
-YAML::Node QSocBusManager::mergeNodes(const YAML::Node &toYaml, const YAML::Node &fromYaml)
-{
-    if (!fromYaml.IsMap()) {
-        /* If fromYaml is not a map, merge result is fromYaml, unless fromYaml is null */
-        return fromYaml.IsNull() ? toYaml : fromYaml;
-    }
-    if (!toYaml.IsMap()) {
-        /* If toYaml is not a map, merge result is fromYaml */
-        return fromYaml;
-    }
-    if (!fromYaml.size()) {
-        /* If toYaml is a map, and fromYaml is an empty map, return toYaml */
-        return toYaml;
-    }
-    /* Create a new map 'resultYaml' with the same mappings as toYaml, merged with fromYaml */
-    YAML::Node resultYaml = YAML::Node(YAML::NodeType::Map);
-    for (auto iter : toYaml) {
-        if (iter.first.IsScalar()) {
-            const std::string &key      = iter.first.Scalar();
-            auto               tempYaml = YAML::Node(fromYaml[key]);
-            if (tempYaml) {
-                resultYaml[iter.first] = mergeNodes(iter.second, tempYaml);
-                continue;
-            }
-        }
-        resultYaml[iter.first] = iter.second;
-    }
-    /* Add the mappings from 'fromYaml' not already in 'resultYaml' */
-    for (auto iter : fromYaml) {
-        if (!iter.first.IsScalar() || !resultYaml[iter.first.Scalar()]) {
-            resultYaml[iter.first] = iter.second;
-        }
-    }
-    return resultYaml;
-}
-
-void QSocBusManager::libraryMapAdd(const QString &libraryName, const QString &busName)
-{
-    /* Check if the library exists in the map */
-    if (!libraryMap.contains(libraryName)) {
-        /* If the key doesn't exist, create a new QSet and insert the busName */
-        QSet<QString> busSet;
-        busSet.insert(busName);
-        libraryMap.insert(libraryName, busSet);
-    } else {
-        /* If the key exists, just add the busName to the existing QSet */
-        libraryMap[libraryName].insert(busName);
-    }
-}
-
-void QSocBusManager::libraryMapRemove(const QString &libraryName, const QString &busName)
-{
-    /* Check if the library exists in the map */
-    if (libraryMap.contains(libraryName)) {
-        QSet<QString> &buses = libraryMap[libraryName];
-
-        /* Remove the bus if it exists in the set */
-        buses.remove(busName);
-
-        /* If the set becomes empty after removal, delete the library entry */
-        if (buses.isEmpty()) {
-            libraryMap.remove(libraryName);
-        }
-    }
-}
-
 bool QSocBusManager::saveLibraryYaml(const QString &libraryName, const YAML::Node &libraryYaml)
 {
     YAML::Node localLibraryYaml;
@@ -271,23 +215,17 @@ bool QSocBusManager::saveLibraryYaml(const QString &libraryName, const YAML::Nod
     /* Check file path */
     const QString &busPath  = projectManager->getBusPath();
     const QString &filePath = busPath + "/" + libraryName + ".soc_bus";
-    if (QFile::exists(filePath)) {
-        /* Load library YAML file */
-        std::ifstream inputFileStream(filePath.toStdString());
-        localLibraryYaml = mergeNodes(YAML::Load(inputFileStream), libraryYaml);
+    if (QStaticYamlCache::exists(filePath)) {
+        /* Load library YAML file, the loaded copy is owned and merged in place */
+        localLibraryYaml = QStaticYamlCache::load(filePath);
+        QStaticDataSedes::mergeYamlInto(localLibraryYaml, libraryYaml);
         qDebug() << "Load and merge";
     } else {
         localLibraryYaml = libraryYaml;
     }
 
-    /* Save YAML file */
-    std::ofstream outputFileStream(filePath.toStdString());
-    if (!outputFileStream.is_open()) {
-        qCritical() << "Error: Unable to open file for writing:" << filePath;
-        return false;
-    }
-    outputFileStream << localLibraryYaml;
-    return true;
+    /* Save YAML file, deferred in batch mode */
+    return QStaticYamlCache::save(filePath, localLibraryYaml);
 }
 
 QStringList QSocBusManager::listLibrary(const QRegularExpression &libraryNameRegex)
@@ -303,17 +241,12 @@ QStringList QSocBusManager::listLibrary(const QRegularExpression &libraryNameReg
         qCritical() << "Error: Invalid or empty regex:" << libraryNameRegex.pattern();
         return result;
     }
-    /* QDir for '.soc_bus' files in bus path, sorted by name. */
-    const QDir busPathDir(
-        projectManager->getBusPath(),
-        "*.soc_bus",
-        QDir::SortFlag::Name | QDir::SortFlag::IgnoreCase,
-        QDir::Files | QDir::NoDotAndDotDot);
+    /* '.soc_bus' files in bus path sorted by name, including pending batch writes. */
+    const QStringList fileNames
+        = QStaticYamlCache::listFiles(projectManager->getBusPath(), "soc_bus");
     /* Add matching file basenames from projectDir to result list. */
-    foreach (const QString &filename, busPathDir.entryList()) {
-        if (QStaticRegex::isNameExactMatch(filename, libraryNameRegex)) {
-            result.append(filename.split('.').first());
-        }
+    for (const QString &filename : QSocNameMatcher(libraryNameRegex).filter(fileNames)) {
+        result.append(filename.split('.').first());
     }
 
     return result;
@@ -336,12 +269,13 @@ bool QSocBusManager::isExist(const QString &libraryName)
     /* Get the full file path by joining bus path and basename with extension */
     const QString filePath = QDir(projectManager->getBusPath()).filePath(libraryName + ".soc_bus");
 
-    /* Check if library file exists */
-    return QFile::exists(filePath);
+    /* Check if library file exists, including pending batch writes */
+    return QStaticYamlCache::exists(filePath);
 }
 
 bool QSocBusManager::load(const QString &libraryName)
 {
+    const QStaticTrace::Span span("bus.load", libraryName);
     /* Validate projectManager and its path */
     if (!isBusPathValid()) {
         qCritical() << "Error: projectManager is null or invalid bus path.";
@@ -355,41 +289,51 @@ bool QSocBusManager::load(const QString &libraryName)
     }
 
     /* Get the full file path by joining bus path and basename with extension */
-    const QString filePath = QDir(projectManager->getBusPath()).filePath(libraryName + ".soc_bus");
+    const QDir    busDir(projectManager->getBusPath());
+    const QString filePath = busDir.filePath(libraryName + ".soc_bus");
 
-    /* Open the YAML file */
-    std::ifstream fileStream(filePath.toStdString());
-    if (!fileStream.is_open()) {
-        qCritical() << "Error: Unable to open file:" << filePath;
-        return false;
+    /* A session reuses the library from the previous command while its file is unchanged */
+    residentLibraries.begin(busDir.absolutePath(), busData);
+    if (residentLibraries.reuse(libraryName, filePath, libraryIndex)) {
+        return true;
     }
 
     try {
-        /* Load YAML content into a temporary node */
-        YAML::Node tempNode = YAML::Load(fileStream);
+        /* Load YAML content into a temporary node, reused while the file is unchanged */
+        YAML::Node  tempNode = QStaticYamlCache::load(filePath);
+        QStringList busNames;
 
         /* Iterate through the temporary node and add to busData */
         for (YAML::const_iterator it = tempNode.begin(); it != tempNode.end(); ++it) {
-            const auto key = it->first.as<std::string>();
-
-            /* Add to busData */
-            busData[key] = it->second;
+            const auto    key     = it->first.as<std::string>();
+            const QString busName = QString::fromStdString(key);
 
             /* Check if this is old format (no "port" node) and reject it */
-            if (!busData[key]["port"]) {
-                qCritical() << "Error: Bus" << QString::fromStdString(key)
+            if (!it->second["port"]) {
+                residentLibraries.discard();
+                qCritical() << "Error: Bus" << busName
                             << "has invalid structure (missing 'port' node)";
-                /* Remove invalid bus data */
-                busData.remove(key);
                 return false;
             }
 
-            busData[key]["library"] = libraryName.toStdString();
+            /* Tag the bus with its library, tempNode is an owned copy */
+            YAML::Node busYaml = it->second;
+            busYaml["library"] = libraryName.toStdString();
 
-            /* Update libraryMap with libraryName to key mapping */
-            libraryMapAdd(libraryName, QString::fromStdString(key));
+            /* Add to busData, new buses are appended without a lookup */
+            if (libraryIndex.containsName(busName) || residentLibraries.contains(busName)) {
+                busData[key] = busYaml;
+            } else {
+                busData.force_insert(key, busYaml);
+            }
+
+            /* Record libraryName as the owner of key */
+            libraryIndex.insert(libraryName, busName);
+            busNames.append(busName);
         }
+        residentLibraries.loaded(libraryName, filePath, busNames);
     } catch (const YAML::Exception &e) {
+        residentLibraries.discard();
         qCritical() << "Error parsing YAML file:" << filePath << ":" << e.what();
         return false;
     }
@@ -461,20 +405,21 @@ bool QSocBusManager::remove(const QString &libraryName)
     const QString filePath = QDir(projectManager->getBusPath()).filePath(libraryName + ".soc_bus");
 
     /* Check if library file exists */
-    if (!QFile::exists(filePath)) {
+    if (!QStaticYamlCache::exists(filePath)) {
         qCritical() << "Error: library file does not exist for basename:" << libraryName;
         return false;
     }
 
     /* Remove the file */
-    if (!QFile::remove(filePath)) {
+    if (!QStaticYamlCache::remove(filePath)) {
         qCritical() << "Error: Failed to remove bus file:" << filePath;
         return false;
     }
 
-    /* Remove from busData and libraryMap */
-    busData.remove(libraryName.toStdString());
-    libraryMap.remove(libraryName);
+    /* Remove the buses of the library from busData and libraryIndex */
+    for (const QString &busName : libraryIndex.removeLibrary(libraryName)) {
+        busData.remove(busName.toStdString());
+    }
 
     return true;
 }
@@ -527,22 +472,23 @@ bool QSocBusManager::remove(const QStringList &libraryNameList)
 
 bool QSocBusManager::save(const QString &libraryName)
 {
+    const QStaticTrace::Span span("bus.save", libraryName);
     /* Validate projectManager and its path */
     if (!isBusPathValid()) {
         qCritical() << "Error: projectManager is null or invalid library path.";
         return false;
     }
 
-    /* Check if the libraryName exists in libraryMap */
-    if (!libraryMap.contains(libraryName)) {
-        qCritical() << "Error: Library basename not found in libraryMap.";
+    /* Check if the libraryName exists in libraryIndex */
+    if (!libraryIndex.containsLibrary(libraryName)) {
+        qCritical() << "Error: Library basename not found in libraryIndex.";
         return false;
     }
 
     /* Extract buses from busData */
     YAML::Node dataToSave;
-    /* Iterate through each bus in libraryMap */
-    for (const auto &busItem : libraryMap[libraryName]) {
+    /* Iterate through each bus of the library in name order */
+    for (const auto &busItem : libraryIndex.getNames(libraryName)) {
         const std::string busNameStd = busItem.toStdString();
         if (!busData[busNameStd]) {
             qCritical() << "Error: Bus data is not exist: " << busNameStd;
@@ -556,13 +502,7 @@ bool QSocBusManager::save(const QString &libraryName)
 
     /* Serialize and save to file */
     const QString filePath = QDir(projectManager->getBusPath()).filePath(libraryName + ".soc_bus");
-    std::ofstream outputFileStream(filePath.toStdString());
-    if (!outputFileStream.is_open()) {
-        qCritical() << "Error: Unable to open file for writing:" << filePath;
-        return false;
-    }
-    outputFileStream << dataToSave;
-    return true;
+    return QStaticYamlCache::save(filePath, dataToSave);
 }
 
 bool QSocBusManager::save(const QRegularExpression &libraryNameRegex)
@@ -580,8 +520,8 @@ bool QSocBusManager::save(const QRegularExpression &libraryNameRegex)
         return false;
     }
 
-    /* Iterate over libraryMap and save matching libraries */
-    for (const QString &libraryName : libraryMap.keys()) {
+    /* Iterate over libraryIndex and save matching libraries */
+    for (const QString &libraryName : libraryIndex.getLibraries()) {
         if (QStaticRegex::isNameExactMatch(libraryName, libraryNameRegex)) {
             if (!save(libraryName)) {
                 qCritical() << "Error: Failed to save library:" << libraryName;
@@ -615,59 +555,47 @@ bool QSocBusManager::save(const QStringList &libraryNameList)
 
 QStringList QSocBusManager::listBus(const QRegularExpression &busNameRegex)
 {
-    QStringList result;
     /* Validate busNameRegex */
     if (!QStaticRegex::isNameRegexValid(busNameRegex)) {
         qCritical() << "Error: Invalid or empty regex:" << busNameRegex.pattern();
-        return result;
+        return QStringList();
     }
+    return listBus(QSocNameMatcher(busNameRegex));
+}
 
-    /* Iterate through each node in busData */
-    for (YAML::const_iterator it = busData.begin(); it != busData.end(); ++it) {
-        const QString busName = QString::fromStdString(it->first.as<std::string>());
+QStringList QSocBusManager::listBus(const QSocNameMatcher &busNameMatcher)
+{
+    /* Names are sorted, plain names and prefixes are found by binary search */
+    return busNameMatcher.filterSorted(libraryIndex.getNames());
+}
 
-        /* Check if the bus name matches the regex */
-        if (QStaticRegex::isNameExactMatch(busName, busNameRegex)) {
-            result.append(busName);
-        }
+bool QSocBusManager::removeBus(const QRegularExpression &busNameRegex)
+{
+    /* Validate busNameRegex */
+    if (!QStaticRegex::isNameRegexValid(busNameRegex)) {
+        qCritical() << "Error: Invalid or empty regex:" << busNameRegex.pattern();
+        return false;
     }
-
-    return result;
+    return removeBus(QSocNameMatcher(busNameRegex));
 }
 
-bool QSocBusManager::removeBus(const QRegularExpression &busNameRegex)
+bool QSocBusManager::removeBus(const QSocNameMatcher &busNameMatcher)
 {
     /* Validate projectManager and its path */
     if (!isBusPathValid()) {
         qCritical() << "Error: projectManager is null or invalid bus path.";
         return false;
     }
-    /* Validate busNameRegex */
-    if (!QStaticRegex::isNameRegexValid(busNameRegex)) {
-        qCritical() << "Error: Invalid or empty regex:" << busNameRegex.pattern();
-        return false;
-    }
 
     QSet<QString> libraryToSave;
     QSet<QString> libraryToRemove;
-    QSet<QString> busToRemove;
-
-    for (auto busDataIter = busData.begin(); busDataIter != busData.end(); ++busDataIter) {
-        const QString busName = QString::fromStdString(busDataIter->first.as<std::string>());
-        if (QStaticRegex::isNameExactMatch(busName, busNameRegex)) {
-            busToRemove.insert(busName);
-            const QString libraryName = QString::fromStdString(
-                busDataIter->second["library"].as<std::string>());
-            libraryToSave.insert(libraryName);
-        }
-    }
 
-    /* Remove buses from busData */
-    for (const QString &busName : busToRemove) {
-        const QString libraryName = QString::fromStdString(
-            busData[busName.toStdString()]["library"].as<std::string>());
-        libraryMapRemove(libraryName, busName);
-        if (!libraryMap.contains(libraryName)) {
+    /* Remove matching buses from busData and libraryIndex */
+    for (const QString &busName : busNameMatcher.filterSorted(libraryIndex.getNames())) {
+        const QString libraryName = libraryIndex.remove(busName);
+        if (libraryIndex.containsLibrary(libraryName)) {
+            libraryToSave.insert(libraryName);
+        } else {
             libraryToRemove.insert(libraryName);
         }
         busData.remove(busName.toStdString());
@@ -682,13 +610,13 @@ bool QSocBusManager::removeBus(const QRegularExpression &busNameRegex)
     const QStringList libraryToRemoveList
         = QList<QString>(libraryToRemove.begin(), libraryToRemove.end());
 
-    /* Save libraries that still have associations in libraryMap */
+    /* Save libraries that still have associations in libraryIndex */
     if (!save(libraryToSaveList)) {
         qCritical() << "Error: Failed to save libraries.";
         return false;
     }
 
-    /* Remove buses with no remaining associations in libraryMap */
+    /* Remove libraries with no remaining associations in libraryIndex */
     if (!remove(libraryToRemoveList)) {
         qCritical() << "Error: Failed to remove buses.";
         return false;
@@ -720,33 +648,34 @@ YAML::Node QSocBusManager::getBusYaml(const QString &busName)
 
 bool QSocBusManager::isBusExist(const QString &busName)
 {
-    return busData[busName.toStdString()].IsDefined();
+    return libraryIndex.containsName(busName);
 }
 
 QString QSocBusManager::getBusLibrary(const QString &busName)
 {
-    if (!isBusExist(busName)) {
-        return QString();
-    }
-    return QString::fromStdString(busData[busName.toStdString()]["library"].as<std::string>());
+    return libraryIndex.getLibrary(busName);
 }
 
 YAML::Node QSocBusManager::getBusYamls(const QRegularExpression &busNameRegex)
 {
-    YAML::Node result;
-
     /* Check if the regex is valid, if not, return an empty node */
     if (!QStaticRegex::isNameRegexValid(busNameRegex)) {
         qWarning() << "Invalid regular expression provided.";
-        return result;
+        return YAML::Node();
     }
+    return getBusYamls(QSocNameMatcher(busNameRegex));
+}
+
+YAML::Node QSocBusManager::getBusYamls(const QSocNameMatcher &busNameMatcher)
+{
+    YAML::Node result;
 
-    /* Iterate over the busData to find matches */
+    /* Iterate over the busData to find matches, skipping kept buses not loaded */
     for (YAML::const_iterator it = busData.begin(); it != busData.end(); ++it) {
         const QString busName = QString::fromStdString(it->first.as<std::string>());
 
-        /* Check if the bus name matches the regex */
-        if (QStaticRegex::isNameExactMatch(busName, busNameRegex)) {
+        /* Check if the bus name matches any pattern */
+        if (libraryIndex.containsName(busName) && busNameMatcher.matches(busName)) {
             /* Add the bus node to the result */
             result[busName.toStdString()] = it->second;
         }
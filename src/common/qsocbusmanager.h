@@ -1,7 +1,10 @@
 #ifndef QSOCBUSMANAGER_H
 #define QSOCBUSMANAGER_H
 
+#include "common/qsoclibraryindex.h"
+#include "common/qsocnamematcher.h"
 #include "common/qsocprojectmanager.h"
+#include "common/qsocresidentlibraries.h"
 
 #include <QObject>
 #include <QRegularExpression>
@@ -24,6 +27,13 @@ public:
      */
     explicit QSocBusManager(QObject *parent = nullptr, QSocProjectManager *projectManager = nullptr);
 
+    /**
+     * @brief Destructor.
+     * @details Leaves the loaded libraries for the next command of a long
+     *          running session, see QSocResidentLibraries.
+     */
+    ~QSocBusManager() override;
+
 public slots:
     /**
      * @brief Set the project manager.
@@ -182,7 +192,7 @@ public slots:
      * @brief Save library data associated with a specific basename.
      * @details Serializes and saves the bus data related to the given
      *          `libraryName`. It locates the corresponding buses in
-     *          `busData` using `libraryMap`, then serializes them into YAML
+     *          `busData` using `libraryIndex`, then serializes them into YAML
      *          format. The result is saved to a file with the same basename,
      *          appending the ".soc_bus" extension. Existing files are
      *          overwritten. This function requires a valid projectManager.
@@ -194,7 +204,7 @@ public slots:
 
     /**
      * @brief Save multiple libraries matching a regex pattern.
-     * @details Iterates through `libraryMap` to find libraries matching the
+     * @details Iterates through `libraryIndex` to find libraries matching the
      *          provided regex pattern. Each matching library is serialized and
      *          saved individually in YAML format. Files are named after the
      *          library basenames with the ".soc_bus" extension. Existing files
@@ -209,7 +219,7 @@ public slots:
      * @brief Save multiple libraries by a list of basenames.
      * @details Serializes and saves bus data related to each `libraryName`
      *          in `libraryNameList`. It locates corresponding buses in
-     *          `busData` using `libraryMap`, then serializes them into YAML
+     *          `busData` using `libraryIndex`, then serializes them into YAML
      *          format. Results are saved to files named after each basename,
      *          appending ".soc_bus". Existing files are overwritten. Requires
      *          a valid projectManager.
@@ -235,10 +245,19 @@ public slots:
      */
     QStringList listBus(const QRegularExpression &busNameRegex = QRegularExpression(".*"));
 
+    /**
+     * @brief Get list of bus names matching any of several patterns.
+     * @details Same as listBus() with a regex, the patterns are matched in
+     *          one pass over `busData`.
+     * @param busNameMatcher Patterns to match bus names.
+     * @return QStringList of matching bus names in the bus library.
+     */
+    QStringList listBus(const QSocNameMatcher &busNameMatcher);
+
     /**
      * @brief Remove buses matching regex from bus library.
      * @details Removes buses that match `busNameRegex` from busData,
-     *          updating libraryMap accordingly. It saves libraries with
+     *          updating libraryIndex accordingly. It saves libraries with
      *          remaining bus associations and removes files with no
      *          associations. Requires a valid projectManager for execution.
      * @param busNameRegex Regex to filter bus names for removal.
@@ -247,6 +266,16 @@ public slots:
      */
     bool removeBus(const QRegularExpression &busNameRegex);
 
+    /**
+     * @brief Remove buses matching any of several patterns.
+     * @details Same as removeBus() with a regex, every affected library is
+     *          saved or removed once.
+     * @param busNameMatcher Patterns to match bus names for removal.
+     * @retval true All matching buses are successfully processed.
+     * @retval false Errors occur during bus removal or bus saving.
+     */
+    bool removeBus(const QSocNameMatcher &busNameMatcher);
+
     /**
      * @brief Get the Bus YAML object.
      * @details This function will get the YAML node for a specific bus from
@@ -296,62 +325,29 @@ public slots:
      */
     YAML::Node getBusYamls(const QRegularExpression &busNameRegex = QRegularExpression(".*"));
 
+    /**
+     * @brief Retrieve combined YAML nodes for buses matching any of several
+     *        patterns.
+     * @param busNameMatcher Patterns to match bus names.
+     * @return YAML::Node A combined YAML node of all matched bus YAMLs, empty
+     *                    if no matches are found.
+     */
+    YAML::Node getBusYamls(const QSocNameMatcher &busNameMatcher);
+
 private:
     /* Internal used project manager. */
     QSocProjectManager *projectManager = nullptr;
 
-    /* This QMap, libraryMap, maps library names to sets of bus names.
-       Each key in the map is a library name (QString).
-       The corresponding value is a QSet<QString> containing the names
-       of all buses that are part of that library.
-       - key: QString libraryName
-       - value: QSet<QString> busNameSet
-       This structure ensures that each library name is associated with
-       a unique set of bus names, allowing efficient retrieval and
-       management of buses within each library. */
-    QMap<QString, QSet<QString>> libraryMap;
+    /* Owning library of every loaded bus, and the sorted bus names
+       of every library. Kept in step with busData so owner lookups and
+       per-library iteration do not scan the YAML node. */
+    QSocLibraryIndex libraryIndex;
 
     /* Bus library YAML node */
     YAML::Node busData;
 
-    /**
-     * @brief Merge two YAML nodes.
-     * @details This function will merge two YAML nodes. It returns a new map
-     *          resultYaml which is a merge of fromYaml into toYaml.
-     *          Values from fromYaml will replace identically keyed non-map
-     *          values from toYaml in the resultYaml map.
-     *          The values ​​in toYaml and fromYaml will not be modified.
-     * @param toYaml The destination YAML node.
-     * @param fromYaml The source YAML node.
-     * @return YAML::Node The merged YAML node which is a merge of fromYaml into
-     *                    toYaml.
-     */
-    YAML::Node mergeNodes(const YAML::Node &toYaml, const YAML::Node &fromYaml);
-
-    /**
-     * @brief Adds a bus name to the library map.
-     * @details This function adds a given bus name to the set of buses
-     *          associated with a specified library in the libraryMap.
-     *          If the library does not already exist in the map, it creates
-     *          a new entry with an empty set of buses and then adds the
-     *          bus name. If the library exists, it simply adds the bus
-     *          name to the existing set.
-     * @param libraryName The name of the library.
-     * @param busName The name of the bus to add to the library.
-     */
-    void libraryMapAdd(const QString &libraryName, const QString &busName);
-
-    /**
-     * @brief Removes a bus from a library in the library map.
-     * @details This function removes the specified bus from the set
-     *          associated with the given library name in the library map. If
-     *          the bus is the only one in the set, it also removes the
-     *          entire library entry from the map. Does nothing if the library
-     *          or bus does not exist.
-     * @param libraryName The name of the library to be modified.
-     * @param busName The name of the bus to be removed.
-     */
-    void libraryMapRemove(const QString &libraryName, const QString &busName);
+    /* Libraries kept in busData between the commands of a session. */
+    QSocResidentLibraries residentLibraries;
 
 signals:
 };
@@ -0,0 +1,260 @@
+#include "common/qsocfilelist.h"
+
+#include "common/qstaticlog.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+
+QSocFileList::QSocFileList(const QMap<QString, QString> &environment)
+    : environment(environment)
+{}
+
+bool QSocFileList::addFileList(const QString &fileListPath)
+{
+    return addFileList(fileListPath, QFileInfo(fileListPath).absoluteDir());
+}
+
+bool QSocFileList::addFileList(const QString &fileListPath, const QDir &baseDir)
+{
+    const QFileInfo fileInfo(fileListPath);
+    QFile           inputFile(fileListPath);
+    if (!inputFile.open(QIODevice::ReadOnly)) {
+        QSOC_LOG_E("Failed to open file list:" + fileListPath);
+        return false;
+    }
+
+    /* Filelists are identified by their canonical path to catch cycles through links */
+    const QString canonicalPath = fileInfo.canonicalFilePath();
+    if (openFileLists.contains(canonicalPath)) {
+        QSOC_LOG_W("File list includes itself, ignored:" + fileListPath);
+        return true;
+    }
+
+    openFileLists.insert(canonicalPath);
+    const bool result = process(tokenize(QString::fromUtf8(inputFile.readAll())), baseDir);
+    openFileLists.remove(canonicalPath);
+    return result;
+}
+
+bool QSocFileList::addText(const QString &content, const QDir &baseDir)
+{
+    return process(tokenize(content), baseDir);
+}
+
+int QSocFileList::resolve()
+{
+    /* Directory listings by absolute directory path */
+    QHash<QString, QSet<QString>> listings;
+    QStringList                   existingFiles;
+    existingFiles.reserve(sourceFiles.size());
+
+    for (const QString &filePath : sourceFiles) {
+        const qsizetype separator = filePath.lastIndexOf('/');
+        const QString   dirPath   = separator > 0 ? filePath.left(separator) : QString("/");
+        const QString   fileName  = filePath.mid(separator + 1);
+        if (!listings.contains(dirPath)) {
+            const QStringList entries = QDir(dirPath).entryList(QDir::Files | QDir::Hidden);
+            listings.insert(dirPath, QSet<QString>(entries.begin(), entries.end()));
+        }
+        /* Names may differ in case on case insensitive file systems, ask for those */
+        if (listings.value(dirPath).contains(fileName) || QFileInfo(filePath).isFile()) {
+            existingFiles.append(filePath);
+        } else {
+            QSOC_LOG_W("Source file not found, ignored:" + filePath);
+        }
+    }
+
+    const int droppedCount = static_cast<int>(sourceFiles.size() - existingFiles.size());
+    sourceFiles            = existingFiles;
+    sourceFileSet          = QSet<QString>(sourceFiles.begin(), sourceFiles.end());
+    return droppedCount;
+}
+
+const QStringList &QSocFileList::getSourceFiles() const
+{
+    return sourceFiles;
+}
+
+const QStringList &QSocFileList::getIncludeDirs() const
+{
+    return includeDirs;
+}
+
+const QStringList &QSocFileList::getDefines() const
+{
+    return defines;
+}
+
+const QStringList &QSocFileList::getLibraryDirs() const
+{
+    return libraryDirs;
+}
+
+const QStringList &QSocFileList::getLibraryFiles() const
+{
+    return libraryFiles;
+}
+
+const QStringList &QSocFileList::getLibraryExtensions() const
+{
+    return libraryExtensions;
+}
+
+QStringList QSocFileList::toArguments(bool withSourceFiles) const
+{
+    QStringList arguments;
+    for (const QString &includeDir : includeDirs) {
+        arguments.append("+incdir+" + includeDir);
+    }
+    for (const QString &define : defines) {
+        arguments.append("+define+" + define);
+    }
+    if (!libraryExtensions.isEmpty()) {
+        arguments.append("+libext+" + libraryExtensions.join('+'));
+    }
+    for (const QString &libraryDir : libraryDirs) {
+        arguments << "-y" << libraryDir;
+    }
+    for (const QString &libraryFile : libraryFiles) {
+        arguments << "-v" << libraryFile;
+    }
+    if (withSourceFiles) {
+        arguments.append(sourceFiles);
+    }
+    return arguments;
+}
+
+QStringList QSocFileList::tokenize(const QString &content) const
+{
+    QStringList     tokens;
+    QString         token;
+    bool            inToken = false;
+    bool            inQuote = false;
+    const qsizetype size    = content.size();
+
+    for (qsizetype position = 0; position < size;) {
+        const QChar character = content.at(position);
+
+        /* Comments end the current token, outside of quotes */
+        if (!inQuote && character == '/' && position + 1 < size) {
+            const QChar next = content.at(position + 1);
+            if (next == '/' || next == '*') {
+                const qsizetype end = next == '/' ? content.indexOf('\n', position + 2)
+                                                  : content.indexOf("*/", position + 2);
+                position = end < 0 ? size : (next == '/' ? end : end + 2);
+                if (inToken) {
+                    tokens.append(token);
+                    token.clear();
+                    inToken = false;
+                }
+                continue;
+            }
+        }
+
+        if (character == '"') {
+            inQuote = !inQuote;
+            inToken = true;
+            position++;
+        } else if (!inQuote && character.isSpace()) {
+            if (inToken) {
+                tokens.append(token);
+                token.clear();
+                inToken = false;
+            }
+            position++;
+        } else if (character == '$') {
+            token.append(expandVariable(content, position));
+            inToken = true;
+        } else {
+            token.append(character);
+            inToken = true;
+            position++;
+        }
+    }
+    if (inToken) {
+        tokens.append(token);
+    }
+    return tokens;
+}
+
+QString QSocFileList::expandVariable(const QString &content, qsizetype &position) const
+{
+    if (position + 1 >= content.size() || content.at(position + 1) != '{') {
+        position++;
+        return QString("$");
+    }
+    const qsizetype end = content.indexOf('}', position + 2);
+    if (end < 0) {
+        position++;
+        return QString("$");
+    }
+
+    /* Only the referenced name is looked up, unknown references are kept */
+    const QString reference = content.mid(position, end - position + 1);
+    position                = end + 1;
+    return environment.value(reference.mid(2, reference.size() - 3), reference);
+}
+
+bool QSocFileList::process(const QStringList &tokens, const QDir &baseDir)
+{
+    bool result = true;
+    for (qsizetype index = 0; index < tokens.size(); index++) {
+        const QString &token = tokens.at(index);
+
+        /* Options with a separate argument */
+        if (token == "-f" || token == "-F" || token == "-y" || token == "-v" || token == "-I"
+            || token == "-D") {
+            if (index + 1 >= tokens.size()) {
+                QSOC_LOG_W("Missing argument of option, ignored:" + token);
+                break;
+            }
+            const QString &argument = tokens.at(++index);
+            if (token == "-D") {
+                defines.append(argument);
+            } else {
+                const QString path = QDir::cleanPath(baseDir.absoluteFilePath(argument));
+                if (token == "-y") {
+                    libraryDirs.append(path);
+                } else if (token == "-v") {
+                    libraryFiles.append(path);
+                } else if (token == "-I") {
+                    includeDirs.append(path);
+                } else {
+                    /* -F lists resolve against their own directory, -f lists keep the base */
+                    const bool added = token == "-F" ? addFileList(path)
+                                                     : addFileList(path, baseDir);
+                    if (!added) {
+                        result = false;
+                    }
+                }
+            }
+        } else if (token.startsWith("+incdir+")) {
+            appendPlusValues(token.mid(8), includeDirs, &baseDir);
+        } else if (token.startsWith("+define+")) {
+            appendPlusValues(token.mid(8), defines, nullptr);
+        } else if (token.startsWith("+libext+")) {
+            appendPlusValues(token.mid(8), libraryExtensions, nullptr);
+        } else if (token.startsWith("-I")) {
+            includeDirs.append(QDir::cleanPath(baseDir.absoluteFilePath(token.mid(2))));
+        } else if (token.startsWith("-D")) {
+            defines.append(token.mid(2));
+        } else if (token.startsWith('-') || token.startsWith('+')) {
+            QSOC_LOG_W("Unsupported file list option, ignored:" + token);
+        } else {
+            const QString path = QDir::cleanPath(baseDir.absoluteFilePath(token));
+            if (!sourceFileSet.contains(path)) {
+                sourceFileSet.insert(path);
+                sourceFiles.append(path);
+            }
+        }
+    }
+    return result;
+}
+
+void QSocFileList::appendPlusValues(const QString &values, QStringList &list, const QDir *baseDir)
+{
+    for (const QString &value : values.split('+', Qt::SkipEmptyParts)) {
+        list.append(baseDir ? QDir::cleanPath(baseDir->absoluteFilePath(value)) : value);
+    }
+}
@@ -0,0 +1,178 @@
+#ifndef QSOCFILELIST_H
+#define QSOCFILELIST_H
+
+#include <QDir>
+#include <QMap>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief The QSocFileList class.
+ * @details This class reads Verilog filelists in a single pass per file.
+ *          Comments are stripped, `${VAR}` references are expanded by a
+ *          lookup of the referenced name only, and the options are sorted
+ *          into source files, include directories, defines and library
+ *          options while the text is scanned. Nested `-f` and `-F` filelists
+ *          are read in place. Relative paths in a `-F` filelist resolve
+ *          against its own directory, those in a `-f` filelist against the
+ *          base directory of the filelist that names it. Existence of source
+ *          files is checked by resolve() with one directory listing per
+ *          directory instead of one stat per file.
+ */
+class QSocFileList
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param environment Variables for `${VAR}` expansion, unknown variables
+     *        are left as they are.
+     */
+    explicit QSocFileList(const QMap<QString, QString> &environment = {});
+
+    /**
+     * @brief Read a filelist.
+     * @details Reads the filelist and the filelists it includes. A filelist
+     *          that includes itself, directly or not, is reported and not
+     *          read again.
+     * @param fileListPath Path of the filelist.
+     * @retval true Filelist read successfully.
+     * @retval false The filelist or a nested filelist could not be opened.
+     */
+    bool addFileList(const QString &fileListPath);
+
+    /**
+     * @brief Read filelist text.
+     * @details Same syntax as a filelist file, entries are separated by
+     *          whitespace. Used for paths given on the command line.
+     * @param content Filelist text.
+     * @param baseDir Base directory used for resolving relative paths.
+     * @retval true Text read successfully.
+     * @retval false A nested filelist could not be opened.
+     */
+    bool addText(const QString &content, const QDir &baseDir);
+
+    /**
+     * @brief Drop source files that are not regular files.
+     * @details Every directory that holds a source file is listed once, the
+     *          files are then looked up in those listings. Symbolic links to
+     *          regular files are kept. Dropped files are reported as
+     *          warnings.
+     * @return int Number of dropped source files.
+     */
+    int resolve();
+
+    /**
+     * @brief Get the source files.
+     * @return const QStringList & Absolute paths in filelist order, without
+     *         duplicates.
+     */
+    const QStringList &getSourceFiles() const;
+
+    /**
+     * @brief Get the include directories of `+incdir+` and `-I`.
+     * @return const QStringList & Absolute paths in filelist order.
+     */
+    const QStringList &getIncludeDirs() const;
+
+    /**
+     * @brief Get the defines of `+define+` and `-D`.
+     * @return const QStringList & Defines as `NAME` or `NAME=VALUE`.
+     */
+    const QStringList &getDefines() const;
+
+    /**
+     * @brief Get the library directories of `-y`.
+     * @return const QStringList & Absolute paths in filelist order.
+     */
+    const QStringList &getLibraryDirs() const;
+
+    /**
+     * @brief Get the library files of `-v`.
+     * @return const QStringList & Absolute paths in filelist order.
+     */
+    const QStringList &getLibraryFiles() const;
+
+    /**
+     * @brief Get the library extensions of `+libext+`.
+     * @return const QStringList & Extensions such as `.v`.
+     */
+    const QStringList &getLibraryExtensions() const;
+
+    /**
+     * @brief Get the content as command line arguments.
+     * @details Options come first, then source files. Nested filelists are
+     *          already expanded and paths are never quoted.
+     * @param withSourceFiles Whether source files are included.
+     * @return QStringList Arguments for slang, without a program name.
+     */
+    QStringList toArguments(bool withSourceFiles = true) const;
+
+private:
+    /* Variables for expansion. */
+    QMap<QString, QString> environment;
+    /* Filelists being read, to detect include cycles. */
+    QSet<QString> openFileLists;
+
+    /* Source files in filelist order. */
+    QStringList sourceFiles;
+    /* Source files already added. */
+    QSet<QString> sourceFileSet;
+    /* Include directories. */
+    QStringList includeDirs;
+    /* Defines. */
+    QStringList defines;
+    /* Library directories. */
+    QStringList libraryDirs;
+    /* Library files. */
+    QStringList libraryFiles;
+    /* Library extensions. */
+    QStringList libraryExtensions;
+
+    /**
+     * @brief Read a filelist with a given base directory.
+     * @param fileListPath Path of the filelist.
+     * @param baseDir Base directory used for resolving relative paths.
+     * @retval true Filelist read successfully.
+     * @retval false The filelist or a nested filelist could not be opened.
+     */
+    bool addFileList(const QString &fileListPath, const QDir &baseDir);
+
+    /**
+     * @brief Split filelist text into tokens.
+     * @details Strips line and block comments, honors double quotes and
+     *          expands variables, all in one scan of the text.
+     * @param content Filelist text.
+     * @return QStringList The tokens in order.
+     */
+    QStringList tokenize(const QString &content) const;
+
+    /**
+     * @brief Expand the variable reference starting at a position.
+     * @details Handles `${VAR}`, on return the position is past the
+     *          reference.
+     * @param content Filelist text.
+     * @param position Position of the `$` character.
+     * @return QString The value, or the reference text if unknown.
+     */
+    QString expandVariable(const QString &content, qsizetype &position) const;
+
+    /**
+     * @brief Sort tokens into the option lists.
+     * @param tokens Tokens from tokenize().
+     * @param baseDir Base directory used for resolving relative paths.
+     * @retval true Tokens processed successfully.
+     * @retval false A nested filelist could not be opened.
+     */
+    bool process(const QStringList &tokens, const QDir &baseDir);
+
+    /**
+     * @brief Append plus-separated values of a `+option+a+b` token.
+     * @param values Values after the option prefix.
+     * @param list The list to append to.
+     * @param baseDir Base directory for paths, nullptr for plain values.
+     */
+    static void appendPlusValues(const QString &values, QStringList &list, const QDir *baseDir);
+};
+
+#endif // QSOCFILELIST_H
@@ -1,14 +1,43 @@
 #include "common/qsocgeneratemanager.h"
 
+#include "common/qstaticmetrics.h"
+#include "common/qstatictrace.h"
+
 #include <QCoreApplication>
+#include <QCryptographicHash>
 #include <QDebug>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
 #include <QTextStream>
 
+#include <algorithm>
 #include <fstream>
-#include <iostream>
+#include <set>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+/* Written by cmake/qsocrevision.cmake on every build */
+#if __has_include("qsocrevision.h")
+#include "qsocrevision.h"
+#endif
+#ifndef QSOC_REVISION
+#define QSOC_REVISION ""
+#endif
+
+namespace {
+/* Format of the generated Verilog. Bump it with every change to the emitted
+   code: the revision misses builds without the generated header and changes
+   in sources it does not hash, and a stale fingerprint skips generation. */
+constexpr int kGeneratorFormat = 1;
+
+/* Instances written to Verilog */
+QStaticMetrics::Counter verilogInstances("generate.verilog.instances");
+
+/* Wires written to Verilog */
+QStaticMetrics::Counter verilogNets("generate.verilog.nets");
+} // namespace
 
 QSoCGenerateManager::QSoCGenerateManager(
     QObject            *parent,
@@ -82,140 +111,216 @@ QLLMService *QSoCGenerateManager::getLLMService()
 
 bool QSoCGenerateManager::loadNetlist(const QString &netlistFilePath)
 {
+    const QStaticTrace::Span span("generate.load", netlistFilePath);
     /* Check if the file exists */
     if (!QFile::exists(netlistFilePath)) {
         qCritical() << "Error: Netlist file does not exist:" << netlistFilePath;
         return false;
     }
 
-    /* Open the YAML file */
-    std::ifstream fileStream(netlistFilePath.toStdString());
-    if (!fileStream.is_open()) {
+    /* Hash the file in chunks, it is never held in memory as a whole */
+    QFile netlistFile(netlistFilePath);
+    if (!netlistFile.open(QIODevice::ReadOnly)) {
+        qCritical() << "Error: Unable to open netlist file:" << netlistFilePath;
+        return false;
+    }
+    QCryptographicHash contentHash(QCryptographicHash::Sha256);
+    contentHash.addData(&netlistFile);
+    netlistFile.close();
+
+    /* Invalidate the fingerprint and the graph of the previous netlist */
+    netlistContentHash = contentHash.result();
+    netlistFingerprint.clear();
+    netlistExpanded = false;
+    netlistBuses.clear();
+
+    std::ifstream netlistStream(netlistFilePath.toStdString(), std::ios::binary);
+    if (!netlistStream) {
         qCritical() << "Error: Unable to open netlist file:" << netlistFilePath;
         return false;
     }
 
     try {
-        /* Load YAML content into netlistData */
-        netlistData = YAML::Load(fileStream);
-
-        /* Validate basic netlist structure */
-        if (!netlistData["instance"]) {
-            qCritical() << "Error: Invalid netlist format, missing 'instance' section";
-            return false;
-        }
-
-        if (!netlistData["instance"].IsMap() || netlistData["instance"].size() == 0) {
-            qCritical()
-                << "Error: Invalid netlist format, 'instance' section is empty or not a map";
-            return false;
-        }
-
-        /* Validate net and bus sections if they exist */
-        if ((netlistData["net"] && !netlistData["net"].IsMap())
-            || (netlistData["bus"] && !netlistData["bus"].IsMap())) {
-            qCritical() << "Error: Invalid netlist format, invalid 'net' or 'bus' section";
+        /* Stream instances and explicit nets into the connectivity graph */
+        QSocNetlistLoader loader(netlistGraph);
+        if (!loader.load(netlistStream)) {
+            netlistGraph.clear();
             return false;
         }
+        netlistBuses = loader.getBuses();
 
         qInfo() << "Successfully loaded netlist file:" << netlistFilePath;
         return true;
     } catch (const YAML::Exception &e) {
+        netlistGraph.clear();
         qCritical() << "Error parsing YAML file:" << netlistFilePath << ":" << e.what();
         return false;
     }
 }
 
+void QSoCGenerateManager::buildNetlistGraph()
+{
+    const QStaticTrace::Span span("generate.graph");
+    /* Module ports are looked up once per module, not once per connection */
+    netlistGraph.build([this](const std::string &moduleName) {
+        const QString name = QString::fromStdString(moduleName);
+        if (!moduleManager || !moduleManager->isModuleExist(name)) {
+            return YAML::Node();
+        }
+        return moduleManager->getModuleYaml(name);
+    });
+}
+
+bool QSoCGenerateManager::saveExpandedNetlist(const QString &filePath)
+{
+    const QStaticTrace::Span span("generate.saveNetlist", filePath);
+    /* Check if the netlist is processed */
+    if (netlistGraph.instanceCount() == 0 || !netlistExpanded) {
+        qCritical() << "Error: No processed netlist, call loadNetlist() and processNetlist() "
+                       "first";
+        return false;
+    }
+
+    std::ofstream output(filePath.toStdString(), std::ios::binary | std::ios::trunc);
+    if (!output) {
+        qCritical() << "Error: Failed to open file for writing:" << filePath;
+        return false;
+    }
+
+    /* Emit straight into the file, one entry at a time, without building a node tree */
+    YAML::Emitter emitter(output);
+    emitter << YAML::BeginMap;
+
+    emitter << YAML::Key << "instance" << YAML::Value << YAML::BeginMap;
+    for (int instance = 0; instance < netlistGraph.instanceCount(); instance++) {
+        const QSocNetlistGraph::Instance &instanceData = netlistGraph.instance(instance);
+        emitter << YAML::Key << netlistGraph.symbolName(instanceData.name);
+        emitter << YAML::Value << YAML::BeginMap;
+        if (instanceData.module >= 0) {
+            emitter << YAML::Key << "module" << YAML::Value
+                    << netlistGraph.symbolName(netlistGraph.module(instanceData.module).name);
+        }
+        if (!instanceData.parameters.empty()) {
+            emitter << YAML::Key << "parameter" << YAML::Value << YAML::BeginMap;
+            for (const auto &[paramName, paramValue] : instanceData.parameters) {
+                emitter << YAML::Key << paramName << YAML::Value << paramValue;
+            }
+            emitter << YAML::EndMap;
+        }
+        emitter << YAML::EndMap;
+    }
+    emitter << YAML::EndMap;
+
+    emitter << YAML::Key << "net" << YAML::Value << YAML::BeginMap;
+    for (int net = 0; net < netlistGraph.netCount(); net++) {
+        emitter << YAML::Key << netlistGraph.netName(net) << YAML::Value << YAML::BeginSeq;
+        for (const int pin : netlistGraph.netPins(net)) {
+            const QSocNetlistGraph::Pin &pinData = netlistGraph.pin(pin);
+            emitter << YAML::BeginMap;
+            emitter << YAML::Key << "instance" << YAML::Value
+                    << netlistGraph.symbolName(pinData.instanceName);
+            emitter << YAML::Key << "port" << YAML::Value
+                    << netlistGraph.symbolName(pinData.portName);
+            emitter << YAML::EndMap;
+        }
+        emitter << YAML::EndSeq;
+    }
+    emitter << YAML::EndMap;
+
+    emitter << YAML::EndMap;
+    output << '\n';
+
+    if (!emitter.good() || !output.flush()) {
+        qCritical() << "Error: Failed to write expanded netlist:" << filePath;
+        return false;
+    }
+
+    qInfo() << "Successfully saved expanded netlist:" << filePath;
+    return true;
+}
+
 bool QSoCGenerateManager::processNetlist()
 {
+    const QStaticTrace::Span span("generate.process");
     try {
-        /* Check if netlistData is valid */
-        if (!netlistData["instance"]) {
+        /* Check if the netlist is loaded */
+        if (netlistGraph.instanceCount() == 0) {
             qCritical() << "Error: Invalid netlist data, missing 'instance' section, call "
                            "loadNetlist() first";
             return false;
         }
 
-        /* Create net section if it doesn't exist */
-        if (!netlistData["net"]) {
-            netlistData["net"] = YAML::Node(YAML::NodeType::Map);
+        /* Buses are expanded only once per loaded netlist */
+        if (netlistExpanded) {
+            return true;
         }
+        netlistExpanded = true;
 
         /* Skip if no bus section */
-        if (!netlistData["bus"] || !netlistData["bus"].IsMap() || netlistData["bus"].size() == 0) {
+        if (netlistBuses.empty()) {
             qInfo() << "No bus section found or empty, skipping bus processing";
+            buildNetlistGraph();
             return true;
         }
 
         /* Process each bus type (e.g., biu_bus) */
-        for (const auto &busTypePair : netlistData["bus"]) {
+        for (const QSocNetlistLoader::Bus &bus : netlistBuses) {
             try {
                 /* Get bus type name */
-                if (!busTypePair.first.IsScalar()) {
-                    qWarning() << "Warning: Bus type name is not a scalar, skipping";
-                    continue;
-                }
-                const std::string busTypeName = busTypePair.first.as<std::string>();
+                const std::string &busTypeName = bus.name;
                 qInfo() << "Processing bus:" << busTypeName.c_str();
 
                 /* Get bus connections (should be a map) */
-                if (!busTypePair.second.IsMap()) {
+                if (!bus.valid) {
                     qWarning() << "Warning: Bus" << busTypeName.c_str() << "is not a map, skipping";
                     continue;
                 }
-                const YAML::Node &busConnections = busTypePair.second;
-                qInfo() << "Found" << busConnections.size() << "connections for bus"
+                qInfo() << "Found" << bus.connections.size() << "connections for bus"
                         << busTypeName.c_str();
 
-                /* Collect all valid connections */
+                /* Collect all valid connections with the signal mapping of each candidate
+                   bus interface: exact name, without pad_ prefix, with pad_ prefix */
                 struct Connection
                 {
-                    std::string instanceName;
-                    std::string portName;
-                    std::string moduleName;
-                    std::string busType;
+                    std::string                                               instanceName;
+                    std::vector<std::unordered_map<std::string, std::string>> mappings;
                 };
 
                 std::vector<Connection> validConnections;
                 std::string busType; // Will be determined from the first valid connection
 
                 /* Step 1: Validate all connections first */
-                for (const auto &connectionPair : busConnections) {
+                for (const QSocNetlistLoader::BusConnection &busConnection : bus.connections) {
                     try {
-                        if (!connectionPair.first.IsScalar()) {
-                            qWarning() << "Warning: Instance name is not a scalar, skipping";
-                            continue;
-                        }
-                        const std::string instanceName = connectionPair.first.as<std::string>();
-
-                        if (!connectionPair.second.IsMap() || !connectionPair.second["port"]
-                            || !connectionPair.second["port"].IsScalar()) {
+                        const std::string &instanceName = busConnection.instanceName;
+                        const std::string &portName     = busConnection.portName;
+                        if (portName.empty()) {
                             qWarning() << "Warning: Invalid port specification for instance"
                                        << instanceName.c_str();
                             continue;
                         }
-                        const std::string portName = connectionPair.second["port"].as<std::string>();
 
                         qInfo() << "Validating connection:" << instanceName.c_str() << "."
                                 << portName.c_str();
 
                         /* Validate the instance exists */
-                        if (!netlistData["instance"][instanceName]) {
+                        const int instance = netlistGraph.findInstance(instanceName);
+                        if (instance < 0) {
                             qWarning() << "Warning: Instance" << instanceName.c_str()
                                        << "not found in netlist";
                             continue;
                         }
 
                         /* Check for module name */
-                        if (!netlistData["instance"][instanceName]["module"]
-                            || !netlistData["instance"][instanceName]["module"].IsScalar()) {
+                        const int module = netlistGraph.instance(instance).module;
+                        if (module < 0) {
                             qWarning()
                                 << "Warning: Invalid module for instance" << instanceName.c_str();
                             continue;
                         }
 
-                        const std::string moduleName
-                            = netlistData["instance"][instanceName]["module"].as<std::string>();
+                        const std::string &moduleName = netlistGraph.symbolName(
+                            netlistGraph.module(module).name);
 
                         /* Check if module exists */
                         if (!moduleManager
@@ -240,49 +345,33 @@ bool QSoCGenerateManager::processNetlist()
                             continue;
                         }
 
-                        /* Try exact port name */
-                        bool portFound = false;
+                        /* Candidate bus interfaces: exact name, without or with pad_ prefix */
+                        std::vector<YAML::Node> busInterfaces;
                         if (moduleData["bus"][portName]) {
-                            portFound = true;
+                            busInterfaces.push_back(moduleData["bus"][portName]);
                         }
-                        /* Try with pad_ prefix if not found */
-                        else if (
-                            portName.compare(0, 4, "pad_") == 0
+                        if (portName.compare(0, 4, "pad_") == 0
                             && moduleData["bus"][portName.substr(4)]) {
-                            portFound = true;
+                            busInterfaces.push_back(moduleData["bus"][portName.substr(4)]);
                         }
-                        /* Try adding pad_ prefix */
-                        else if (moduleData["bus"]["pad_" + portName]) {
-                            portFound = true;
+                        if (moduleData["bus"]["pad_" + portName]) {
+                            busInterfaces.push_back(moduleData["bus"]["pad_" + portName]);
                         }
-
-                        if (!portFound) {
+                        if (busInterfaces.empty()) {
                             qWarning() << "Warning: Port" << portName.c_str()
                                        << "not found in module" << moduleName.c_str();
                             continue;
                         }
 
-                        /* Check bus type */
+                        /* Check bus type, the first candidate that declares one */
                         std::string currentBusType;
-
-                        /* Try to find bus type declaration in module */
-                        if (moduleData["bus"][portName] && moduleData["bus"][portName]["bus"]
-                            && moduleData["bus"][portName]["bus"].IsScalar()) {
-                            currentBusType = moduleData["bus"][portName]["bus"].as<std::string>();
-                        } else if (
-                            portName.compare(0, 4, "pad_") == 0
-                            && moduleData["bus"][portName.substr(4)]
-                            && moduleData["bus"][portName.substr(4)]["bus"]
-                            && moduleData["bus"][portName.substr(4)]["bus"].IsScalar()) {
-                            currentBusType
-                                = moduleData["bus"][portName.substr(4)]["bus"].as<std::string>();
-                        } else if (
-                            moduleData["bus"]["pad_" + portName]
-                            && moduleData["bus"]["pad_" + portName]["bus"]
-                            && moduleData["bus"]["pad_" + portName]["bus"].IsScalar()) {
-                            currentBusType
-                                = moduleData["bus"]["pad_" + portName]["bus"].as<std::string>();
-                        } else {
+                        for (const YAML::Node &busInterface : busInterfaces) {
+                            if (busInterface["bus"] && busInterface["bus"].IsScalar()) {
+                                currentBusType = busInterface["bus"].as<std::string>();
+                                break;
+                            }
+                        }
+                        if (currentBusType.empty()) {
                             qWarning() << "Warning: No bus type for port" << portName.c_str();
                             continue;
                         }
@@ -307,13 +396,26 @@ bool QSoCGenerateManager::processNetlist()
                             continue;
                         }
 
-                        /* Add to valid connections */
+                        /* Read the signal to port mappings once per connection, signals
+                           are looked up in each candidate in turn */
                         Connection conn;
                         conn.instanceName = instanceName;
-                        conn.portName     = portName;
-                        conn.moduleName   = moduleName;
-                        conn.busType      = currentBusType;
-                        validConnections.push_back(conn);
+                        for (const YAML::Node &busInterface : busInterfaces) {
+                            std::unordered_map<std::string, std::string> &mapping
+                                = conn.mappings.emplace_back();
+                            if (!busInterface["mapping"] || !busInterface["mapping"].IsMap()) {
+                                continue;
+                            }
+                            for (const auto &mappingPair : busInterface["mapping"]) {
+                                if (mappingPair.first.IsScalar()
+                                    && mappingPair.second.IsScalar()) {
+                                    mapping.emplace(
+                                        mappingPair.first.as<std::string>(),
+                                        mappingPair.second.as<std::string>());
+                                }
+                            }
+                        }
+                        validConnections.push_back(std::move(conn));
 
                     } catch (const YAML::Exception &e) {
                         qWarning() << "YAML exception validating connection:" << e.what();
@@ -362,82 +464,36 @@ bool QSoCGenerateManager::processNetlist()
 
                     qInfo() << "Creating net for bus signal:" << signalName.c_str();
 
-                    /* Create a net for this signal as a sequence */
-                    netlistData["net"][netName] = YAML::Node(YAML::NodeType::Sequence);
+                    /* A bus net replaces a net of the same name in place */
+                    int net = netlistGraph.findNet(netName);
+                    if (net >= 0) {
+                        netlistGraph.clearNet(net);
+                    }
 
-                    /* Add each connection to this net */
+                    /* Connect every instance that maps this signal */
+                    bool connected = false;
                     for (const Connection &conn : validConnections) {
-                        try {
-                            /* Get module data again */
-                            YAML::Node moduleData = moduleManager->getModuleYaml(
-                                QString::fromStdString(conn.moduleName));
-
-                            /* Get port mapping */
-                            std::string mappedPortName;
-                            bool        mappingFound = false;
-
-                            /* Try with the exact port name */
-                            if (moduleData["bus"][conn.portName]
-                                && moduleData["bus"][conn.portName]["mapping"]
-                                && moduleData["bus"][conn.portName]["mapping"].IsMap()
-                                && moduleData["bus"][conn.portName]["mapping"][signalName]
-                                && moduleData["bus"][conn.portName]["mapping"][signalName]
-                                       .IsScalar()) {
-                                mappedPortName
-                                    = moduleData["bus"][conn.portName]["mapping"][signalName]
-                                          .as<std::string>();
-                                mappingFound = true;
+                        const std::string *mappedPortName = nullptr;
+                        for (const auto &mapping : conn.mappings) {
+                            const auto mappingIter = mapping.find(signalName);
+                            if (mappingIter != mapping.end()) {
+                                mappedPortName = &mappingIter->second;
+                                break;
                             }
-                            /* Try with the stripped port name (without pad_ prefix) */
-                            else if (
-                                conn.portName.compare(0, 4, "pad_") == 0
-                                && moduleData["bus"][conn.portName.substr(4)]
-                                && moduleData["bus"][conn.portName.substr(4)]["mapping"]
-                                && moduleData["bus"][conn.portName.substr(4)]["mapping"].IsMap()
-                                && moduleData["bus"][conn.portName.substr(4)]["mapping"][signalName]
-                                && moduleData["bus"][conn.portName.substr(4)]["mapping"][signalName]
-                                       .IsScalar()) {
-                                mappedPortName = moduleData["bus"][conn.portName.substr(4)]
-                                                           ["mapping"][signalName]
-                                                               .as<std::string>();
-                                mappingFound = true;
-                            }
-                            /* Try with prefixed port name (with pad_ prefix) */
-                            else if (
-                                moduleData["bus"]["pad_" + conn.portName]
-                                && moduleData["bus"]["pad_" + conn.portName]["mapping"]
-                                && moduleData["bus"]["pad_" + conn.portName]["mapping"].IsMap()
-                                && moduleData["bus"]["pad_" + conn.portName]["mapping"][signalName]
-                                && moduleData["bus"]["pad_" + conn.portName]["mapping"][signalName]
-                                       .IsScalar()) {
-                                mappedPortName = moduleData["bus"]["pad_" + conn.portName]
-                                                           ["mapping"][signalName]
-                                                               .as<std::string>();
-                                mappingFound = true;
-                            }
-
-                            if (!mappingFound || mappedPortName.empty()) {
-                                continue; // Skip this signal for this connection
-                            }
-
-                            /* Create a connection entry in the sequence format */
-                            YAML::Node connectionNode;
-                            connectionNode["instance"] = conn.instanceName;
-                            connectionNode["port"]     = mappedPortName;
-                            netlistData["net"][netName].push_back(connectionNode);
-
-                        } catch (const YAML::Exception &e) {
-                            qWarning() << "YAML exception adding connection to net:" << e.what();
-                            continue;
-                        } catch (const std::exception &e) {
-                            qWarning() << "Exception adding connection to net:" << e.what();
-                            continue;
                         }
+                        if (!mappedPortName || mappedPortName->empty()) {
+                            continue; // Skip this signal for this connection
+                        }
+                        if (net < 0) {
+                            net = netlistGraph.addNet(netName);
+                        }
+                        netlistGraph.addPin(net, conn.instanceName, *mappedPortName);
+                        connected = true;
                     }
 
                     /* If no connections were added to this net, remove it */
-                    if (netlistData["net"][netName].size() == 0) {
-                        netlistData["net"].remove(netName);
+                    if (net >= 0 && !connected) {
+                        netlistGraph.removeNet(net);
                     }
                 }
 
@@ -450,11 +506,10 @@ bool QSoCGenerateManager::processNetlist()
             }
         }
 
-        /* Clean up by removing the bus section */
-        netlistData.remove("bus");
+        /* Resolve module ports and build the adjacency of the expanded netlist */
+        buildNetlistGraph();
 
         qInfo() << "Netlist processed successfully";
-        std::cout << "Expanded Netlist:\n" << netlistData << std::endl;
         return true;
     } catch (const YAML::Exception &e) {
         qCritical() << "YAML exception in processNetlist:" << e.what();
@@ -468,23 +523,181 @@ bool QSoCGenerateManager::processNetlist()
     }
 }
 
-bool QSoCGenerateManager::generateVerilog(const QString &outputFileName)
+bool QSoCGenerateManager::checkNetlist(YAML::Node &report)
 {
-    /* Check if netlistData is valid */
-    if (!netlistData["instance"]) {
+    const QStaticTrace::Span span("generate.check");
+    /* Check if the netlist is loaded */
+    if (netlistGraph.instanceCount() == 0) {
         qCritical() << "Error: Invalid netlist data, missing 'instance' section, make sure "
                        "loadNetlist() and processNetlist() have been called";
         return false;
     }
 
-    if (!netlistData["instance"].IsMap() || netlistData["instance"].size() == 0) {
-        qCritical() << "Error: Invalid netlist data, 'instance' section is empty or not a map";
+    /* Resolve module ports if processNetlist() did not */
+    if (!netlistGraph.isBuilt()) {
+        buildNetlistGraph();
+    }
+
+    QSocNetlistChecker checker(netlistGraph);
+    checker.run();
+    report = checker.getReport();
+
+    return checker.getErrorCount() == 0;
+}
+
+const QSocNetlistGraph &QSoCGenerateManager::getNetlistGraph()
+{
+    if (!netlistGraph.isBuilt()) {
+        buildNetlistGraph();
+    }
+    return netlistGraph;
+}
+
+QString QSoCGenerateManager::getNetlistFingerprint()
+{
+    /* Reuse the fingerprint computed for the current netlist */
+    if (!netlistFingerprint.isEmpty()) {
+        return netlistFingerprint;
+    }
+
+    if (netlistContentHash.isEmpty() || netlistGraph.instanceCount() == 0) {
+        return QString();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+
+    /* Generator identity, a new generator may emit different code. The
+       version alone misses builds in between releases, so the source
+       revision and the output format are part of it too. */
+    hash.addData(QCoreApplication::applicationName().toUtf8());
+    hash.addData(QCoreApplication::applicationVersion().toUtf8());
+    hash.addData(QByteArray(QSOC_REVISION));
+    hash.addData(QByteArray::number(kGeneratorFormat));
+
+    /* Raw netlist content */
+    hash.addData(netlistContentHash);
+
+    /* Collect referenced modules in a stable order */
+    std::set<std::string> moduleNames;
+    for (int module = 0; module < netlistGraph.moduleCount(); module++) {
+        moduleNames.insert(netlistGraph.symbolName(netlistGraph.module(module).name));
+    }
+
+    /* Hash module definitions and collect the buses they reference */
+    std::set<std::string> busNames;
+    for (const std::string &moduleName : moduleNames) {
+        hash.addData(QByteArray::fromStdString(moduleName));
+        const QString qModuleName = QString::fromStdString(moduleName);
+        if (!moduleManager || !moduleManager->isModuleExist(qModuleName)) {
+            /* A missing module is part of the state, keep it distinct */
+            hash.addData(QByteArray("<missing>"));
+            continue;
+        }
+        const YAML::Node  moduleData = moduleManager->getModuleYaml(qModuleName);
+        std::stringstream moduleStream;
+        moduleStream << moduleData;
+        hash.addData(QByteArray::fromStdString(moduleStream.str()));
+
+        if (moduleData["bus"] && moduleData["bus"].IsMap()) {
+            for (const auto &busPair : moduleData["bus"]) {
+                if (busPair.second.IsMap() && busPair.second["bus"]
+                    && busPair.second["bus"].IsScalar()) {
+                    busNames.insert(busPair.second["bus"].as<std::string>());
+                }
+            }
+        }
+    }
+
+    /* Hash bus definitions */
+    for (const std::string &busName : busNames) {
+        hash.addData(QByteArray::fromStdString(busName));
+        const QString qBusName = QString::fromStdString(busName);
+        if (!busManager || !busManager->isBusExist(qBusName)) {
+            hash.addData(QByteArray("<missing>"));
+            continue;
+        }
+        std::stringstream busStream;
+        busStream << busManager->getBusYaml(qBusName);
+        hash.addData(QByteArray::fromStdString(busStream.str()));
+    }
+
+    netlistFingerprint = QString::fromLatin1(hash.result().toHex());
+    return netlistFingerprint;
+}
+
+bool QSoCGenerateManager::isVerilogUpToDate(const QString &outputFileName)
+{
+    if (!projectManager) {
+        return false;
+    }
+
+    /* Generated file must still exist */
+    const QString outputFilePath
+        = QDir(projectManager->getOutputPath()).filePath(outputFileName + ".v");
+    if (!QFile::exists(outputFilePath)) {
+        return false;
+    }
+
+    /* Compare with the fingerprint recorded at the last generation */
+    QFile fingerprintFile(getFingerprintFilePath(outputFileName));
+    if (!fingerprintFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return false;
+    }
+    const QString recordedFingerprint = QString::fromLatin1(fingerprintFile.readAll()).trimmed();
+    fingerprintFile.close();
+
+    const QString currentFingerprint = getNetlistFingerprint();
+    return !currentFingerprint.isEmpty() && recordedFingerprint == currentFingerprint;
+}
+
+QString QSoCGenerateManager::getFingerprintFilePath(const QString &outputFileName)
+{
+    return QDir(projectManager->getOutputPath()).filePath("." + outputFileName + ".v.fingerprint");
+}
+
+bool QSoCGenerateManager::writeFileIfChanged(
+    const QString &filePath, const QByteArray &content, bool *written)
+{
+    if (written) {
+        *written = false;
+    }
+
+    /* Skip the write if the file already holds the same content */
+    QFile existingFile(filePath);
+    if (existingFile.exists() && existingFile.size() == content.size()
+        && existingFile.open(QIODevice::ReadOnly)) {
+        const QByteArray existingContent = existingFile.readAll();
+        existingFile.close();
+        if (existingContent == content) {
+            return true;
+        }
+    }
+
+    QFile outputFile(filePath);
+    if (!outputFile.open(QIODevice::WriteOnly)) {
+        qCritical() << "Error: Failed to open output file for writing:" << filePath;
+        return false;
+    }
+    if (outputFile.write(content) != content.size()) {
+        qCritical() << "Error: Failed to write output file:" << filePath;
+        outputFile.close();
         return false;
     }
+    outputFile.close();
 
-    /* Check if net section exists and has valid format if present */
-    if (netlistData["net"] && !netlistData["net"].IsMap()) {
-        qCritical() << "Error: Invalid netlist data, 'net' section is not a map";
+    if (written) {
+        *written = true;
+    }
+    return true;
+}
+
+bool QSoCGenerateManager::generateVerilog(const QString &outputFileName)
+{
+    const QStaticTrace::Span span("generate.verilog", outputFileName);
+    /* Check if the netlist is loaded */
+    if (netlistGraph.instanceCount() == 0) {
+        qCritical() << "Error: Invalid netlist data, missing 'instance' section, make sure "
+                       "loadNetlist() and processNetlist() have been called";
         return false;
     }
 
@@ -499,18 +712,21 @@ bool QSoCGenerateManager::generateVerilog(const QString &outputFileName)
         return false;
     }
 
+    /* Resolve module ports if processNetlist() did not */
+    if (!netlistGraph.isBuilt()) {
+        buildNetlistGraph();
+    }
+
     /* Prepare output file path */
     const QString outputFilePath
         = QDir(projectManager->getOutputPath()).filePath(outputFileName + ".v");
 
-    /* Open output file for writing */
-    QFile outputFile(outputFilePath);
-    if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        qCritical() << "Error: Failed to open output file for writing:" << outputFilePath;
-        return false;
-    }
+    /* Compute the fingerprint before processing state is consumed */
+    const QString fingerprint = getNetlistFingerprint();
 
-    QTextStream out(&outputFile);
+    /* Generate into memory, the file is only touched if the content changed */
+    QString     outputContent;
+    QTextStream out(&outputContent);
 
     /* Generate file header */
     out << "/**\n";
@@ -539,246 +755,134 @@ bool QSoCGenerateManager::generateVerilog(const QString &outputFileName)
     }
     out << ");\n\n";
 
-    /* Build a mapping of all connections for each instance and port */
-    QMap<QString, QMap<QString, QString>> instancePortConnections;
+    /* Nets that got a wire declaration, only those are connected to instances */
+    std::vector<char> netDeclared(netlistGraph.netCount(), 0);
 
     /* Generate wire declarations FIRST */
-    if (netlistData["net"]) {
-        if (!netlistData["net"].IsMap()) {
-            qWarning() << "Warning: 'net' section is not a map, skipping wire declarations";
-        } else if (netlistData["net"].size() == 0) {
-            qWarning() << "Warning: 'net' section is empty, no wire declarations to generate";
-        } else {
-            for (auto netIter = netlistData["net"].begin(); netIter != netlistData["net"].end();
-                 ++netIter) {
-                if (!netIter->first.IsScalar()) {
-                    qWarning() << "Warning: Invalid net name, skipping";
-                    continue;
-                }
-
-                const QString netName = QString::fromStdString(netIter->first.as<std::string>());
-
-                if (!netIter->second) {
-                    qWarning() << "Warning: Net" << netName << "has null data, skipping";
-                    continue;
-                }
-
-                /* Net connections should be a sequence of instance-port pairs */
-                if (!netIter->second.IsSequence()) {
-                    qWarning() << "Warning: Net" << netName << "is not a sequence, skipping";
-                    continue;
-                }
-
-                const YAML::Node &connections = netIter->second;
-
-                if (connections.size() == 0) {
-                    qWarning() << "Warning: Net" << netName << "has no connections, skipping";
-                    continue;
-                }
-
-                /* Determine wire type based on the first connection */
-                /* In a real implementation, this would need validation across all connections */
-                const YAML::Node &firstConnection = connections[0];
-
-                if (!firstConnection.IsMap()) {
-                    qWarning() << "Warning: First connection of net" << netName
-                               << "is not a map, skipping";
-                    continue;
-                }
-
-                if (!firstConnection["instance"] || !firstConnection["instance"].IsScalar()
-                    || !firstConnection["port"] || !firstConnection["port"].IsScalar()) {
-                    qWarning() << "Warning: Invalid connection data in net" << netName
-                               << ", skipping";
-                    continue;
-                }
-
-                const QString instanceName = QString::fromStdString(
-                    firstConnection["instance"].as<std::string>());
-                const QString portName = QString::fromStdString(
-                    firstConnection["port"].as<std::string>());
-
-                /* Check if instance exists */
-                if (!netlistData["instance"]
-                    || !netlistData["instance"][instanceName.toStdString()]) {
-                    qWarning() << "Warning: Instance" << instanceName << "referenced in net"
-                               << netName << "not found in netlist, skipping";
-                    continue;
-                }
-
-                /* Get module name for this instance */
-                if (!netlistData["instance"][instanceName.toStdString()]["module"]
-                    || !netlistData["instance"][instanceName.toStdString()]["module"].IsScalar()) {
-                    qWarning() << "Warning: Invalid module name for instance" << instanceName
-                               << ", skipping";
-                    continue;
-                }
-
-                const QString moduleName = QString::fromStdString(
-                    netlistData["instance"][instanceName.toStdString()]["module"].as<std::string>());
-
-                /* Get port type from module definition */
-                if (!moduleManager) {
-                    qWarning() << "Warning: Module manager is null, skipping wire declaration for"
-                               << netName;
-                    continue;
-                }
-
-                if (!moduleManager->isModuleExist(moduleName)) {
-                    qWarning() << "Warning: Module" << moduleName
-                               << "not found in module library, skipping";
-                    continue;
-                }
-
-                YAML::Node moduleData = moduleManager->getModuleYaml(moduleName);
-                if (!moduleData) {
-                    qWarning() << "Warning: Failed to get module data for" << moduleName
-                               << ", skipping";
-                    continue;
-                }
-
-                if (!moduleData["port"]) {
-                    qWarning() << "Warning: Module" << moduleName
-                               << "has no port section, skipping";
-                    continue;
-                }
-
-                if (!moduleData["port"].IsMap()) {
-                    qWarning() << "Warning: Port section of module" << moduleName
-                               << "is not a map, skipping";
-                    continue;
-                }
-
-                if (!moduleData["port"][portName.toStdString()]) {
-                    qWarning() << "Warning: Port" << portName << "not found in module" << moduleName
-                               << ", skipping";
-                    continue;
-                }
-
-                const YAML::Node &portData = moduleData["port"][portName.toStdString()];
-                QString           wireType = "logic"; // Default type
-
-                if (portData["type"] && portData["type"].IsScalar()) {
-                    wireType = QString::fromStdString(portData["type"].as<std::string>());
-                }
+    if (netlistGraph.netCount() == 0) {
+        qWarning() << "Warning: No nets in netlist, no wire declarations will be generated";
+    }
+    for (int net = 0; net < netlistGraph.netCount(); net++) {
+        const QString netName = QString::fromStdString(netlistGraph.netName(net));
+        const auto    pins    = netlistGraph.netPins(net);
 
-                QString wireWidth = "";
-                if (portData["width"] && portData["width"].IsScalar()) {
-                    int width = portData["width"].as<int>();
-                    if (width > 1) {
-                        wireWidth = QString("[%1:0]").arg(width - 1);
-                    }
-                }
+        if (pins.empty()) {
+            qWarning() << "Warning: Net" << netName << "has no connections, skipping";
+            continue;
+        }
 
-                /* Generate wire declaration */
-                out << "    wire " << wireType << wireWidth << " " << netName << ";\n";
+        /* Determine wire type based on the first connection */
+        /* In a real implementation, this would need validation across all connections */
+        const QSocNetlistGraph::Pin &firstPin     = netlistGraph.pin(pins.front());
+        const QString                instanceName = QString::fromStdString(
+            netlistGraph.symbolName(firstPin.instanceName));
+        const QString portName = QString::fromStdString(netlistGraph.symbolName(firstPin.portName));
+
+        /* Check if instance exists */
+        if (firstPin.instance < 0) {
+            qWarning() << "Warning: Instance" << instanceName << "referenced in net" << netName
+                       << "not found in netlist, skipping";
+            continue;
+        }
 
-                /* Build port connection mapping for each instance */
-                for (size_t i = 0; i < connections.size(); i++) {
-                    const YAML::Node &conn = connections[i];
-                    if (!conn.IsMap() || !conn["instance"] || !conn["instance"].IsScalar()
-                        || !conn["port"] || !conn["port"].IsScalar()) {
-                        continue;
-                    }
+        /* Get module for this instance */
+        const int module = netlistGraph.instance(firstPin.instance).module;
+        if (module < 0) {
+            qWarning() << "Warning: Invalid module name for instance" << instanceName
+                       << ", skipping";
+            continue;
+        }
 
-                    QString connInstance = QString::fromStdString(
-                        conn["instance"].as<std::string>());
-                    QString connPort = QString::fromStdString(conn["port"].as<std::string>());
+        const QSocNetlistGraph::Module &moduleData = netlistGraph.module(module);
+        const QString moduleName = QString::fromStdString(netlistGraph.symbolName(moduleData.name));
 
-                    /* Add to the connection map */
-                    if (!instancePortConnections.contains(connInstance)) {
-                        instancePortConnections[connInstance] = QMap<QString, QString>();
-                    }
-                    instancePortConnections[connInstance][connPort] = netName;
-                }
-            }
+        if (!moduleData.found) {
+            qWarning() << "Warning: Module" << moduleName
+                       << "not found in module library, skipping";
+            continue;
         }
-    } else {
-        qWarning()
-            << "Warning: No 'net' section in netlist, no wire declarations will be generated";
-    }
 
-    /* Generate instance declarations after wire declarations */
-    for (auto instanceIter = netlistData["instance"].begin();
-         instanceIter != netlistData["instance"].end();
-         ++instanceIter) {
-        if (!instanceIter->first.IsScalar()) {
-            qWarning() << "Warning: Invalid instance name, skipping";
+        /* Get port type from module definition */
+        const QSocNetlistGraph::Port *portData = netlistGraph.pinPort(pins.front());
+        if (!portData) {
+            qWarning() << "Warning: Port" << portName << "not found in module" << moduleName
+                       << ", skipping";
             continue;
         }
 
-        const QString instanceName = QString::fromStdString(instanceIter->first.as<std::string>());
+        /* Port types are folded with the parameters of the connected instance */
+        QString wireType = "logic"; // Default type
+        if (!netlistGraph.pinType(pins.front()).empty()) {
+            wireType = QString::fromStdString(netlistGraph.pinType(pins.front()));
+        }
 
-        if (!instanceIter->second || !instanceIter->second.IsMap()) {
-            qWarning() << "Warning: Invalid instance data for" << instanceName
-                       << "(not a map), skipping";
-            continue;
+        QString wireWidth = "";
+        if (portData->explicitWidth && portData->width > 1) {
+            wireWidth = QString("[%1:0]").arg(portData->width - 1);
         }
 
-        const YAML::Node &instanceData = instanceIter->second;
+        /* Generate wire declaration */
+        out << "    wire " << wireType << wireWidth << " " << netName << ";\n";
+        netDeclared[net] = 1;
+        verilogNets.add();
+    }
 
-        if (!instanceData["module"] || !instanceData["module"].IsScalar()) {
+    /* Generate instance declarations after wire declarations */
+    for (int instance = 0; instance < netlistGraph.instanceCount(); instance++) {
+        const QSocNetlistGraph::Instance &instanceData = netlistGraph.instance(instance);
+        const QString                     instanceName = QString::fromStdString(
+            netlistGraph.symbolName(instanceData.name));
+
+        if (instanceData.module < 0) {
             qWarning() << "Warning: Invalid module name for instance" << instanceName;
             continue;
         }
 
-        const QString moduleName = QString::fromStdString(instanceData["module"].as<std::string>());
+        const QString moduleName = QString::fromStdString(
+            netlistGraph.symbolName(netlistGraph.module(instanceData.module).name));
 
         /* Generate instance declaration with parameters if any */
         out << "    " << moduleName << " ";
 
         /* Add parameters if they exist */
-        if (instanceData["parameter"]) {
-            if (!instanceData["parameter"].IsMap()) {
-                qWarning() << "Warning: 'parameter' section for instance" << instanceName
-                           << "is not a map, ignoring";
-            } else if (instanceData["parameter"].size() == 0) {
-                qWarning() << "Warning: 'parameter' section for instance" << instanceName
-                           << "is empty, ignoring";
-            } else {
-                out << "#(\n";
-
-                QStringList paramList;
-                for (auto paramIter = instanceData["parameter"].begin();
-                     paramIter != instanceData["parameter"].end();
-                     ++paramIter) {
-                    if (!paramIter->first.IsScalar()) {
-                        qWarning() << "Warning: Invalid parameter name in instance" << instanceName;
-                        continue;
-                    }
-
-                    if (!paramIter->second.IsScalar()) {
-                        qWarning()
-                            << "Warning: Parameter"
-                            << QString::fromStdString(paramIter->first.as<std::string>())
-                            << "in instance" << instanceName << "has a non-scalar value, skipping";
-                        continue;
-                    }
+        if (!instanceData.parameters.empty()) {
+            out << "#(\n";
+
+            QStringList paramList;
+            for (const auto &[paramName, paramValue] : instanceData.parameters) {
+                paramList.append(QString("        .%1(%2)")
+                                     .arg(QString::fromStdString(paramName))
+                                     .arg(QString::fromStdString(paramValue)));
+            }
 
-                    const QString paramName = QString::fromStdString(
-                        paramIter->first.as<std::string>());
-                    const QString paramValue = QString::fromStdString(
-                        paramIter->second.as<std::string>());
+            out << paramList.join(",\n") << "\n    ) ";
+        }
 
-                    paramList.append(QString("        .%1(%2)").arg(paramName).arg(paramValue));
-                }
+        out << instanceName << " (\n";
 
-                out << paramList.join(",\n") << "\n    ) ";
+        /* Collect the port connections of this instance, sorted by port name */
+        std::vector<std::pair<const std::string *, int>> portNets;
+        for (const int pin : netlistGraph.instancePins(instance)) {
+            const QSocNetlistGraph::Pin &pinData = netlistGraph.pin(pin);
+            if (netDeclared[pinData.net]) {
+                portNets.emplace_back(&netlistGraph.symbolName(pinData.portName), pinData.net);
             }
         }
+        std::stable_sort(portNets.begin(), portNets.end(), [](const auto &lhs, const auto &rhs) {
+            return *lhs.first < *rhs.first;
+        });
 
-        out << instanceName << " (\n";
-
-        /* Get the port connections for this instance */
         QStringList portConnections;
-
-        if (instancePortConnections.contains(instanceName)) {
-            QMap<QString, QString>        &portMap = instancePortConnections[instanceName];
-            QMapIterator<QString, QString> it(portMap);
-            while (it.hasNext()) {
-                it.next();
-                portConnections.append(QString("        .%1(%2)").arg(it.key()).arg(it.value()));
+        for (size_t index = 0; index < portNets.size(); index++) {
+            /* A port connected to several nets keeps the last one */
+            if (index + 1 < portNets.size()
+                && *portNets[index + 1].first == *portNets[index].first) {
+                continue;
             }
+            portConnections.append(QString("        .%1(%2)")
+                                       .arg(QString::fromStdString(*portNets[index].first))
+                                       .arg(QString::fromStdString(
+                                           netlistGraph.netName(portNets[index].second))));
         }
 
         if (portConnections.isEmpty()) {
@@ -788,13 +892,31 @@ bool QSoCGenerateManager::generateVerilog(const QString &outputFileName)
         }
 
         out << "    );\n\n";
+        verilogInstances.add();
     }
 
     /* Close module */
     out << "endmodule\n";
+    out.flush();
 
-    outputFile.close();
-    qInfo() << "Successfully generated Verilog file:" << outputFilePath;
+    /* Write output file if its content changed */
+    bool outputWritten = false;
+    if (!writeFileIfChanged(outputFilePath, outputContent.toUtf8(), &outputWritten)) {
+        return false;
+    }
+
+    /* Record the fingerprint of the inputs for the next incremental run */
+    if (!fingerprint.isEmpty()
+        && !writeFileIfChanged(
+            getFingerprintFilePath(outputFileName), fingerprint.toLatin1() + "\n", nullptr)) {
+        qWarning() << "Warning: Failed to record fingerprint for" << outputFilePath;
+    }
+
+    if (outputWritten) {
+        qInfo() << "Successfully generated Verilog file:" << outputFilePath;
+    } else {
+        qInfo() << "Verilog file content unchanged, not rewritten:" << outputFilePath;
+    }
 
     return true;
-}
\ No newline at end of file
+}
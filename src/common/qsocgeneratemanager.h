@@ -4,8 +4,12 @@
 #include "common/qllmservice.h"
 #include "common/qsocbusmanager.h"
 #include "common/qsocmodulemanager.h"
+#include "common/qsocnetlistchecker.h"
+#include "common/qsocnetlistgraph.h"
+#include "common/qsocnetlistloader.h"
 #include "common/qsocprojectmanager.h"
 
+#include <QByteArray>
 #include <QObject>
 #include <QString>
 #include <QStringList>
@@ -99,7 +103,9 @@ public slots:
 
     /**
      * @brief Load netlist file.
-     * @details Loads a netlist file and creates an in-memory representation.
+     * @details Streams a netlist file into the connectivity graph. The file is
+     *          parsed event by event, so memory use is bounded by the size of
+     *          the graph rather than by the size of the file.
      * @param netlistFilePath Path to the netlist file.
      * @retval true Netlist file loaded successfully.
      * @retval false Failed to load netlist file.
@@ -114,6 +120,66 @@ public slots:
      */
     bool processNetlist();
 
+    /**
+     * @brief Save the expanded netlist to a file.
+     * @details Writes the instances and nets of the processed netlist,
+     *          including the nets created by bus expansion, as YAML. The file
+     *          is emitted entry by entry. Call this after processNetlist().
+     * @param filePath Path of the file to write.
+     * @retval true Expanded netlist saved successfully.
+     * @retval false No processed netlist or failed to write the file.
+     */
+    bool saveExpandedNetlist(const QString &filePath);
+
+    /**
+     * @brief Run design-rule checks on the processed netlist.
+     * @details Checks the connectivity graph for unresolved instances, modules
+     *          and ports, ports connected to several nets, nets with multiple
+     *          drivers or conflicting directions, undriven nets and width
+     *          mismatches. Nets are checked in parallel. Call this after
+     *          processNetlist().
+     * @param report Set to the structured report, see
+     *        QSocNetlistChecker::getReport().
+     * @retval true No errors were found, warnings are allowed.
+     * @retval false Errors were found or no netlist is loaded.
+     */
+    bool checkNetlist(YAML::Node &report);
+
+    /**
+     * @brief Get the connectivity graph of the loaded netlist.
+     * @details Builds the graph first if the netlist changed since the last
+     *          build. The graph is valid until the next loadNetlist() or
+     *          processNetlist().
+     * @return const QSocNetlistGraph & The connectivity graph, empty if no
+     *         netlist is loaded.
+     */
+    const QSocNetlistGraph &getNetlistGraph();
+
+    /**
+     * @brief Get the fingerprint of the loaded netlist.
+     * @details Computes a SHA-256 fingerprint over everything that affects
+     *          the generated RTL: the netlist file content, the library
+     *          entries of every module referenced by an instance, the bus
+     *          definitions referenced by those modules, and the generator
+     *          identity: version, source revision and output format. The
+     *          result is cached until the next loadNetlist().
+     * @return QString Hexadecimal fingerprint, or an empty string if no
+     *         netlist is loaded.
+     */
+    QString getNetlistFingerprint();
+
+    /**
+     * @brief Check whether the generated Verilog is up to date.
+     * @details Compares the fingerprint of the loaded netlist with the one
+     *          recorded when the output file was last generated. Call this
+     *          after loadNetlist() to skip processNetlist() and
+     *          generateVerilog() when none of their inputs changed.
+     * @param outputFileName Output file name (without extension).
+     * @retval true Output file exists and was generated from identical inputs.
+     * @retval false Output file is missing or its inputs have changed.
+     */
+    bool isVerilogUpToDate(const QString &outputFileName);
+
     /**
      * @brief Generate Verilog code from the processed netlist.
      * @details Generates Verilog code and saves it to the output directory.
@@ -124,6 +190,33 @@ public slots:
     bool generateVerilog(const QString &outputFileName);
 
 private:
+    /**
+     * @brief Resolve module ports and build the connectivity graph adjacency.
+     * @details Each referenced module is fetched from the module manager once.
+     */
+    void buildNetlistGraph();
+
+    /**
+     * @brief Get the fingerprint file path of an output file.
+     * @details The fingerprint is stored in a hidden sidecar file next to the
+     *          generated file, so the generated RTL itself stays byte-stable.
+     * @param outputFileName Output file name (without extension).
+     * @return QString Path of the fingerprint file.
+     */
+    QString getFingerprintFilePath(const QString &outputFileName);
+
+    /**
+     * @brief Write file content only if it differs from the file on disk.
+     * @details Leaves the file (and its timestamp) untouched when the content
+     *          is identical, so downstream tools do not see a spurious change.
+     * @param filePath Path of the file to write.
+     * @param content Content to write.
+     * @param written Set to true if the file was actually written.
+     * @retval true File is up to date with the given content.
+     * @retval false Failed to write the file.
+     */
+    bool writeFileIfChanged(const QString &filePath, const QByteArray &content, bool *written);
+
     /** Project manager. */
     QSocProjectManager *projectManager = nullptr;
     /** Module manager. */
@@ -132,8 +225,16 @@ private:
     QSocBusManager *busManager = nullptr;
     /** LLM service. */
     QLLMService *llmService = nullptr;
-    /** Netlist data. */
-    YAML::Node netlistData;
+    /** Connectivity graph of the loaded netlist. */
+    QSocNetlistGraph netlistGraph;
+    /** Buses of the loaded netlist, expanded by processNetlist(). */
+    std::vector<QSocNetlistLoader::Bus> netlistBuses;
+    /** Buses of the loaded netlist have been expanded into nets. */
+    bool netlistExpanded = false;
+    /** Hash of the raw netlist file content. */
+    QByteArray netlistContentHash;
+    /** Cached netlist fingerprint, cleared by loadNetlist(). */
+    QString netlistFingerprint;
 };
 
 #endif // QSOCGENERATEMANAGER_H
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "common/qsocjsonarena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <new>
+
+namespace {
+/* Allocation header, keeps the returned memory aligned like operator new */
+constexpr std::size_t kHeaderSize = alignof(std::max_align_t);
+/* First block size, later blocks double up to the maximum */
+constexpr std::size_t kMinBlockSize = 64 * 1024;
+constexpr std::size_t kMaxBlockSize = 16 * 1024 * 1024;
+/* Header tags */
+constexpr std::uintptr_t kHeapTag  = 0;
+constexpr std::uintptr_t kArenaTag = 1;
+} // namespace
+
+thread_local QSocJsonArena *QSocJsonArena::current = nullptr;
+
+QSocJsonArena::Scope::Scope(QSocJsonArena &arena)
+    : previous(current)
+{
+    current = &arena;
+}
+
+QSocJsonArena::Scope::~Scope()
+{
+    current = previous;
+}
+
+QSocJsonArena::~QSocJsonArena()
+{
+    clear();
+}
+
+void QSocJsonArena::clear()
+{
+    for (void *block : blocks) {
+        ::operator delete(block);
+    }
+    blocks.clear();
+    cursor    = nullptr;
+    remaining = 0;
+    reserved  = 0;
+}
+
+std::size_t QSocJsonArena::getReservedBytes() const
+{
+    return reserved;
+}
+
+void *QSocJsonArena::allocate(std::size_t size)
+{
+    if (size > std::numeric_limits<std::size_t>::max() - 2 * kHeaderSize) {
+        throw std::bad_alloc();
+    }
+    /* Round up so the next allocation of a block stays aligned */
+    const std::size_t total = kHeaderSize + (size + kHeaderSize - 1) / kHeaderSize * kHeaderSize;
+
+    char *base = static_cast<char *>(
+        current ? current->allocateFromBlocks(total) : ::operator new(total));
+    *reinterpret_cast<std::uintptr_t *>(base) = current ? kArenaTag : kHeapTag;
+    return base + kHeaderSize;
+}
+
+void QSocJsonArena::deallocate(void *pointer) noexcept
+{
+    if (!pointer) {
+        return;
+    }
+    char *base = static_cast<char *>(pointer) - kHeaderSize;
+    if (*reinterpret_cast<std::uintptr_t *>(base) == kHeapTag) {
+        ::operator delete(base);
+    }
+}
+
+void *QSocJsonArena::allocateFromBlocks(std::size_t size)
+{
+    if (size > remaining) {
+        const std::size_t blockSize = std::max(
+            size, std::min(kMaxBlockSize, std::max(kMinBlockSize, reserved)));
+        cursor    = static_cast<char *>(::operator new(blockSize));
+        remaining = blockSize;
+        reserved += blockSize;
+        blocks.push_back(cursor);
+    }
+    void *result = cursor;
+    cursor += size;
+    remaining -= size;
+    return result;
+}
@@ -0,0 +1,165 @@
+#ifndef QSOCJSONARENA_H
+#define QSOCJSONARENA_H
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief The QSocJsonArena class.
+ * @details A monotonic arena for large JSON documents that are built once
+ *          and dropped as a whole, such as the AST of a design. Memory is
+ *          taken from big blocks with a bump pointer and is only given back
+ *          by clear() or the destructor, so millions of small nodes cost a
+ *          handful of heap allocations. The arena is used through
+ *          QSocJsonArenaAllocator while a Scope is active on the thread,
+ *          allocations outside a scope go to the heap as usual. Every
+ *          allocation is tagged, so values may move freely between arena and
+ *          heap documents. Keys and strings of a document go to the arena
+ *          too when it uses QSocJsonArenaString, short ones are kept inside
+ *          the string object by std::basic_string and allocate nothing.
+ *          Values moved or copied out of an arena document still point into
+ *          the arena and must be gone before clear().
+ */
+class QSocJsonArena
+{
+public:
+    /**
+     * @brief The Scope class.
+     * @details Makes an arena the target of QSocJsonArenaAllocator on the
+     *          current thread for the lifetime of the scope.
+     */
+    class Scope
+    {
+    public:
+        /**
+         * @brief Constructor.
+         * @param arena The arena to allocate from.
+         */
+        explicit Scope(QSocJsonArena &arena);
+
+        /**
+         * @brief Destructor, restores the previous arena of the thread.
+         */
+        ~Scope();
+
+        Scope(const Scope &)            = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        /** Arena that was active before this scope. */
+        QSocJsonArena *previous;
+    };
+
+    /**
+     * @brief Constructor.
+     */
+    QSocJsonArena() = default;
+
+    /**
+     * @brief Destructor.
+     * @details Frees all blocks, nothing allocated from the arena may be
+     *          used afterwards.
+     */
+    ~QSocJsonArena();
+
+    QSocJsonArena(const QSocJsonArena &)            = delete;
+    QSocJsonArena &operator=(const QSocJsonArena &) = delete;
+
+    /**
+     * @brief Free all blocks.
+     * @details Nothing allocated from the arena may be alive.
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of bytes reserved in blocks.
+     * @return std::size_t Bytes reserved.
+     */
+    std::size_t getReservedBytes() const;
+
+    /**
+     * @brief Allocate memory.
+     * @details Allocates from the arena of the current scope, or from the
+     *          heap if there is none.
+     * @param size Number of bytes.
+     * @return void * Memory aligned for any fundamental type.
+     */
+    static void *allocate(std::size_t size);
+
+    /**
+     * @brief Deallocate memory returned by allocate().
+     * @details Heap memory is freed, arena memory is kept until clear().
+     * @param pointer The memory.
+     */
+    static void deallocate(void *pointer) noexcept;
+
+private:
+    /** Block memory in allocation order. */
+    std::vector<void *> blocks;
+    /** Next free byte of the last block. */
+    char *cursor = nullptr;
+    /** Free bytes of the last block. */
+    std::size_t remaining = 0;
+    /** Bytes reserved in blocks. */
+    std::size_t reserved = 0;
+
+    /** Arena of the active scope on this thread. */
+    static thread_local QSocJsonArena *current;
+
+    /**
+     * @brief Allocate from the blocks, adding a block if needed.
+     * @param size Number of bytes, a multiple of the alignment.
+     * @return void * The memory.
+     */
+    void *allocateFromBlocks(std::size_t size);
+};
+
+/**
+ * @brief The QSocJsonArenaAllocator class.
+ * @details A stateless allocator that allocates through QSocJsonArena, for
+ *          the AllocatorType parameter of nlohmann::basic_json.
+ */
+template<typename T>
+class QSocJsonArenaAllocator
+{
+public:
+    using value_type      = T;
+    using is_always_equal = std::true_type;
+
+    QSocJsonArenaAllocator() noexcept = default;
+
+    template<typename U>
+    QSocJsonArenaAllocator(const QSocJsonArenaAllocator<U> &) noexcept
+    {}
+
+    T *allocate(std::size_t count)
+    {
+        return static_cast<T *>(QSocJsonArena::allocate(count * sizeof(T)));
+    }
+
+    void deallocate(T *pointer, std::size_t) noexcept { QSocJsonArena::deallocate(pointer); }
+
+    template<typename U>
+    bool operator==(const QSocJsonArenaAllocator<U> &) const noexcept
+    {
+        return true;
+    }
+
+    template<typename U>
+    bool operator!=(const QSocJsonArenaAllocator<U> &) const noexcept
+    {
+        return false;
+    }
+};
+
+/**
+ * @brief String type that allocates through QSocJsonArena.
+ * @details For the StringType parameter of nlohmann::basic_json. It
+ *          converts to std::string_view, and only explicitly to std::string.
+ */
+using QSocJsonArenaString
+    = std::basic_string<char, std::char_traits<char>, QSocJsonArenaAllocator<char>>;
+
+#endif // QSOCJSONARENA_H
@@ -0,0 +1,115 @@
+#include "common/qsoclibraryindex.h"
+
+#include <algorithm>
+
+void QSocLibraryIndex::insert(const QString &libraryName, const QString &name)
+{
+    const auto owner = libraryByName.constFind(name);
+    if (owner != libraryByName.constEnd()) {
+        if (*owner == libraryName) {
+            return;
+        }
+        remove(name);
+    }
+
+    libraryByName.insert(name, libraryName);
+    QStringList &names = namesByLibrary[libraryName];
+    /* Names mostly arrive in order, only sort when they do not */
+    if (!names.isEmpty() && name < names.last()) {
+        unsortedLibraries.insert(libraryName);
+    }
+    names.append(name);
+    allNamesValid = false;
+}
+
+QString QSocLibraryIndex::remove(const QString &name)
+{
+    const QString libraryName = libraryByName.take(name);
+    if (libraryName.isEmpty()) {
+        return libraryName;
+    }
+
+    QStringList &names = namesByLibrary[libraryName];
+    if (unsortedLibraries.contains(libraryName)) {
+        names.removeOne(name);
+    } else {
+        const auto iterator = std::lower_bound(names.begin(), names.end(), name);
+        if (iterator != names.end() && *iterator == name) {
+            names.erase(iterator);
+        }
+    }
+    if (names.isEmpty()) {
+        namesByLibrary.remove(libraryName);
+        unsortedLibraries.remove(libraryName);
+    }
+    allNamesValid = false;
+    return libraryName;
+}
+
+QStringList QSocLibraryIndex::removeLibrary(const QString &libraryName)
+{
+    if (!namesByLibrary.contains(libraryName)) {
+        return QStringList();
+    }
+    const QStringList names = getNames(libraryName);
+    for (const QString &name : names) {
+        libraryByName.remove(name);
+    }
+    namesByLibrary.remove(libraryName);
+    allNamesValid = false;
+    return names;
+}
+
+void QSocLibraryIndex::clear()
+{
+    libraryByName.clear();
+    namesByLibrary.clear();
+    unsortedLibraries.clear();
+    allNames.clear();
+    allNamesValid = true;
+}
+
+bool QSocLibraryIndex::containsName(const QString &name) const
+{
+    return libraryByName.contains(name);
+}
+
+bool QSocLibraryIndex::containsLibrary(const QString &libraryName) const
+{
+    return namesByLibrary.contains(libraryName);
+}
+
+QString QSocLibraryIndex::getLibrary(const QString &name) const
+{
+    return libraryByName.value(name);
+}
+
+const QStringList &QSocLibraryIndex::getNames(const QString &libraryName) const
+{
+    static const QStringList empty;
+    const auto               iterator = namesByLibrary.find(libraryName);
+    if (iterator == namesByLibrary.end()) {
+        return empty;
+    }
+    if (unsortedLibraries.remove(libraryName)) {
+        std::sort(iterator->begin(), iterator->end());
+    }
+    return *iterator;
+}
+
+const QStringList &QSocLibraryIndex::getNames() const
+{
+    if (!allNamesValid) {
+        allNames = libraryByName.keys();
+        std::sort(allNames.begin(), allNames.end());
+        allNamesValid = true;
+    }
+    return allNames;
+}
+
+QStringList QSocLibraryIndex::getLibraries() const
+{
+    QStringList libraries = namesByLibrary.keys();
+    std::sort(libraries.begin(), libraries.end());
+    return libraries;
+}
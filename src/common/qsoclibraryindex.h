@@ -0,0 +1,103 @@
+#ifndef QSOCLIBRARYINDEX_H
+#define QSOCLIBRARYINDEX_H
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief The QSocLibraryIndex class.
+ * @details Tracks which library owns which module or bus. Owners are kept
+ *          in a hash by name, so owner lookups do not search the libraries.
+ *          The names of each library are kept as a sorted list, as is the
+ *          list of all names, for binary search and ordered iteration.
+ *          Lists are sorted lazily on first read after a change, so loading
+ *          a library in any order costs one sort. A name belongs to exactly
+ *          one library, inserting it again moves it to the new library.
+ */
+class QSocLibraryIndex
+{
+public:
+    /**
+     * @brief Add a name to a library.
+     * @param libraryName The library name.
+     * @param name The module or bus name.
+     */
+    void insert(const QString &libraryName, const QString &name);
+
+    /**
+     * @brief Remove a name.
+     * @param name The module or bus name.
+     * @return QString The library that owned the name, empty if none.
+     */
+    QString remove(const QString &name);
+
+    /**
+     * @brief Remove a library and all of its names.
+     * @param libraryName The library name.
+     * @return QStringList The names the library owned, sorted.
+     */
+    QStringList removeLibrary(const QString &libraryName);
+
+    /**
+     * @brief Remove all libraries and names.
+     */
+    void clear();
+
+    /**
+     * @brief Check if a name is owned by any library.
+     * @param name The module or bus name.
+     * @retval true The name is indexed.
+     * @retval false The name is unknown.
+     */
+    bool containsName(const QString &name) const;
+
+    /**
+     * @brief Check if a library owns any name.
+     * @param libraryName The library name.
+     * @retval true The library is indexed.
+     * @retval false The library is unknown or empty.
+     */
+    bool containsLibrary(const QString &libraryName) const;
+
+    /**
+     * @brief Get the library that owns a name.
+     * @param name The module or bus name.
+     * @return QString The library name, empty if the name is unknown.
+     */
+    QString getLibrary(const QString &name) const;
+
+    /**
+     * @brief Get the names owned by a library.
+     * @param libraryName The library name.
+     * @return const QStringList & Sorted names, valid until the next change.
+     */
+    const QStringList &getNames(const QString &libraryName) const;
+
+    /**
+     * @brief Get all names.
+     * @return const QStringList & Sorted names, valid until the next change.
+     */
+    const QStringList &getNames() const;
+
+    /**
+     * @brief Get all library names.
+     * @return QStringList Sorted library names.
+     */
+    QStringList getLibraries() const;
+
+private:
+    /** Owning library by name. */
+    QHash<QString, QString> libraryByName;
+    /** Names by library, see unsortedLibraries. */
+    mutable QHash<QString, QStringList> namesByLibrary;
+    /** Libraries whose name lists need sorting. */
+    mutable QSet<QString> unsortedLibraries;
+    /** All names, sorted, valid if allNamesValid. */
+    mutable QStringList allNames;
+    /** Whether allNames is up to date. */
+    mutable bool allNamesValid = true;
+};
+
+#endif // QSOCLIBRARYINDEX_H
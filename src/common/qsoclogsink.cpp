@@ -0,0 +1,172 @@
+#include "common/qsoclogsink.h"
+
+#include <QScrollBar>
+#include <QStringList>
+#include <QTextCursor>
+#include <QTextDocument>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace {
+/* Flush period in milliseconds, about 30 frames per second */
+constexpr int kFlushInterval = 33;
+/* Lines kept in the browser */
+constexpr int kDefaultHistoryLimit = 10000;
+} // namespace
+
+QSocLogSink::QSocLogSink(QObject *parent, int capacity)
+    : QObject(parent)
+    , historyLimit(kDefaultHistoryLimit)
+{
+    size_t size = 2;
+    while (size < static_cast<size_t>(std::max(capacity, 2))) {
+        size <<= 1;
+    }
+    ring  = std::make_unique<Slot[]>(size);
+    mask  = size - 1;
+    for (size_t index = 0; index < size; index++) {
+        ring[index].sequence.store(index, std::memory_order_relaxed);
+    }
+
+    timer.setInterval(kFlushInterval);
+    connect(&timer, &QTimer::timeout, this, &QSocLogSink::flush);
+    timer.start();
+}
+
+QSocLogSink::~QSocLogSink()
+{
+    if (QStaticLog::getSink() == this) {
+        QStaticLog::setSink(nullptr);
+    }
+}
+
+bool QSocLogSink::accepts(QStaticLog::Level level) const
+{
+    return level <= this->level.load(std::memory_order_relaxed);
+}
+
+bool QSocLogSink::push(QStaticLog::Level level, const QString &func, const QString &message)
+{
+    /* Claim a slot, a slot is free when its sequence equals the position */
+    size_t position = head.load(std::memory_order_relaxed);
+    while (true) {
+        const size_t    sequence = ring[position & mask].sequence.load(std::memory_order_acquire);
+        const ptrdiff_t diff     = static_cast<ptrdiff_t>(sequence - position);
+        if (diff == 0) {
+            if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = head.load(std::memory_order_relaxed);
+        }
+    }
+
+    /* Fill it and hand it to the consumer */
+    Slot &slot          = ring[position & mask];
+    slot.record.level   = level;
+    slot.record.func    = func;
+    slot.record.message = message;
+    slot.record.repeat  = 1;
+    slot.sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+void QSocLogSink::attach(QTextBrowser *browser)
+{
+    this->browser = browser;
+    if (browser) {
+        browser->document()->setMaximumBlockCount(historyLimit);
+    }
+}
+
+void QSocLogSink::setLevel(QStaticLog::Level level)
+{
+    this->level.store(level, std::memory_order_relaxed);
+}
+
+QStaticLog::Level QSocLogSink::getLevel() const
+{
+    return static_cast<QStaticLog::Level>(level.load(std::memory_order_relaxed));
+}
+
+void QSocLogSink::setHistoryLimit(int lines)
+{
+    historyLimit = std::max(lines, 1);
+    if (browser) {
+        browser->document()->setMaximumBlockCount(historyLimit);
+    }
+}
+
+void QSocLogSink::flush()
+{
+    /* Drain every filled slot, runs of the same message become one record */
+    while (true) {
+        Slot &slot = ring[tail & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != tail + 1) {
+            break;
+        }
+        Record record = std::move(slot.record);
+        slot.sequence.store(tail + mask + 1, std::memory_order_release);
+        tail++;
+
+        if (!batch.empty() && batch.back().level == record.level
+            && batch.back().message == record.message && batch.back().func == record.func) {
+            batch.back().repeat++;
+        } else {
+            batch.push_back(std::move(record));
+        }
+    }
+    const size_t lost = dropped.exchange(0, std::memory_order_relaxed);
+    if (batch.empty() && lost == 0) {
+        return;
+    }
+
+    /* Format only what the history can hold */
+    const size_t first = batch.size() > static_cast<size_t>(historyLimit)
+                             ? batch.size() - static_cast<size_t>(historyLimit)
+                             : 0;
+    QStringList  lines;
+    lines.reserve(static_cast<qsizetype>(batch.size() - first + 1));
+    for (size_t index = first; index < batch.size(); index++) {
+        const Record &record = batch[index];
+        QString       line
+            = QStaticLog::formatRichtext(record.level, record.func, record.message);
+        if (record.repeat > 1) {
+            line += QString(" (x%1)").arg(record.repeat);
+        }
+        lines.append(line);
+    }
+    if (lost > 0) {
+        lines.append(QStaticLog::formatRichtext(
+            QStaticLog::Level::Warning,
+            Q_FUNC_INFO,
+            QString("Log view is behind, %1 messages dropped").arg(lost)));
+    }
+    batch.clear();
+
+    /* One edit block, the browser lays out and repaints once */
+    if (browser) {
+        QScrollBar    *scrollBar = browser->verticalScrollBar();
+        const bool     atBottom  = scrollBar->value() == scrollBar->maximum();
+        QTextDocument *document  = browser->document();
+        QTextCursor    cursor(document);
+        cursor.movePosition(QTextCursor::End);
+        cursor.beginEditBlock();
+        for (const QString &line : lines) {
+            if (!document->isEmpty()) {
+                cursor.insertBlock();
+            }
+            cursor.insertHtml(line);
+        }
+        cursor.endEditBlock();
+        if (atBottom) {
+            scrollBar->setValue(scrollBar->maximum());
+        }
+    }
+
+    emit QStaticLog::instance().log(lines.join("<br>"));
+}
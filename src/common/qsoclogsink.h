@@ -0,0 +1,152 @@
+#ifndef QSOCLOGSINK_H
+#define QSOCLOGSINK_H
+
+#include "common/qstaticlog.h"
+
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QTextBrowser>
+#include <QTimer>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief The QSocLogSink class.
+ * @details This class collects log messages for a text browser. Messages
+ *          are stored unformatted in a fixed size lock-free ring buffer, so
+ *          logging from any thread costs one slot claim and two string
+ *          reference counts. A timer drains the ring at a fixed frame rate,
+ *          coalesces repeated messages, formats only what is left to show
+ *          and appends it to the browser in a single edit. Messages that
+ *          arrive while the ring is full are dropped and counted, and the
+ *          browser keeps a bounded number of lines.
+ */
+class QSocLogSink : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief Constructor.
+     * @details This constructor will create an instance of this object. It
+     *          must be created on the thread of the browser, the flush timer
+     *          runs there.
+     * @param[in] parent parent object.
+     * @param[in] capacity ring size, rounded up to a power of two.
+     */
+    explicit QSocLogSink(QObject *parent = nullptr, int capacity = 65536);
+
+    /**
+     * @brief Destructor.
+     * @details Uninstalls the sink from QStaticLog if it is installed.
+     */
+    ~QSocLogSink() override;
+
+    /**
+     * @brief Check if a message level is shown.
+     * @details Thread-safe, called before a message is stored.
+     * @param level The message level.
+     * @retval true The message is shown.
+     * @retval false The message is filtered out.
+     */
+    bool accepts(QStaticLog::Level level) const;
+
+    /**
+     * @brief Store a message.
+     * @details Thread-safe and lock-free, the message is not formatted.
+     * @param level The message level.
+     * @param func The function name.
+     * @param message The log message.
+     * @retval true The message was stored.
+     * @retval false The ring is full, the message was dropped.
+     */
+    bool push(QStaticLog::Level level, const QString &func, const QString &message);
+
+public slots:
+    /**
+     * @brief Attach a text browser.
+     * @details The browser is limited to the history size and receives
+     *          every flush from now on.
+     * @param browser The text browser, nullptr to detach.
+     */
+    void attach(QTextBrowser *browser);
+
+    /**
+     * @brief Set the level shown by the sink.
+     * @details Messages above this level are dropped before they are
+     *          stored, QStaticLog::getLevel() still applies first.
+     * @param level The highest level to show.
+     */
+    void setLevel(QStaticLog::Level level);
+
+    /**
+     * @brief Get the level shown by the sink.
+     * @return QStaticLog::Level The highest level shown.
+     */
+    QStaticLog::Level getLevel() const;
+
+    /**
+     * @brief Set the history size.
+     * @details Older lines are removed from the browser.
+     * @param lines Number of lines to keep.
+     */
+    void setHistoryLimit(int lines);
+
+    /**
+     * @brief Drain the ring into the browser.
+     * @details Called by the timer, emits QStaticLog::log() once with the
+     *          new lines when there are any.
+     */
+    void flush();
+
+private:
+    /* Stored message. */
+    struct Record
+    {
+        QStaticLog::Level level = QStaticLog::Level::Silent; /* Message level */
+        QString           func;                              /* Function name */
+        QString           message;                           /* Log message */
+        int               repeat = 1;                        /* Times in a row */
+    };
+
+    /* Ring slot, the sequence tells producers and the consumer whose turn it is. */
+    struct Slot
+    {
+        std::atomic<size_t> sequence{0}; /* Position the slot is ready for */
+        Record              record;      /* Stored message */
+    };
+
+    /* Ring slots. */
+    std::unique_ptr<Slot[]> ring;
+
+    /* Ring size minus one. */
+    size_t mask;
+
+    /* Next position to store. */
+    std::atomic<size_t> head{0};
+
+    /* Next position to drain, only used by flush(). */
+    size_t tail = 0;
+
+    /* Messages dropped since the last flush. */
+    std::atomic<size_t> dropped{0};
+
+    /* Highest level shown. */
+    std::atomic<int> level{QStaticLog::Level::Verbose};
+
+    /* Lines kept in the browser. */
+    int historyLimit;
+
+    /* Attached browser. */
+    QPointer<QTextBrowser> browser;
+
+    /* Flush timer. */
+    QTimer timer;
+
+    /* Drained messages, kept to reuse the allocation. */
+    std::vector<Record> batch;
+};
+
+#endif // QSOCLOGSINK_H
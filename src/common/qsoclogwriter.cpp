@@ -0,0 +1,99 @@
+#include "common/qsoclogwriter.h"
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QMutexLocker>
+
+namespace {
+/* Plain level tag of a file line */
+QString levelTag(QStaticLog::Level level)
+{
+    switch (level) {
+    case QStaticLog::Level::Error:
+        return "[E]";
+    case QStaticLog::Level::Warning:
+        return "[W]";
+    case QStaticLog::Level::Info:
+        return "[I]";
+    case QStaticLog::Level::Debug:
+        return "[D]";
+    default:
+        return "[V]";
+    }
+}
+} // namespace
+
+QSocLogWriter::QSocLogWriter(const QString &path)
+    : file(path)
+{}
+
+QSocLogWriter::~QSocLogWriter()
+{
+    if (thread.joinable()) {
+        {
+            const QMutexLocker locker(&mutex);
+            stopping = true;
+        }
+        wake.wakeOne();
+        thread.join();
+    }
+    file.close();
+}
+
+bool QSocLogWriter::open()
+{
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        return false;
+    }
+    thread = std::thread(&QSocLogWriter::run, this);
+    return true;
+}
+
+void QSocLogWriter::push(
+    QStaticLog::Level         level,
+    const QString            &func,
+    const QString            &message,
+    const QStaticLog::Fields &fields)
+{
+    Record record{QDateTime::currentMSecsSinceEpoch(), level, func, message, fields};
+    bool   idle = false;
+    {
+        const QMutexLocker locker(&mutex);
+        idle = queue.empty();
+        queue.push_back(std::move(record));
+    }
+    /* The writer only sleeps on an empty queue */
+    if (idle) {
+        wake.wakeOne();
+    }
+}
+
+void QSocLogWriter::run()
+{
+    std::vector<Record> batch;
+    while (true) {
+        {
+            const QMutexLocker locker(&mutex);
+            while (queue.empty() && !stopping) {
+                wake.wait(&mutex);
+            }
+            if (queue.empty()) {
+                return;
+            }
+            batch.swap(queue);
+        }
+
+        /* Format the whole batch, then write it at once */
+        QByteArray buffer;
+        for (const Record &record : batch) {
+            const QString line
+                = QDateTime::fromMSecsSinceEpoch(record.time).toString(Qt::ISODateWithMs) + ' '
+                  + levelTag(record.level) + ' ' + record.func + ':' + record.message
+                  + QStaticLog::formatFields(record.fields) + '\n';
+            buffer += line.toUtf8();
+        }
+        file.write(buffer);
+        file.flush();
+        batch.clear();
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef QSOCLOGWRITER_H
+#define QSOCLOGWRITER_H
+
+#include "common/qstaticlog.h"
+
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include <QWaitCondition>
+
+#include <thread>
+#include <vector>
+
+/**
+ * @brief The QSocLogWriter class.
+ * @details This class appends log messages to a file on a background
+ *          thread. Logging threads only move the unformatted message and
+ *          its fields into a queue. The writer thread swaps the whole queue
+ *          out, formats it with timestamps and writes it in one call, so a
+ *          slow disk never blocks the caller. Used by QStaticLog::setFile().
+ */
+class QSocLogWriter
+{
+public:
+    /**
+     * @brief Constructor.
+     * @details This constructor will create an instance of this object,
+     *          the file is opened by open().
+     * @param[in] path log file path.
+     */
+    explicit QSocLogWriter(const QString &path);
+
+    /**
+     * @brief Destructor.
+     * @details Writes the queued messages, stops the thread and closes the
+     *          file.
+     */
+    ~QSocLogWriter();
+
+    /**
+     * @brief Open the file and start the writer thread.
+     * @details The file is truncated.
+     * @retval true The file is open.
+     * @retval false The file could not be opened.
+     */
+    bool open();
+
+    /**
+     * @brief Queue a message.
+     * @details Thread-safe, the timestamp is taken here and everything else
+     *          is formatted on the writer thread.
+     * @param level The message level.
+     * @param func The function name.
+     * @param message The log message.
+     * @param fields The structured fields.
+     */
+    void push(
+        QStaticLog::Level         level,
+        const QString            &func,
+        const QString            &message,
+        const QStaticLog::Fields &fields);
+
+private:
+    /* Queued message. */
+    struct Record
+    {
+        qint64             time;    /* Milliseconds since epoch */
+        QStaticLog::Level  level;   /* Message level */
+        QString            func;    /* Function name */
+        QString            message; /* Log message */
+        QStaticLog::Fields fields;  /* Structured fields */
+    };
+
+    /* Log file. */
+    QFile file;
+
+    /* Guards the queue and the stop flag. */
+    QMutex mutex;
+
+    /* Wakes the writer thread. */
+    QWaitCondition wake;
+
+    /* Messages not written yet. */
+    std::vector<Record> queue;
+
+    /* The writer thread should stop once the queue is empty. */
+    bool stopping = false;
+
+    /* Writer thread. */
+    std::thread thread;
+
+    /**
+     * @brief Write queued messages until stopped.
+     * @details Runs on the writer thread.
+     */
+    void run();
+};
+
+#endif // QSOCLOGWRITER_H
@@ -3,14 +3,25 @@
 #include "common/qslangdriver.h"
 #include "common/qsocbusmanager.h"
 #include "common/qsocconfig.h"
+#include "common/qsocnamematcher.h"
+#include "common/qstaticdatasedes.h"
+#include "common/qstaticmetrics.h"
 #include "common/qstaticregex.h"
 #include "common/qstaticstringweaver.h"
+#include "common/qstatictrace.h"
+#include "common/qstaticyamlcache.h"
 
 #include <QDebug>
 #include <QDir>
 #include <QFile>
 
-#include <fstream>
+namespace {
+/* Modules found by the parser */
+QStaticMetrics::Counter modulesParsed("module.parsed");
+
+/* Modules imported into a library */
+QStaticMetrics::Counter modulesImported("module.imported");
+} // namespace
 
 QSocModuleManager::QSocModuleManager(
     QObject            *parent,
@@ -21,6 +32,7 @@ QSocModuleManager::QSocModuleManager(
     , projectManager(projectManager)
     , busManager(busManager)
     , llmService(llmService)
+    , residentLibraries("module")
 {
     /* Set projectManager */
     setProjectManager(projectManager);
@@ -28,6 +40,11 @@ QSocModuleManager::QSocModuleManager(
     setBusManager(busManager);
 }
 
+QSocModuleManager::~QSocModuleManager()
+{
+    residentLibraries.end(moduleData);
+}
+
 void QSocModuleManager::setProjectManager(QSocProjectManager *projectManager)
 {
     /* Set projectManager */
@@ -65,11 +82,14 @@ bool QSocModuleManager::isModulePathValid()
 }
 
 bool QSocModuleManager::importFromFileList(
-    const QString            &libraryName,
-    const QRegularExpression &moduleNameRegex,
-    const QString            &fileListPath,
-    const QStringList        &filePathList)
+    const QString                   &libraryName,
+    const QRegularExpression        &moduleNameRegex,
+    const QString                   &fileListPath,
+    const QStringList               &filePathList,
+    int                              parseJobs,
+    QList<QSlangDriver::Diagnostic> *diagnostics)
 {
+    const QStaticTrace::Span span("module.import", libraryName);
     /* Validate projectManager and its path */
     if (!isModulePathValid()) {
         qCritical() << "Error: projectManager is null or invalid module path.";
@@ -82,9 +102,16 @@ bool QSocModuleManager::importFromFileList(
     }
 
     QSlangDriver driver(this, projectManager);
-    if (driver.parseFileList(fileListPath, filePathList)) {
+    driver.setParseJobs(parseJobs);
+    driver.setModuleFilter(moduleNameRegex);
+    const bool parsed = driver.parseFileList(fileListPath, filePathList);
+    if (diagnostics) {
+        *diagnostics = driver.getDiagnostics();
+    }
+    if (parsed) {
         /* Parse success */
         QStringList moduleList = driver.getModuleList();
+        modulesParsed.add(moduleList.size());
         if (moduleList.isEmpty()) {
             /* No module found */
             qCritical() << "Error: no module found.";
@@ -105,6 +132,7 @@ bool QSocModuleManager::importFromFileList(
             const YAML::Node &moduleYaml = getModuleYaml(moduleAst);
             /* Add module to library yaml */
             libraryYaml[moduleName.toStdString()] = moduleYaml;
+            modulesImported.add();
             saveLibraryYaml(effectiveName, libraryYaml);
             return true;
         }
@@ -122,6 +150,7 @@ bool QSocModuleManager::importFromFileList(
                 const YAML::Node &moduleYaml          = getModuleYaml(moduleAst);
                 libraryYaml[moduleName.toStdString()] = moduleYaml;
                 hasMatch                              = true;
+                modulesImported.add();
             }
         }
         if (hasMatch) {
@@ -210,23 +239,17 @@ bool QSocModuleManager::saveLibraryYaml(const QString &libraryName, const YAML::
     /* Check file path */
     const QString &modulePath = projectManager->getModulePath();
     const QString &filePath   = modulePath + "/" + libraryName + ".soc_mod";
-    if (QFile::exists(filePath)) {
-        /* Load library YAML file */
-        std::ifstream inputFileStream(filePath.toStdString());
-        localLibraryYaml = mergeNodes(YAML::Load(inputFileStream), libraryYaml);
+    if (QStaticYamlCache::exists(filePath)) {
+        /* Load library YAML file, the loaded copy is owned and merged in place */
+        localLibraryYaml = QStaticYamlCache::load(filePath);
+        QStaticDataSedes::mergeYamlInto(localLibraryYaml, libraryYaml);
         qDebug() << "Load and merge";
     } else {
         localLibraryYaml = libraryYaml;
     }
 
-    /* Save YAML file */
-    std::ofstream outputFileStream(filePath.toStdString());
-    if (!outputFileStream.is_open()) {
-        qCritical() << "Error: Unable to open file for writing:" << filePath;
-        return false;
-    }
-    outputFileStream << localLibraryYaml;
-    return true;
+    /* Save YAML file, deferred in batch mode */
+    return QStaticYamlCache::save(filePath, localLibraryYaml);
 }
 
 bool QSocModuleManager::isLibraryFileExist(const QString &libraryName)
@@ -247,13 +270,13 @@ bool QSocModuleManager::isLibraryFileExist(const QString &libraryName)
     const QString filePath
         = QDir(projectManager->getModulePath()).filePath(libraryName + ".soc_mod");
 
-    /* Check if library file exists */
-    return QFile::exists(filePath);
+    /* Check if library file exists, including pending batch writes */
+    return QStaticYamlCache::exists(filePath);
 }
 
 bool QSocModuleManager::isLibraryExist(const QString &libraryName)
 {
-    return libraryMap.contains(libraryName);
+    return libraryIndex.containsLibrary(libraryName);
 }
 
 QStringList QSocModuleManager::listLibrary(const QRegularExpression &libraryNameRegex)
@@ -269,17 +292,12 @@ QStringList QSocModuleManager::listLibrary(const QRegularExpression &libraryName
         qCritical() << "Error: Invalid or empty regex:" << libraryNameRegex.pattern();
         return result;
     }
-    /* QDir for '.soc_mod' files in module path, sorted by name. */
-    const QDir modulePathDir(
-        projectManager->getModulePath(),
-        "*.soc_mod",
-        QDir::SortFlag::Name | QDir::SortFlag::IgnoreCase,
-        QDir::Files | QDir::NoDotAndDotDot);
+    /* '.soc_mod' files in module path sorted by name, including pending batch writes. */
+    const QStringList fileNames
+        = QStaticYamlCache::listFiles(projectManager->getModulePath(), "soc_mod");
     /* Add matching file basenames from projectDir to result list. */
-    foreach (const QString &filename, modulePathDir.entryList()) {
-        if (QStaticRegex::isNameExactMatch(filename, libraryNameRegex)) {
-            result.append(filename.split('.').first());
-        }
+    for (const QString &filename : QSocNameMatcher(libraryNameRegex).filter(fileNames)) {
+        result.append(filename.split('.').first());
     }
 
     return result;
@@ -287,6 +305,7 @@ QStringList QSocModuleManager::listLibrary(const QRegularExpression &libraryName
 
 bool QSocModuleManager::load(const QString &libraryName)
 {
+    const QStaticTrace::Span span("module.load", libraryName);
     /* Validate projectManager and its path */
     if (!isModulePathValid()) {
         qCritical() << "Error: projectManager is null or invalid module path.";
@@ -300,32 +319,43 @@ bool QSocModuleManager::load(const QString &libraryName)
     }
 
     /* Get the full file path by joining module path and basename with extension */
-    const QString filePath
-        = QDir(projectManager->getModulePath()).filePath(libraryName + ".soc_mod");
+    const QDir    moduleDir(projectManager->getModulePath());
+    const QString filePath = moduleDir.filePath(libraryName + ".soc_mod");
 
-    /* Open the YAML file */
-    std::ifstream fileStream(filePath.toStdString());
-    if (!fileStream.is_open()) {
-        qCritical() << "Error: Unable to open file:" << filePath;
-        return false;
+    /* A session reuses the library from the previous command while its file is unchanged */
+    residentLibraries.begin(moduleDir.absolutePath(), moduleData);
+    if (residentLibraries.reuse(libraryName, filePath, libraryIndex)) {
+        return true;
     }
 
     try {
-        /* Load YAML content into a temporary node */
-        YAML::Node tempNode = YAML::Load(fileStream);
+        /* Load YAML content into a temporary node, reused while the file is unchanged */
+        YAML::Node  tempNode = QStaticYamlCache::load(filePath);
+        QStringList moduleNames;
 
         /* Iterate through the temporary node and add to moduleData */
         for (YAML::const_iterator it = tempNode.begin(); it != tempNode.end(); ++it) {
-            const auto key = it->first.as<std::string>();
+            const auto    key        = it->first.as<std::string>();
+            const QString moduleName = QString::fromStdString(key);
+
+            /* Tag the module with its library, tempNode is an owned copy */
+            YAML::Node moduleYaml = it->second;
+            moduleYaml["library"] = libraryName.toStdString();
 
-            /* Add to moduleData */
-            moduleData[key]            = it->second;
-            moduleData[key]["library"] = libraryName.toStdString();
+            /* Add to moduleData, new modules are appended without a lookup */
+            if (libraryIndex.containsName(moduleName) || residentLibraries.contains(moduleName)) {
+                moduleData[key] = moduleYaml;
+            } else {
+                moduleData.force_insert(key, moduleYaml);
+            }
 
-            /* Update libraryMap with libraryName to key mapping */
-            libraryMapAdd(libraryName, QString::fromStdString(key));
+            /* Record libraryName as the owner of key */
+            libraryIndex.insert(libraryName, moduleName);
+            moduleNames.append(moduleName);
         }
+        residentLibraries.loaded(libraryName, filePath, moduleNames);
     } catch (const YAML::Exception &e) {
+        residentLibraries.discard();
         qCritical() << "Error parsing YAML file:" << filePath << ":" << e.what();
         return false;
     }
@@ -381,22 +411,23 @@ bool QSocModuleManager::load(const QStringList &libraryNameList)
 
 bool QSocModuleManager::save(const QString &libraryName)
 {
+    const QStaticTrace::Span span("module.save", libraryName);
     /* Validate projectManager and its path */
     if (!isModulePathValid()) {
         qCritical() << "Error: projectManager is null or invalid library path.";
         return false;
     }
 
-    /* Check if the libraryName exists in libraryMap */
-    if (!libraryMap.contains(libraryName)) {
-        qCritical() << "Error: Library basename not found in libraryMap.";
+    /* Check if the libraryName exists in libraryIndex */
+    if (!libraryIndex.containsLibrary(libraryName)) {
+        qCritical() << "Error: Library basename not found in libraryIndex.";
         return false;
     }
 
     /* Extract modules from moduleData */
     YAML::Node dataToSave;
-    /* Iterate through each module in libraryMap */
-    for (const auto &moduleItem : libraryMap[libraryName]) {
+    /* Iterate through each module of the library in name order */
+    for (const auto &moduleItem : libraryIndex.getNames(libraryName)) {
         const std::string moduleNameStd = moduleItem.toStdString();
         if (!moduleData[moduleNameStd]) {
             qCritical() << "Error: Module data is not exist: " << moduleNameStd;
@@ -411,13 +442,7 @@ bool QSocModuleManager::save(const QString &libraryName)
     /* Serialize and save to file */
     const QString filePath
         = QDir(projectManager->getModulePath()).filePath(libraryName + ".soc_mod");
-    std::ofstream outputFileStream(filePath.toStdString());
-    if (!outputFileStream.is_open()) {
-        qCritical() << "Error: Unable to open file for writing:" << filePath;
-        return false;
-    }
-    outputFileStream << dataToSave;
-    return true;
+    return QStaticYamlCache::save(filePath, dataToSave);
 }
 
 bool QSocModuleManager::save(const QRegularExpression &libraryNameRegex)
@@ -435,8 +460,8 @@ bool QSocModuleManager::save(const QRegularExpression &libraryNameRegex)
         return false;
     }
 
-    /* Iterate over libraryMap and save matching libraries */
-    for (const QString &libraryName : libraryMap.keys()) {
+    /* Iterate over libraryIndex and save matching libraries */
+    for (const QString &libraryName : libraryIndex.getLibraries()) {
         if (QStaticRegex::isNameExactMatch(libraryName, libraryNameRegex)) {
             if (!save(libraryName)) {
                 qCritical() << "Error: Failed to save library:" << libraryName;
@@ -487,20 +512,21 @@ bool QSocModuleManager::remove(const QString &libraryName)
         = QDir(projectManager->getModulePath()).filePath(libraryName + ".soc_mod");
 
     /* Check if library file exists */
-    if (!QFile::exists(filePath)) {
+    if (!QStaticYamlCache::exists(filePath)) {
         qCritical() << "Error: library file does not exist for basename:" << libraryName;
         return false;
     }
 
     /* Remove the file */
-    if (!QFile::remove(filePath)) {
+    if (!QStaticYamlCache::remove(filePath)) {
         qCritical() << "Error: Failed to remove module file:" << filePath;
         return false;
     }
 
-    /* Remove from moduleData and libraryMap */
-    moduleData.remove(libraryName.toStdString());
-    libraryMap.remove(libraryName);
+    /* Remove the modules of the library from moduleData and libraryIndex */
+    for (const QString &moduleName : libraryIndex.removeLibrary(libraryName)) {
+        moduleData.remove(moduleName.toStdString());
+    }
 
     return true;
 }
@@ -553,55 +579,50 @@ bool QSocModuleManager::remove(const QStringList &libraryNameList)
 
 bool QSocModuleManager::isModuleExist(const QString &moduleName)
 {
-    return moduleData[moduleName.toStdString()].IsDefined();
+    return libraryIndex.containsName(moduleName);
 }
 
 QString QSocModuleManager::getModuleLibrary(const QString &moduleName)
 {
-    if (!isModuleExist(moduleName)) {
-        return QString();
-    }
-    return QString::fromStdString(moduleData[moduleName.toStdString()]["library"].as<std::string>());
+    return libraryIndex.getLibrary(moduleName);
 }
 
 QStringList QSocModuleManager::listModule(const QRegularExpression &moduleNameRegex)
 {
-    QStringList result;
     /* Validate moduleNameRegex */
     if (!QStaticRegex::isNameRegexValid(moduleNameRegex)) {
         qCritical() << "Error: Invalid or empty regex:" << moduleNameRegex.pattern();
-        return result;
-    }
-
-    /* Iterate through each node in moduleData */
-    for (YAML::const_iterator it = moduleData.begin(); it != moduleData.end(); ++it) {
-        const QString moduleName = QString::fromStdString(it->first.as<std::string>());
-
-        /* Check if the module name matches the regex */
-        if (QStaticRegex::isNameExactMatch(moduleName, moduleNameRegex)) {
-            result.append(moduleName);
-        }
+        return QStringList();
     }
+    return listModule(QSocNameMatcher(moduleNameRegex));
+}
 
-    return result;
+QStringList QSocModuleManager::listModule(const QSocNameMatcher &moduleNameMatcher)
+{
+    /* Names are sorted, plain names and prefixes are found by binary search */
+    return moduleNameMatcher.filterSorted(libraryIndex.getNames());
 }
 
 YAML::Node QSocModuleManager::getModuleYamls(const QRegularExpression &moduleNameRegex)
 {
-    YAML::Node result;
-
     /* Check if the regex is valid, if not, return an empty node */
     if (!QStaticRegex::isNameRegexValid(moduleNameRegex)) {
         qWarning() << "Invalid regular expression provided.";
-        return result;
+        return YAML::Node();
     }
+    return getModuleYamls(QSocNameMatcher(moduleNameRegex));
+}
+
+YAML::Node QSocModuleManager::getModuleYamls(const QSocNameMatcher &moduleNameMatcher)
+{
+    YAML::Node result;
 
-    /* Iterate over the moduleData to find matches */
+    /* Iterate over the moduleData to find matches, skipping kept modules not loaded */
     for (YAML::const_iterator it = moduleData.begin(); it != moduleData.end(); ++it) {
         const QString moduleName = QString::fromStdString(it->first.as<std::string>());
 
-        /* Check if the module name matches the regex */
-        if (QStaticRegex::isNameExactMatch(moduleName, moduleNameRegex)) {
+        /* Check if the module name matches any pattern */
+        if (libraryIndex.containsName(moduleName) && moduleNameMatcher.matches(moduleName)) {
             /* Add the module node to the result */
             result[moduleName.toStdString()] = it->second;
         }
@@ -635,38 +656,31 @@ bool QSocModuleManager::updateModuleYaml(const QString &moduleName, const YAML::
 
 bool QSocModuleManager::removeModule(const QRegularExpression &moduleNameRegex)
 {
-    /* Validate projectManager and its path */
-    if (!isModulePathValid()) {
-        qCritical() << "Error: projectManager is null or invalid module path.";
-        return false;
-    }
     /* Validate moduleNameRegex */
     if (!QStaticRegex::isNameRegexValid(moduleNameRegex)) {
         qCritical() << "Error: Invalid or empty regex:" << moduleNameRegex.pattern();
         return false;
     }
+    return removeModule(QSocNameMatcher(moduleNameRegex));
+}
+
+bool QSocModuleManager::removeModule(const QSocNameMatcher &moduleNameMatcher)
+{
+    /* Validate projectManager and its path */
+    if (!isModulePathValid()) {
+        qCritical() << "Error: projectManager is null or invalid module path.";
+        return false;
+    }
 
     QSet<QString> libraryToSave;
     QSet<QString> libraryToRemove;
-    QSet<QString> moduleToRemove;
-
-    for (auto moduleDataIter = moduleData.begin(); moduleDataIter != moduleData.end();
-         ++moduleDataIter) {
-        const QString moduleName = QString::fromStdString(moduleDataIter->first.as<std::string>());
-        if (QStaticRegex::isNameExactMatch(moduleName, moduleNameRegex)) {
-            moduleToRemove.insert(moduleName);
-            const QString libraryName = QString::fromStdString(
-                moduleDataIter->second["library"].as<std::string>());
-            libraryToSave.insert(libraryName);
-        }
-    }
 
-    /* Remove modules from moduleData */
-    for (const QString &moduleName : moduleToRemove) {
-        const QString libraryName = QString::fromStdString(
-            moduleData[moduleName.toStdString()]["library"].as<std::string>());
-        libraryMapRemove(libraryName, moduleName);
-        if (!libraryMap.contains(libraryName)) {
+    /* Remove matching modules from moduleData and libraryIndex */
+    for (const QString &moduleName : moduleNameMatcher.filterSorted(libraryIndex.getNames())) {
+        const QString libraryName = libraryIndex.remove(moduleName);
+        if (libraryIndex.containsLibrary(libraryName)) {
+            libraryToSave.insert(libraryName);
+        } else {
             libraryToRemove.insert(libraryName);
         }
         moduleData.remove(moduleName.toStdString());
@@ -681,13 +695,13 @@ bool QSocModuleManager::removeModule(const QRegularExpression &moduleNameRegex)
     const QStringList libraryToRemoveList
         = QList<QString>(libraryToRemove.begin(), libraryToRemove.end());
 
-    /* Save libraries that still have associations in libraryMap */
+    /* Save libraries that still have associations in libraryIndex */
     if (!save(libraryToSaveList)) {
         qCritical() << "Error: Failed to save libraries.";
         return false;
     }
 
-    /* Remove modules with no remaining associations in libraryMap */
+    /* Remove libraries with no remaining associations in libraryIndex */
     if (!remove(libraryToRemoveList)) {
         qCritical() << "Error: Failed to remove modules.";
         return false;
@@ -759,70 +773,8 @@ bool QSocModuleManager::addModuleBus(
     qDebug() << "Bus signals:" << groupBus;
 
     /* Use QStaticStringWeaver to match bus signals to module ports */
-    /* Step 1: Extract candidate substrings for clustering */
-    int minSubstringLength = 3; /* Min length for common substrings */
-    int freqThreshold      = 2; /* Must appear in at least 2 strings */
-
-    QMap<QString, int> candidateSubstrings = QStaticStringWeaver::extractCandidateSubstrings(
-        groupModule, minSubstringLength, freqThreshold);
-
-    /* Step 2: Cluster module ports based on common substrings */
-    QMap<QString, QVector<QString>> groups
-        = QStaticStringWeaver::clusterStrings(groupModule, candidateSubstrings);
-
-    /* Step 3: Find best matching group for the bus interface hint */
-    QList<QString> candidateMarkers = candidateSubstrings.keys();
-    std::sort(candidateMarkers.begin(), candidateMarkers.end(), [](const QString &a, const QString &b) {
-        return a.size() > b.size();
-    });
-
-    /* Find best matching group markers for the bus interface hint */
-    QVector<QString> bestHintGroupMarkers;
-
-    /* Try to find markers using the original bus interface without hardcoding prefixes */
-    QString bestMarker
-        = QStaticStringWeaver::findBestGroupMarkerForHint(busInterface, candidateMarkers);
-    if (!bestMarker.isEmpty()) {
-        bestHintGroupMarkers.append(bestMarker);
-        qDebug() << "Best matching marker:" << bestMarker << "for hint:" << busInterface;
-    } else {
-        /* If no marker found, use empty string */
-        bestHintGroupMarkers.append("");
-        qDebug() << "No suitable group marker found, using empty string";
-    }
-
-    /* Collect all module ports from groups whose keys match any of the best hint group markers */
-    QVector<QString> filteredModulePorts;
-    for (auto it = groups.begin(); it != groups.end(); ++it) {
-        QString groupKey = it.key();
-        bool    matches  = false;
-
-        for (const QString &marker : bestHintGroupMarkers) {
-            if (groupKey.contains(marker, Qt::CaseInsensitive)) {
-                matches = true;
-                break;
-            }
-        }
-
-        if (matches) {
-            qDebug() << "Including ports from group:" << groupKey;
-            for (const QString &portStr : it.value()) {
-                filteredModulePorts.append(portStr);
-            }
-        }
-    }
-
-    /* If no filtered ports found, fall back to all ports */
-    if (filteredModulePorts.isEmpty()) {
-        qDebug() << "No ports found in matching groups, using all ports";
-        filteredModulePorts = groupModule;
-    } else {
-        qDebug() << "Using filtered ports for matching:" << filteredModulePorts;
-    }
-
-    /* Find optimal matching between bus signals and filtered module ports */
-    QMap<QString, QString> matching
-        = QStaticStringWeaver::findOptimalMatching(filteredModulePorts, groupBus, bestMarker);
+    const QMap<QString, QString> matching
+        = QStaticStringWeaver::matchBusInterface(groupModule, groupBus, busInterface);
 
     /* Debug output */
     for (auto it = matching.begin(); it != matching.end(); ++it) {
@@ -1148,72 +1100,6 @@ YAML::Node QSocModuleManager::showModuleBus(
     return result;
 }
 
-YAML::Node QSocModuleManager::mergeNodes(const YAML::Node &toYaml, const YAML::Node &fromYaml)
-{
-    if (!fromYaml.IsMap()) {
-        /* If fromYaml is not a map, merge result is fromYaml, unless fromYaml is null */
-        return fromYaml.IsNull() ? toYaml : fromYaml;
-    }
-    if (!toYaml.IsMap()) {
-        /* If toYaml is not a map, merge result is fromYaml */
-        return fromYaml;
-    }
-    if (!fromYaml.size()) {
-        /* If toYaml is a map, and fromYaml is an empty map, return toYaml */
-        return toYaml;
-    }
-    /* Create a new map 'resultYaml' with the same mappings as toYaml, merged with fromYaml */
-    YAML::Node resultYaml = YAML::Node(YAML::NodeType::Map);
-    for (auto iter : toYaml) {
-        if (iter.first.IsScalar()) {
-            const std::string &key      = iter.first.Scalar();
-            auto               tempYaml = YAML::Node(fromYaml[key]);
-            if (tempYaml) {
-                resultYaml[iter.first] = mergeNodes(iter.second, tempYaml);
-                continue;
-            }
-        }
-        resultYaml[iter.first] = iter.second;
-    }
-    /* Add the mappings from 'fromYaml' not already in 'resultYaml' */
-    for (auto iter : fromYaml) {
-        if (!iter.first.IsScalar() || !resultYaml[iter.first.Scalar()]) {
-            resultYaml[iter.first] = iter.second;
-        }
-    }
-    return resultYaml;
-}
-
-void QSocModuleManager::libraryMapAdd(const QString &libraryName, const QString &moduleName)
-{
-    /* Check if the library exists in the map */
-    if (!libraryMap.contains(libraryName)) {
-        /* If the key doesn't exist, create a new QSet and insert the moduleName */
-        QSet<QString> moduleSet;
-        moduleSet.insert(moduleName);
-        libraryMap.insert(libraryName, moduleSet);
-    } else {
-        /* If the key exists, just add the moduleName to the existing QSet */
-        libraryMap[libraryName].insert(moduleName);
-    }
-}
-
-void QSocModuleManager::libraryMapRemove(const QString &libraryName, const QString &moduleName)
-{
-    /* Check if the library exists in the map */
-    if (libraryMap.contains(libraryName)) {
-        QSet<QString> &modules = libraryMap[libraryName];
-
-        /* Remove the module if it exists in the set */
-        modules.remove(moduleName);
-
-        /* If the set becomes empty after removal, delete the library entry */
-        if (modules.isEmpty()) {
-            libraryMap.remove(libraryName);
-        }
-    }
-}
-
 void QSocModuleManager::setLLMService(QLLMService *llmService)
 {
     this->llmService = llmService;
@@ -2,8 +2,12 @@
 #define QSOCMODULEMANAGER_H
 
 #include "common/qllmservice.h"
+#include "common/qslangdriver.h"
 #include "common/qsocbusmanager.h"
+#include "common/qsoclibraryindex.h"
+#include "common/qsocnamematcher.h"
 #include "common/qsocprojectmanager.h"
+#include "common/qsocresidentlibraries.h"
 
 #include <QObject>
 #include <QRegularExpression>
@@ -35,6 +39,13 @@ public:
         QSocBusManager     *busManager     = nullptr,
         QLLMService        *llmService     = nullptr);
 
+    /**
+     * @brief Destructor.
+     * @details Leaves the loaded libraries for the next command of a long
+     *          running session, see QSocResidentLibraries.
+     */
+    ~QSocModuleManager() override;
+
 public slots:
     /**
      * @brief Set the project manager.
@@ -104,14 +115,20 @@ public slots:
      * @param moduleNameRegex Regular expression to match the module name.
      * @param fileListPath The path of the verilog file list.
      * @param filePathList The list of verilog files.
+     * @param parseJobs Number of threads that parse verilog files, 0 for
+     *        one per core, 1 for a single compilation unit.
+     * @param diagnostics Receives the slang diagnostics of the parse, also
+     *        when the import fails, may be nullptr.
      * @retval true Import successfully.
      * @retval false Import failed.
      */
     bool importFromFileList(
-        const QString            &libraryName,
-        const QRegularExpression &moduleNameRegex,
-        const QString            &fileListPath,
-        const QStringList        &filePathList);
+        const QString                   &libraryName,
+        const QRegularExpression        &moduleNameRegex,
+        const QString                   &fileListPath,
+        const QStringList               &filePathList,
+        int                              parseJobs   = 1,
+        QList<QSlangDriver::Diagnostic> *diagnostics = nullptr);
 
     /**
      * @brief Get the Module Yaml object.
@@ -158,12 +175,12 @@ public slots:
     /**
      * @brief Check if a library is loaded in memory.
      * @details Checks whether the specified library name exists in the
-     *          libraryMap. This function verifies if a library has been
+     *          libraryIndex. This function verifies if a library has been
      *          loaded into memory using one of the load() functions,
      *          rather than checking for the file's existence on disk.
      * @param libraryName Name of the library to check
-     * @retval true Library exists in libraryMap
-     * @retval false Library does not exist in libraryMap
+     * @retval true Library exists in libraryIndex
+     * @retval false Library does not exist in libraryIndex
      */
     bool isLibraryExist(const QString &libraryName);
 
@@ -223,7 +240,7 @@ public slots:
      * @brief Save library data associated with a specific basename.
      * @details Serializes and saves the module data related to the given
      *          `libraryName`. It locates the corresponding modules in
-     *          `moduleData` using `libraryMap`, then serializes them into YAML
+     *          `moduleData` using `libraryIndex`, then serializes them into YAML
      *          format. The result is saved to a file with the same basename,
      *          appending the ".soc_mod" extension. Existing files are
      *          overwritten. This function requires a valid projectManager.
@@ -235,7 +252,7 @@ public slots:
 
     /**
      * @brief Save multiple libraries matching a regex pattern.
-     * @details Iterates through `libraryMap` to find libraries matching the
+     * @details Iterates through `libraryIndex` to find libraries matching the
      *          provided regex pattern. Each matching library is serialized and
      *          saved individually in YAML format. Files are named after the
      *          library basenames with the ".soc_mod" extension. Existing files
@@ -250,7 +267,7 @@ public slots:
      * @brief Save multiple libraries by a list of basenames.
      * @details Serializes and saves module data related to each `libraryName`
      *          in `libraryNameList`. It locates corresponding modules in
-     *          `moduleData` using `libraryMap`, then serializes them into YAML
+     *          `moduleData` using `libraryIndex`, then serializes them into YAML
      *          format. Results are saved to files named after each basename,
      *          appending ".soc_mod". Existing files are overwritten. Requires
      *          a valid projectManager.
@@ -338,6 +355,15 @@ public slots:
      */
     QStringList listModule(const QRegularExpression &moduleNameRegex = QRegularExpression(".*"));
 
+    /**
+     * @brief Get list of module names matching any of several patterns.
+     * @details Same as listModule() with a regex, the patterns are matched
+     *          in one pass over `moduleData`.
+     * @param moduleNameMatcher Patterns to match module names.
+     * @return QStringList of matching module names in the module library.
+     */
+    QStringList listModule(const QSocNameMatcher &moduleNameMatcher);
+
     /**
      * @brief Retrieve YAML nodes for modules matching the regex.
      * @details Fetches and returns YAML nodes for all modules whose names
@@ -355,6 +381,14 @@ public slots:
      */
     YAML::Node getModuleYamls(const QRegularExpression &moduleNameRegex = QRegularExpression(".*"));
 
+    /**
+     * @brief Retrieve YAML nodes for modules matching any of several patterns.
+     * @param moduleNameMatcher Patterns to match module names.
+     * @return YAML::Node A map of YAML nodes by module name, empty if no
+     *                    matches are found.
+     */
+    YAML::Node getModuleYamls(const QSocNameMatcher &moduleNameMatcher);
+
     /**
      * @brief Update existing module's YAML data and save to its library file
      * @details Updates the YAML data for an existing module in moduleData and
@@ -372,7 +406,7 @@ public slots:
     /**
      * @brief Remove modules matching regex from module library.
      * @details Removes modules that match `moduleNameRegex` from moduleData,
-     *          updating libraryMap accordingly. It saves libraries with
+     *          updating libraryIndex accordingly. It saves libraries with
      *          remaining module associations and removes files with no
      *          associations. Requires a valid projectManager for execution.
      * @param moduleNameRegex Regex to filter module names for removal.
@@ -381,6 +415,16 @@ public slots:
      */
     bool removeModule(const QRegularExpression &moduleNameRegex);
 
+    /**
+     * @brief Remove modules matching any of several patterns.
+     * @details Same as removeModule() with a regex, every affected library
+     *          is saved or removed once.
+     * @param moduleNameMatcher Patterns to match module names for removal.
+     * @retval true All matching modules are successfully processed.
+     * @retval false Errors occur during module removal or module saving.
+     */
+    bool removeModule(const QSocNameMatcher &moduleNameMatcher);
+
     /**
      * @brief Add a bus interface to a module.
      * @details This function adds a bus interface to a specified module by
@@ -461,58 +505,16 @@ private:
     /* Internal used LLM service. */
     QLLMService *llmService = nullptr;
 
-    /* This QMap, libraryMap, maps library names to sets of module names.
-       Each key in the map is a library name (QString).
-       The corresponding value is a QSet<QString> containing the names
-       of all modules that are part of that library.
-       - key: QString libraryName
-       - value: QSet<QString> moduleNameSet
-       This structure ensures that each library name is associated with
-       a unique set of module names, allowing efficient retrieval and
-       management of modules within each library. */
-    QMap<QString, QSet<QString>> libraryMap;
+    /* Owning library of every loaded module, and the sorted module names
+       of every library. Kept in step with moduleData so owner lookups and
+       per-library iteration do not scan the YAML node. */
+    QSocLibraryIndex libraryIndex;
 
     /* Module library YAML node. */
     YAML::Node moduleData;
 
-    /**
-     * @brief Merge two YAML nodes.
-     * @details This function will merge two YAML nodes. It returns a new map
-     *          resultYaml which is a merge of fromYaml into toYaml.
-     *          Values from fromYaml will replace identically keyed non-map
-     *          values from toYaml in the resultYaml map.
-     *          The values ​​in toYaml and fromYaml will not be modified.
-     * @param toYaml The destination YAML node.
-     * @param fromYaml The source YAML node.
-     * @return YAML::Node The merged YAML node which is a merge of fromYaml into
-     *                    toYaml.
-     */
-    YAML::Node mergeNodes(const YAML::Node &toYaml, const YAML::Node &fromYaml);
-
-    /**
-     * @brief Adds a module name to the library map.
-     * @details This function adds a given module name to the set of modules
-     *          associated with a specified library in the libraryMap.
-     *          If the library does not already exist in the map, it creates
-     *          a new entry with an empty set of modules and then adds the
-     *          module name. If the library exists, it simply adds the module
-     *          name to the existing set.
-     * @param libraryName The name of the library.
-     * @param moduleName The name of the module to add to the library.
-     */
-    void libraryMapAdd(const QString &libraryName, const QString &moduleName);
-
-    /**
-     * @brief Removes a module from a library in the library map.
-     * @details This function removes the specified module from the set
-     *          associated with the given library name in the library map. If
-     *          the module is the only one in the set, it also removes the
-     *          entire library entry from the map. Does nothing if the library
-     *          or module does not exist.
-     * @param libraryName The name of the library to be modified.
-     * @param moduleName The name of the module to be removed.
-     */
-    void libraryMapRemove(const QString &libraryName, const QString &moduleName);
+    /* Libraries kept in moduleData between the commands of a session. */
+    QSocResidentLibraries residentLibraries;
 
 signals:
 };
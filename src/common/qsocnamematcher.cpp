@@ -0,0 +1,234 @@
+#include "common/qsocnamematcher.h"
+
+#include "common/qstaticregex.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+/* Compiled expressions kept by compile(), the cache is dropped when full */
+constexpr qsizetype kRegexCacheSize = 256;
+} // namespace
+
+QSocNameMatcher::QSocNameMatcher(const QStringList &patterns)
+{
+    QStringList regexPatterns;
+    for (const QString &pattern : patterns) {
+        addPattern(pattern, regexPatterns);
+    }
+    if (regexPatterns.isEmpty()) {
+        return;
+    }
+
+    /* Validate one by one so the offending pattern can be reported */
+    static const QRegularExpression groupReference(
+        "\\\\[1-9gkP]|\\(\\?(?:P?<[A-Za-z_]|'|[0-9+-]|&|R\\))");
+    QStringList joinable;
+    for (const QString &pattern : regexPatterns) {
+        const QRegularExpression regex = compile(pattern, QRegularExpression::NoPatternOption);
+        if (!regex.isValid()) {
+            if (invalidPattern.isEmpty()) {
+                invalidPattern = pattern;
+            }
+        } else if (pattern.contains(groupReference)) {
+            /* Group references and names would clash inside an alternation */
+            regexes.append(regex);
+        } else {
+            joinable.append(pattern);
+        }
+    }
+    if (joinable.size() == 1) {
+        regexes.append(compile(joinable.first(), QRegularExpression::NoPatternOption));
+    } else if (!joinable.isEmpty()) {
+        regexes.append(
+            compile("(?:" + joinable.join(")|(?:") + ")", QRegularExpression::NoPatternOption));
+    }
+}
+
+QSocNameMatcher::QSocNameMatcher(const QRegularExpression &regex)
+{
+    if (!regex.isValid()) {
+        invalidPattern = regex.pattern();
+        return;
+    }
+    /* Options such as case insensitivity only apply to real expressions */
+    if (regex.patternOptions() != QRegularExpression::NoPatternOption
+        && QStaticRegex::isNameRegularExpression(regex.pattern())) {
+        regexes.append(compile(regex.pattern(), regex.patternOptions()));
+        return;
+    }
+    QStringList regexPatterns;
+    addPattern(regex.pattern(), regexPatterns);
+    for (const QString &pattern : regexPatterns) {
+        regexes.append(compile(pattern, QRegularExpression::NoPatternOption));
+    }
+}
+
+bool QSocNameMatcher::isValid() const
+{
+    return invalidPattern.isEmpty();
+}
+
+const QString &QSocNameMatcher::getInvalidPattern() const
+{
+    return invalidPattern;
+}
+
+bool QSocNameMatcher::isEmpty() const
+{
+    return !matchAll && literals.isEmpty() && prefixes.isEmpty() && suffixes.isEmpty()
+           && substrings.isEmpty() && regexes.isEmpty();
+}
+
+bool QSocNameMatcher::matches(const QString &name) const
+{
+    if (matchAll || literals.contains(name)) {
+        return true;
+    }
+    for (const QString &prefix : prefixes) {
+        if (name.startsWith(prefix)) {
+            return true;
+        }
+    }
+    for (const QString &suffix : suffixes) {
+        if (name.endsWith(suffix)) {
+            return true;
+        }
+    }
+    for (const QString &substring : substrings) {
+        if (name.contains(substring)) {
+            return true;
+        }
+    }
+    for (const QRegularExpression &regex : regexes) {
+        if (regex.match(name).hasMatch()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QStringList QSocNameMatcher::filter(const QStringList &names) const
+{
+    if (matchAll) {
+        return names;
+    }
+    QStringList result;
+    for (const QString &name : names) {
+        if (matches(name)) {
+            result.append(name);
+        }
+    }
+    return result;
+}
+
+QStringList QSocNameMatcher::filterSorted(const QStringList &sortedNames) const
+{
+    if (matchAll || !suffixes.isEmpty() || !substrings.isEmpty() || !regexes.isEmpty()) {
+        return filter(sortedNames);
+    }
+
+    /* Plain names and prefixes select ranges of the sorted list */
+    std::vector<bool> selected(sortedNames.size(), false);
+    for (const QString &literal : literals) {
+        const auto iterator = std::lower_bound(sortedNames.begin(), sortedNames.end(), literal);
+        if (iterator != sortedNames.end() && *iterator == literal) {
+            selected[iterator - sortedNames.begin()] = true;
+        }
+    }
+    for (const QString &prefix : prefixes) {
+        auto iterator = std::lower_bound(sortedNames.begin(), sortedNames.end(), prefix);
+        for (; iterator != sortedNames.end() && iterator->startsWith(prefix); ++iterator) {
+            selected[iterator - sortedNames.begin()] = true;
+        }
+    }
+
+    QStringList result;
+    for (qsizetype index = 0; index < sortedNames.size(); index++) {
+        if (selected[index]) {
+            result.append(sortedNames.at(index));
+        }
+    }
+    return result;
+}
+
+void QSocNameMatcher::addPattern(const QString &pattern, QStringList &regexPatterns)
+{
+    if (pattern.isEmpty()) {
+        return;
+    }
+    if (!QStaticRegex::isNameRegularExpression(pattern)) {
+        literals.insert(pattern);
+        return;
+    }
+
+    /* Peel anchors and leading or trailing `.*` off a plain core */
+    QString core           = pattern;
+    bool    anchoredStart  = false;
+    bool    anchoredEnd    = false;
+    bool    wildcardBefore = false;
+    bool    wildcardAfter  = false;
+    if (core.startsWith('^')) {
+        anchoredStart = true;
+        core.remove(0, 1);
+    }
+    if (core.endsWith('$') && !core.endsWith("\\$")) {
+        anchoredEnd = true;
+        core.chop(1);
+    }
+    if (core.startsWith(".*")) {
+        wildcardBefore = true;
+        core.remove(0, 2);
+    }
+    if (core.endsWith(".*") && !core.endsWith("\\.*")) {
+        wildcardAfter = true;
+        core.chop(2);
+    }
+    const bool fixedStart = anchoredStart && !wildcardBefore;
+    const bool fixedEnd   = anchoredEnd && !wildcardAfter;
+
+    if (core.isEmpty()) {
+        /* `^$` only matches an empty name, leave it to the regex engine */
+        if (fixedStart && fixedEnd) {
+            regexPatterns.append(pattern);
+        } else {
+            matchAll = true;
+        }
+    } else if (QStaticRegex::isNameRegularExpression(core)) {
+        regexPatterns.append(pattern);
+    } else if (fixedStart && fixedEnd) {
+        literals.insert(core);
+    } else if (fixedStart) {
+        prefixes.append(core);
+    } else if (fixedEnd) {
+        suffixes.append(core);
+    } else {
+        substrings.append(core);
+    }
+}
+
+QRegularExpression QSocNameMatcher::compile(
+    const QString &pattern, QRegularExpression::PatternOptions options)
+{
+    static QMutex                             mutex;
+    static QHash<QString, QRegularExpression> cache;
+
+    const QMutexLocker locker(&mutex);
+    const auto         iterator = cache.constFind(pattern);
+    if (iterator != cache.constEnd() && iterator->patternOptions() == options) {
+        return *iterator;
+    }
+
+    QRegularExpression regex(pattern, options);
+    /* Compile now, with JIT where available, instead of on the first match */
+    regex.optimize();
+    if (cache.size() >= kRegexCacheSize) {
+        cache.clear();
+    }
+    cache.insert(pattern, regex);
+    return regex;
+}
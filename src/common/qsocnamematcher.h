@@ -0,0 +1,122 @@
+#ifndef QSOCNAMEMATCHER_H
+#define QSOCNAMEMATCHER_H
+
+#include <QList>
+#include <QRegularExpression>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief The QSocNameMatcher class.
+ * @details Matches names against a list of name patterns with the rules of
+ *          QStaticRegex::isNameExactMatch(): plain names match exactly,
+ *          regular expressions match anywhere in the name. A name matches
+ *          the list if it matches any pattern. Patterns are sorted by shape
+ *          once, so matching a name rarely needs a regular expression:
+ *          plain names are looked up in a hash set, patterns such as `^abc`,
+ *          `abc.*$` or `.*abc` become prefix, suffix or substring tests, and
+ *          `.*` matches everything. The remaining regular expressions are
+ *          joined into one alternation that is compiled once, optimized and
+ *          cached for later matchers with the same patterns.
+ */
+class QSocNameMatcher
+{
+public:
+    /**
+     * @brief Constructor of an empty matcher, it matches nothing.
+     */
+    QSocNameMatcher() = default;
+
+    /**
+     * @brief Constructor.
+     * @param patterns Name patterns, empty patterns are ignored.
+     */
+    explicit QSocNameMatcher(const QStringList &patterns);
+
+    /**
+     * @brief Constructor.
+     * @param regex Name pattern, its options are kept if it is matched as a
+     *        regular expression.
+     */
+    explicit QSocNameMatcher(const QRegularExpression &regex);
+
+    /**
+     * @brief Check if all patterns are valid.
+     * @retval true All patterns are valid.
+     * @retval false Some pattern is not a valid regular expression.
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Get the first invalid pattern.
+     * @return const QString & The pattern, empty if all are valid.
+     */
+    const QString &getInvalidPattern() const;
+
+    /**
+     * @brief Check if the matcher has no pattern.
+     * @retval true No pattern, nothing matches.
+     * @retval false Some pattern is set.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Check if a name matches any pattern.
+     * @param name The name.
+     * @retval true The name matches.
+     * @retval false The name does not match.
+     */
+    bool matches(const QString &name) const;
+
+    /**
+     * @brief Select the matching names.
+     * @param names The names.
+     * @return QStringList The matching names in the given order.
+     */
+    QStringList filter(const QStringList &names) const;
+
+    /**
+     * @brief Select the matching names of a sorted list.
+     * @details Plain names and prefixes are found by binary search, other
+     *          patterns fall back to filter().
+     * @param sortedNames The names sorted by QString::operator<().
+     * @return QStringList The matching names in sorted order.
+     */
+    QStringList filterSorted(const QStringList &sortedNames) const;
+
+private:
+    /** Some pattern matches every name. */
+    bool matchAll = false;
+    /** Plain names. */
+    QSet<QString> literals;
+    /** Required name prefixes. */
+    QStringList prefixes;
+    /** Required name suffixes. */
+    QStringList suffixes;
+    /** Required substrings. */
+    QStringList substrings;
+    /** Regular expressions, joined where possible. */
+    QList<QRegularExpression> regexes;
+    /** First invalid pattern. */
+    QString invalidPattern;
+
+    /**
+     * @brief Sort a pattern into the matcher.
+     * @param pattern The pattern.
+     * @param regexPatterns Receives patterns that need a regular expression.
+     */
+    void addPattern(const QString &pattern, QStringList &regexPatterns);
+
+    /**
+     * @brief Get a compiled regular expression.
+     * @details Compiled expressions are cached by pattern and options.
+     * @param pattern The pattern.
+     * @param options The pattern options.
+     * @return QRegularExpression The optimized expression.
+     */
+    static QRegularExpression compile(
+        const QString &pattern, QRegularExpression::PatternOptions options);
+};
+
+#endif // QSOCNAMEMATCHER_H
@@ -0,0 +1,296 @@
+#include "common/qsocnetlistchecker.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace {
+/* Nets per thread below which spawning another thread does not pay off */
+constexpr int kMinNetsPerThread = 4096;
+} // namespace
+
+QSocNetlistChecker::QSocNetlistChecker(const QSocNetlistGraph &graph)
+    : graph(graph)
+{}
+
+void QSocNetlistChecker::run(int threadCount)
+{
+    violations.clear();
+    errorCount   = 0;
+    warningCount = 0;
+
+    /* Instance checks are a single cheap pass */
+    checkInstances(violations);
+
+    /* Split nets into contiguous shards, one per thread */
+    const int netCount = graph.netCount();
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    const int maxShards  = std::max(1, (netCount + kMinNetsPerThread - 1) / kMinNetsPerThread);
+    const int shardCount = std::clamp(threadCount, 1, maxShards);
+    const int shardSize  = (netCount + shardCount - 1) / std::max(shardCount, 1);
+
+    std::vector<std::vector<Violation>> shardResults(shardCount);
+    if (shardCount == 1) {
+        checkNets(0, netCount, shardResults[0]);
+    } else {
+        std::vector<std::thread> workers;
+        workers.reserve(shardCount);
+        for (int shard = 0; shard < shardCount; shard++) {
+            const int first = std::min(shard * shardSize, netCount);
+            const int last  = std::min(first + shardSize, netCount);
+            workers.emplace_back([this, first, last, &result = shardResults[shard]]() {
+                checkNets(first, last, result);
+            });
+        }
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+    }
+
+    /* Concatenate in shard order, so the report is deterministic */
+    for (std::vector<Violation> &result : shardResults) {
+        violations.insert(
+            violations.end(),
+            std::make_move_iterator(result.begin()),
+            std::make_move_iterator(result.end()));
+    }
+
+    for (const Violation &violation : violations) {
+        if (violation.severity == Severity::Error) {
+            errorCount++;
+        } else {
+            warningCount++;
+        }
+    }
+}
+
+const std::vector<QSocNetlistChecker::Violation> &QSocNetlistChecker::getViolations() const
+{
+    return violations;
+}
+
+int QSocNetlistChecker::getErrorCount() const
+{
+    return errorCount;
+}
+
+int QSocNetlistChecker::getWarningCount() const
+{
+    return warningCount;
+}
+
+YAML::Node QSocNetlistChecker::getReport() const
+{
+    YAML::Node report;
+    report["summary"]["instance"] = graph.instanceCount();
+    report["summary"]["net"]      = graph.netCount();
+    report["summary"]["error"]    = errorCount;
+    report["summary"]["warning"]  = warningCount;
+
+    YAML::Node violationsYaml(YAML::NodeType::Sequence);
+    for (const Violation &violation : violations) {
+        YAML::Node violationYaml;
+        violationYaml["rule"]     = violation.rule;
+        violationYaml["severity"] = severityName(violation.severity);
+        if (!violation.net.empty()) {
+            violationYaml["net"] = violation.net;
+        }
+        if (!violation.instance.empty()) {
+            violationYaml["instance"] = violation.instance;
+        }
+        if (!violation.pins.empty()) {
+            violationYaml["pin"] = violation.pins;
+        }
+        violationYaml["message"] = violation.message;
+        violationsYaml.push_back(violationYaml);
+    }
+    report["violation"] = violationsYaml;
+
+    return report;
+}
+
+const char *QSocNetlistChecker::severityName(Severity severity)
+{
+    return severity == Severity::Error ? "error" : "warning";
+}
+
+void QSocNetlistChecker::checkInstances(std::vector<Violation> &result) const
+{
+    for (int instance = 0; instance < graph.instanceCount(); instance++) {
+        const QSocNetlistGraph::Instance &instanceData = graph.instance(instance);
+        const std::string                &instanceName = graph.symbolName(instanceData.name);
+
+        /* Module must be specified and exist in the library */
+        if (instanceData.module < 0 || !graph.module(instanceData.module).found) {
+            Violation violation;
+            violation.rule     = "unresolved-module";
+            violation.instance = instanceName;
+            violation.message
+                = instanceData.module < 0
+                      ? "Instance " + instanceName + " has no module"
+                      : "Module " + graph.symbolName(graph.module(instanceData.module).name)
+                            + " of instance " + instanceName + " not found in library";
+            result.push_back(std::move(violation));
+            continue;
+        }
+
+        /* Each port may be connected to one net only, pins are in port order after sorting */
+        const auto       pins = graph.instancePins(instance);
+        std::vector<int> connected(pins.begin(), pins.end());
+        std::stable_sort(connected.begin(), connected.end(), [this](int left, int right) {
+            return graph.pin(left).port < graph.pin(right).port;
+        });
+        for (size_t index = 0; index < connected.size();) {
+            const int port = graph.pin(connected[index]).port;
+            size_t    end  = index + 1;
+            while (end < connected.size() && graph.pin(connected[end]).port == port) {
+                end++;
+            }
+            if (port >= 0 && end - index > 1) {
+                Violation violation;
+                violation.rule     = "multiple-connections";
+                violation.instance = instanceName;
+                for (size_t other = index; other < end; other++) {
+                    violation.pins.push_back(
+                        pinName(connected[other]) + " -> "
+                        + graph.netName(graph.pin(connected[other]).net));
+                }
+                violation.message = "Port " + pinName(connected[index]) + " is connected to "
+                                    + std::to_string(end - index) + " nets";
+                result.push_back(std::move(violation));
+            }
+            index = end;
+        }
+    }
+}
+
+void QSocNetlistChecker::checkNets(int first, int last, std::vector<Violation> &result) const
+{
+    for (int net = first; net < last; net++) {
+        const std::string &netName = graph.netName(net);
+        const auto         pins    = graph.netPins(net);
+
+        std::vector<int> outputs;
+        std::vector<int> inouts;
+        std::vector<int> inputs;
+        int              width      = 0;
+        bool             widthMatch = true;
+
+        for (const int pin : pins) {
+            const QSocNetlistGraph::Pin &pinData = graph.pin(pin);
+
+            /* References must resolve, unresolved modules are reported per instance */
+            if (pinData.instance < 0) {
+                Violation violation;
+                violation.rule    = "unresolved-instance";
+                violation.net     = netName;
+                violation.pins    = {pinName(pin)};
+                violation.message = "Instance " + graph.symbolName(pinData.instanceName)
+                                    + " referenced in net " + netName + " not found in netlist";
+                result.push_back(std::move(violation));
+                continue;
+            }
+            const int module = graph.instance(pinData.instance).module;
+            if (module < 0 || !graph.module(module).found) {
+                continue;
+            }
+            const QSocNetlistGraph::Port *port = graph.pinPort(pin);
+            if (!port) {
+                Violation violation;
+                violation.rule    = "unresolved-port";
+                violation.net     = netName;
+                violation.pins    = {pinName(pin)};
+                violation.message = "Port " + graph.symbolName(pinData.portName)
+                                    + " not found in module "
+                                    + graph.symbolName(graph.module(module).name);
+                result.push_back(std::move(violation));
+                continue;
+            }
+
+            /* Classify by direction */
+            switch (port->direction) {
+            case QSocNetlistGraph::Direction::Output:
+                outputs.push_back(pin);
+                break;
+            case QSocNetlistGraph::Direction::Inout:
+                inouts.push_back(pin);
+                break;
+            case QSocNetlistGraph::Direction::Input:
+                inputs.push_back(pin);
+                break;
+            default:
+                break;
+            }
+
+            /* Widths are only compared when known */
+            const int portWidth = graph.pinWidth(pin);
+            if (portWidth > 0) {
+                if (width == 0) {
+                    width = portWidth;
+                } else if (portWidth != width) {
+                    widthMatch = false;
+                }
+            }
+        }
+
+        if (outputs.size() > 1) {
+            Violation violation;
+            violation.rule = "multiple-drivers";
+            violation.net  = netName;
+            for (const int pin : outputs) {
+                violation.pins.push_back(pinName(pin));
+            }
+            violation.message = "Net " + netName + " is driven by " + std::to_string(outputs.size())
+                                + " outputs";
+            result.push_back(std::move(violation));
+        }
+
+        if (!outputs.empty() && !inouts.empty()) {
+            Violation violation;
+            violation.rule = "direction-conflict";
+            violation.net  = netName;
+            for (const int pin : outputs) {
+                violation.pins.push_back(pinName(pin));
+            }
+            for (const int pin : inouts) {
+                violation.pins.push_back(pinName(pin));
+            }
+            violation.message = "Net " + netName + " is driven by both outputs and inouts";
+            result.push_back(std::move(violation));
+        }
+
+        if (!inputs.empty() && outputs.empty() && inouts.empty()) {
+            Violation violation;
+            violation.severity = Severity::Warning;
+            violation.rule     = "undriven";
+            violation.net      = netName;
+            for (const int pin : inputs) {
+                violation.pins.push_back(pinName(pin));
+            }
+            violation.message = "Net " + netName + " has inputs but no driver";
+            result.push_back(std::move(violation));
+        }
+
+        if (!widthMatch) {
+            Violation violation;
+            violation.severity = Severity::Warning;
+            violation.rule     = "width-mismatch";
+            violation.net      = netName;
+            for (const int pin : pins) {
+                const int portWidth = graph.pinWidth(pin);
+                if (portWidth > 0) {
+                    violation.pins.push_back(pinName(pin) + " [" + std::to_string(portWidth) + "]");
+                }
+            }
+            violation.message = "Ports on net " + netName + " have different widths";
+            result.push_back(std::move(violation));
+        }
+    }
+}
+
+std::string QSocNetlistChecker::pinName(int pin) const
+{
+    const QSocNetlistGraph::Pin &pinData = graph.pin(pin);
+    return graph.symbolName(pinData.instanceName) + "." + graph.symbolName(pinData.portName);
+}
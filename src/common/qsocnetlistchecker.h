@@ -0,0 +1,136 @@
+#ifndef QSOCNETLISTCHECKER_H
+#define QSOCNETLISTCHECKER_H
+
+#include "common/qsocnetlistgraph.h"
+
+#include <string>
+#include <vector>
+
+#include <yaml-cpp/yaml.h>
+
+/**
+ * @brief The QSocNetlistChecker class.
+ * @details This class runs design-rule checks over a built connectivity
+ *          graph. Nets are split into contiguous shards that are checked on
+ *          worker threads, each thread collects its own violations and the
+ *          results are concatenated in net order, so the report does not
+ *          depend on the number of threads. The following rules are checked:
+ *          - unresolved-module: instance has no module or the module is not
+ *            in the library (error).
+ *          - unresolved-instance: net references a missing instance (error).
+ *          - unresolved-port: net references a port the module does not
+ *            have (error).
+ *          - multiple-connections: an instance port is connected to more
+ *            than one net (error).
+ *          - multiple-drivers: net is driven by more than one output (error).
+ *          - direction-conflict: net is driven by an output and an inout at
+ *            the same time (error).
+ *          - undriven: net has inputs but no output or inout driver (warning).
+ *          - width-mismatch: ports on a net have different widths (warning).
+ */
+class QSocNetlistChecker
+{
+public:
+    /**
+     * @brief Violation severity.
+     */
+    enum class Severity { Warning, Error };
+
+    /**
+     * @brief The Violation struct.
+     * @details A single design-rule violation.
+     */
+    struct Violation
+    {
+        Severity                 severity = Severity::Error; /* Violation severity */
+        std::string              rule;                       /* Rule name */
+        std::string              net;                        /* Net name, empty if none */
+        std::string              instance;                   /* Instance name, empty if none */
+        std::vector<std::string> pins;                       /* Involved pins as instance.port */
+        std::string              message;                    /* Human-readable description */
+    };
+
+    /**
+     * @brief Constructor.
+     * @details The graph must be built and must outlive the checker.
+     * @param graph The connectivity graph to check.
+     */
+    explicit QSocNetlistChecker(const QSocNetlistGraph &graph);
+
+    /**
+     * @brief Run all checks.
+     * @details Clears the previous results and checks the graph again.
+     * @param threadCount Number of worker threads, 0 to use one thread per
+     *        hardware core. Small netlists are checked on fewer threads.
+     */
+    void run(int threadCount = 0);
+
+    /**
+     * @brief Get the violations found by the last run.
+     * @details Instance violations come first, followed by net violations in
+     *          net order.
+     * @return const std::vector<Violation> & The violations.
+     */
+    const std::vector<Violation> &getViolations() const;
+
+    /**
+     * @brief Get the number of errors found by the last run.
+     * @return int The number of violations with error severity.
+     */
+    int getErrorCount() const;
+
+    /**
+     * @brief Get the number of warnings found by the last run.
+     * @return int The number of violations with warning severity.
+     */
+    int getWarningCount() const;
+
+    /**
+     * @brief Get the report of the last run.
+     * @details The report has a "summary" map with the instance, net, error
+     *          and warning counts, and a "violation" sequence with one map
+     *          per violation.
+     * @return YAML::Node The report.
+     */
+    YAML::Node getReport() const;
+
+    /**
+     * @brief Get the name of a severity.
+     * @param severity The severity.
+     * @return const char * "error" or "warning".
+     */
+    static const char *severityName(Severity severity);
+
+private:
+    /** Connectivity graph being checked. */
+    const QSocNetlistGraph &graph;
+    /** Violations of the last run. */
+    std::vector<Violation> violations;
+    /** Number of errors of the last run. */
+    int errorCount = 0;
+    /** Number of warnings of the last run. */
+    int warningCount = 0;
+
+    /**
+     * @brief Check all instances.
+     * @param result Output violations.
+     */
+    void checkInstances(std::vector<Violation> &result) const;
+
+    /**
+     * @brief Check a range of nets.
+     * @param first First net ID.
+     * @param last One past the last net ID.
+     * @param result Output violations.
+     */
+    void checkNets(int first, int last, std::vector<Violation> &result) const;
+
+    /**
+     * @brief Get the display name of a pin.
+     * @param pin The pin ID.
+     * @return std::string The pin as instance.port.
+     */
+    std::string pinName(int pin) const;
+};
+
+#endif // QSOCNETLISTCHECKER_H
@@ -0,0 +1,445 @@
+#include "common/qsocnetlistgraph.h"
+
+#include <algorithm>
+#include <cctype>
+
+void QSocNetlistGraph::clear()
+{
+    symbolNames.clear();
+    symbolIds.clear();
+    symbolInstance.clear();
+    symbolNet.clear();
+    symbolModule.clear();
+    modules.clear();
+    instances.clear();
+    nets.clear();
+    pins.clear();
+    netPinOffsets.clear();
+    netPinList.clear();
+    instancePinOffsets.clear();
+    instancePinList.clear();
+    variants.clear();
+    variantIndex.clear();
+    built = false;
+}
+
+int QSocNetlistGraph::intern(std::string_view name)
+{
+    const auto iter = symbolIds.find(name);
+    if (iter != symbolIds.end()) {
+        return iter->second;
+    }
+
+    /* The deque never relocates its elements, so the view stays valid */
+    const int symbol = static_cast<int>(symbolNames.size());
+    symbolNames.emplace_back(name);
+    symbolIds.emplace(std::string_view(symbolNames.back()), symbol);
+    symbolInstance.push_back(-1);
+    symbolNet.push_back(-1);
+    symbolModule.push_back(-1);
+    return symbol;
+}
+
+int QSocNetlistGraph::findSymbol(std::string_view name) const
+{
+    const auto iter = symbolIds.find(name);
+    return iter == symbolIds.end() ? -1 : iter->second;
+}
+
+const std::string &QSocNetlistGraph::symbolName(int symbol) const
+{
+    return symbolNames[symbol];
+}
+
+int QSocNetlistGraph::addInstance(const std::string &name, const std::string &moduleName)
+{
+    const int symbol = intern(name);
+    if (symbolInstance[symbol] >= 0) {
+        return symbolInstance[symbol];
+    }
+
+    Instance instance;
+    instance.name = symbol;
+
+    /* Modules are shared by all of their instances */
+    if (!moduleName.empty()) {
+        const int moduleSymbol = intern(moduleName);
+        if (symbolModule[moduleSymbol] < 0) {
+            Module module;
+            module.name                = moduleSymbol;
+            symbolModule[moduleSymbol] = static_cast<int>(modules.size());
+            modules.push_back(std::move(module));
+        }
+        instance.module = symbolModule[moduleSymbol];
+    }
+
+    const int id           = static_cast<int>(instances.size());
+    symbolInstance[symbol] = id;
+    instances.push_back(std::move(instance));
+    built = false;
+    return id;
+}
+
+void QSocNetlistGraph::addParameter(int instance, const std::string &name, const std::string &value)
+{
+    instances[instance].parameters.emplace_back(name, value);
+}
+
+int QSocNetlistGraph::findInstance(std::string_view name) const
+{
+    const int symbol = findSymbol(name);
+    return symbol < 0 ? -1 : symbolInstance[symbol];
+}
+
+int QSocNetlistGraph::addNet(const std::string &name)
+{
+    const int symbol = intern(name);
+    if (symbolNet[symbol] >= 0) {
+        return symbolNet[symbol];
+    }
+
+    const int id      = static_cast<int>(nets.size());
+    symbolNet[symbol] = id;
+    nets.push_back(symbol);
+    built = false;
+    return id;
+}
+
+int QSocNetlistGraph::findNet(std::string_view name) const
+{
+    const int symbol = findSymbol(name);
+    return symbol < 0 ? -1 : symbolNet[symbol];
+}
+
+void QSocNetlistGraph::clearNet(int net)
+{
+    pins.erase(
+        std::remove_if(pins.begin(), pins.end(), [net](const Pin &pin) { return pin.net == net; }),
+        pins.end());
+    built = false;
+}
+
+void QSocNetlistGraph::removeNet(int net)
+{
+    clearNet(net);
+    symbolNet[nets[net]] = -1;
+    nets.erase(nets.begin() + net);
+    for (int id = net; id < static_cast<int>(nets.size()); id++) {
+        symbolNet[nets[id]] = id;
+    }
+    for (Pin &pin : pins) {
+        if (pin.net > net) {
+            pin.net--;
+        }
+    }
+}
+
+int QSocNetlistGraph::addPin(int net, const std::string &instanceName, const std::string &portName)
+{
+    Pin pin;
+    pin.net          = net;
+    pin.instanceName = intern(instanceName);
+    pin.portName     = intern(portName);
+
+    const int id = static_cast<int>(pins.size());
+    pins.push_back(pin);
+    built = false;
+    return id;
+}
+
+void QSocNetlistGraph::build(const ModuleLookup &lookup)
+{
+    /* Load the parameters and ports of each referenced module exactly once */
+    for (Module &module : modules) {
+        module.found         = false;
+        module.parameterized = false;
+        module.parameters.clear();
+        module.ports.clear();
+        module.portIndex.clear();
+
+        const YAML::Node moduleData = lookup ? lookup(symbolNames[module.name]) : YAML::Node();
+        if (!moduleData || !moduleData.IsMap()) {
+            continue;
+        }
+        module.found = true;
+
+        const YAML::Node parametersData = moduleData["parameter"];
+        if (parametersData && parametersData.IsMap()) {
+            for (const auto &paramPair : parametersData) {
+                const YAML::Node &paramData = paramPair.second;
+                if (paramPair.first.IsScalar() && paramData.IsMap() && paramData["value"]
+                    && paramData["value"].IsScalar()) {
+                    module.parameters.emplace_back(
+                        paramPair.first.as<std::string>(), paramData["value"].as<std::string>());
+                }
+            }
+        }
+        const QSocPortType::ParameterMap defaults = QSocPortType::foldParameters(
+            module.parameters);
+
+        const YAML::Node portsData = moduleData["port"];
+        if (!portsData || !portsData.IsMap()) {
+            continue;
+        }
+        module.ports.reserve(portsData.size());
+        for (const auto &portPair : portsData) {
+            if (!portPair.first.IsScalar()) {
+                continue;
+            }
+            Port              port;
+            const YAML::Node &portData = portPair.second;
+            port.name                  = intern(portPair.first.as<std::string>());
+            if (portData.IsMap()) {
+                if (portData["direction"] && portData["direction"].IsScalar()) {
+                    port.direction = parseDirection(portData["direction"].as<std::string>());
+                }
+                if (portData["type"] && portData["type"].IsScalar()) {
+                    port.type = portData["type"].as<std::string>();
+                }
+                /* Types are parsed once per module port, not once per connection */
+                port.shape.parse(port.type);
+                if (portData["width"] && portData["width"].IsScalar()) {
+                    port.width         = portData["width"].as<int>();
+                    port.explicitWidth = true;
+                } else {
+                    port.shape.resolve(defaults);
+                    port.width = port.shape.width();
+                    module.parameterized |= port.shape.isParameterized();
+                }
+            }
+            module.portIndex.emplace(port.name, static_cast<int>(module.ports.size()));
+            module.ports.push_back(std::move(port));
+        }
+    }
+
+    /* Instances with the same module and overrides share resolved port types */
+    variants.clear();
+    variantIndex.clear();
+    for (int instance = 0; instance < static_cast<int>(instances.size()); instance++) {
+        const int module            = instances[instance].module;
+        instances[instance].variant = (module >= 0 && modules[module].found)
+                                          ? resolveVariant(instance)
+                                          : -1;
+    }
+
+    /* Resolve pins to instances and module ports */
+    for (Pin &pin : pins) {
+        pin.instance = symbolInstance[pin.instanceName];
+        pin.port     = -1;
+        if (pin.instance < 0 || instances[pin.instance].module < 0) {
+            continue;
+        }
+        const Module &module = modules[instances[pin.instance].module];
+        const auto    iter   = module.portIndex.find(pin.portName);
+        if (iter != module.portIndex.end()) {
+            pin.port = iter->second;
+        }
+    }
+
+    /* Build adjacency in both directions */
+    buildAdjacency(
+        static_cast<int>(nets.size()),
+        [this](int pinId) { return pins[pinId].net; },
+        netPinOffsets,
+        netPinList);
+    buildAdjacency(
+        static_cast<int>(instances.size()),
+        [this](int pinId) { return pins[pinId].instance; },
+        instancePinOffsets,
+        instancePinList);
+
+    built = true;
+}
+
+bool QSocNetlistGraph::isBuilt() const
+{
+    return built;
+}
+
+int QSocNetlistGraph::moduleCount() const
+{
+    return static_cast<int>(modules.size());
+}
+
+int QSocNetlistGraph::instanceCount() const
+{
+    return static_cast<int>(instances.size());
+}
+
+int QSocNetlistGraph::netCount() const
+{
+    return static_cast<int>(nets.size());
+}
+
+int QSocNetlistGraph::pinCount() const
+{
+    return static_cast<int>(pins.size());
+}
+
+const QSocNetlistGraph::Module &QSocNetlistGraph::module(int module) const
+{
+    return modules[module];
+}
+
+const QSocNetlistGraph::Instance &QSocNetlistGraph::instance(int instance) const
+{
+    return instances[instance];
+}
+
+const QSocNetlistGraph::Pin &QSocNetlistGraph::pin(int pin) const
+{
+    return pins[pin];
+}
+
+const std::string &QSocNetlistGraph::netName(int net) const
+{
+    return symbolNames[nets[net]];
+}
+
+std::span<const int> QSocNetlistGraph::netPins(int net) const
+{
+    return std::span<const int>(netPinList)
+        .subspan(netPinOffsets[net], netPinOffsets[net + 1] - netPinOffsets[net]);
+}
+
+std::span<const int> QSocNetlistGraph::instancePins(int instance) const
+{
+    return std::span<const int>(instancePinList)
+        .subspan(
+            instancePinOffsets[instance],
+            instancePinOffsets[instance + 1] - instancePinOffsets[instance]);
+}
+
+const QSocNetlistGraph::Port *QSocNetlistGraph::pinPort(int pin) const
+{
+    const Pin &pinData = pins[pin];
+    if (pinData.port < 0) {
+        return nullptr;
+    }
+    return &modules[instances[pinData.instance].module].ports[pinData.port];
+}
+
+int QSocNetlistGraph::pinWidth(int pin) const
+{
+    const Pin &pinData = pins[pin];
+    if (pinData.port < 0) {
+        return 0;
+    }
+    const int variant = instances[pinData.instance].variant;
+    return variants[variant].widths[pinData.port];
+}
+
+const std::string &QSocNetlistGraph::pinType(int pin) const
+{
+    static const std::string empty;
+    const Pin               &pinData = pins[pin];
+    if (pinData.port < 0) {
+        return empty;
+    }
+    const int variant = instances[pinData.instance].variant;
+    return variants[variant].types[pinData.port];
+}
+
+QSocNetlistGraph::Direction QSocNetlistGraph::parseDirection(const std::string &direction)
+{
+    std::string lower(direction);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+
+    if (lower == "input" || lower == "in") {
+        return Direction::Input;
+    }
+    if (lower == "output" || lower == "out") {
+        return Direction::Output;
+    }
+    if (lower == "inout") {
+        return Direction::Inout;
+    }
+    return Direction::Unknown;
+}
+
+int QSocNetlistGraph::resolveVariant(int instance)
+{
+    const Instance &instanceData = instances[instance];
+    const Module   &module       = modules[instanceData.module];
+
+    /* Overrides of parameters the module does not define do not matter */
+    std::vector<Parameter> overrides;
+    std::string            signature = std::to_string(instanceData.module);
+    if (module.parameterized) {
+        for (const Parameter &override : instanceData.parameters) {
+            for (const Parameter &definition : module.parameters) {
+                if (definition.first == override.first) {
+                    overrides.push_back(override);
+                    signature += '\n' + override.first + '=' + override.second;
+                    break;
+                }
+            }
+        }
+    }
+
+    const auto iter = variantIndex.find(signature);
+    if (iter != variantIndex.end()) {
+        return iter->second;
+    }
+
+    /* Fold the parameters once per distinct set of overrides */
+    Variant variant;
+    variant.widths.reserve(module.ports.size());
+    variant.types.reserve(module.ports.size());
+    if (overrides.empty()) {
+        for (const Port &port : module.ports) {
+            variant.widths.push_back(port.width);
+            variant.types.push_back(port.explicitWidth ? port.type : port.shape.toString());
+        }
+    } else {
+        const QSocPortType::ParameterMap parameters
+            = QSocPortType::foldParameters(module.parameters, overrides);
+        for (const Port &port : module.ports) {
+            if (port.explicitWidth || !port.shape.isParameterized()) {
+                variant.widths.push_back(port.width);
+                variant.types.push_back(port.explicitWidth ? port.type : port.shape.toString());
+                continue;
+            }
+            QSocPortType shape = port.shape;
+            shape.resolve(parameters);
+            variant.widths.push_back(shape.width());
+            variant.types.push_back(shape.toString());
+        }
+    }
+
+    const int index = static_cast<int>(variants.size());
+    variants.push_back(std::move(variant));
+    variantIndex.emplace(std::move(signature), index);
+    return index;
+}
+
+void QSocNetlistGraph::buildAdjacency(
+    int                            count,
+    const std::function<int(int)> &rowOf,
+    std::vector<int>              &offsets,
+    std::vector<int>              &list) const
+{
+    /* Counting sort of pins by row keeps the insertion order inside a row */
+    offsets.assign(count + 1, 0);
+    const int total = static_cast<int>(pins.size());
+    for (int pinId = 0; pinId < total; pinId++) {
+        const int row = rowOf(pinId);
+        if (row >= 0) {
+            offsets[row + 1]++;
+        }
+    }
+    for (int row = 0; row < count; row++) {
+        offsets[row + 1] += offsets[row];
+    }
+
+    list.assign(offsets[count], -1);
+    std::vector<int> cursor(offsets.begin(), offsets.end() - 1);
+    for (int pinId = 0; pinId < total; pinId++) {
+        const int row = rowOf(pinId);
+        if (row >= 0) {
+            list[cursor[row]++] = pinId;
+        }
+    }
+}
@@ -0,0 +1,387 @@
+#ifndef QSOCNETLISTGRAPH_H
+#define QSOCNETLISTGRAPH_H
+
+#include "common/qsocporttype.h"
+
+#include <deque>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <yaml-cpp/yaml.h>
+
+/**
+ * @brief The QSocNetlistGraph class.
+ * @details This class holds the connectivity of a netlist in compact arrays.
+ *          All names are interned once into integer symbols, instances, nets
+ *          and pins are addressed by integer IDs, and the adjacency between
+ *          nets and pins and between instances and pins is kept in CSR
+ *          (compressed sparse row) form. Module ports are resolved once per
+ *          module, so walks over the netlist never go back to YAML lookups.
+ *          The graph is filled with addInstance(), addNet() and addPin(),
+ *          then finalized with build().
+ */
+class QSocNetlistGraph
+{
+public:
+    /**
+     * @brief Port direction.
+     */
+    enum class Direction { Unknown, Input, Output, Inout };
+
+    /**
+     * @brief The Port struct.
+     * @details A port of a module, resolved from the module library.
+     */
+    struct Port
+    {
+        int          name      = -1;                 /* Symbol of the port name */
+        Direction    direction = Direction::Unknown; /* Port direction */
+        std::string  type;                           /* Declared type, e.g. logic[31:0] */
+        QSocPortType shape;                          /* Parsed type */
+        int          width         = 0;              /* Default width, 0 if unknown */
+        bool         explicitWidth = false;          /* Width comes from a "width" key */
+    };
+
+    /**
+     * @brief Parameter, a name and value expression pair.
+     */
+    using Parameter = std::pair<std::string, std::string>;
+
+    /**
+     * @brief The Module struct.
+     * @details A module referenced by at least one instance.
+     */
+    struct Module
+    {
+        int                          name          = -1;    /* Symbol of the module name */
+        bool                         found         = false; /* Module exists in the library */
+        bool                         parameterized = false; /* Port widths depend on parameters */
+        std::vector<Parameter>       parameters;            /* Parameter definitions */
+        std::vector<Port>            ports;                 /* Ports in library order */
+        std::unordered_map<int, int> portIndex;             /* Port name symbol to index in ports */
+    };
+
+    /**
+     * @brief The Instance struct.
+     * @details An instance of a module in the netlist.
+     */
+    struct Instance
+    {
+        int                    name    = -1; /* Symbol of the instance name */
+        int                    module  = -1; /* Index into modules, -1 if not specified */
+        int                    variant = -1; /* Resolved port types, -1 if module not found */
+        std::vector<Parameter> parameters;   /* Parameter overrides in netlist order */
+    };
+
+    /**
+     * @brief The Pin struct.
+     * @details A connection of an instance port to a net.
+     */
+    struct Pin
+    {
+        int net          = -1; /* Net ID */
+        int instanceName = -1; /* Symbol of the referenced instance name */
+        int instance     = -1; /* Instance ID, -1 if the instance does not exist */
+        int portName     = -1; /* Symbol of the referenced port name */
+        int port         = -1; /* Index into the module ports, -1 if unresolved */
+    };
+
+    /**
+     * @brief Module lookup callback.
+     * @details Returns the library YAML of a module, or an undefined node if the
+     *          module does not exist.
+     */
+    using ModuleLookup = std::function<YAML::Node(const std::string &moduleName)>;
+
+    /**
+     * @brief Clear the graph.
+     * @details Removes all symbols, modules, instances, nets and pins.
+     */
+    void clear();
+
+    /**
+     * @brief Intern a name.
+     * @details Returns the symbol of a name, creating it on first use.
+     * @param name The name to intern.
+     * @return int The symbol of the name.
+     */
+    int intern(std::string_view name);
+
+    /**
+     * @brief Find the symbol of a name.
+     * @param name The name to look up.
+     * @return int The symbol of the name, -1 if it was never interned.
+     */
+    int findSymbol(std::string_view name) const;
+
+    /**
+     * @brief Get the name of a symbol.
+     * @param symbol The symbol.
+     * @return const std::string & The interned name.
+     */
+    const std::string &symbolName(int symbol) const;
+
+    /**
+     * @brief Add an instance.
+     * @details Adds an instance of a module. Adding an instance with an
+     *          existing name returns the existing instance.
+     * @param name The instance name.
+     * @param moduleName The module name, empty if the module is not specified.
+     * @return int The instance ID.
+     */
+    int addInstance(const std::string &name, const std::string &moduleName);
+
+    /**
+     * @brief Add a parameter override to an instance.
+     * @param instance The instance ID.
+     * @param name The parameter name.
+     * @param value The parameter value.
+     */
+    void addParameter(int instance, const std::string &name, const std::string &value);
+
+    /**
+     * @brief Find an instance by name.
+     * @param name The instance name.
+     * @return int The instance ID, -1 if not found.
+     */
+    int findInstance(std::string_view name) const;
+
+    /**
+     * @brief Add a net.
+     * @details Returns the existing net if a net with this name exists.
+     * @param name The net name.
+     * @return int The net ID.
+     */
+    int addNet(const std::string &name);
+
+    /**
+     * @brief Find a net by name.
+     * @param name The net name.
+     * @return int The net ID, -1 if not found.
+     */
+    int findNet(std::string_view name) const;
+
+    /**
+     * @brief Disconnect every pin of a net.
+     * @details The net keeps its ID and its place in the net order.
+     * @param net The net ID.
+     */
+    void clearNet(int net);
+
+    /**
+     * @brief Remove a net and its pins.
+     * @details Nets after it move down by one ID, pin IDs change.
+     * @param net The net ID.
+     */
+    void removeNet(int net);
+
+    /**
+     * @brief Connect an instance port to a net.
+     * @details The instance may be added later, references are resolved by
+     *          build().
+     * @param net The net ID.
+     * @param instanceName The instance name.
+     * @param portName The port name.
+     * @return int The pin ID.
+     */
+    int addPin(int net, const std::string &instanceName, const std::string &portName);
+
+    /**
+     * @brief Resolve references and build the adjacency.
+     * @details Resolves pins to instances, loads the ports of every referenced
+     *          module once through the lookup callback, resolves pins to module
+     *          ports and builds the CSR adjacency. Must be called again after
+     *          the graph is modified.
+     * @param lookup The module lookup callback.
+     */
+    void build(const ModuleLookup &lookup);
+
+    /**
+     * @brief Check whether the graph is built.
+     * @retval true build() was called after the last modification.
+     * @retval false The graph was modified since the last build().
+     */
+    bool isBuilt() const;
+
+    /**
+     * @brief Get the number of modules.
+     * @return int The number of modules.
+     */
+    int moduleCount() const;
+
+    /**
+     * @brief Get the number of instances.
+     * @return int The number of instances.
+     */
+    int instanceCount() const;
+
+    /**
+     * @brief Get the number of nets.
+     * @return int The number of nets.
+     */
+    int netCount() const;
+
+    /**
+     * @brief Get the number of pins.
+     * @return int The number of pins.
+     */
+    int pinCount() const;
+
+    /**
+     * @brief Get a module.
+     * @param module The module index.
+     * @return const Module & The module.
+     */
+    const Module &module(int module) const;
+
+    /**
+     * @brief Get an instance.
+     * @param instance The instance ID.
+     * @return const Instance & The instance.
+     */
+    const Instance &instance(int instance) const;
+
+    /**
+     * @brief Get a pin.
+     * @param pin The pin ID.
+     * @return const Pin & The pin.
+     */
+    const Pin &pin(int pin) const;
+
+    /**
+     * @brief Get the name of a net.
+     * @param net The net ID.
+     * @return const std::string & The net name.
+     */
+    const std::string &netName(int net) const;
+
+    /**
+     * @brief Get the pins connected to a net.
+     * @details Pins are returned in the order they were added. Requires build().
+     * @param net The net ID.
+     * @return std::span<const int> The pin IDs.
+     */
+    std::span<const int> netPins(int net) const;
+
+    /**
+     * @brief Get the pins of an instance.
+     * @details Each pin references the net it connects to, so this is the
+     *          instance to net adjacency. Requires build().
+     * @param instance The instance ID.
+     * @return std::span<const int> The pin IDs.
+     */
+    std::span<const int> instancePins(int instance) const;
+
+    /**
+     * @brief Get the module port a pin connects to.
+     * @param pin The pin ID.
+     * @return const Port * The resolved port, nullptr if unresolved.
+     */
+    const Port *pinPort(int pin) const;
+
+    /**
+     * @brief Get the width of the port a pin connects to.
+     * @details Takes the parameter overrides of the pin instance into account.
+     * @param pin The pin ID.
+     * @return int The width in bits, 0 if unresolved or unknown.
+     */
+    int pinWidth(int pin) const;
+
+    /**
+     * @brief Get the type of the port a pin connects to.
+     * @details Parameterized dimensions are folded with the parameter
+     *          overrides of the pin instance, e.g. "logic[WIDTH-1:0]" becomes
+     *          "logic[15:0]" for WIDTH=16. Types that cannot be folded are
+     *          returned as declared.
+     * @param pin The pin ID.
+     * @return const std::string & The type, empty if the pin is unresolved
+     *         or the port has no declared type.
+     */
+    const std::string &pinType(int pin) const;
+
+    /**
+     * @brief Parse a port direction string.
+     * @param direction Direction string such as "input", "output" or "inout".
+     * @return Direction The parsed direction.
+     */
+    static Direction parseDirection(const std::string &direction);
+
+private:
+    /** Interned names, a deque keeps string addresses stable for the views. */
+    std::deque<std::string> symbolNames;
+    /** Name to symbol map. */
+    std::unordered_map<std::string_view, int> symbolIds;
+    /** Symbol to instance ID, -1 if the symbol is not an instance name. */
+    std::vector<int> symbolInstance;
+    /** Symbol to net ID, -1 if the symbol is not a net name. */
+    std::vector<int> symbolNet;
+    /** Symbol to module index, -1 if the symbol is not a module name. */
+    std::vector<int> symbolModule;
+
+    /** Modules referenced by instances. */
+    std::vector<Module> modules;
+    /** Instances. */
+    std::vector<Instance> instances;
+    /** Net name symbols, indexed by net ID. */
+    std::vector<int> nets;
+    /** Pins. */
+    std::vector<Pin> pins;
+
+    /** CSR offsets of net to pin adjacency, netCount() + 1 entries. */
+    std::vector<int> netPinOffsets;
+    /** CSR pin IDs of net to pin adjacency. */
+    std::vector<int> netPinList;
+    /** CSR offsets of instance to pin adjacency, instanceCount() + 1 entries. */
+    std::vector<int> instancePinOffsets;
+    /** CSR pin IDs of instance to pin adjacency. */
+    std::vector<int> instancePinList;
+
+    /**
+     * @brief The Variant struct.
+     * @details Port widths and types of a module for one set of parameter
+     *          overrides, shared by all instances with the same overrides.
+     */
+    struct Variant
+    {
+        std::vector<int>         widths; /* Port widths, indexed like Module::ports */
+        std::vector<std::string> types;  /* Folded port types, indexed like Module::ports */
+    };
+
+    /** Port variants of modules. */
+    std::vector<Variant> variants;
+    /** Module index and override signature to variant index. */
+    std::unordered_map<std::string, int> variantIndex;
+
+    /** Graph is built and adjacency is valid. */
+    bool built = false;
+
+    /**
+     * @brief Get the variant of an instance, creating it on first use.
+     * @details Only overrides of parameters the module defines take part in
+     *          the signature, so instances that differ in unrelated
+     *          parameters share a variant.
+     * @param instance The instance ID, its module must be found.
+     * @return int The variant index.
+     */
+    int resolveVariant(int instance);
+
+    /**
+     * @brief Build a CSR adjacency.
+     * @param count Number of rows.
+     * @param rowOf Row of each pin, negative rows are skipped.
+     * @param offsets Output row offsets.
+     * @param list Output pin IDs.
+     */
+    void buildAdjacency(
+        int                            count,
+        const std::function<int(int)> &rowOf,
+        std::vector<int>              &offsets,
+        std::vector<int>              &list) const;
+};
+
+#endif // QSOCNETLISTGRAPH_H
@@ -0,0 +1,462 @@
+#include "common/qsocnetlistloader.h"
+
+#include <QDebug>
+
+#include <algorithm>
+
+#include <yaml-cpp/parser.h>
+
+QSocNetlistLoader::QSocNetlistLoader(QSocNetlistGraph &graph)
+    : graph(graph)
+{}
+
+bool QSocNetlistLoader::load(std::istream &input)
+{
+    graph.clear();
+    buses.clear();
+    stack.clear();
+    anchors.clear();
+    recordings.clear();
+    rootValid       = false;
+    instanceEntries = -1;
+    sectionInvalid  = false;
+
+    /* Only the first document is read, the parser pulls the stream in chunks */
+    YAML::Parser parser(input);
+    parser.HandleNextDocument(*this);
+
+    /* Validate basic netlist structure */
+    if (!rootValid || instanceEntries < 0) {
+        qCritical() << "Error: Invalid netlist format, missing 'instance' section";
+        return false;
+    }
+    if (instanceEntries == 0) {
+        qCritical() << "Error: Invalid netlist format, 'instance' section is empty or not a map";
+        return false;
+    }
+    if (sectionInvalid) {
+        qCritical() << "Error: Invalid netlist format, invalid 'net' or 'bus' section";
+        return false;
+    }
+    return true;
+}
+
+const std::vector<QSocNetlistLoader::Bus> &QSocNetlistLoader::getBuses() const
+{
+    return buses;
+}
+
+void QSocNetlistLoader::handleEvent(const Event &event)
+{
+    /* Keep the event for every anchored collection it is part of */
+    for (Recording &recording : recordings) {
+        anchors[recording.anchor].push_back(event);
+        if (event.kind == Event::Kind::SequenceStart || event.kind == Event::Kind::MapStart) {
+            recording.depth++;
+        } else if (event.kind == Event::Kind::End) {
+            recording.depth--;
+        }
+    }
+    while (!recordings.empty() && recordings.back().depth == 0) {
+        recordings.pop_back();
+    }
+
+    switch (event.kind) {
+    case Event::Kind::Scalar:
+        onNode(&event.value);
+        break;
+    case Event::Kind::Null:
+        onNode(nullptr);
+        break;
+    case Event::Kind::SequenceStart:
+        onCollectionStart(false);
+        break;
+    case Event::Kind::MapStart:
+        onCollectionStart(true);
+        break;
+    case Event::Kind::End:
+        onCollectionEnd();
+        break;
+    }
+}
+
+void QSocNetlistLoader::onNode(const std::string *value)
+{
+    /* A scalar root is not a netlist */
+    if (stack.empty()) {
+        return;
+    }
+
+    Frame &parent = stack.back();
+    if (parent.isMap && parent.expectKey) {
+        parent.key       = value ? *value : std::string();
+        parent.keyValid  = value != nullptr;
+        parent.expectKey = false;
+        return;
+    }
+    scalarValue(parent, value);
+    if (parent.isMap) {
+        parent.expectKey = true;
+    }
+}
+
+void QSocNetlistLoader::onCollectionStart(bool isMap)
+{
+    if (stack.empty()) {
+        rootValid = isMap;
+        stack.push_back({isMap ? Context::Root : Context::Skip, isMap});
+        return;
+    }
+
+    Frame &parent = stack.back();
+    if (parent.isMap && parent.expectKey) {
+        /* Collections as keys are never valid names */
+        parent.keyValid  = false;
+        parent.expectKey = false;
+        parent.key.clear();
+        stack.push_back({Context::Skip, isMap, true});
+        return;
+    }
+    const Context context = enterValue(parent, isMap);
+    stack.push_back({context, isMap});
+}
+
+void QSocNetlistLoader::onCollectionEnd()
+{
+    const Frame frame = std::move(stack.back());
+    stack.pop_back();
+
+    switch (frame.context) {
+    case Context::Instance: {
+        const int instance = graph.addInstance(instanceName, instanceModule);
+        for (const auto &[paramName, paramValue] : instanceParameters) {
+            graph.addParameter(instance, paramName, paramValue);
+        }
+        if (instanceHasParameters && instanceParameters.empty()) {
+            qWarning() << "Warning: 'parameter' section for instance" << instanceName.c_str()
+                       << "is empty, ignoring";
+        }
+        break;
+    }
+    case Context::Net:
+        if (net < 0) {
+            qWarning() << "Warning: Net" << netName.c_str() << "has no connections, skipping";
+        }
+        break;
+    case Context::Connection:
+        if (connectionInstance.empty() || connectionPort.empty()) {
+            qWarning() << "Warning: Invalid connection data in net" << netName.c_str()
+                       << ", skipping";
+            break;
+        }
+        if (net < 0) {
+            net = graph.addNet(netName);
+        }
+        graph.addPin(net, connectionInstance, connectionPort);
+        break;
+    default:
+        break;
+    }
+
+    /* After a collection key its value follows, after a value the next key */
+    if (!stack.empty() && stack.back().isMap && !frame.isKey) {
+        stack.back().expectKey = true;
+    }
+}
+
+QSocNetlistLoader::Context QSocNetlistLoader::enterValue(Frame &parent, bool isMap)
+{
+    const std::string &key = parent.key;
+
+    switch (parent.context) {
+    case Context::Root:
+        if (key == "instance") {
+            instanceEntries = isMap ? 0 : -1;
+            return isMap ? Context::InstanceSection : Context::Skip;
+        }
+        if (key == "net" || key == "bus") {
+            sectionInvalid = sectionInvalid || !isMap;
+            if (!isMap) {
+                return Context::Skip;
+            }
+            return key == "net" ? Context::NetSection : Context::BusSection;
+        }
+        return Context::Skip;
+
+    case Context::InstanceSection:
+        instanceEntries++;
+        if (!parent.keyValid) {
+            qWarning() << "Warning: Invalid instance name, skipping";
+            return Context::Skip;
+        }
+        if (graph.findInstance(key) >= 0) {
+            qWarning() << "Warning: Duplicate instance" << key.c_str() << ", skipping";
+            return Context::Skip;
+        }
+        if (!isMap) {
+            qWarning() << "Warning: Invalid instance data for" << key.c_str()
+                       << "(not a map), skipping";
+            graph.addInstance(key, std::string());
+            return Context::Skip;
+        }
+        instanceName = key;
+        instanceModule.clear();
+        instanceParameters.clear();
+        instanceHasParameters = false;
+        return Context::Instance;
+
+    case Context::Instance:
+        if (parent.keyValid && key == "parameter") {
+            if (!isMap) {
+                qWarning() << "Warning: 'parameter' section for instance" << instanceName.c_str()
+                           << "is not a map, ignoring";
+                return Context::Skip;
+            }
+            instanceHasParameters = true;
+            return Context::ParameterSection;
+        }
+        return Context::Skip;
+
+    case Context::ParameterSection:
+        if (!parent.keyValid) {
+            qWarning() << "Warning: Invalid parameter name in instance" << instanceName.c_str();
+        } else {
+            qWarning() << "Warning: Parameter" << key.c_str() << "in instance"
+                       << instanceName.c_str() << "has a non-scalar value, skipping";
+        }
+        return Context::Skip;
+
+    case Context::NetSection:
+        if (!parent.keyValid) {
+            qWarning() << "Warning: Invalid net name, skipping";
+            return Context::Skip;
+        }
+        if (isMap) {
+            qWarning() << "Warning: Net" << key.c_str() << "is not a sequence, skipping";
+            return Context::Skip;
+        }
+        netName = key;
+        net     = graph.findNet(netName);
+        if (net >= 0) {
+            qWarning() << "Warning: Duplicate net" << netName.c_str() << ", merging connections";
+        }
+        return Context::Net;
+
+    case Context::Net:
+        if (!isMap) {
+            qWarning() << "Warning: Invalid connection data in net" << netName.c_str()
+                       << ", skipping";
+            return Context::Skip;
+        }
+        connectionInstance.clear();
+        connectionPort.clear();
+        return Context::Connection;
+
+    case Context::Connection:
+        /* Instance and port must be scalars */
+        if (parent.keyValid && key == "instance") {
+            connectionInstance.clear();
+        } else if (parent.keyValid && key == "port") {
+            connectionPort.clear();
+        }
+        return Context::Skip;
+
+    case Context::BusSection:
+        if (!parent.keyValid) {
+            qWarning() << "Warning: Bus type name is not a scalar, skipping";
+            return Context::Skip;
+        }
+        buses.push_back({key, isMap, {}});
+        return isMap ? Context::Bus : Context::Skip;
+
+    case Context::Bus:
+        if (!parent.keyValid) {
+            qWarning() << "Warning: Instance name is not a scalar, skipping";
+            return Context::Skip;
+        }
+        buses.back().connections.push_back({key, std::string()});
+        return isMap ? Context::BusConnection : Context::Skip;
+
+    default:
+        return Context::Skip;
+    }
+}
+
+void QSocNetlistLoader::scalarValue(Frame &parent, const std::string *value)
+{
+    const std::string &key = parent.key;
+
+    switch (parent.context) {
+    case Context::Root:
+        if (key == "net" || key == "bus") {
+            sectionInvalid = true;
+        }
+        break;
+
+    case Context::InstanceSection:
+        instanceEntries++;
+        if (!parent.keyValid) {
+            qWarning() << "Warning: Invalid instance name, skipping";
+            break;
+        }
+        if (graph.findInstance(key) >= 0) {
+            qWarning() << "Warning: Duplicate instance" << key.c_str() << ", skipping";
+            break;
+        }
+        qWarning() << "Warning: Invalid instance data for" << key.c_str()
+                   << "(not a map), skipping";
+        graph.addInstance(key, std::string());
+        break;
+
+    case Context::Instance:
+        if (parent.keyValid && key == "module" && value) {
+            instanceModule = *value;
+        } else if (parent.keyValid && key == "parameter") {
+            qWarning() << "Warning: 'parameter' section for instance" << instanceName.c_str()
+                       << "is not a map, ignoring";
+        }
+        break;
+
+    case Context::ParameterSection:
+        if (!parent.keyValid) {
+            qWarning() << "Warning: Invalid parameter name in instance" << instanceName.c_str();
+        } else if (!value) {
+            qWarning() << "Warning: Parameter" << key.c_str() << "in instance"
+                       << instanceName.c_str() << "has a non-scalar value, skipping";
+        } else {
+            instanceParameters.emplace_back(key, *value);
+        }
+        break;
+
+    case Context::NetSection:
+        if (!parent.keyValid) {
+            qWarning() << "Warning: Invalid net name, skipping";
+        } else {
+            qWarning() << "Warning: Net" << key.c_str() << "is not a sequence, skipping";
+        }
+        break;
+
+    case Context::Net:
+        qWarning() << "Warning: Invalid connection data in net" << netName.c_str()
+                   << ", skipping";
+        break;
+
+    case Context::Connection:
+        if (parent.keyValid && key == "instance") {
+            connectionInstance = value ? *value : std::string();
+        } else if (parent.keyValid && key == "port") {
+            connectionPort = value ? *value : std::string();
+        }
+        break;
+
+    case Context::BusSection:
+        if (!parent.keyValid) {
+            qWarning() << "Warning: Bus type name is not a scalar, skipping";
+            break;
+        }
+        buses.push_back({key, false, {}});
+        break;
+
+    case Context::Bus:
+        if (!parent.keyValid) {
+            qWarning() << "Warning: Instance name is not a scalar, skipping";
+            break;
+        }
+        buses.back().connections.push_back({key, std::string()});
+        break;
+
+    case Context::BusConnection:
+        if (parent.keyValid && key == "port" && value) {
+            buses.back().connections.back().portName = *value;
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void QSocNetlistLoader::OnDocumentStart(const YAML::Mark & /*mark*/) {}
+
+void QSocNetlistLoader::OnDocumentEnd() {}
+
+void QSocNetlistLoader::OnNull(const YAML::Mark & /*mark*/, YAML::anchor_t anchor)
+{
+    const Event event{Event::Kind::Null};
+    handleEvent(event);
+    if (anchor != YAML::NullAnchor) {
+        anchors[anchor] = {event};
+    }
+}
+
+void QSocNetlistLoader::OnAlias(const YAML::Mark &mark, YAML::anchor_t anchor)
+{
+    /* A collection cannot contain an alias of itself */
+    const auto iter = anchors.find(anchor);
+    const bool open = std::any_of(
+        recordings.begin(), recordings.end(), [anchor](const Recording &recording) {
+            return recording.anchor == anchor;
+        });
+    if (iter == anchors.end() || open) {
+        qWarning() << "Warning: Alias at line" << mark.line + 1
+                   << "does not refer to a complete node, treated as null";
+        handleEvent({Event::Kind::Null});
+        return;
+    }
+
+    /* Replaying never adds anchors, so the events stay in place */
+    for (const Event &event : iter->second) {
+        handleEvent(event);
+    }
+}
+
+void QSocNetlistLoader::OnScalar(
+    const YAML::Mark & /*mark*/,
+    const std::string & /*tag*/,
+    YAML::anchor_t     anchor,
+    const std::string &value)
+{
+    const Event event{Event::Kind::Scalar, value};
+    handleEvent(event);
+    if (anchor != YAML::NullAnchor) {
+        anchors[anchor] = {event};
+    }
+}
+
+void QSocNetlistLoader::OnSequenceStart(
+    const YAML::Mark & /*mark*/,
+    const std::string & /*tag*/,
+    YAML::anchor_t anchor,
+    YAML::EmitterStyle::value /*style*/)
+{
+    const Event event{Event::Kind::SequenceStart};
+    handleEvent(event);
+    if (anchor != YAML::NullAnchor) {
+        anchors[anchor] = {event};
+        recordings.push_back({anchor, 1});
+    }
+}
+
+void QSocNetlistLoader::OnSequenceEnd()
+{
+    handleEvent({Event::Kind::End});
+}
+
+void QSocNetlistLoader::OnMapStart(
+    const YAML::Mark & /*mark*/,
+    const std::string & /*tag*/,
+    YAML::anchor_t anchor,
+    YAML::EmitterStyle::value /*style*/)
+{
+    const Event event{Event::Kind::MapStart};
+    handleEvent(event);
+    if (anchor != YAML::NullAnchor) {
+        anchors[anchor] = {event};
+        recordings.push_back({anchor, 1});
+    }
+}
+
+void QSocNetlistLoader::OnMapEnd()
+{
+    handleEvent({Event::Kind::End});
+}
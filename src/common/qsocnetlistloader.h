@@ -0,0 +1,226 @@
+#ifndef QSOCNETLISTLOADER_H
+#define QSOCNETLISTLOADER_H
+
+#include "common/qsocnetlistgraph.h"
+
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <yaml-cpp/eventhandler.h>
+
+/**
+ * @brief The QSocNetlistLoader class.
+ * @details This class reads a netlist with the event based yaml-cpp parser
+ *          and fills a connectivity graph while the document is being
+ *          parsed, so no YAML node tree of the netlist is ever built. Memory
+ *          use is bounded by the size of the graph, not by the size of the
+ *          file. Instances and explicit nets go straight into the graph, bus
+ *          connections are kept in a small list for bus expansion. Invalid
+ *          entries are reported and skipped like the tree based loader did.
+ *          A net name that appears twice is reported and its connections are
+ *          merged into one net. An instance name that appears twice is
+ *          reported and only its first entry is used. The events of anchored nodes are kept, so an
+ *          alias reads like a copy of its anchored node.
+ */
+class QSocNetlistLoader : private YAML::EventHandler
+{
+public:
+    /**
+     * @brief The BusConnection struct.
+     * @details An instance port connected to a bus.
+     */
+    struct BusConnection
+    {
+        std::string instanceName; /* Instance name */
+        std::string portName;     /* Bus port name, empty if not specified */
+    };
+
+    /**
+     * @brief The Bus struct.
+     * @details A bus of the netlist bus section.
+     */
+    struct Bus
+    {
+        std::string                name;         /* Bus name, prefix of the expanded nets */
+        bool                       valid = true; /* Bus entry is a map */
+        std::vector<BusConnection> connections;  /* Connections in netlist order */
+    };
+
+    /**
+     * @brief Constructor.
+     * @param graph The graph to fill, it is cleared by load().
+     */
+    explicit QSocNetlistLoader(QSocNetlistGraph &graph);
+
+    /**
+     * @brief Load a netlist.
+     * @details Clears the graph and parses the first document of the stream.
+     *          YAML syntax errors are thrown as YAML::ParserException.
+     * @param input The netlist stream.
+     * @retval true Netlist loaded successfully.
+     * @retval false Netlist has no valid 'instance' section or has an
+     *         invalid 'net' or 'bus' section.
+     */
+    bool load(std::istream &input);
+
+    /**
+     * @brief Get the buses of the loaded netlist.
+     * @return const std::vector<Bus> & The buses in netlist order.
+     */
+    const std::vector<Bus> &getBuses() const;
+
+private:
+    /**
+     * @brief Parser context of a collection.
+     */
+    enum class Context {
+        Skip,
+        Root,
+        InstanceSection,
+        Instance,
+        ParameterSection,
+        NetSection,
+        Net,
+        Connection,
+        BusSection,
+        Bus,
+        BusConnection
+    };
+
+    /**
+     * @brief The Frame struct.
+     * @details An open collection on the parser stack.
+     */
+    struct Frame
+    {
+        Context     context;           /* What the collection holds */
+        bool        isMap;             /* Collection is a map */
+        bool        isKey     = false; /* Collection is itself a map key */
+        bool        expectKey = true;  /* Next map node is a key */
+        bool        keyValid  = true;  /* Current key is a scalar */
+        std::string key{};             /* Current key */
+    };
+
+    /**
+     * @brief The Event struct.
+     * @details A parser event of an anchored node, replayed by its aliases.
+     */
+    struct Event
+    {
+        enum class Kind { Scalar, Null, SequenceStart, MapStart, End };
+        Kind        kind;    /* Event kind */
+        std::string value{}; /* Scalar value */
+    };
+
+    /**
+     * @brief The Recording struct.
+     * @details An anchored collection whose events are being kept.
+     */
+    struct Recording
+    {
+        YAML::anchor_t anchor; /* Anchor of the collection */
+        int            depth;  /* Collections open inside it, itself included */
+    };
+
+    /** Graph being filled. */
+    QSocNetlistGraph &graph;
+    /** Buses of the netlist. */
+    std::vector<Bus> buses;
+    /** Open collections. */
+    std::vector<Frame> stack;
+    /** Events of anchored nodes, for aliases. */
+    std::unordered_map<YAML::anchor_t, std::vector<Event>> anchors;
+    /** Anchored collections being read, innermost last. */
+    std::vector<Recording> recordings;
+
+    /** Root is a map. */
+    bool rootValid = false;
+    /** Number of entries of the instance section, -1 if missing or invalid. */
+    int instanceEntries = -1;
+    /** Net or bus section is not a map. */
+    bool sectionInvalid = false;
+
+    /** Instance being read. */
+    std::string instanceName;
+    /** Module of the instance being read. */
+    std::string instanceModule;
+    /** Parameters of the instance being read. */
+    std::vector<QSocNetlistGraph::Parameter> instanceParameters;
+    /** Instance being read has a parameter map. */
+    bool instanceHasParameters = false;
+    /** Net being read. */
+    std::string netName;
+    /** Net ID of the net being read, -1 until its first valid connection. */
+    int net = -1;
+    /** Instance of the connection being read, empty if invalid. */
+    std::string connectionInstance;
+    /** Port of the connection being read, empty if invalid. */
+    std::string connectionPort;
+
+    /**
+     * @brief Handle a parser event.
+     * @details Keeps the event for the anchored collections being read, then
+     *          passes it on to the node handlers.
+     * @param event The event.
+     */
+    void handleEvent(const Event &event);
+
+    /**
+     * @brief Handle a scalar, null or alias node.
+     * @param value The scalar value, nullptr for null and unknown aliases.
+     */
+    void onNode(const std::string *value);
+
+    /**
+     * @brief Handle the start of a map or sequence node.
+     * @param isMap The collection is a map.
+     */
+    void onCollectionStart(bool isMap);
+
+    /**
+     * @brief Handle the end of a map or sequence node.
+     */
+    void onCollectionEnd();
+
+    /**
+     * @brief Get the context of a collection that is the value of the current key.
+     * @param parent The parent frame.
+     * @param isMap The collection is a map.
+     * @return Context The child context.
+     */
+    Context enterValue(Frame &parent, bool isMap);
+
+    /**
+     * @brief Handle a scalar or null that is the value of the current key.
+     * @param parent The parent frame.
+     * @param value The scalar value, nullptr for null.
+     */
+    void scalarValue(Frame &parent, const std::string *value);
+
+    /* yaml-cpp parser events, see YAML::EventHandler */
+    void OnDocumentStart(const YAML::Mark &mark) override;
+    void OnDocumentEnd() override;
+    void OnNull(const YAML::Mark &mark, YAML::anchor_t anchor) override;
+    void OnAlias(const YAML::Mark &mark, YAML::anchor_t anchor) override;
+    void OnScalar(
+        const YAML::Mark  &mark,
+        const std::string &tag,
+        YAML::anchor_t     anchor,
+        const std::string &value) override;
+    void OnSequenceStart(
+        const YAML::Mark         &mark,
+        const std::string        &tag,
+        YAML::anchor_t            anchor,
+        YAML::EmitterStyle::value style) override;
+    void OnSequenceEnd() override;
+    void OnMapStart(
+        const YAML::Mark         &mark,
+        const std::string        &tag,
+        YAML::anchor_t            anchor,
+        YAML::EmitterStyle::value style) override;
+    void OnMapEnd() override;
+};
+
+#endif // QSOCNETLISTLOADER_H
@@ -0,0 +1,625 @@
+#include "common/qsocporttype.h"
+
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+
+namespace {
+
+/* Trim leading and trailing whitespace */
+std::string_view trim(std::string_view text)
+{
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+/* Width of a base type without packed dimensions, 0 if unknown */
+int baseTypeWidth(std::string_view baseType)
+{
+    /* Drop signing keywords, they do not change the width */
+    std::string_view name = trim(baseType);
+    for (std::string_view keyword : {" signed", " unsigned"}) {
+        if (name.size() > keyword.size() && name.ends_with(keyword)) {
+            name = trim(name.substr(0, name.size() - keyword.size()));
+        }
+    }
+
+    if (name.empty() || name == "logic" || name == "bit" || name == "reg" || name == "wire") {
+        return 1;
+    }
+    if (name == "byte") {
+        return 8;
+    }
+    if (name == "shortint") {
+        return 16;
+    }
+    if (name == "int" || name == "integer") {
+        return 32;
+    }
+    if (name == "longint") {
+        return 64;
+    }
+    return 0;
+}
+
+/* Recursive descent constant folder over SystemVerilog expression syntax */
+class ExpressionFolder
+{
+public:
+    ExpressionFolder(std::string_view text, const QSocPortType::ParameterMap &parameters)
+        : text(text)
+        , parameters(parameters)
+    {}
+
+    bool fold(long long &value)
+    {
+        value = parseTernary();
+        skipSpace();
+        return ok && pos == text.size();
+    }
+
+private:
+    std::string_view                  text;
+    const QSocPortType::ParameterMap &parameters;
+    size_t                            pos = 0;
+    bool                              ok  = true;
+
+    void skipSpace()
+    {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+            pos++;
+        }
+    }
+
+    /* Consume an operator if it is next, but not when it is a prefix of a longer one */
+    bool accept(std::string_view op, std::string_view notFollowedBy = {})
+    {
+        skipSpace();
+        if (text.substr(pos, op.size()) != op) {
+            return false;
+        }
+        if (pos + op.size() < text.size()
+            && notFollowedBy.find(text[pos + op.size()]) != std::string_view::npos) {
+            return false;
+        }
+        pos += op.size();
+        return true;
+    }
+
+    long long fail()
+    {
+        ok = false;
+        return 0;
+    }
+
+    /* Arithmetic that does not fold when the result overflows */
+    long long add(long long left, long long right)
+    {
+        long long result = 0;
+        return __builtin_add_overflow(left, right, &result) ? fail() : result;
+    }
+
+    long long subtract(long long left, long long right)
+    {
+        long long result = 0;
+        return __builtin_sub_overflow(left, right, &result) ? fail() : result;
+    }
+
+    long long multiply(long long left, long long right)
+    {
+        long long result = 0;
+        return __builtin_mul_overflow(left, right, &result) ? fail() : result;
+    }
+
+    long long divide(long long left, long long right)
+    {
+        if (right == 0 || (left == LLONG_MIN && right == -1)) {
+            return fail();
+        }
+        return left / right;
+    }
+
+    long long remainder(long long left, long long right)
+    {
+        if (right == 0) {
+            return fail();
+        }
+        /* LLONG_MIN % -1 overflows in the division behind it */
+        return right == -1 ? 0 : left % right;
+    }
+
+    long long parseTernary()
+    {
+        const long long condition = parseBinary(0);
+        if (!accept("?")) {
+            return condition;
+        }
+        const long long whenTrue = parseTernary();
+        if (!accept(":")) {
+            return fail();
+        }
+        const long long whenFalse = parseTernary();
+        return condition ? whenTrue : whenFalse;
+    }
+
+    /* Binary operators by precedence level, lowest first */
+    long long parseBinary(int level)
+    {
+        if (level > 9) {
+            return parsePower();
+        }
+
+        long long left = parseBinary(level + 1);
+        while (ok) {
+            if (level == 0 && accept("||")) {
+                const long long right = parseBinary(level + 1);
+                left                  = (left || right) ? 1 : 0;
+            } else if (level == 1 && accept("&&")) {
+                const long long right = parseBinary(level + 1);
+                left                  = (left && right) ? 1 : 0;
+            } else if (level == 2 && accept("|", "|")) {
+                left |= parseBinary(level + 1);
+            } else if (level == 3 && (accept("^~") || accept("~^"))) {
+                left = ~(left ^ parseBinary(level + 1));
+            } else if (level == 3 && accept("^")) {
+                left ^= parseBinary(level + 1);
+            } else if (level == 4 && accept("&", "&")) {
+                left &= parseBinary(level + 1);
+            } else if (level == 5 && accept("==", "=")) {
+                left = left == parseBinary(level + 1) ? 1 : 0;
+            } else if (level == 5 && accept("!=", "=")) {
+                left = left != parseBinary(level + 1) ? 1 : 0;
+            } else if (level == 6 && accept("<=")) {
+                left = left <= parseBinary(level + 1) ? 1 : 0;
+            } else if (level == 6 && accept(">=")) {
+                left = left >= parseBinary(level + 1) ? 1 : 0;
+            } else if (level == 6 && accept("<", "<")) {
+                left = left < parseBinary(level + 1) ? 1 : 0;
+            } else if (level == 6 && accept(">", ">")) {
+                left = left > parseBinary(level + 1) ? 1 : 0;
+            } else if (level == 7 && (accept("<<<") || accept("<<"))) {
+                const long long right = parseShiftAmount();
+                left = static_cast<long long>(static_cast<unsigned long long>(left) << right);
+            } else if (level == 7 && accept(">>>")) {
+                left >>= parseShiftAmount();
+            } else if (level == 7 && accept(">>")) {
+                const long long right = parseShiftAmount();
+                left = static_cast<long long>(static_cast<unsigned long long>(left) >> right);
+            } else if (level == 8 && accept("+")) {
+                left = add(left, parseBinary(level + 1));
+            } else if (level == 8 && accept("-")) {
+                left = subtract(left, parseBinary(level + 1));
+            } else if (level == 9 && accept("*", "*")) {
+                left = multiply(left, parsePower());
+            } else if (level == 9 && accept("/")) {
+                left = divide(left, parsePower());
+            } else if (level == 9 && accept("%")) {
+                left = remainder(left, parsePower());
+            } else {
+                break;
+            }
+        }
+        return left;
+    }
+
+    /* Shift amounts beyond the value width are not folded */
+    long long parseShiftAmount()
+    {
+        const long long amount = parseBinary(8);
+        return (amount < 0 || amount > 63) ? fail() : amount;
+    }
+
+    long long parsePower()
+    {
+        const long long base = parseUnary();
+        if (!accept("**")) {
+            return base;
+        }
+        /* Power is right associative */
+        const long long exponent = parsePower();
+        if (exponent < 0) {
+            return fail();
+        }
+        if (base == 0 || base == 1) {
+            return exponent == 0 ? 1 : base;
+        }
+        if (base == -1) {
+            return exponent % 2 == 0 ? 1 : -1;
+        }
+        if (exponent > 63) {
+            return fail();
+        }
+        long long result = 1;
+        for (long long index = 0; index < exponent && ok; index++) {
+            result = multiply(result, base);
+        }
+        return result;
+    }
+
+    long long parseUnary()
+    {
+        if (accept("+")) {
+            return parseUnary();
+        }
+        if (accept("-")) {
+            return subtract(0, parseUnary());
+        }
+        if (accept("!")) {
+            return parseUnary() ? 0 : 1;
+        }
+        if (accept("~")) {
+            return ~parseUnary();
+        }
+        return parsePrimary();
+    }
+
+    long long parsePrimary()
+    {
+        skipSpace();
+        if (pos >= text.size()) {
+            return fail();
+        }
+
+        if (accept("(")) {
+            const long long value = parseTernary();
+            if (!accept(")")) {
+                return fail();
+            }
+            return value;
+        }
+
+        if (accept("$clog2")) {
+            if (!accept("(")) {
+                return fail();
+            }
+            const long long value = parseTernary();
+            if (!accept(")") || value < 0) {
+                return fail();
+            }
+            long long bits = 0;
+            while ((1LL << bits) < value && bits < 63) {
+                bits++;
+            }
+            return bits;
+        }
+
+        const char head = text[pos];
+        if (std::isdigit(static_cast<unsigned char>(head)) || head == '\'') {
+            return parseNumber();
+        }
+
+        if (std::isalpha(static_cast<unsigned char>(head)) || head == '_') {
+            const size_t start = pos;
+            while (pos < text.size()
+                   && (std::isalnum(static_cast<unsigned char>(text[pos])) || text[pos] == '_'
+                       || text[pos] == '$')) {
+                pos++;
+            }
+            /* Package scoped names are not known here */
+            if (text.substr(pos, 2) == "::") {
+                return fail();
+            }
+            const auto iter = parameters.find(std::string(text.substr(start, pos - start)));
+            return iter == parameters.end() ? fail() : iter->second;
+        }
+
+        return fail();
+    }
+
+    /* Decimal digits with optional underscores */
+    std::string readDigits(bool (*isDigit)(char))
+    {
+        std::string digits;
+        skipSpace();
+        while (pos < text.size() && (isDigit(text[pos]) || text[pos] == '_')) {
+            if (text[pos] != '_') {
+                digits += text[pos];
+            }
+            pos++;
+        }
+        return digits;
+    }
+
+    long long parseNumber()
+    {
+        static const auto isDecimal = [](char c) {
+            return std::isdigit(static_cast<unsigned char>(c)) != 0;
+        };
+        static const auto isHex = [](char c) {
+            return std::isxdigit(static_cast<unsigned char>(c)) != 0;
+        };
+
+        /* Optional size, ignored since values are folded at full precision */
+        std::string digits = readDigits(isDecimal);
+        if (pos >= text.size() || text[pos] != '\'') {
+            if (digits.empty()) {
+                return fail();
+            }
+            errno                 = 0;
+            const long long value = std::strtoll(digits.c_str(), nullptr, 10);
+            return errno == ERANGE ? fail() : value;
+        }
+        pos++;
+
+        /* Unbased unsized literals such as '0 and '1 */
+        if (pos < text.size() && (text[pos] == '0' || text[pos] == '1')) {
+            return text[pos++] - '0';
+        }
+
+        if (pos < text.size() && (text[pos] == 's' || text[pos] == 'S')) {
+            pos++;
+        }
+        if (pos >= text.size()) {
+            return fail();
+        }
+        int base = 0;
+        switch (std::tolower(static_cast<unsigned char>(text[pos]))) {
+        case 'b':
+            base = 2;
+            break;
+        case 'o':
+            base = 8;
+            break;
+        case 'd':
+            base = 10;
+            break;
+        case 'h':
+            base = 16;
+            break;
+        default:
+            return fail();
+        }
+        pos++;
+
+        digits = readDigits(isHex);
+        if (digits.empty()) {
+            return fail();
+        }
+        char *end = nullptr;
+        errno     = 0;
+        /* Based literals keep their 64 bit pattern, 'hFFFF_FFFF_FFFF_FFFF folds to -1 */
+        long long value = static_cast<long long>(std::strtoull(digits.c_str(), &end, base));
+        /* Digits outside the base, including x and z, are not constant */
+        if (end != digits.c_str() + digits.size() || errno == ERANGE) {
+            return fail();
+        }
+        return value;
+    }
+};
+
+} // namespace
+
+bool QSocPortType::parse(const std::string &type)
+{
+    declaredType = type;
+    baseType.clear();
+    dimensions.clear();
+    valid         = false;
+    parameterized = false;
+    resolved      = false;
+
+    const std::string_view text    = type;
+    const size_t           bracket = text.find('[');
+    baseType = std::string(trim(text.substr(0, bracket)));
+    if (baseType.empty()) {
+        baseType = "logic";
+    }
+
+    /* Each packed dimension is a bracket pair, brackets may nest in expressions */
+    size_t pos = bracket;
+    while (pos != std::string_view::npos && pos < text.size()) {
+        if (text[pos] != '[') {
+            return false;
+        }
+        int    depth     = 0;
+        int    questions = 0;
+        size_t colon     = std::string_view::npos;
+        size_t close     = pos;
+        for (; close < text.size(); close++) {
+            const char c = text[close];
+            if (c == '[' || c == '(' || c == '{') {
+                depth++;
+            } else if (c == ']' || c == ')' || c == '}') {
+                depth--;
+                if (depth == 0) {
+                    break;
+                }
+            } else if (c == '?' && depth == 1) {
+                questions++;
+            } else if (c == ':' && depth == 1) {
+                /* Package scope operators and ternary colons are not range separators */
+                const bool scope = (close + 1 < text.size() && text[close + 1] == ':')
+                                   || (close > 0 && text[close - 1] == ':');
+                if (scope) {
+                    continue;
+                }
+                if (questions > 0) {
+                    questions--;
+                } else if (colon == std::string_view::npos) {
+                    colon = close;
+                }
+            }
+        }
+        if (close >= text.size()) {
+            return false;
+        }
+
+        Dimension dimension;
+        if (colon == std::string_view::npos) {
+            dimension.msbExpression = std::string(trim(text.substr(pos + 1, close - pos - 1)));
+        } else {
+            dimension.msbExpression = std::string(trim(text.substr(pos + 1, colon - pos - 1)));
+            dimension.lsbExpression = std::string(trim(text.substr(colon + 1, close - colon - 1)));
+            if (dimension.lsbExpression.empty()) {
+                return false;
+            }
+        }
+        if (dimension.msbExpression.empty()) {
+            return false;
+        }
+        dimensions.push_back(std::move(dimension));
+
+        /* Skip whitespace between dimensions */
+        pos = close + 1;
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+            pos++;
+        }
+    }
+    valid = true;
+
+    /* Bounds that fold without parameters never change */
+    const ParameterMap noParameters;
+    parameterized = !resolve(noParameters);
+    return true;
+}
+
+bool QSocPortType::resolve(const ParameterMap &parameters)
+{
+    resolved = false;
+    if (!valid) {
+        return false;
+    }
+
+    for (Dimension &dimension : dimensions) {
+        long long msb = 0;
+        long long lsb = 0;
+        if (!evaluate(dimension.msbExpression, parameters, msb)) {
+            return false;
+        }
+        if (dimension.lsbExpression.empty()) {
+            /* [size] is the same as [size-1:0] */
+            if (msb <= 0) {
+                return false;
+            }
+            msb = msb - 1;
+        } else if (!evaluate(dimension.lsbExpression, parameters, lsb)) {
+            return false;
+        }
+        dimension.msb = msb;
+        dimension.lsb = lsb;
+    }
+
+    resolved = true;
+    return true;
+}
+
+bool QSocPortType::isValid() const
+{
+    return valid;
+}
+
+bool QSocPortType::isParameterized() const
+{
+    return parameterized;
+}
+
+bool QSocPortType::isResolved() const
+{
+    return resolved;
+}
+
+int QSocPortType::width() const
+{
+    if (!resolved) {
+        return 0;
+    }
+
+    /* Packed dimensions multiply the base type, an unknown base type stays unknown */
+    long long result = baseTypeWidth(baseType);
+    if (result == 0) {
+        return 0;
+    }
+    for (const Dimension &dimension : dimensions) {
+        /* Bounds far apart would overflow the product, they are too wide anyway */
+        long long span = 0;
+        if (__builtin_sub_overflow(dimension.msb, dimension.lsb, &span)
+            || span <= -0x7fffffffLL || span >= 0x7fffffffLL) {
+            return 0;
+        }
+        result *= std::llabs(span) + 1;
+        if (result > 0x7fffffffLL) {
+            return 0;
+        }
+    }
+    return static_cast<int>(result);
+}
+
+std::string QSocPortType::toString() const
+{
+    if (!parameterized || !resolved) {
+        return declaredType;
+    }
+
+    std::string result = baseType;
+    for (const Dimension &dimension : dimensions) {
+        result += "[" + std::to_string(dimension.msb) + ":" + std::to_string(dimension.lsb) + "]";
+    }
+    return result;
+}
+
+const std::string &QSocPortType::getBaseType() const
+{
+    return baseType;
+}
+
+const std::vector<QSocPortType::Dimension> &QSocPortType::getDimensions() const
+{
+    return dimensions;
+}
+
+bool QSocPortType::evaluate(
+    std::string_view expression, const ParameterMap &parameters, long long &value)
+{
+    ExpressionFolder folder(expression, parameters);
+    return folder.fold(value);
+}
+
+QSocPortType::ParameterMap QSocPortType::foldParameters(
+    const std::vector<std::pair<std::string, std::string>> &definitions,
+    const std::vector<std::pair<std::string, std::string>> &overrides)
+{
+    ParameterMap result;
+
+    /* Overrides come from the parent scope and cannot see the definitions */
+    const ParameterMap noParameters;
+    for (const auto &[name, expression] : overrides) {
+        long long value = 0;
+        if (evaluate(expression, noParameters, value)) {
+            result[name] = value;
+        }
+    }
+
+    /* Fold definitions until a pass makes no progress */
+    std::vector<const std::pair<std::string, std::string> *> pending;
+    for (const auto &definition : definitions) {
+        bool overridden = false;
+        for (const auto &override : overrides) {
+            overridden = overridden || override.first == definition.first;
+        }
+        if (!overridden) {
+            pending.push_back(&definition);
+        }
+    }
+    bool progress = true;
+    while (progress && !pending.empty()) {
+        progress = false;
+        for (auto iter = pending.begin(); iter != pending.end();) {
+            long long value = 0;
+            if (evaluate((*iter)->second, result, value)) {
+                result[(*iter)->first] = value;
+                iter                   = pending.erase(iter);
+                progress               = true;
+            } else {
+                ++iter;
+            }
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,152 @@
+#ifndef QSOCPORTTYPE_H
+#define QSOCPORTTYPE_H
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief The QSocPortType class.
+ * @details This class models a SystemVerilog port type such as
+ *          "logic signed[WIDTH-1:0][3:0]". The type is parsed once into a
+ *          base type and a list of packed dimensions whose bounds are kept as
+ *          expressions. resolve() then folds the bound expressions to
+ *          constants with a given set of parameter values, so a type can be
+ *          parsed once per module port and resolved cheaply for every
+ *          parameter override. Expressions support integer and sized
+ *          literals, parameter names, parentheses, the unary, binary and
+ *          ternary operators of SystemVerilog and $clog2().
+ */
+class QSocPortType
+{
+public:
+    /**
+     * @brief Parameter name to value map.
+     */
+    using ParameterMap = std::unordered_map<std::string, long long>;
+
+    /**
+     * @brief The Dimension struct.
+     * @details A packed dimension, either [msb:lsb] or [size].
+     */
+    struct Dimension
+    {
+        std::string msbExpression; /* MSB expression, or size expression of [size] */
+        std::string lsbExpression; /* LSB expression, empty for [size] */
+        long long   msb = 0;       /* Folded MSB, valid after resolve() */
+        long long   lsb = 0;       /* Folded LSB, valid after resolve() */
+    };
+
+    /**
+     * @brief Parse a type string.
+     * @details Splits the type into its base type and packed dimensions. An
+     *          empty type is parsed as "logic".
+     * @param type The type string.
+     * @retval true Type parsed successfully.
+     * @retval false Type has unbalanced brackets or trailing text.
+     */
+    bool parse(const std::string &type);
+
+    /**
+     * @brief Fold all dimension bounds with the given parameters.
+     * @param parameters Parameter values visible to the type.
+     * @retval true All bounds folded to constants.
+     * @retval false A bound references an unknown name or is not constant.
+     */
+    bool resolve(const ParameterMap &parameters);
+
+    /**
+     * @brief Check whether the type was parsed successfully.
+     * @retval true Type is valid.
+     * @retval false Type could not be parsed.
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Check whether the dimensions depend on parameters.
+     * @retval true At least one bound is not a plain constant expression.
+     * @retval false All bounds are constant, the type never changes width.
+     */
+    bool isParameterized() const;
+
+    /**
+     * @brief Check whether all bounds are folded.
+     * @retval true resolve() succeeded.
+     * @retval false Type is not resolved.
+     */
+    bool isResolved() const;
+
+    /**
+     * @brief Get the width of the resolved type.
+     * @details Multiplies the width of the base type by the sizes of all
+     *          packed dimensions, e.g. "logic[3:0][7:0]" is 32 bits wide and
+     *          "byte[1:0]" 16. A base type of unknown width, such as a
+     *          typedef, makes the whole type unknown.
+     * @return int The width in bits, 0 if unresolved or unknown.
+     */
+    int width() const;
+
+    /**
+     * @brief Get the resolved type string.
+     * @details Returns the declared type unchanged when it does not depend on
+     *          parameters, otherwise the base type followed by the folded
+     *          dimensions, e.g. "logic[7:0]". Unresolved types are returned
+     *          as declared.
+     * @return std::string The type string.
+     */
+    std::string toString() const;
+
+    /**
+     * @brief Get the base type.
+     * @return const std::string & The base type, e.g. "logic signed".
+     */
+    const std::string &getBaseType() const;
+
+    /**
+     * @brief Get the packed dimensions.
+     * @return const std::vector<Dimension> & The dimensions, outermost first.
+     */
+    const std::vector<Dimension> &getDimensions() const;
+
+    /**
+     * @brief Evaluate a constant expression.
+     * @param expression The expression text.
+     * @param parameters Parameter values visible to the expression.
+     * @param value Set to the folded value on success.
+     * @retval true Expression folded to a constant.
+     * @retval false Expression is malformed or references an unknown name.
+     */
+    static bool evaluate(
+        std::string_view expression, const ParameterMap &parameters, long long &value);
+
+    /**
+     * @brief Fold a set of parameter definitions.
+     * @details Definitions may reference each other in any order, they are
+     *          folded until no further definition can be resolved. Overrides
+     *          replace definitions of the same name.
+     * @param definitions Parameter name and expression pairs.
+     * @param overrides Parameter name and expression pairs that take
+     *        precedence, evaluated without access to the definitions.
+     * @return ParameterMap The parameters that folded to constants.
+     */
+    static ParameterMap foldParameters(
+        const std::vector<std::pair<std::string, std::string>> &definitions,
+        const std::vector<std::pair<std::string, std::string>> &overrides = {});
+
+private:
+    /** Declared type string. */
+    std::string declaredType;
+    /** Base type without dimensions. */
+    std::string baseType;
+    /** Packed dimensions, outermost first. */
+    std::vector<Dimension> dimensions;
+    /** Type was parsed successfully. */
+    bool valid = false;
+    /** Bounds depend on parameters. */
+    bool parameterized = false;
+    /** All bounds are folded. */
+    bool resolved = false;
+};
+
+#endif // QSOCPORTTYPE_H
@@ -0,0 +1,178 @@
+#include "common/qsocprojectloader.h"
+
+#include "common/qsocbusmanager.h"
+#include "common/qsocmodulemanager.h"
+#include "common/qsocprojectmanager.h"
+
+#include <QMetaObject>
+#include <QRegularExpression>
+
+#include <thread>
+
+namespace {
+/* Load a project into a project manager of the calling thread */
+bool loadProject(
+    QSocProjectManager &projectManager, const QString &projectPath, const QString &projectName)
+{
+    projectManager.setProjectPath(projectPath);
+    if (projectName.isEmpty()) {
+        return projectManager.loadFirst();
+    }
+    return projectManager.load(projectName);
+}
+} // namespace
+
+QSocProjectLoader::QSocProjectLoader(QObject *parent)
+    : QObject(parent)
+{
+    qRegisterMetaType<QSocProjectLoader::SnapshotPointer>();
+    threadPool.setMaxThreadCount(1);
+}
+
+QSocProjectLoader::~QSocProjectLoader()
+{
+    cancel();
+    threadPool.waitForDone();
+}
+
+void QSocProjectLoader::load(const QString &projectPath, const QString &projectName)
+{
+    const quint64 loadGeneration = ++generation;
+    loading                      = true;
+
+    threadPool.clear();
+    threadPool.start([this, projectPath, projectName, loadGeneration]() {
+        auto       result = std::make_shared<Snapshot>();
+        QString    error;
+        const bool success = loadSnapshot(projectPath, projectName, loadGeneration, *result, error);
+
+        /* Hand the snapshot over on the thread of this object */
+        QMetaObject::invokeMethod(
+            this,
+            [this, result, success, error, loadGeneration]() {
+                if (loadGeneration != generation) {
+                    return;
+                }
+                loading = false;
+                if (!success) {
+                    emit failed(error);
+                    return;
+                }
+                snapshot = result;
+                emit loaded(snapshot);
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+void QSocProjectLoader::cancel()
+{
+    ++generation;
+    loading = false;
+    threadPool.clear();
+}
+
+bool QSocProjectLoader::isLoading() const
+{
+    return loading;
+}
+
+QSocProjectLoader::SnapshotPointer QSocProjectLoader::getSnapshot() const
+{
+    return snapshot;
+}
+
+bool QSocProjectLoader::loadSnapshot(
+    const QString &projectPath,
+    const QString &projectName,
+    quint64        loadGeneration,
+    Snapshot      &result,
+    QString       &error)
+{
+    /* Resolve the project once, so both library threads load the same one */
+    emit progress("project", 0, 1);
+    QSocProjectManager projectManager;
+    if (!loadProject(projectManager, projectPath, projectName)) {
+        error = tr("Failed to load project in %1").arg(projectPath);
+        return false;
+    }
+    result.projectName = projectManager.getProjectName();
+    result.projectPath = projectManager.getProjectPath();
+    emit progress("project", 1, 1);
+
+    /* Buses load on a second thread while modules load on this one */
+    QStringList busFailures;
+    std::thread busThread([&]() {
+        busFailures = loadBuses(result.projectPath, result.projectName, loadGeneration, result);
+    });
+    const QStringList moduleFailures
+        = loadModules(result.projectPath, result.projectName, loadGeneration, result);
+    busThread.join();
+
+    result.failedLibraries = moduleFailures + busFailures;
+    return loadGeneration == generation;
+}
+
+QStringList QSocProjectLoader::loadModules(
+    const QString &projectPath,
+    const QString &projectName,
+    quint64        loadGeneration,
+    Snapshot      &result)
+{
+    QStringList        failures;
+    QSocProjectManager projectManager;
+    if (!loadProject(projectManager, projectPath, projectName)) {
+        return failures;
+    }
+    QSocModuleManager moduleManager(nullptr, &projectManager);
+
+    result.moduleLibraries = moduleManager.listLibrary();
+    const int total        = static_cast<int>(result.moduleLibraries.size());
+    emit      progress("module", 0, total);
+    for (int index = 0; index < total; index++) {
+        if (loadGeneration != generation) {
+            return failures;
+        }
+        const QString &libraryName = result.moduleLibraries.at(index);
+        if (!moduleManager.load(libraryName)) {
+            failures.append(libraryName);
+        }
+        emit progress("module", index + 1, total);
+    }
+
+    result.modules    = moduleManager.listModule();
+    result.moduleData = moduleManager.getModuleYamls();
+    return failures;
+}
+
+QStringList QSocProjectLoader::loadBuses(
+    const QString &projectPath,
+    const QString &projectName,
+    quint64        loadGeneration,
+    Snapshot      &result)
+{
+    QStringList        failures;
+    QSocProjectManager projectManager;
+    if (!loadProject(projectManager, projectPath, projectName)) {
+        return failures;
+    }
+    QSocBusManager busManager(nullptr, &projectManager);
+
+    result.busLibraries = busManager.listLibrary();
+    const int total     = static_cast<int>(result.busLibraries.size());
+    emit      progress("bus", 0, total);
+    for (int index = 0; index < total; index++) {
+        if (loadGeneration != generation) {
+            return failures;
+        }
+        const QString &libraryName = result.busLibraries.at(index);
+        if (!busManager.load(libraryName)) {
+            failures.append(libraryName);
+        }
+        emit progress("bus", index + 1, total);
+    }
+
+    result.buses   = busManager.listBus();
+    result.busData = busManager.getBusYamls();
+    return failures;
+}
@@ -0,0 +1,186 @@
+#ifndef QSOCPROJECTLOADER_H
+#define QSOCPROJECTLOADER_H
+
+#include <QMetaType>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <atomic>
+#include <memory>
+
+#include <yaml-cpp/yaml.h>
+
+/**
+ * @brief The QSocProjectLoader class.
+ * @details This class loads a project and all of its module and bus
+ *          libraries in the background. The project is loaded first, then
+ *          module libraries and bus libraries are loaded at the same time on
+ *          two worker threads, each with managers of its own, so nothing is
+ *          shared with the caller while loading. Progress is reported per
+ *          library. The result is handed over as an immutable snapshot once
+ *          everything is loaded, so the GUI stays responsive and never sees
+ *          a half loaded library. Starting a new load drops the previous one,
+ *          and a cancelled load stops after the library it is loading.
+ */
+class QSocProjectLoader : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief The Snapshot struct.
+     * @details A loaded project with its libraries.
+     */
+    struct Snapshot
+    {
+        QString     projectName;     /* Project name */
+        QString     projectPath;     /* Project directory */
+        QStringList moduleLibraries; /* Module library names, sorted */
+        QStringList busLibraries;    /* Bus library names, sorted */
+        QStringList modules;         /* Module names, sorted */
+        QStringList buses;           /* Bus names, sorted */
+        YAML::Node  moduleData;      /* Module YAML by module name */
+        YAML::Node  busData;         /* Bus YAML by bus name */
+        QStringList failedLibraries; /* Libraries that failed to load */
+    };
+
+    /**
+     * @brief Shared pointer to an immutable snapshot.
+     */
+    using SnapshotPointer = std::shared_ptr<const Snapshot>;
+
+    /**
+     * @brief Constructor.
+     * @details This constructor will create an instance of this object.
+     * @param[in] parent parent object.
+     */
+    explicit QSocProjectLoader(QObject *parent = nullptr);
+
+    /**
+     * @brief Destructor.
+     * @details Cancels a running load and waits for it to stop.
+     */
+    ~QSocProjectLoader() override;
+
+public slots:
+    /**
+     * @brief Start loading a project.
+     * @details Returns at once, loaded() or failed() is emitted when done.
+     * @param projectPath The project directory.
+     * @param projectName The project name, empty to load the first project
+     *        found in the directory.
+     */
+    void load(const QString &projectPath, const QString &projectName = QString());
+
+    /**
+     * @brief Cancel the running load.
+     * @details Neither loaded() nor failed() is emitted for it.
+     */
+    void cancel();
+
+    /**
+     * @brief Check if a load is running.
+     * @retval true A load is running.
+     * @retval false No load is running.
+     */
+    bool isLoading() const;
+
+    /**
+     * @brief Get the latest snapshot.
+     * @return SnapshotPointer The last loaded snapshot, null before the first
+     *         load finished.
+     */
+    SnapshotPointer getSnapshot() const;
+
+signals:
+    /**
+     * @brief Report loading progress.
+     * @details Emitted from worker threads, module and bus progress are
+     *          reported separately.
+     * @param stage "project", "module" or "bus".
+     * @param done Number of items loaded.
+     * @param total Number of items to load.
+     */
+    void progress(const QString &stage, int done, int total);
+
+    /**
+     * @brief Report a finished load.
+     * @details Emitted on the thread of this object.
+     * @param snapshot The loaded project.
+     */
+    void loaded(QSocProjectLoader::SnapshotPointer snapshot);
+
+    /**
+     * @brief Report a failed load.
+     * @details Emitted on the thread of this object.
+     * @param message The error message.
+     */
+    void failed(const QString &message);
+
+private:
+    /* Worker thread of the loader, module and bus libraries add a second one. */
+    QThreadPool threadPool;
+
+    /* Number of the latest load, older loads stop and drop their result. */
+    std::atomic<quint64> generation{0};
+
+    /* A load is running. */
+    bool loading = false;
+
+    /* Last loaded snapshot. */
+    SnapshotPointer snapshot;
+
+    /**
+     * @brief Load a project into a snapshot.
+     * @details Runs on a worker thread.
+     * @param projectPath The project directory.
+     * @param projectName The project name, empty for the first project.
+     * @param loadGeneration Number of this load.
+     * @param result The snapshot to fill.
+     * @param error Set to the error message on failure.
+     * @retval true The project was loaded, failed libraries are listed in
+     *         the snapshot.
+     * @retval false The project could not be loaded or the load was dropped.
+     */
+    bool loadSnapshot(
+        const QString &projectPath,
+        const QString &projectName,
+        quint64        loadGeneration,
+        Snapshot      &result,
+        QString       &error);
+
+    /**
+     * @brief Load the module libraries of a project.
+     * @details Runs on a worker thread with a project manager of its own.
+     * @param projectPath The project directory.
+     * @param projectName The project name.
+     * @param loadGeneration Number of this load.
+     * @param result The snapshot to fill with modules.
+     * @return QStringList Libraries that failed to load.
+     */
+    QStringList loadModules(
+        const QString &projectPath,
+        const QString &projectName,
+        quint64        loadGeneration,
+        Snapshot      &result);
+
+    /**
+     * @brief Load the bus libraries of a project.
+     * @details Runs on a worker thread with a project manager of its own.
+     * @param projectPath The project directory.
+     * @param projectName The project name.
+     * @param loadGeneration Number of this load.
+     * @param result The snapshot to fill with buses.
+     * @return QStringList Libraries that failed to load.
+     */
+    QStringList loadBuses(
+        const QString &projectPath,
+        const QString &projectName,
+        quint64        loadGeneration,
+        Snapshot      &result);
+};
+
+Q_DECLARE_METATYPE(QSocProjectLoader::SnapshotPointer)
+
+#endif // QSOCPROJECTLOADER_H
@@ -1,5 +1,8 @@
 #include "common/qsocprojectmanager.h"
 
+#include "common/qstatictrace.h"
+#include "common/qstaticyamlcache.h"
+
 #include <QCoreApplication>
 #include <QDir>
 #include <QFile>
@@ -139,12 +142,14 @@ bool QSocProjectManager::save(const QString &projectName)
     std::ofstream  outputFileStream(projectFilePath.toStdString());
     /* Serialize project yaml data */
     outputFileStream << getProjectYaml();
+    QStaticYamlCache::invalidate(projectFilePath);
 
     return true;
 }
 
 bool QSocProjectManager::load(const QString &projectName)
 {
+    const QStaticTrace::Span span("project.load", projectName);
     /* Check project name */
     if (projectName.isEmpty()) {
         qCritical() << "Error: project name is empty.";
@@ -158,7 +163,7 @@ bool QSocProjectManager::load(const QString &projectName)
         return false;
     }
     /* Load project file */
-    YAML::Node localProjectNode = YAML::LoadFile(filePath.toStdString());
+    YAML::Node localProjectNode = QStaticYamlCache::load(filePath);
     /* Check project file version */
     const QVersionNumber projectVersion = QVersionNumber::fromString(
         QString::fromStdString(localProjectNode["version"].as<std::string>()));
@@ -225,6 +230,7 @@ bool QSocProjectManager::remove(const QString &projectName)
         qCritical() << "Error: failed to remove project file.";
         return false;
     }
+    QStaticYamlCache::invalidate(filePath);
     return true;
 }
 
@@ -0,0 +1,122 @@
+#include "common/qsocresidentlibraries.h"
+
+#include "common/qstaticmetrics.h"
+#include "common/qstaticyamlcache.h"
+
+#include <QMutexLocker>
+#include <QSet>
+
+namespace {
+/* Libraries reused from a previous command */
+QStaticMetrics::Counter librariesReused("library.reused");
+} // namespace
+
+QHash<QString, QSocResidentLibraries::Kept> QSocResidentLibraries::kept;
+QMutex                                      QSocResidentLibraries::mutex;
+
+QSocResidentLibraries::QSocResidentLibraries(const QString &kind)
+    : kind(kind)
+{}
+
+void QSocResidentLibraries::begin(const QString &dirPath, YAML::Node &data)
+{
+    if (started) {
+        if (dirPath != this->dirPath) {
+            discard();
+        }
+        return;
+    }
+    started = true;
+    if (!QStaticYamlCache::isEnabled() || data.size() > 0) {
+        return;
+    }
+    active        = true;
+    this->dirPath = dirPath;
+
+    /* Take what was kept even if it is for another directory, it is stale then */
+    const QMutexLocker locker(&mutex);
+    const Kept         previous = kept.take(kind);
+    if (previous.dirPath != dirPath) {
+        return;
+    }
+    /* Rebind, assigning a node would overwrite the node it refers to */
+    data.reset(previous.data);
+    libraries = previous.libraries;
+    owners    = previous.owners;
+    replaced  = previous.replaced;
+}
+
+bool QSocResidentLibraries::reuse(
+    const QString &libraryName, const QString &filePath, QSocLibraryIndex &libraryIndex)
+{
+    if (!active) {
+        return false;
+    }
+    const auto library = libraries.constFind(libraryName);
+    if (library == libraries.cend() || library->generation == 0
+        || library->generation != QStaticYamlCache::generation(filePath)) {
+        return false;
+    }
+    for (const QString &name : library->names) {
+        if (owners.value(name) != libraryName) {
+            return false;
+        }
+    }
+
+    for (const QString &name : library->names) {
+        libraryIndex.insert(libraryName, name);
+    }
+    librariesReused.add();
+    return true;
+}
+
+bool QSocResidentLibraries::contains(const QString &name) const
+{
+    return owners.contains(name);
+}
+
+void QSocResidentLibraries::loaded(
+    const QString &libraryName, const QString &filePath, const QStringList &names)
+{
+    if (!active) {
+        return;
+    }
+    /* Names the library no longer has keep their nodes, count them as replaced */
+    const Library       previous = libraries.value(libraryName);
+    const QSet<QString> current(names.cbegin(), names.cend());
+    for (const QString &name : previous.names) {
+        if (!current.contains(name) && owners.value(name) == libraryName) {
+            replaced++;
+        }
+    }
+    for (const QString &name : names) {
+        if (owners.contains(name)) {
+            replaced++;
+        }
+        owners.insert(name, libraryName);
+    }
+    libraries.insert(libraryName, {QStaticYamlCache::generation(filePath), names});
+}
+
+void QSocResidentLibraries::discard()
+{
+    active = false;
+    libraries.clear();
+    owners.clear();
+}
+
+void QSocResidentLibraries::end(const YAML::Node &data)
+{
+    if (!active || !QStaticYamlCache::isEnabled() || replaced > owners.size()) {
+        return;
+    }
+    const QMutexLocker locker(&mutex);
+    kept.remove(kind);
+    kept.insert(kind, {dirPath, data, libraries, owners, replaced});
+}
+
+void QSocResidentLibraries::clear()
+{
+    const QMutexLocker locker(&mutex);
+    kept.clear();
+}
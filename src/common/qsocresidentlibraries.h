@@ -0,0 +1,148 @@
+#ifndef QSOCRESIDENTLIBRARIES_H
+#define QSOCRESIDENTLIBRARIES_H
+
+#include "common/qsoclibraryindex.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+#include <yaml-cpp/yaml.h>
+
+/**
+ * @brief The QSocResidentLibraries class.
+ * @details Keeps the libraries a module or bus manager loaded between the
+ *          commands of a long running session, such as `qsoc serve` or
+ *          `qsoc batch`. Every command still gets fresh managers. The first
+ *          load of a manager takes over the data the last manager of the same
+ *          kind left for the same directory, and the manager leaves its data
+ *          behind when it is destroyed. A library is reused while
+ *          QStaticYamlCache reports the generation it was loaded from, so
+ *          saving, removing or editing its file loads it again. Reused
+ *          libraries only add their names to the library index, modules or
+ *          buses of libraries the command does not load stay in the data but
+ *          out of sight. Nothing is kept while the cache is disabled.
+ */
+class QSocResidentLibraries
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param kind Kind of the libraries, such as "module" or "bus". Managers
+     *             of the same kind share what is kept.
+     */
+    explicit QSocResidentLibraries(const QString &kind);
+
+    /**
+     * @brief Start loading from a library directory.
+     * @details Call before each load. The first call takes over the data
+     *          kept for the directory, if the cache is enabled and the data
+     *          of the manager is still empty. Loading from another directory
+     *          later stops keeping anything for this manager.
+     * @param dirPath Absolute path of the library directory.
+     * @param data The library data of the manager, rebound to the kept data.
+     */
+    void begin(const QString &dirPath, YAML::Node &data);
+
+    /**
+     * @brief Reuse a library kept in the data.
+     * @details The library is reused if its file has the generation it was
+     *          loaded from and no other library replaced any of its nodes
+     *          since. Its names are added to the library index.
+     * @param libraryName The library name.
+     * @param filePath Path of the library file.
+     * @param libraryIndex The library index of the manager.
+     * @retval true The library was reused.
+     * @retval false The library must be loaded from its file.
+     */
+    bool reuse(
+        const QString &libraryName, const QString &filePath, QSocLibraryIndex &libraryIndex);
+
+    /**
+     * @brief Check if the data has a node of a name.
+     * @details Kept nodes are in the data even when no loaded library owns
+     *          them, so a name missing from the library index may still need
+     *          its node replaced rather than appended.
+     * @param name The module or bus name.
+     * @retval true The data may have a node of the name.
+     * @retval false The data has no node of the name.
+     */
+    bool contains(const QString &name) const;
+
+    /**
+     * @brief Record a library loaded from its file.
+     * @param libraryName The library name.
+     * @param filePath Path of the library file.
+     * @param names The names of the library, in the order they were loaded.
+     */
+    void loaded(const QString &libraryName, const QString &filePath, const QStringList &names);
+
+    /**
+     * @brief Keep nothing of this manager.
+     * @details Call when a library failed to load halfway, the data then has
+     *          nodes that no recorded library accounts for.
+     */
+    void discard();
+
+    /**
+     * @brief Leave the data for the next manager of the same kind.
+     * @details Nothing is kept once the replaced nodes outnumber the names,
+     *          the next manager then loads from the cache into fresh data.
+     * @param data The library data of the manager.
+     */
+    void end(const YAML::Node &data);
+
+    /**
+     * @brief Drop everything kept for all kinds.
+     * @details Call after a failed command, it may have changed the data of
+     *          its managers without saving the libraries.
+     */
+    static void clear();
+
+private:
+    /**
+     * @brief The Library struct.
+     * @details A library loaded into the data.
+     */
+    struct Library
+    {
+        quint64     generation = 0; /* Cache generation of the file it was loaded from */
+        QStringList names;          /* Names of the library */
+    };
+
+    /**
+     * @brief The Kept struct.
+     * @details What a manager left behind, see end().
+     */
+    struct Kept
+    {
+        QString                 dirPath;      /* Library directory */
+        YAML::Node              data;         /* Library data */
+        QHash<QString, Library> libraries;    /* Loaded libraries by name */
+        QHash<QString, QString> owners;       /* Library whose node the data has, by name */
+        qsizetype               replaced = 0; /* Nodes replaced since the data was fresh */
+    };
+
+    /** Kind of the libraries. */
+    QString kind;
+    /** Library directory. */
+    QString dirPath;
+    /** Loaded libraries by name. */
+    QHash<QString, Library> libraries;
+    /** Library whose node the data has, by name. */
+    QHash<QString, QString> owners;
+    /** Nodes replaced since the data was fresh. */
+    qsizetype replaced = 0;
+    /** Whether begin() was called. */
+    bool started = false;
+    /** Whether the data is kept when the manager is done. */
+    bool active = false;
+
+    /** Kept data by kind. */
+    static QHash<QString, Kept> kept;
+    /** Guards kept. */
+    static QMutex mutex;
+};
+
+#endif // QSOCRESIDENTLIBRARIES_H
@@ -0,0 +1,625 @@
+#include "common/qsocschematiclayout.h"
+
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <queue>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+
+namespace {
+/* Row of the first port, the rows above hold the instance title */
+constexpr int kPortFirstRow = 2;
+/* Smallest instance size in grid units */
+constexpr int kNodeMinWidth  = 6;
+constexpr int kNodeMinHeight = 3;
+/* Characters of a port or instance name per grid column */
+constexpr int kCharsPerColumn = 3;
+/* Free rows between instances of one layer */
+constexpr int kNodeGap = 2;
+/* Free columns on both sides of the tracks of a channel */
+constexpr int kChannelMargin = 2;
+/* Row of the first crossover, counted upwards from the top of the instances */
+constexpr int kCrossoverFirstRow = 2;
+/* Barycenter sweeps, each one goes down and up once */
+constexpr int kOrderingSweeps = 8;
+/* Work per thread below which spawning another thread does not pay off */
+constexpr int kMinChannelsPerThread = 16;
+constexpr int kMinNetsPerThread     = 1024;
+
+/* Split [0, count) into contiguous shards and run them on worker threads */
+void forEachShard(
+    int count, int threadCount, int minPerThread, const std::function<void(int, int)> &function)
+{
+    const int maxShards  = std::max(1, (count + minPerThread - 1) / minPerThread);
+    const int shardCount = std::clamp(threadCount, 1, maxShards);
+    if (shardCount == 1) {
+        function(0, count);
+        return;
+    }
+    const int                shardSize = (count + shardCount - 1) / shardCount;
+    std::vector<std::thread> workers;
+    workers.reserve(shardCount);
+    for (int shard = 0; shard < shardCount; shard++) {
+        const int first = std::min(shard * shardSize, count);
+        const int last  = std::min(first + shardSize, count);
+        workers.emplace_back(function, first, last);
+    }
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+/* Append a polyline point, dropping repeated and collinear points */
+void appendPoint(std::vector<QSocSchematicLayout::Point> &points, QSocSchematicLayout::Point point)
+{
+    const size_t size = points.size();
+    if (size > 0 && points[size - 1].x == point.x && points[size - 1].y == point.y) {
+        return;
+    }
+    if (size > 1) {
+        const QSocSchematicLayout::Point &before = points[size - 2];
+        const QSocSchematicLayout::Point &last   = points[size - 1];
+        if ((before.x == last.x && last.x == point.x)
+            || (before.y == last.y && last.y == point.y)) {
+            points[size - 1] = point;
+            return;
+        }
+    }
+    points.push_back(point);
+}
+
+/* Row of a crossover */
+int crossoverRow(int row)
+{
+    return -(kCrossoverFirstRow + row);
+}
+} // namespace
+
+QSocSchematicLayout::QSocSchematicLayout(const QSocNetlistGraph &graph)
+{
+    /* Nodes with the ports of their module */
+    nodes.resize(graph.instanceCount());
+    for (int instance = 0; instance < graph.instanceCount(); instance++) {
+        const QSocNetlistGraph::Instance &instanceData = graph.instance(instance);
+        Node                             &node         = nodes[instance];
+
+        node.name = graph.symbolName(instanceData.name);
+        if (instanceData.module < 0) {
+            continue;
+        }
+        const QSocNetlistGraph::Module &module = graph.module(instanceData.module);
+
+        node.module = graph.symbolName(module.name);
+        node.ports.reserve(module.ports.size());
+        for (const QSocNetlistGraph::Port &port : module.ports) {
+            Port portData;
+            portData.name  = graph.symbolName(port.name);
+            portData.right = port.direction == QSocNetlistGraph::Direction::Output
+                             || port.direction == QSocNetlistGraph::Direction::Inout;
+            node.ports.push_back(std::move(portData));
+        }
+    }
+
+    /* Net endpoints, the first output or inout drives the net */
+    netNames.reserve(graph.netCount());
+    for (int net = 0; net < graph.netCount(); net++) {
+        netNames.push_back(graph.netName(net));
+        Net netData;
+        netData.id = net;
+        int driver = -1;
+        for (const int pin : graph.netPins(net)) {
+            const QSocNetlistGraph::Pin &pinData = graph.pin(pin);
+            if (pinData.instance < 0) {
+                continue;
+            }
+            Node &node = nodes[pinData.instance];
+            int   port = pinData.port;
+            if (port < 0 || port >= static_cast<int>(node.ports.size())) {
+                /* Unresolved ports are shown on the left side */
+                const std::string &portName = graph.symbolName(pinData.portName);
+                const auto         iterator = std::find_if(
+                    node.ports.begin(), node.ports.end(), [&portName](const Port &portData) {
+                        return portData.name == portName;
+                    });
+                port = static_cast<int>(iterator - node.ports.begin());
+                if (iterator == node.ports.end()) {
+                    Port portData;
+                    portData.name = portName;
+                    node.ports.push_back(std::move(portData));
+                }
+            }
+            if (driver < 0 && node.ports[port].right) {
+                driver = static_cast<int>(netData.endpoints.size());
+            }
+            netData.endpoints.push_back({pinData.instance, port});
+            netData.width = std::max(netData.width, graph.pinWidth(pin));
+        }
+        if (netData.endpoints.size() < 2) {
+            continue;
+        }
+        if (driver > 0) {
+            std::swap(netData.endpoints[0], netData.endpoints[driver]);
+        }
+        nets.push_back(std::move(netData));
+    }
+
+    /* Size nodes to fit their ports and names */
+    for (Node &node : nodes) {
+        int    leftCount  = 0;
+        int    rightCount = 0;
+        size_t leftChars  = 0;
+        size_t rightChars = 0;
+        for (Port &port : node.ports) {
+            int    &count = port.right ? rightCount : leftCount;
+            size_t &chars = port.right ? rightChars : leftChars;
+            port.offset   = kPortFirstRow + count++;
+            chars         = std::max(chars, port.name.size());
+        }
+        const size_t nameChars = std::max(node.name.size(), node.module.size());
+        const int    portWidth = static_cast<int>(leftChars + rightChars) / kCharsPerColumn + 2;
+        const int    nameWidth = static_cast<int>(nameChars) / kCharsPerColumn + 2;
+
+        node.width  = std::max({kNodeMinWidth, portWidth, nameWidth});
+        node.height = std::max(kNodeMinHeight, std::max(leftCount, rightCount) + kPortFirstRow);
+    }
+}
+
+void QSocSchematicLayout::run(int threadCount)
+{
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    threadCount = std::max(threadCount, 1);
+
+    buildEdges();
+    assignLayers();
+    orderLayers();
+    placeRows();
+    const std::vector<int> channelX = routeChannels(threadCount);
+    emitWires(channelX, threadCount);
+    indexWires();
+}
+
+const std::vector<QSocSchematicLayout::Node> &QSocSchematicLayout::getNodes() const
+{
+    return nodes;
+}
+
+const std::vector<QSocSchematicLayout::Wire> &QSocSchematicLayout::getWires() const
+{
+    return wires;
+}
+
+const std::string &QSocSchematicLayout::getNetName(int net) const
+{
+    return netNames[net];
+}
+
+const QSocSpatialIndex &QSocSchematicLayout::getNodeIndex() const
+{
+    return nodeIndex;
+}
+
+const QSocSpatialIndex &QSocSchematicLayout::getWireIndex() const
+{
+    return wireIndex;
+}
+
+int QSocSchematicLayout::getLayerCount() const
+{
+    return static_cast<int>(layers.size());
+}
+
+void QSocSchematicLayout::buildEdges()
+{
+    const int count = static_cast<int>(nodes.size());
+
+    /* One edge from the driver of each net to every other instance on it */
+    std::vector<std::pair<int, int>> edges;
+    for (const Net &net : nets) {
+        const int driver = net.endpoints.front().node;
+        for (const Endpoint &endpoint : net.endpoints) {
+            if (endpoint.node != driver) {
+                edges.emplace_back(driver, endpoint.node);
+            }
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    std::vector<std::vector<int>> outgoing(count);
+    std::vector<int>              incoming(count, 0);
+    for (const auto &[from, to] : edges) {
+        outgoing[from].push_back(to);
+        incoming[to]++;
+    }
+
+    /* Depth-first search, edges back into the search stack are reversed */
+    predecessors.assign(count, {});
+    successors.assign(count, {});
+    enum : char { Unvisited, Active, Finished };
+    std::vector<char>                   state(count, Unvisited);
+    std::vector<std::pair<int, size_t>> stack;
+    const auto                          visit = [&](int root) {
+        if (state[root] != Unvisited) {
+            return;
+        }
+        state[root] = Active;
+        stack.emplace_back(root, 0);
+        while (!stack.empty()) {
+            const int node = stack.back().first;
+            size_t   &next = stack.back().second;
+            if (next == outgoing[node].size()) {
+                state[node] = Finished;
+                stack.pop_back();
+                continue;
+            }
+            const int target = outgoing[node][next++];
+            if (state[target] == Active) {
+                successors[target].push_back(node);
+                predecessors[node].push_back(target);
+                continue;
+            }
+            successors[node].push_back(target);
+            predecessors[target].push_back(node);
+            if (state[target] == Unvisited) {
+                state[target] = Active;
+                stack.emplace_back(target, 0);
+            }
+        }
+    };
+    /* Start from sources, so cycles are cut where signals enter them */
+    for (int node = 0; node < count; node++) {
+        if (incoming[node] == 0) {
+            visit(node);
+        }
+    }
+    for (int node = 0; node < count; node++) {
+        visit(node);
+    }
+
+    /* A reversed edge may duplicate an edge in the other direction */
+    for (int node = 0; node < count; node++) {
+        for (std::vector<int> *list : {&predecessors[node], &successors[node]}) {
+            std::sort(list->begin(), list->end());
+            list->erase(std::unique(list->begin(), list->end()), list->end());
+        }
+    }
+}
+
+void QSocSchematicLayout::assignLayers()
+{
+    const int count = static_cast<int>(nodes.size());
+
+    /* Longest path from the sources, in topological order */
+    std::vector<int> layerOf(count, 0);
+    std::vector<int> remaining(count);
+    std::vector<int> order;
+    order.reserve(count);
+    for (int node = 0; node < count; node++) {
+        remaining[node] = static_cast<int>(predecessors[node].size());
+        if (remaining[node] == 0) {
+            order.push_back(node);
+        }
+    }
+    for (size_t index = 0; index < order.size(); index++) {
+        const int node = order[index];
+        for (const int successor : successors[node]) {
+            layerOf[successor] = std::max(layerOf[successor], layerOf[node] + 1);
+            if (--remaining[successor] == 0) {
+                order.push_back(successor);
+            }
+        }
+    }
+
+    /* Pull sources next to their first sink, so their wires stay short */
+    int layerCount = count > 0 ? 1 : 0;
+    for (int node = 0; node < count; node++) {
+        if (predecessors[node].empty() && !successors[node].empty()) {
+            int layer = INT_MAX;
+            for (const int successor : successors[node]) {
+                layer = std::min(layer, layerOf[successor]);
+            }
+            layerOf[node] = layer - 1;
+        }
+        layerCount = std::max(layerCount, layerOf[node] + 1);
+    }
+
+    /* Topological order is the starting order inside each layer */
+    layers.assign(layerCount, {});
+    for (const int node : order) {
+        nodes[node].layer = layerOf[node];
+        layers[layerOf[node]].push_back(node);
+    }
+}
+
+void QSocSchematicLayout::orderLayers()
+{
+    const int layerCount = static_cast<int>(layers.size());
+
+    /* Positions are relative to the layer size, so layers of any size mix */
+    std::vector<double> position(nodes.size(), 0.0);
+    std::vector<double> barycenter(nodes.size(), 0.0);
+    const auto          updatePositions = [&](int layer) {
+        const std::vector<int> &members = layers[layer];
+        for (size_t index = 0; index < members.size(); index++) {
+            position[members[index]] = (static_cast<double>(index) + 0.5)
+                                       / static_cast<double>(members.size());
+        }
+    };
+    const auto sortLayer = [&](int layer, const std::vector<std::vector<int>> &neighbors) {
+        std::vector<int> &members = layers[layer];
+        for (const int node : members) {
+            if (neighbors[node].empty()) {
+                barycenter[node] = position[node];
+                continue;
+            }
+            double sum = 0.0;
+            for (const int neighbor : neighbors[node]) {
+                sum += position[neighbor];
+            }
+            barycenter[node] = sum / static_cast<double>(neighbors[node].size());
+        }
+        std::stable_sort(members.begin(), members.end(), [&barycenter](int left, int right) {
+            return barycenter[left] < barycenter[right];
+        });
+        updatePositions(layer);
+    };
+
+    for (int layer = 0; layer < layerCount; layer++) {
+        updatePositions(layer);
+    }
+    for (int sweep = 0; sweep < kOrderingSweeps; sweep++) {
+        for (int layer = 1; layer < layerCount; layer++) {
+            sortLayer(layer, predecessors);
+        }
+        for (int layer = layerCount - 2; layer >= 0; layer--) {
+            sortLayer(layer, successors);
+        }
+    }
+}
+
+void QSocSchematicLayout::placeRows()
+{
+    /* Predecessors are in earlier layers, so they are placed first */
+    for (const std::vector<int> &members : layers) {
+        int nextRow = 0;
+        for (const int node : members) {
+            Node &nodeData = nodes[node];
+            int   row      = nextRow;
+            if (!predecessors[node].empty()) {
+                /* Center on the predecessors, in half rows */
+                long long sum = 0;
+                for (const int predecessor : predecessors[node]) {
+                    sum += 2LL * nodes[predecessor].y + nodes[predecessor].height;
+                }
+                const long long center = sum / static_cast<long long>(predecessors[node].size());
+                row = std::max(nextRow, static_cast<int>((center - nodeData.height) / 2));
+            }
+            nodeData.y = row;
+            nextRow    = row + nodeData.height + kNodeGap;
+        }
+    }
+}
+
+std::vector<int> QSocSchematicLayout::routeChannels(int threadCount)
+{
+    const int channelCount = static_cast<int>(layers.size()) + 1;
+
+    /* Nets that touch several channels get a crossover row */
+    std::vector<Segment> crossovers;
+    for (int net = 0; net < static_cast<int>(nets.size()); net++) {
+        int first = INT_MAX;
+        int last  = -1;
+        for (const Endpoint &endpoint : nets[net].endpoints) {
+            const int channel = channelOf(endpoint);
+            first             = std::min(first, channel);
+            last              = std::max(last, channel);
+        }
+        nets[net].row = -1;
+        nets[net].tracks.clear();
+        if (first != last) {
+            crossovers.push_back({net, first, last});
+        }
+    }
+    std::vector<int> rows;
+    assignTracks(crossovers, rows);
+    for (size_t index = 0; index < crossovers.size(); index++) {
+        nets[crossovers[index].net].row = rows[index];
+    }
+
+    /* Vertical extent of every net in every channel it touches */
+    std::vector<std::vector<Segment>>    channels(channelCount);
+    std::vector<std::pair<int, Segment>> extents;
+    for (int net = 0; net < static_cast<int>(nets.size()); net++) {
+        extents.clear();
+        for (const Endpoint &endpoint : nets[net].endpoints) {
+            const int  channel  = channelOf(endpoint);
+            const int  row      = pointOf(endpoint).y;
+            const auto iterator = std::find_if(
+                extents.begin(), extents.end(), [channel](const std::pair<int, Segment> &extent) {
+                    return extent.first == channel;
+                });
+            if (iterator == extents.end()) {
+                extents.push_back({channel, {net, row, row}});
+            } else {
+                iterator->second.top    = std::min(iterator->second.top, row);
+                iterator->second.bottom = std::max(iterator->second.bottom, row);
+            }
+        }
+        for (auto &[channel, segment] : extents) {
+            if (nets[net].row >= 0) {
+                segment.top = std::min(segment.top, crossoverRow(nets[net].row));
+            }
+            channels[channel].push_back(segment);
+        }
+    }
+
+    /* Channels are independent, route them in parallel */
+    std::vector<std::vector<int>> tracks(channelCount);
+    std::vector<int>              trackCounts(channelCount, 0);
+    forEachShard(channelCount, threadCount, kMinChannelsPerThread, [&](int first, int last) {
+        for (int channel = first; channel < last; channel++) {
+            trackCounts[channel] = assignTracks(channels[channel], tracks[channel]);
+        }
+    });
+    for (int channel = 0; channel < channelCount; channel++) {
+        for (size_t index = 0; index < channels[channel].size(); index++) {
+            nets[channels[channel][index].net].tracks.emplace_back(channel, tracks[channel][index]);
+        }
+    }
+
+    /* Columns follow from the channel widths */
+    std::vector<int> channelX(channelCount, 0);
+    int              column = 0;
+    for (int channel = 0; channel < channelCount; channel++) {
+        channelX[channel] = column;
+        column += trackCounts[channel] + 2 * kChannelMargin;
+        if (channel == channelCount - 1) {
+            break;
+        }
+        int layerWidth = 0;
+        for (const int node : layers[channel]) {
+            layerWidth = std::max(layerWidth, nodes[node].width);
+        }
+        for (const int node : layers[channel]) {
+            nodes[node].x = column + (layerWidth - nodes[node].width) / 2;
+        }
+        column += layerWidth;
+    }
+    return channelX;
+}
+
+void QSocSchematicLayout::emitWires(const std::vector<int> &channelX, int threadCount)
+{
+    /* One wire per sink, each net writes its own slice */
+    std::vector<size_t> offsets(nets.size() + 1, 0);
+    for (size_t net = 0; net < nets.size(); net++) {
+        offsets[net + 1] = offsets[net] + nets[net].endpoints.size() - 1;
+    }
+    wires.assign(offsets.back(), Wire());
+
+    const int netCount = static_cast<int>(nets.size());
+    forEachShard(netCount, threadCount, kMinNetsPerThread, [&](int first, int last) {
+        for (int net = first; net < last; net++) {
+            const Net &netData     = nets[net];
+            const auto trackColumn = [&](int channel) {
+                for (const auto &[trackChannel, track] : netData.tracks) {
+                    if (trackChannel == channel) {
+                        return channelX[channel] + kChannelMargin + track;
+                    }
+                }
+                return channelX[channel] + kChannelMargin;
+            };
+            const Endpoint &driver        = netData.endpoints.front();
+            const int       driverChannel = channelOf(driver);
+            const Point     driverPoint   = pointOf(driver);
+            const int       driverColumn  = trackColumn(driverChannel);
+            for (size_t index = 1; index < netData.endpoints.size(); index++) {
+                const Endpoint &sink      = netData.endpoints[index];
+                const int       channel   = channelOf(sink);
+                const Point     sinkPoint = pointOf(sink);
+                Wire           &wire      = wires[offsets[net] + index - 1];
+                wire.net                  = netData.id;
+                wire.width                = netData.width;
+                wire.from                 = driver;
+                wire.to                   = sink;
+                appendPoint(wire.points, driverPoint);
+                appendPoint(wire.points, {driverColumn, driverPoint.y});
+                if (channel != driverChannel) {
+                    const int row    = crossoverRow(netData.row);
+                    const int column = trackColumn(channel);
+                    appendPoint(wire.points, {driverColumn, row});
+                    appendPoint(wire.points, {column, row});
+                    appendPoint(wire.points, {column, sinkPoint.y});
+                } else {
+                    appendPoint(wire.points, {driverColumn, sinkPoint.y});
+                }
+                appendPoint(wire.points, sinkPoint);
+            }
+        }
+    });
+}
+
+void QSocSchematicLayout::indexWires()
+{
+    /* Wires between the same two nodes share a bundle */
+    const long long                    nodeCount = static_cast<long long>(nodes.size());
+    std::unordered_map<long long, int> bundles;
+    bundles.reserve(wires.size());
+    for (int index = 0; index < static_cast<int>(wires.size()); index++) {
+        Wire           &wire = wires[index];
+        const long long key  = wire.from.node * nodeCount + wire.to.node;
+
+        const auto [iterator, inserted] = bundles.try_emplace(key, index);
+        wire.bundle                     = iterator->second;
+        if (!inserted) {
+            wires[iterator->second].bundleSize++;
+        }
+    }
+
+    std::vector<QSocSpatialIndex::Entry> entries;
+    entries.reserve(nodes.size());
+    for (int index = 0; index < static_cast<int>(nodes.size()); index++) {
+        const Node &node = nodes[index];
+        entries.push_back({{node.x, node.y, node.x + node.width, node.y + node.height}, index});
+    }
+    nodeIndex.build(std::move(entries));
+
+    entries.clear();
+    for (int index = 0; index < static_cast<int>(wires.size()); index++) {
+        const std::vector<Point> &points = wires[index].points;
+        for (size_t point = 1; point < points.size(); point++) {
+            const Point &from = points[point - 1];
+            const Point &to   = points[point];
+            entries.push_back(
+                {{std::min(from.x, to.x),
+                  std::min(from.y, to.y),
+                  std::max(from.x, to.x),
+                  std::max(from.y, to.y)},
+                 index});
+        }
+    }
+    wireIndex.build(std::move(entries));
+}
+
+int QSocSchematicLayout::channelOf(const Endpoint &endpoint) const
+{
+    const Node &node = nodes[endpoint.node];
+    return node.layer + (node.ports[endpoint.port].right ? 1 : 0);
+}
+
+QSocSchematicLayout::Point QSocSchematicLayout::pointOf(const Endpoint &endpoint) const
+{
+    const Node &node = nodes[endpoint.node];
+    const Port &port = node.ports[endpoint.port];
+    return {port.right ? node.x + node.width : node.x, node.y + port.offset};
+}
+
+int QSocSchematicLayout::assignTracks(std::vector<Segment> &segments, std::vector<int> &tracks)
+{
+    std::sort(segments.begin(), segments.end(), [](const Segment &left, const Segment &right) {
+        return std::tie(left.top, left.bottom, left.net)
+               < std::tie(right.top, right.bottom, right.net);
+    });
+
+    /* Tracks by the bottom of their last segment, the highest one first */
+    using TrackEnd = std::pair<int, int>;
+    std::priority_queue<TrackEnd, std::vector<TrackEnd>, std::greater<>> trackEnds;
+    int                                                                  trackCount = 0;
+    tracks.assign(segments.size(), 0);
+    for (size_t index = 0; index < segments.size(); index++) {
+        int track = trackCount;
+        if (!trackEnds.empty() && trackEnds.top().first < segments[index].top) {
+            track = trackEnds.top().second;
+            trackEnds.pop();
+        } else {
+            trackCount++;
+        }
+        tracks[index] = track;
+        trackEnds.emplace(segments[index].bottom, track);
+    }
+    return trackCount;
+}
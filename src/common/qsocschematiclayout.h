@@ -0,0 +1,270 @@
+#ifndef QSOCSCHEMATICLAYOUT_H
+#define QSOCSCHEMATICLAYOUT_H
+
+#include "common/qsocnetlistgraph.h"
+#include "common/qsocspatialindex.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The QSocSchematicLayout class.
+ * @details This class places the instances of a netlist and routes its nets
+ *          for a schematic view. Coordinates are in grid units, x grows to
+ *          the right and y grows down. Placement is layered in the style of
+ *          Sugiyama:
+ *          - Cycles are broken by reversing the back edges of a depth-first
+ *            search over the driver to sink edges of every net.
+ *          - Instances are assigned to layers by longest path, sources are
+ *            pulled next to their first sink.
+ *          - Instances inside a layer are ordered by barycenter sweeps to
+ *            reduce crossings.
+ *          - Instances are stacked in each layer next to the center of their
+ *            predecessors.
+ *          Input ports are on the left side of an instance, output and inout
+ *          ports on the right side. Nets are routed orthogonally in the
+ *          vertical channels between layers. Every net gets one vertical
+ *          segment in each channel it touches, tracks are assigned per
+ *          channel by the left-edge algorithm, so segments of different nets
+ *          in a channel never overlap. Nets that touch more than one channel
+ *          cross over in a horizontal channel above all instances, with rows
+ *          assigned the same way. Channels are routed on worker threads.
+ *          Wires between the same two instances form a bundle that a view
+ *          can draw as one wire when zoomed out. Instances and wire segments
+ *          are indexed in R-trees for hit-testing.
+ *          The constructor copies what it needs out of the graph, so run()
+ *          may be called on another thread while the graph changes.
+ */
+class QSocSchematicLayout
+{
+public:
+    /**
+     * @brief The Point struct.
+     * @details A point in grid units.
+     */
+    struct Point
+    {
+        int x = 0; /* Column */
+        int y = 0; /* Row */
+    };
+
+    /**
+     * @brief The Port struct.
+     * @details A port of a placed instance.
+     */
+    struct Port
+    {
+        std::string name;           /* Port name */
+        bool        right  = false; /* Port is on the right side */
+        int         offset = 0;     /* Row relative to the top of the instance */
+    };
+
+    /**
+     * @brief The Node struct.
+     * @details A placed instance.
+     */
+    struct Node
+    {
+        std::string       name;       /* Instance name */
+        std::string       module;     /* Module name, empty if not specified */
+        int               layer  = 0; /* Layer index, from left to right */
+        int               x      = 0; /* Left edge */
+        int               y      = 0; /* Top edge */
+        int               width  = 0; /* Width */
+        int               height = 0; /* Height */
+        std::vector<Port> ports;      /* Module ports in library order, then unresolved ports */
+    };
+
+    /**
+     * @brief The Endpoint struct.
+     * @details A port of a node.
+     */
+    struct Endpoint
+    {
+        int node = -1; /* Index into getNodes() */
+        int port = -1; /* Index into Node::ports */
+    };
+
+    /**
+     * @brief The Wire struct.
+     * @details A routed connection from the driver of a net to one sink.
+     */
+    struct Wire
+    {
+        int                net        = -1; /* Net ID of the graph */
+        int                width      = 0;  /* Widest port on the net in bits, 0 if unknown */
+        int                bundle     = -1; /* First wire between the same two nodes */
+        int                bundleSize = 1;  /* Wires in the bundle, counted on its first wire */
+        Endpoint           from;            /* Driver */
+        Endpoint           to;              /* Sink */
+        std::vector<Point> points;          /* Orthogonal polyline from driver to sink */
+    };
+
+    /**
+     * @brief Constructor.
+     * @details Copies instances, module ports and net endpoints out of the
+     *          graph. The graph must be built.
+     * @param graph The connectivity graph.
+     */
+    explicit QSocSchematicLayout(const QSocNetlistGraph &graph);
+
+    /**
+     * @brief Place all nodes and route all nets.
+     * @param threadCount Number of routing threads, 0 for the number of
+     *        hardware threads.
+     */
+    void run(int threadCount = 0);
+
+    /**
+     * @brief Get the placed nodes.
+     * @details Indexed by instance ID of the graph. Valid after run().
+     * @return const std::vector<Node> & The nodes.
+     */
+    const std::vector<Node> &getNodes() const;
+
+    /**
+     * @brief Get the routed wires.
+     * @details Ordered by net, then by sink. Valid after run().
+     * @return const std::vector<Wire> & The wires.
+     */
+    const std::vector<Wire> &getWires() const;
+
+    /**
+     * @brief Get the name of a net.
+     * @param net The net ID of the graph.
+     * @return const std::string & The net name.
+     */
+    const std::string &getNetName(int net) const;
+
+    /**
+     * @brief Get the spatial index of the nodes.
+     * @details Entry IDs are node indexes. Valid after run().
+     * @return const QSocSpatialIndex & The node index.
+     */
+    const QSocSpatialIndex &getNodeIndex() const;
+
+    /**
+     * @brief Get the spatial index of the wires.
+     * @details Every segment is an entry with the wire index as ID, so a
+     *          query can return a wire more than once. Valid after run().
+     * @return const QSocSpatialIndex & The wire index.
+     */
+    const QSocSpatialIndex &getWireIndex() const;
+
+    /**
+     * @brief Get the number of layers.
+     * @return int The number of layers, valid after run().
+     */
+    int getLayerCount() const;
+
+private:
+    /**
+     * @brief The Net struct.
+     * @details The endpoints of a net, the driver comes first.
+     */
+    struct Net
+    {
+        int                              id    = -1; /* Net ID of the graph */
+        int                              width = 0;  /* Widest port in bits, 0 if unknown */
+        std::vector<Endpoint>            endpoints;  /* Driver, then sinks */
+        int                              row = -1;   /* Crossover row, -1 if in one channel */
+        std::vector<std::pair<int, int>> tracks;     /* Channel and track of each segment */
+    };
+
+    /**
+     * @brief The Segment struct.
+     * @details The vertical extent of a net in a channel.
+     */
+    struct Segment
+    {
+        int net    = 0; /* Index into nets */
+        int top    = 0; /* Top row, or first channel of a crossover */
+        int bottom = 0; /* Bottom row, or last channel of a crossover */
+    };
+
+    /** Nodes, indexed by instance ID. */
+    std::vector<Node> nodes;
+    /** Nets with at least two endpoints. */
+    std::vector<Net> nets;
+    /** Routed wires. */
+    std::vector<Wire> wires;
+    /** Net names, indexed by net ID. */
+    std::vector<std::string> netNames;
+    /** Spatial index of the nodes. */
+    QSocSpatialIndex nodeIndex;
+    /** Spatial index of the wire segments. */
+    QSocSpatialIndex wireIndex;
+    /** Node indexes per layer, in placement order. */
+    std::vector<std::vector<int>> layers;
+    /** Predecessors of each node after cycle breaking. */
+    std::vector<std::vector<int>> predecessors;
+    /** Successors of each node after cycle breaking. */
+    std::vector<std::vector<int>> successors;
+
+    /**
+     * @brief Build the acyclic driver to sink edges between nodes.
+     */
+    void buildEdges();
+
+    /**
+     * @brief Assign every node to a layer.
+     */
+    void assignLayers();
+
+    /**
+     * @brief Order the nodes inside each layer.
+     */
+    void orderLayers();
+
+    /**
+     * @brief Assign the rows of all nodes.
+     */
+    void placeRows();
+
+    /**
+     * @brief Assign crossover rows and channel tracks, then the columns.
+     * @param threadCount Number of routing threads.
+     * @return std::vector<int> Left column of every channel.
+     */
+    std::vector<int> routeChannels(int threadCount);
+
+    /**
+     * @brief Emit the wire polylines of all nets.
+     * @param channelX Left column of every channel.
+     * @param threadCount Number of routing threads.
+     */
+    void emitWires(const std::vector<int> &channelX, int threadCount);
+
+    /**
+     * @brief Group the wires into bundles and build the spatial indexes.
+     */
+    void indexWires();
+
+    /**
+     * @brief Get the channel a port is reached from.
+     * @param endpoint The port.
+     * @return int The channel index, channel i is left of layer i.
+     */
+    int channelOf(const Endpoint &endpoint) const;
+
+    /**
+     * @brief Get the position of a port.
+     * @param endpoint The port.
+     * @return Point The port position.
+     */
+    Point pointOf(const Endpoint &endpoint) const;
+
+    /**
+     * @brief Assign tracks to segments by the left-edge algorithm.
+     * @details Segments are sorted by top row, each takes the first track
+     *          that is free above it.
+     * @param segments The segments of one channel, sorted in place.
+     * @param tracks Receives the track of every segment, by position in the
+     *        sorted segments.
+     * @return int Number of tracks used.
+     */
+    static int assignTracks(std::vector<Segment> &segments, std::vector<int> &tracks);
+};
+
+#endif // QSOCSCHEMATICLAYOUT_H
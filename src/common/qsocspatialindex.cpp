@@ -0,0 +1,127 @@
+#include "common/qsocspatialindex.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+/* Children per node */
+constexpr int kNodeCapacity = 16;
+
+bool intersects(const QSocSpatialIndex::Box &left, const QSocSpatialIndex::Box &right)
+{
+    return left.left <= right.right && right.left <= left.right && left.top <= right.bottom
+           && right.top <= left.bottom;
+}
+
+void extend(QSocSpatialIndex::Box &box, const QSocSpatialIndex::Box &other)
+{
+    box.left   = std::min(box.left, other.left);
+    box.top    = std::min(box.top, other.top);
+    box.right  = std::max(box.right, other.right);
+    box.bottom = std::max(box.bottom, other.bottom);
+}
+
+/* Sort-Tile-Recursive order of items that have a box, centers doubled */
+template<typename Item>
+void sortTiles(std::vector<Item> &items)
+{
+    const auto centerX = [](const Item &item) { return item.box.left + item.box.right; };
+    const auto centerY = [](const Item &item) { return item.box.top + item.box.bottom; };
+
+    const size_t count      = items.size();
+    const double pages      = std::ceil(static_cast<double>(count) / kNodeCapacity);
+    const size_t slices     = static_cast<size_t>(std::ceil(std::sqrt(pages)));
+    const size_t sliceItems = std::max<size_t>(1, slices) * kNodeCapacity;
+
+    std::sort(items.begin(), items.end(), [&centerX](const Item &left, const Item &right) {
+        return centerX(left) < centerX(right);
+    });
+    for (size_t first = 0; first < count; first += sliceItems) {
+        const size_t last = std::min(first + sliceItems, count);
+        std::sort(
+            items.begin() + first,
+            items.begin() + last,
+            [&centerY](const Item &left, const Item &right) {
+                return centerY(left) < centerY(right);
+            });
+    }
+}
+} // namespace
+
+void QSocSpatialIndex::build(std::vector<Entry> entries)
+{
+    this->entries = std::move(entries);
+    nodes.clear();
+    leafCount = 0;
+    if (this->entries.empty()) {
+        return;
+    }
+
+    /* Pack entries into leaves */
+    sortTiles(this->entries);
+    const int entryCount = static_cast<int>(this->entries.size());
+    for (int first = 0; first < entryCount; first += kNodeCapacity) {
+        Node node;
+        node.first = first;
+        node.count = std::min(kNodeCapacity, entryCount - first);
+        node.box   = this->entries[first].box;
+        for (int index = first + 1; index < first + node.count; index++) {
+            extend(node.box, this->entries[index].box);
+        }
+        nodes.push_back(node);
+    }
+    leafCount = static_cast<int>(nodes.size());
+
+    /* Pack each level into the next one until a single root is left */
+    int levelFirst = 0;
+    int levelCount = leafCount;
+    while (levelCount > 1) {
+        /* Nothing points into a level before its parents exist, it can be sorted */
+        std::vector<Node> level(nodes.begin() + levelFirst, nodes.end());
+        sortTiles(level);
+        std::copy(level.begin(), level.end(), nodes.begin() + levelFirst);
+        const int nextFirst = static_cast<int>(nodes.size());
+        for (int first = 0; first < levelCount; first += kNodeCapacity) {
+            Node node;
+            node.first = levelFirst + first;
+            node.count = std::min(kNodeCapacity, levelCount - first);
+            node.box   = level[first].box;
+            for (int index = first + 1; index < first + node.count; index++) {
+                extend(node.box, level[index].box);
+            }
+            nodes.push_back(node);
+        }
+        levelFirst = nextFirst;
+        levelCount = static_cast<int>(nodes.size()) - nextFirst;
+    }
+}
+
+void QSocSpatialIndex::query(const Box &box, std::vector<int> &ids) const
+{
+    if (nodes.empty()) {
+        return;
+    }
+
+    std::vector<int> stack;
+    stack.push_back(static_cast<int>(nodes.size()) - 1);
+    while (!stack.empty()) {
+        const Node &node = nodes[stack.back()];
+        const bool  leaf = stack.back() < leafCount;
+        stack.pop_back();
+        if (!intersects(node.box, box)) {
+            continue;
+        }
+        for (int child = node.first; child < node.first + node.count; child++) {
+            if (!leaf) {
+                stack.push_back(child);
+            } else if (intersects(entries[child].box, box)) {
+                ids.push_back(entries[child].id);
+            }
+        }
+    }
+}
+
+int QSocSpatialIndex::size() const
+{
+    return static_cast<int>(entries.size());
+}
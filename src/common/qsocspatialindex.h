@@ -0,0 +1,83 @@
+#ifndef QSOCSPATIALINDEX_H
+#define QSOCSPATIALINDEX_H
+
+#include <vector>
+
+/**
+ * @brief The QSocSpatialIndex class.
+ * @details This class is a static R-tree over integer boxes. The tree is
+ *          bulk loaded once with Sort-Tile-Recursive packing: entries are
+ *          sorted into vertical slices by center x, each slice is sorted by
+ *          center y and cut into full leaves, and the same packing is
+ *          repeated on the leaves until one root is left. Packed nodes are
+ *          full and overlap little, so a query visits few nodes, and the
+ *          tree is stored in flat arrays without per-node allocations.
+ */
+class QSocSpatialIndex
+{
+public:
+    /**
+     * @brief The Box struct.
+     * @details An axis-aligned box, both corners are inside.
+     */
+    struct Box
+    {
+        int left   = 0; /* Smallest x */
+        int top    = 0; /* Smallest y */
+        int right  = 0; /* Largest x */
+        int bottom = 0; /* Largest y */
+    };
+
+    /**
+     * @brief The Entry struct.
+     * @details An indexed box and the ID of what it bounds.
+     */
+    struct Entry
+    {
+        Box box;     /* Bounding box */
+        int id = -1; /* Caller-defined ID */
+    };
+
+    /**
+     * @brief Build the tree.
+     * @details Replaces the previous content.
+     * @param entries The entries to index.
+     */
+    void build(std::vector<Entry> entries);
+
+    /**
+     * @brief Find the entries that intersect a box.
+     * @param box The box to search.
+     * @param ids Receives the IDs of the intersecting entries, appended in
+     *        no particular order. An ID indexed more than once can be
+     *        appended more than once.
+     */
+    void query(const Box &box, std::vector<int> &ids) const;
+
+    /**
+     * @brief Get the number of entries.
+     * @return int The number of entries.
+     */
+    int size() const;
+
+private:
+    /**
+     * @brief The Node struct.
+     * @details A tree node, its children are a range of nodes or entries.
+     */
+    struct Node
+    {
+        Box box;       /* Bounding box of the children */
+        int first = 0; /* First child */
+        int count = 0; /* Number of children */
+    };
+
+    /** Entries in leaf order. */
+    std::vector<Entry> entries;
+    /** Nodes, leaves first and the root last. */
+    std::vector<Node> nodes;
+    /** Number of leaves, the nodes before it have entries as children. */
+    int leafCount = 0;
+};
+
+#endif // QSOCSPATIALINDEX_H
@@ -1,6 +1,8 @@
 #include "qstaticdatasedes.h"
 
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 
 QString QStaticDataSedes::serializeYaml(const YAML::Node &node)
 {
@@ -27,3 +29,64 @@ json QStaticDataSedes::deserializeJson(const QString &str)
     const std::string stdString = str.toStdString();
     return json::parse(stdString);
 }
+
+YAML::Node QStaticDataSedes::mergeYaml(const YAML::Node &toYaml, const YAML::Node &fromYaml)
+{
+    /* Nodes of different documents are merged by yaml-cpp on every insertion
+       of a shared subtree, which is quadratic, a single clone is not */
+    YAML::Node resultYaml = YAML::Clone(toYaml);
+    mergeYamlInto(resultYaml, fromYaml);
+    return resultYaml;
+}
+
+void QStaticDataSedes::mergeYamlInto(YAML::Node &toYaml, const YAML::Node &fromYaml)
+{
+    if (!fromYaml.IsMap()) {
+        /* A null fromYaml keeps toYaml, any other value replaces it */
+        if (!fromYaml.IsNull()) {
+            toYaml = fromYaml;
+        }
+        return;
+    }
+    if (!toYaml.IsMap()) {
+        toYaml = fromYaml;
+        return;
+    }
+    if (fromYaml.size() == 0) {
+        return;
+    }
+    /* A merged map is emitted as a new map would be */
+    toYaml.SetStyle(YAML::EmitterStyle::Block);
+
+    /* Index toYaml once, assigning to an indexed value updates the map,
+       every value of a duplicate key is merged */
+    std::unordered_multimap<std::string, YAML::Node> toIndex;
+    toIndex.reserve(toYaml.size());
+    for (const auto &iter : toYaml) {
+        if (iter.first.IsScalar()) {
+            toIndex.emplace(iter.first.Scalar(), iter.second);
+        }
+    }
+
+    std::unordered_set<std::string> fromKeys;
+    fromKeys.reserve(fromYaml.size());
+    for (const auto &iter : fromYaml) {
+        if (!iter.first.IsScalar()) {
+            toYaml.force_insert(iter.first, iter.second);
+            continue;
+        }
+        /* A new key is appended every time it repeats */
+        const auto [first, last] = toIndex.equal_range(iter.first.Scalar());
+        if (first == last) {
+            toYaml.force_insert(iter.first, iter.second);
+            continue;
+        }
+        /* An existing key is merged with its first value only, as in a lookup */
+        if (!fromKeys.insert(iter.first.Scalar()).second) {
+            continue;
+        }
+        for (auto found = first; found != last; ++found) {
+            mergeYamlInto(found->second, iter.second);
+        }
+    }
+}
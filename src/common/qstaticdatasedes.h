@@ -70,6 +70,33 @@ public slots:
      */
     static json deserializeJson(const QString &str);
 
+    /**
+     * @brief Merge two YAML nodes into a new node.
+     * @details Values from fromYaml replace identically keyed non-map values
+     *          of toYaml, maps are merged recursively and a null value in
+     *          fromYaml keeps the value of toYaml. Keys keep the order of
+     *          toYaml, followed by the new keys of fromYaml, and merged maps
+     *          are emitted in block style. toYaml is cloned once and merged
+     *          with mergeYamlInto(), the inputs are not modified.
+     * @param toYaml The destination YAML node.
+     * @param fromYaml The source YAML node.
+     * @return YAML::Node The merged YAML node.
+     */
+    static YAML::Node mergeYaml(const YAML::Node &toYaml, const YAML::Node &fromYaml);
+
+    /**
+     * @brief Merge a YAML node into another in place.
+     * @details Same rules as mergeYaml(), but toYaml is modified instead of
+     *          copied. The keys of each level of toYaml are indexed once, so
+     *          merging is linear in the size of the nodes, and subtrees of
+     *          fromYaml that are added are shared rather than copied. Use it
+     *          when toYaml is owned by the caller, such as a document just
+     *          loaded from a file.
+     * @param toYaml The destination YAML node, modified.
+     * @param fromYaml The source YAML node.
+     */
+    static void mergeYamlInto(YAML::Node &toYaml, const YAML::Node &fromYaml);
+
 private:
     /**
      * @brief Constructor.
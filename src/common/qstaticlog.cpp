@@ -1,4 +1,6 @@
 #include "common/qstaticlog.h"
+#include "common/qsoclogsink.h"
+#include "common/qsoclogwriter.h"
 
 #include <QDebug>
 
@@ -29,44 +31,134 @@ QStaticLog::Level QStaticLog::level         = QStaticLog::Level::Error;
 bool              QStaticLog::colorConsole  = true;
 bool              QStaticLog::colorRichtext = true;
 
-void QStaticLog::logE(const QString &func, const QString &message)
+std::atomic<QSocLogSink *>   QStaticLog::sink   = nullptr;
+std::atomic<QSocLogWriter *> QStaticLog::writer = nullptr;
+
+void QStaticLog::write(
+    QStaticLog::Level         level,
+    const QString            &func,
+    const QString            &message,
+    const QStaticLog::Fields &fields)
 {
-    if (QStaticLog::level >= QStaticLog::Level::Error) {
-        qCritical() << QString(strEConsole + func + ":" + message).toStdString().c_str();
-        emit instance().log(strERichtext + func + ":" + message);
+    if (!isEnabled(level) || level == QStaticLog::Level::Silent) {
+        return;
     }
+
+    /* Fields are formatted once for the console and the sink, the file formats its own */
+    const QString text = fields.isEmpty() ? message : message + formatFields(fields);
+    switch (level) {
+    case QStaticLog::Level::Error:
+        qCritical().noquote() << strEConsole + func + ":" + text;
+        break;
+    case QStaticLog::Level::Warning:
+        qWarning().noquote() << strWConsole + func + ":" + text;
+        break;
+    case QStaticLog::Level::Info:
+        qInfo().noquote() << strIConsole + func + ":" + text;
+        break;
+    case QStaticLog::Level::Debug:
+        qDebug().noquote() << strDConsole + func + ":" + text;
+        break;
+    default:
+        qDebug().noquote() << strVConsole + func + ":" + text;
+        break;
+    }
+    logSink(level, func, text);
+
+    QSocLogWriter *current = writer.load(std::memory_order_acquire);
+    if (current) {
+        current->push(level, func, message, fields);
+    }
+}
+
+void QStaticLog::logE(const QString &func, const QString &message)
+{
+    write(QStaticLog::Level::Error, func, message);
 }
 
 void QStaticLog::logW(const QString &func, const QString &message)
 {
-    if (QStaticLog::level >= QStaticLog::Level::Warning) {
-        qWarning() << QString(strWConsole + func + ":" + message).toStdString().c_str();
-        emit instance().log(strWRichtext + func + ":" + message);
-    }
+    write(QStaticLog::Level::Warning, func, message);
 }
 
 void QStaticLog::logI(const QString &func, const QString &message)
 {
-    if (QStaticLog::level >= QStaticLog::Level::Info) {
-        qInfo() << QString(strIConsole + func + ":" + message).toStdString().c_str();
-        emit instance().log(strIRichtext + func + ":" + message);
-    }
+    write(QStaticLog::Level::Info, func, message);
 }
 
 void QStaticLog::logD(const QString &func, const QString &message)
 {
-    if (QStaticLog::level >= QStaticLog::Level::Debug) {
-        qDebug() << QString(strDConsole + func + ":" + message).toStdString().c_str();
-        emit instance().log(strDRichtext + func + ":" + message);
-    }
+    write(QStaticLog::Level::Debug, func, message);
 }
 
 void QStaticLog::logV(const QString &func, const QString &message)
 {
-    if (QStaticLog::level >= QStaticLog::Level::Verbose) {
-        qDebug() << QString(strVConsole + func + ":" + message).toStdString().c_str();
-        emit instance().log(strVRichtext + func + ":" + message);
+    write(QStaticLog::Level::Verbose, func, message);
+}
+
+QString QStaticLog::formatFields(const QStaticLog::Fields &fields)
+{
+    QString result;
+    for (const QPair<QString, QVariant> &field : fields) {
+        QString value = field.second.toString();
+        if (value.isEmpty() || value.contains(' ') || value.contains('"')) {
+            value = '"' + value.replace("\"", "\\\"") + '"';
+        }
+        result += ' ' + field.first + '=' + value;
+    }
+    return result;
+}
+
+void QStaticLog::logSink(QStaticLog::Level level, const QString &func, const QString &message)
+{
+    QSocLogSink *current = sink.load(std::memory_order_acquire);
+    if (current && current->accepts(level)) {
+        current->push(level, func, message);
+    }
+}
+
+QString QStaticLog::formatRichtext(
+    QStaticLog::Level level, const QString &func, const QString &message)
+{
+    switch (level) {
+    case QStaticLog::Level::Error:
+        return strERichtext + func + ":" + message;
+    case QStaticLog::Level::Warning:
+        return strWRichtext + func + ":" + message;
+    case QStaticLog::Level::Info:
+        return strIRichtext + func + ":" + message;
+    case QStaticLog::Level::Debug:
+        return strDRichtext + func + ":" + message;
+    default:
+        return strVRichtext + func + ":" + message;
+    }
+}
+
+void QStaticLog::setSink(QSocLogSink *sink)
+{
+    QStaticLog::sink.store(sink, std::memory_order_release);
+}
+
+bool QStaticLog::setFile(const QString &path)
+{
+    /* The old writer drains its queue before the new one takes over */
+    delete writer.exchange(nullptr, std::memory_order_acq_rel);
+    if (path.isEmpty()) {
+        return true;
     }
+
+    auto *current = new QSocLogWriter(path);
+    if (!current->open()) {
+        delete current;
+        return false;
+    }
+    writer.store(current, std::memory_order_release);
+    return true;
+}
+
+QSocLogSink *QStaticLog::getSink()
+{
+    return QStaticLog::sink.load(std::memory_order_acquire);
 }
 
 void QStaticLog::setLevel(QStaticLog::Level level)
@@ -1,15 +1,25 @@
 #ifndef QSTATICLOG_H
 #define QSTATICLOG_H
 
+#include <QList>
 #include <QObject>
+#include <QPair>
 #include <QString>
 #include <QTextBrowser>
+#include <QVariant>
 #include <QtCore>
 
+#include <atomic>
+
+class QSocLogSink;
+class QSocLogWriter;
+
 /**
  * @brief The QStaticLog class.
  * @details This class is a static logging class that can be used to log
- *          messages to the console or a text browser.
+ *          messages to the console, a text browser or a file. Use the
+ *          QSOC_LOG macros in new code, they check the level before the
+ *          message and its fields are evaluated.
  */
 class QStaticLog : public QObject
 {
@@ -30,6 +40,13 @@ public:
 
     Q_DECLARE_FLAGS(Levels, Level)
 
+    /**
+     * @brief Structured key/value fields of a message.
+     * @details Fields are formatted as key=value after the message, only
+     *          when the message is written.
+     */
+    using Fields = QList<QPair<QString, QVariant>>;
+
     /**
      * @brief Get the static instance of this object.
      * @details This function will return the static instance of this object.
@@ -53,6 +70,16 @@ public:
      */
     static QStaticLog::Level getLevel();
 
+    /**
+     * @brief Check if a level is logged.
+     * @details This function is inlined into the QSOC_LOG macros, so a
+     *          filtered message costs one comparison.
+     * @param level The message level.
+     * @retval true Messages of this level are written.
+     * @retval false Messages of this level are dropped.
+     */
+    static bool isEnabled(QStaticLog::Level level) { return QStaticLog::level >= level; }
+
     /**
      * @brief Get the color mode for console.
      * @details This function will return the color mode for console.
@@ -69,7 +96,49 @@ public:
      */
     static bool isColorRichtext();
 
+    /**
+     * @brief Format a message as richtext.
+     * @details This function prefixes the message with the richtext level
+     *          tag, it is called by the sink only for lines it shows.
+     * @param level The message level.
+     * @param func The function name.
+     * @param message The log message.
+     * @return QString The formatted message.
+     */
+    static QString formatRichtext(
+        QStaticLog::Level level, const QString &func, const QString &message);
+
+    /**
+     * @brief Format structured fields.
+     * @details Values with spaces or quotes are quoted.
+     * @param fields The fields to format.
+     * @return QString The fields as " key=value" pairs, empty for no fields.
+     */
+    static QString formatFields(const QStaticLog::Fields &fields);
+
+    /**
+     * @brief Get the richtext sink.
+     * @return QSocLogSink* The installed sink, nullptr when there is none.
+     */
+    static QSocLogSink *getSink();
+
 public slots:
+    /**
+     * @brief Log a message with fields.
+     * @details Writes the message to the console, the richtext sink and the
+     *          log file if the level is enabled. Prefer the QSOC_LOG macros,
+     *          they skip building the arguments of filtered messages.
+     * @param level The message level.
+     * @param func The function name.
+     * @param message The log message.
+     * @param fields The structured fields.
+     */
+    static void write(
+        QStaticLog::Level         level,
+        const QString            &func,
+        const QString            &message,
+        const QStaticLog::Fields &fields = {});
+
     /**
      * @brief Log error message to console.
      * @details Log the message to the console.
@@ -151,11 +220,34 @@ public slots:
      */
     static void setColor(bool color);
 
+    /**
+     * @brief Set the richtext sink.
+     * @details Messages that pass the log level are stored unformatted in the
+     *          sink, which formats and emits them in batches. Without a sink
+     *          only the console is written. The sink must outlive logging
+     *          from other threads.
+     * @param sink The sink to install, nullptr to uninstall.
+     */
+    static void setSink(QSocLogSink *sink);
+
+    /**
+     * @brief Set the log file.
+     * @details Messages that pass the log level are also appended to this
+     *          file with a timestamp and without color. Formatting and
+     *          writing happen on a background thread. Setting another file
+     *          or an empty path flushes and closes the current one, do so
+     *          before exit.
+     * @param path The file path, empty to close the log file.
+     * @retval true The file is open, or was closed for an empty path.
+     * @retval false The file could not be opened.
+     */
+    static bool setFile(const QString &path);
+
 signals:
     /**
-     * @brief Log error message to richtext.
-     * @details Log the message to the richtext.
-     * @param message The log message.
+     * @brief Log messages to richtext.
+     * @details Emitted by the installed sink once per flush.
+     * @param message The formatted messages, separated by line breaks.
      */
     void log(const QString &message);
 
@@ -229,6 +321,21 @@ private:
     /* Color mode for richtext. */
     static bool colorRichtext;
 
+    /* Richtext sink. */
+    static std::atomic<QSocLogSink *> sink;
+
+    /* Log file writer. */
+    static std::atomic<QSocLogWriter *> writer;
+
+    /**
+     * @brief Store a message in the richtext sink.
+     * @details The sink level is checked before the message is stored.
+     * @param level The message level.
+     * @param func The function name.
+     * @param message The log message.
+     */
+    static void logSink(QStaticLog::Level level, const QString &func, const QString &message);
+
     /**
      * @brief Constructor.
      * @details This is a private constructor for this class to prevent
@@ -239,4 +346,25 @@ private:
     QStaticLog() {}
 };
 
+/**
+ * @brief Log a message if its level is enabled.
+ * @details The message and fields are evaluated only when the level is
+ *          enabled, for example
+ *          QSOC_LOG_D("Parsed file", {{"path", path}, {"ms", elapsed}}).
+ * @param level The message level.
+ * @param ... The message, optionally followed by QStaticLog::Fields.
+ */
+#define QSOC_LOG(level, ...) \
+    do { \
+        if (QStaticLog::isEnabled(level)) { \
+            QStaticLog::write(level, Q_FUNC_INFO, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define QSOC_LOG_E(...) QSOC_LOG(QStaticLog::Level::Error, __VA_ARGS__)
+#define QSOC_LOG_W(...) QSOC_LOG(QStaticLog::Level::Warning, __VA_ARGS__)
+#define QSOC_LOG_I(...) QSOC_LOG(QStaticLog::Level::Info, __VA_ARGS__)
+#define QSOC_LOG_D(...) QSOC_LOG(QStaticLog::Level::Debug, __VA_ARGS__)
+#define QSOC_LOG_V(...) QSOC_LOG(QStaticLog::Level::Verbose, __VA_ARGS__)
+
 #endif // QSTATICLOG_H
@@ -0,0 +1,226 @@
+#include "common/qstaticmetrics.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStringList>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <vector>
+
+namespace {
+/* Width of the name column in the summary */
+constexpr int kNameWidth = 32;
+
+/* Every metric registered so far, metrics live until the process exits */
+struct Registry
+{
+    QMutex                                   mutex;
+    std::vector<QStaticMetrics::Counter *>   counters;
+    std::vector<QStaticMetrics::Gauge *>     gauges;
+    std::vector<QStaticMetrics::Histogram *> histograms;
+};
+
+Registry &registry()
+{
+    static Registry instance;
+    return instance;
+}
+} // namespace
+
+std::atomic<bool> QStaticMetrics::enabled = false;
+bool              QStaticMetrics::print   = false;
+QString           QStaticMetrics::path;
+
+QStaticMetrics::Counter::Counter(const char *name)
+    : name(name)
+{
+    Registry          &shared = registry();
+    const QMutexLocker locker(&shared.mutex);
+    shared.counters.push_back(this);
+}
+
+QStaticMetrics::Gauge::Gauge(const char *name)
+    : name(name)
+{
+    Registry          &shared = registry();
+    const QMutexLocker locker(&shared.mutex);
+    shared.gauges.push_back(this);
+}
+
+void QStaticMetrics::Gauge::raise(qint64 level)
+{
+    qint64 current = peak.load(std::memory_order_relaxed);
+    while (level > current
+           && !peak.compare_exchange_weak(current, level, std::memory_order_relaxed)) {
+    }
+}
+
+QStaticMetrics::Histogram::Histogram(const char *name)
+    : name(name)
+{
+    Registry          &shared = registry();
+    const QMutexLocker locker(&shared.mutex);
+    shared.histograms.push_back(this);
+}
+
+void QStaticMetrics::Histogram::add(qint64 sample)
+{
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(sample, std::memory_order_relaxed);
+    buckets[std::bit_width(static_cast<quint64>(sample))].fetch_add(1, std::memory_order_relaxed);
+
+    qint64 current = minimum.load(std::memory_order_relaxed);
+    while (sample < current
+           && !minimum.compare_exchange_weak(current, sample, std::memory_order_relaxed)) {
+    }
+    current = maximum.load(std::memory_order_relaxed);
+    while (sample > current
+           && !maximum.compare_exchange_weak(current, sample, std::memory_order_relaxed)) {
+    }
+}
+
+qint64 QStaticMetrics::Histogram::percentile(double fraction) const
+{
+    const qint64 total = count.load(std::memory_order_relaxed);
+    if (total == 0) {
+        return 0;
+    }
+    /* Rank of the value, then the bucket that holds it */
+    const auto rank = qMax<qint64>(1, static_cast<qint64>(fraction * static_cast<double>(total)));
+    qint64     seen = 0;
+    for (size_t index = 0; index < buckets.size(); index++) {
+        seen += buckets[index].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            const qint64 largest = maximum.load(std::memory_order_relaxed);
+            return index < 63 ? qMin((qint64(1) << index) - 1, largest) : largest;
+        }
+    }
+    return maximum.load(std::memory_order_relaxed);
+}
+
+void QStaticMetrics::start(bool print, const QString &path)
+{
+    Registry          &shared = registry();
+    const QMutexLocker locker(&shared.mutex);
+    for (Counter *counter : shared.counters) {
+        counter->value.store(0, std::memory_order_relaxed);
+    }
+    for (Gauge *gauge : shared.gauges) {
+        gauge->value.store(0, std::memory_order_relaxed);
+        gauge->peak.store(0, std::memory_order_relaxed);
+    }
+    for (Histogram *histogram : shared.histograms) {
+        histogram->count.store(0, std::memory_order_relaxed);
+        histogram->sum.store(0, std::memory_order_relaxed);
+        histogram->minimum.store(std::numeric_limits<qint64>::max(), std::memory_order_relaxed);
+        histogram->maximum.store(0, std::memory_order_relaxed);
+        for (std::atomic<qint64> &bucket : histogram->buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+    QStaticMetrics::print = print;
+    QStaticMetrics::path  = path;
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+bool QStaticMetrics::stop()
+{
+    if (!enabled.exchange(false, std::memory_order_relaxed)) {
+        return true;
+    }
+
+    /* The JSON keeps every metric so runs compare key by key, the summary
+       skips the ones this run never touched */
+    QJsonObject countersJson;
+    QJsonObject gaugesJson;
+    QJsonObject histogramsJson;
+    QStringList lines;
+
+    /* Report metrics in name order, whatever order they registered in */
+    const auto sortedByName = [](auto metrics) {
+        std::sort(metrics.begin(), metrics.end(), [](const auto *left, const auto *right) {
+            return std::strcmp(left->name, right->name) < 0;
+        });
+        return metrics;
+    };
+
+    Registry          &shared = registry();
+    const QMutexLocker locker(&shared.mutex);
+    for (const Counter *counter : sortedByName(shared.counters)) {
+        const qint64 value = counter->value.load(std::memory_order_relaxed);
+        countersJson.insert(counter->name, value);
+        if (value != 0) {
+            lines.append(QString("  %1 %2").arg(counter->name, -kNameWidth).arg(value));
+        }
+    }
+    for (const Gauge *gauge : sortedByName(shared.gauges)) {
+        const qint64 value = gauge->value.load(std::memory_order_relaxed);
+        const qint64 peak  = gauge->peak.load(std::memory_order_relaxed);
+        gaugesJson.insert(gauge->name, QJsonObject{{"value", value}, {"peak", peak}});
+        if (value != 0 || peak != 0) {
+            lines.append(QString("  %1 %2 (peak %3)")
+                             .arg(gauge->name, -kNameWidth)
+                             .arg(value)
+                             .arg(peak));
+        }
+    }
+    for (const Histogram *histogram : sortedByName(shared.histograms)) {
+        const qint64 count   = histogram->count.load(std::memory_order_relaxed);
+        const qint64 sum     = histogram->sum.load(std::memory_order_relaxed);
+        const qint64 minimum = count == 0 ? 0 : histogram->minimum.load(std::memory_order_relaxed);
+        const qint64 maximum = histogram->maximum.load(std::memory_order_relaxed);
+        const double mean    = count == 0 ? 0.0 : static_cast<double>(sum) / count;
+        const qint64 p50     = histogram->percentile(0.50);
+        const qint64 p90     = histogram->percentile(0.90);
+        const qint64 p99     = histogram->percentile(0.99);
+        histogramsJson.insert(
+            histogram->name,
+            QJsonObject{
+                {"count", count},
+                {"sum", sum},
+                {"min", minimum},
+                {"max", maximum},
+                {"mean", mean},
+                {"p50", p50},
+                {"p90", p90},
+                {"p99", p99}});
+        if (count != 0) {
+            lines.append(QString("  %1 count=%2 min=%3 mean=%4 p50<=%5 p90<=%6 p99<=%7 max=%8")
+                             .arg(histogram->name, -kNameWidth)
+                             .arg(count)
+                             .arg(minimum)
+                             .arg(mean, 0, 'f', 1)
+                             .arg(p50)
+                             .arg(p90)
+                             .arg(p99)
+                             .arg(maximum));
+        }
+    }
+
+    if (print) {
+        qInfo().noquote() << "Metrics:";
+        for (const QString &line : lines) {
+            qInfo().noquote() << line;
+        }
+    }
+    if (path.isEmpty()) {
+        return true;
+    }
+
+    const QByteArray json = QJsonDocument(QJsonObject{
+                                              {"counters", countersJson},
+                                              {"gauges", gaugesJson},
+                                              {"histograms", histogramsJson}})
+                                .toJson();
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(json) == json.size();
+}
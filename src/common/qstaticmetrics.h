@@ -0,0 +1,226 @@
+#ifndef QSTATICMETRICS_H
+#define QSTATICMETRICS_H
+
+#include <QString>
+#include <QtGlobal>
+
+#include <array>
+#include <atomic>
+#include <limits>
+
+/**
+ * @brief The QStaticMetrics class.
+ * @details This class keeps process wide counters, gauges and histograms that
+ *          hot paths update, and reports them once the run is over as a text
+ *          summary, a JSON file or both. Metrics are declared as objects with
+ *          static storage duration next to the code that updates them, and
+ *          register themselves by name. Updates are relaxed atomics, and
+ *          while metrics are off an update costs one relaxed atomic load.
+ */
+class QStaticMetrics
+{
+public:
+    /**
+     * @brief The Counter class.
+     * @details A counter only grows, such as calls made or bytes read.
+     */
+    class Counter
+    {
+    public:
+        /**
+         * @brief Register a counter.
+         * @param name Counter name, a string literal such as "yaml.bytes.read".
+         */
+        explicit Counter(const char *name);
+
+        /**
+         * @brief Add to the counter.
+         * @param amount Amount to add.
+         */
+        void add(qint64 amount = 1)
+        {
+            if (QStaticMetrics::isEnabled()) {
+                value.fetch_add(amount, std::memory_order_relaxed);
+            }
+        }
+
+        Counter(const Counter &)            = delete;
+        Counter &operator=(const Counter &) = delete;
+
+    private:
+        friend class QStaticMetrics;
+
+        /* Counter name. */
+        const char *name;
+
+        /* Current value. */
+        std::atomic<qint64> value{0};
+    };
+
+    /**
+     * @brief The Gauge class.
+     * @details A gauge holds a level that goes up and down, such as entries
+     *          in a cache. Its peak is reported with the last value.
+     */
+    class Gauge
+    {
+    public:
+        /**
+         * @brief Register a gauge.
+         * @param name Gauge name, a string literal such as "yaml.cache.entries".
+         */
+        explicit Gauge(const char *name);
+
+        /**
+         * @brief Set the gauge.
+         * @param level New level.
+         */
+        void set(qint64 level)
+        {
+            if (QStaticMetrics::isEnabled()) {
+                value.store(level, std::memory_order_relaxed);
+                raise(level);
+            }
+        }
+
+        /**
+         * @brief Move the gauge.
+         * @param amount Amount to add, negative to lower the gauge.
+         */
+        void add(qint64 amount)
+        {
+            if (QStaticMetrics::isEnabled()) {
+                raise(value.fetch_add(amount, std::memory_order_relaxed) + amount);
+            }
+        }
+
+        Gauge(const Gauge &)            = delete;
+        Gauge &operator=(const Gauge &) = delete;
+
+    private:
+        friend class QStaticMetrics;
+
+        /* Gauge name. */
+        const char *name;
+
+        /* Current level. */
+        std::atomic<qint64> value{0};
+
+        /* Highest level seen. */
+        std::atomic<qint64> peak{0};
+
+        /**
+         * @brief Raise the peak.
+         * @param level Level just reached.
+         */
+        void raise(qint64 level);
+    };
+
+    /**
+     * @brief The Histogram class.
+     * @details A histogram records a distribution, such as request latency.
+     *          Values fall into power of two buckets, so reported percentiles
+     *          are upper bounds within a factor of two, while count, sum,
+     *          minimum and maximum are exact.
+     */
+    class Histogram
+    {
+    public:
+        /**
+         * @brief Register a histogram.
+         * @param name Histogram name, a string literal that ends with the
+         *        unit, such as "llm.request.ms".
+         */
+        explicit Histogram(const char *name);
+
+        /**
+         * @brief Record a value.
+         * @param sample Value to record, negative values count as zero.
+         */
+        void record(qint64 sample)
+        {
+            if (QStaticMetrics::isEnabled()) {
+                add(qMax<qint64>(sample, 0));
+            }
+        }
+
+        Histogram(const Histogram &)            = delete;
+        Histogram &operator=(const Histogram &) = delete;
+
+    private:
+        friend class QStaticMetrics;
+
+        /* Histogram name. */
+        const char *name;
+
+        /* Number of values. */
+        std::atomic<qint64> count{0};
+
+        /* Sum of values. */
+        std::atomic<qint64> sum{0};
+
+        /* Smallest value. */
+        std::atomic<qint64> minimum{std::numeric_limits<qint64>::max()};
+
+        /* Largest value. */
+        std::atomic<qint64> maximum{0};
+
+        /* Bucket i counts values below 2^i and not below 2^(i-1). */
+        std::array<std::atomic<qint64>, 64> buckets{};
+
+        /**
+         * @brief Record a value while metrics are on.
+         * @param sample Value to record, not negative.
+         */
+        void add(qint64 sample);
+
+        /**
+         * @brief Estimate a percentile.
+         * @param fraction Percentile as a fraction, such as 0.99.
+         * @return qint64 Upper bound of the bucket holding the percentile.
+         */
+        qint64 percentile(double fraction) const;
+    };
+
+    /**
+     * @brief Check if metrics are on.
+     * @retval true Updates are recorded.
+     * @retval false Updates are ignored.
+     */
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Start recording metrics.
+     * @details Resets every metric, the report is made by stop().
+     * @param print Print a summary when stopped.
+     * @param path JSON file written when stopped, empty for none.
+     */
+    static void start(bool print, const QString &path = QString());
+
+    /**
+     * @brief Stop recording and report the metrics.
+     * @details Call it once the measured threads are done.
+     * @retval true The report was made, or metrics were off.
+     * @retval false The JSON file could not be written.
+     */
+    static bool stop();
+
+private:
+    /* Metrics are on. */
+    static std::atomic<bool> enabled;
+
+    /* Print a summary when stopped. */
+    static bool print;
+
+    /* JSON file path. */
+    static QString path;
+
+    /**
+     * @brief Constructor.
+     * @details This is a private constructor for this class to prevent
+     *          instantiation.
+     */
+    QStaticMetrics() {}
+};
+
+#endif // QSTATICMETRICS_H
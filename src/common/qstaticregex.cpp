@@ -11,26 +11,17 @@ bool QStaticRegex::isNameRegexValid(const QRegularExpression &regex)
 
 bool QStaticRegex::isNameRegularExpression(const QString &str)
 {
-    /* List of special characters commonly used in regular expressions */
-    const QStringList specialCharacters
-        = {"*", "+", "?", "|", "[", "]", "(", ")", "{", "}", "^", "$", "\\", "."};
+    /* Special characters commonly used in regular expressions, common escapes
+       such as `\d` or `\w` start with a backslash and are covered as well */
+    static const QString specialCharacters = QStringLiteral("*+?|[](){}^$\\.");
 
-    /* Check for special characters */
-    for (const auto &character : specialCharacters) {
-        if (str.contains(character)) {
+    for (const QChar character : str) {
+        if (specialCharacters.contains(character)) {
             return true;
         }
     }
 
-    /* Check for common regex patterns */
-    const QStringList regexPatterns = {"\\d", "\\w", "\\s", "\\b"};
-    for (const auto &pattern : regexPatterns) {
-        if (str.contains(pattern)) {
-            return true;
-        }
-    }
-
-    /* If none of the special characters or patterns are found, assume it's not a regex */
+    /* If none of the special characters are found, assume it's not a regex */
     return false;
 }
 
@@ -40,9 +31,9 @@ bool QStaticRegex::isNameExactMatch(const QString &str, const QRegularExpression
     if (pattern.isEmpty()) {
         return false;
     }
-    const QRegularExpression strictRegex
-        = QStaticRegex::isNameRegularExpression(pattern)
-              ? regex
-              : QRegularExpression("^" + QRegularExpression::escape(pattern) + "$");
-    return strictRegex.match(str).hasMatch();
+    /* Plain names are compared directly instead of through an escaped regex */
+    if (!QStaticRegex::isNameRegularExpression(pattern)) {
+        return str == pattern;
+    }
+    return regex.match(str).hasMatch();
 }
@@ -1,11 +1,24 @@
 #include "qstaticstringweaver.h"
 
+#include "common/qstaticmetrics.h"
+#include "common/qstatictrace.h"
+
 #include <algorithm>
 #include <limits>
 
+namespace {
+/* Distances computed */
+QStaticMetrics::Counter levenshteinCalls("weaver.levenshtein.calls");
+
+/* Dynamic programming cells filled by those distances */
+QStaticMetrics::Counter levenshteinCells("weaver.levenshtein.cells");
+} // namespace
+
 int QStaticStringWeaver::levenshteinDistance(const QString &s1, const QString &s2)
 {
     int n = s1.size(), m = s2.size();
+    levenshteinCalls.add();
+    levenshteinCells.add(static_cast<qint64>(n) * m);
     if (n == 0)
         return m;
     if (m == 0)
@@ -68,6 +81,7 @@ QMap<QString, int> QStaticStringWeaver::extractCandidateSubstrings(
 QMap<QString, QVector<QString>> QStaticStringWeaver::clusterStrings(
     const QVector<QString> &stringList, const QMap<QString, int> &candidateSubstrings)
 {
+    const QStaticTrace::Span span("weaver.cluster");
     /* Sort candidate substrings by descending length - longer ones are more specific */
     QList<QString> candidateMarkers = candidateSubstrings.keys();
     std::sort(candidateMarkers.begin(), candidateMarkers.end(), [](const QString &a, const QString &b) {
@@ -575,6 +589,7 @@ double QStaticStringWeaver::trimmedSimilarity(
 QMap<QString, QString> QStaticStringWeaver::findOptimalMatching(
     const QVector<QString> &groupA, const QVector<QString> &groupB, const QString &commonSubstr)
 {
+    const QStaticTrace::Span span("weaver.match");
     int nB = groupB.size();
     int nA = groupA.size();
     int N  = qMax(nB, nA);
@@ -871,3 +886,46 @@ QString QStaticStringWeaver::findBestGroupMarkerForHint(
 
     return bestGroupMarker;
 }
+
+QMap<QString, QString> QStaticStringWeaver::matchBusInterface(
+    const QVector<QString> &modulePorts,
+    const QVector<QString> &busSignals,
+    const QString          &hint)
+{
+    /* Cluster module ports by substrings of at least 3 characters shared by 2 ports */
+    const QMap<QString, int> candidateSubstrings = extractCandidateSubstrings(modulePorts, 3, 2);
+    const QMap<QString, QVector<QString>> groups
+        = clusterStrings(modulePorts, candidateSubstrings);
+
+    /* Find the group marker closest to the bus interface hint, longest markers first */
+    QList<QString> candidateMarkers = candidateSubstrings.keys();
+    std::sort(
+        candidateMarkers.begin(),
+        candidateMarkers.end(),
+        [](const QString &a, const QString &b) { return a.size() > b.size(); });
+    const QString bestMarker = findBestGroupMarkerForHint(hint, candidateMarkers);
+    if (!bestMarker.isEmpty()) {
+        qDebug() << "Best matching marker:" << bestMarker << "for hint:" << hint;
+    } else {
+        qDebug() << "No suitable group marker found, using empty string";
+    }
+
+    /* Collect the ports of all groups whose keys contain the marker */
+    QVector<QString> filteredModulePorts;
+    for (auto it = groups.begin(); it != groups.end(); ++it) {
+        if (it.key().contains(bestMarker, Qt::CaseInsensitive)) {
+            qDebug() << "Including ports from group:" << it.key();
+            filteredModulePorts.append(it.value());
+        }
+    }
+
+    /* If no filtered ports found, fall back to all ports */
+    if (filteredModulePorts.isEmpty()) {
+        qDebug() << "No ports found in matching groups, using all ports";
+        filteredModulePorts = modulePorts;
+    } else {
+        qDebug() << "Using filtered ports for matching:" << filteredModulePorts;
+    }
+
+    return findOptimalMatching(filteredModulePorts, busSignals, bestMarker);
+}
@@ -177,6 +177,22 @@ public slots:
     static QString findBestGroupMarkerForHint(
         const QString &hintString, const QList<QString> &candidateMarkers);
 
+    /**
+     * @brief Match bus signals to the ports of a module.
+     * @details Clusters the module ports by common substrings, picks the group
+     *          marker closest to the bus interface hint, then finds the optimal
+     *          matching between the bus signals and the ports of the groups
+     *          containing that marker, or all ports if there are none.
+     * @param modulePorts All ports of the module.
+     * @param busSignals The signals of the bus.
+     * @param hint The bus interface name.
+     * @return A map of bus signals to their matched module ports.
+     */
+    static QMap<QString, QString> matchBusInterface(
+        const QVector<QString> &modulePorts,
+        const QVector<QString> &busSignals,
+        const QString          &hint);
+
 private:
     /**
      * @brief Constructor.
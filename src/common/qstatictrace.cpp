@@ -0,0 +1,150 @@
+#include "common/qstatictrace.h"
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace {
+/* Finished span */
+struct Event
+{
+    const char *name;   /* Span name */
+    QString     detail; /* Span detail */
+    qint64      start;  /* Start time in nanoseconds */
+    qint64      end;    /* End time in nanoseconds */
+};
+
+/* Spans of one thread, the lock is only contended while the trace is written */
+struct Buffer
+{
+    QMutex             mutex;
+    std::vector<Event> events;
+    int                threadId = 0;
+};
+
+/* Buffers of every thread that traced, they outlive their threads */
+struct Registry
+{
+    QMutex                               mutex;
+    std::vector<std::unique_ptr<Buffer>> buffers;
+};
+
+Registry &registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+Buffer &threadBuffer()
+{
+    thread_local Buffer *buffer = nullptr;
+    if (!buffer) {
+        Registry          &shared = registry();
+        const QMutexLocker locker(&shared.mutex);
+        shared.buffers.push_back(std::make_unique<Buffer>());
+        buffer           = shared.buffers.back().get();
+        buffer->threadId = static_cast<int>(shared.buffers.size());
+    }
+    return *buffer;
+}
+
+/* JSON string body, names are literals but details may be paths */
+QByteArray escapeJson(const QString &text)
+{
+    QByteArray result;
+    for (const char byte : text.toUtf8()) {
+        if (byte == '"' || byte == '\\') {
+            result += '\\';
+            result += byte;
+        } else if (static_cast<unsigned char>(byte) >= 0x20) {
+            result += byte;
+        }
+    }
+    return result;
+}
+
+/* Nanoseconds to the microseconds of trace events */
+QByteArray microseconds(qint64 nanoseconds)
+{
+    return QByteArray::number(static_cast<double>(nanoseconds) / 1000.0, 'f', 3);
+}
+} // namespace
+
+std::atomic<bool> QStaticTrace::enabled = false;
+QString           QStaticTrace::path;
+qint64            QStaticTrace::epoch = 0;
+
+void QStaticTrace::start(const QString &path)
+{
+    Registry          &shared = registry();
+    const QMutexLocker locker(&shared.mutex);
+    for (const std::unique_ptr<Buffer> &buffer : shared.buffers) {
+        const QMutexLocker bufferLocker(&buffer->mutex);
+        buffer->events.clear();
+    }
+    QStaticTrace::path  = path;
+    QStaticTrace::epoch = now();
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+bool QStaticTrace::stop()
+{
+    if (!enabled.exchange(false, std::memory_order_relaxed)) {
+        return true;
+    }
+
+    /* Metadata first, then the spans of each thread */
+    const QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+    QByteArray       json;
+    json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    json += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" + pid
+            + ",\"tid\":0,\"args\":{\"name\":\"qsoc\"}}";
+
+    Registry          &shared = registry();
+    const QMutexLocker locker(&shared.mutex);
+    for (const std::unique_ptr<Buffer> &buffer : shared.buffers) {
+        const QMutexLocker bufferLocker(&buffer->mutex);
+        const QByteArray   tid = QByteArray::number(buffer->threadId);
+        for (const Event &event : buffer->events) {
+            const QByteArray name     = event.name;
+            const int        dot      = name.indexOf('.');
+            const QByteArray category = dot > 0 ? name.left(dot) : name;
+            json += ",\n{\"name\":\"" + name + "\",\"cat\":\"" + category
+                    + "\",\"ph\":\"X\",\"ts\":" + microseconds(event.start - epoch)
+                    + ",\"dur\":" + microseconds(event.end - event.start) + ",\"pid\":" + pid
+                    + ",\"tid\":" + tid;
+            if (!event.detail.isEmpty()) {
+                json += ",\"args\":{\"detail\":\"" + escapeJson(event.detail) + "\"}";
+            }
+            json += '}';
+        }
+        buffer->events.clear();
+    }
+    json += "\n]}\n";
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(json) == json.size();
+}
+
+qint64 QStaticTrace::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void QStaticTrace::record(const char *name, const QString &detail, qint64 start, qint64 end)
+{
+    Buffer            &buffer = threadBuffer();
+    const QMutexLocker locker(&buffer.mutex);
+    buffer.events.push_back({name, detail, start, end});
+}
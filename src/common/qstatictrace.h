@@ -0,0 +1,125 @@
+#ifndef QSTATICTRACE_H
+#define QSTATICTRACE_H
+
+#include <QString>
+
+#include <atomic>
+
+/**
+ * @brief The QStaticTrace class.
+ * @details This class records timed spans of qsoc phases and writes them
+ *          as Chrome trace-event JSON, which chrome://tracing and Perfetto
+ *          open directly. Every thread appends to a buffer of its own, the
+ *          buffers are merged only when the trace is written. While tracing
+ *          is off a span costs one relaxed atomic load.
+ */
+class QStaticTrace
+{
+public:
+    /**
+     * @brief The Span class.
+     * @details A span is timed from its construction to its destruction,
+     *          declare it at the top of the scope to measure.
+     */
+    class Span
+    {
+    public:
+        /**
+         * @brief Start a span.
+         * @param name Span name, a string literal such as "slang.parse". The
+         *        part before the first dot is used as the category.
+         * @param detail Optional detail shown with the span, such as a file
+         *        path, copied only while tracing.
+         */
+        explicit Span(const char *name, const QString &detail = QString())
+            : name(name)
+            , start(QStaticTrace::isEnabled() ? QStaticTrace::now() : -1)
+        {
+            if (start >= 0) {
+                this->detail = detail;
+            }
+        }
+
+        /**
+         * @brief End the span.
+         * @details Records the span in the buffer of the calling thread.
+         */
+        ~Span()
+        {
+            if (start >= 0) {
+                QStaticTrace::record(name, detail, start, QStaticTrace::now());
+            }
+        }
+
+        Span(const Span &)            = delete;
+        Span &operator=(const Span &) = delete;
+
+    private:
+        /* Span name. */
+        const char *name;
+
+        /* Span detail. */
+        QString detail;
+
+        /* Start time in nanoseconds, -1 while tracing is off. */
+        qint64 start;
+    };
+
+    /**
+     * @brief Check if tracing is on.
+     * @retval true Spans are recorded.
+     * @retval false Spans are ignored.
+     */
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Start tracing.
+     * @details Drops spans of an earlier trace, the file is written by
+     *          stop().
+     * @param path Trace file path.
+     */
+    static void start(const QString &path);
+
+    /**
+     * @brief Stop tracing and write the trace file.
+     * @details Call it once the traced threads are done, spans that end
+     *          later are dropped.
+     * @retval true The trace was written, or tracing was off.
+     * @retval false The trace file could not be written.
+     */
+    static bool stop();
+
+private:
+    /* Tracing is on. */
+    static std::atomic<bool> enabled;
+
+    /* Trace file path. */
+    static QString path;
+
+    /* Time tracing started in nanoseconds. */
+    static qint64 epoch;
+
+    /**
+     * @brief Get the current time.
+     * @return qint64 Monotonic time in nanoseconds.
+     */
+    static qint64 now();
+
+    /**
+     * @brief Record a finished span.
+     * @param name Span name.
+     * @param detail Span detail.
+     * @param start Start time in nanoseconds.
+     * @param end End time in nanoseconds.
+     */
+    static void record(const char *name, const QString &detail, qint64 start, qint64 end);
+
+    /**
+     * @brief Constructor.
+     * @details This is a private constructor for this class to prevent
+     *          instantiation.
+     */
+    QStaticTrace() {}
+};
+
+#endif // QSTATICTRACE_H
@@ -0,0 +1,278 @@
+#include "common/qstaticyamlcache.h"
+
+#include "common/qstaticmetrics.h"
+#include "common/qstatictrace.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <fstream>
+
+namespace {
+/* Files parsed, cache hits excluded */
+QStaticMetrics::Counter filesRead("yaml.files.read");
+
+/* Bytes of the files parsed */
+QStaticMetrics::Counter bytesRead("yaml.bytes.read");
+
+/* Loads served from the cache */
+QStaticMetrics::Counter cacheHits("yaml.cache.hits");
+
+/* Files written */
+QStaticMetrics::Counter filesWritten("yaml.files.written");
+
+/* Bytes of the files written */
+QStaticMetrics::Counter bytesWritten("yaml.bytes.written");
+
+/* Documents held by the cache, pending changes included */
+QStaticMetrics::Gauge cacheEntries("yaml.cache.entries");
+} // namespace
+
+bool                                    QStaticYamlCache::enabled  = false;
+bool                                    QStaticYamlCache::deferred = false;
+QHash<QString, QStaticYamlCache::Entry> QStaticYamlCache::entries;
+quint64                                 QStaticYamlCache::lastGeneration = 0;
+QRecursiveMutex                         QStaticYamlCache::mutex;
+
+bool QStaticYamlCache::isEnabled()
+{
+    const QMutexLocker locker(&mutex);
+    return enabled;
+}
+
+void QStaticYamlCache::setEnabled(bool enabled)
+{
+    const QMutexLocker locker(&mutex);
+    QStaticYamlCache::enabled = enabled;
+    if (!enabled) {
+        deferred = false;
+        entries.clear();
+        cacheEntries.set(0);
+    }
+}
+
+bool QStaticYamlCache::isDeferred()
+{
+    const QMutexLocker locker(&mutex);
+    return deferred;
+}
+
+void QStaticYamlCache::setDeferred(bool deferred)
+{
+    const QMutexLocker locker(&mutex);
+    QStaticYamlCache::deferred = deferred;
+    if (deferred) {
+        enabled = true;
+    }
+}
+
+YAML::Node QStaticYamlCache::load(const QString &filePath)
+{
+    const QStaticTrace::Span span("yaml.load", filePath);
+    if (!isEnabled()) {
+        if (QStaticMetrics::isEnabled()) {
+            filesRead.add();
+            bytesRead.add(QFileInfo(filePath).size());
+        }
+        return YAML::LoadFile(filePath.toStdString());
+    }
+
+    /* A fresh QFileInfo stats the file, so external edits are noticed */
+    const QFileInfo fileInfo(filePath);
+    const QString   key          = fileInfo.absoluteFilePath();
+    const qint64    size         = fileInfo.size();
+    const QDateTime lastModified = fileInfo.lastModified();
+    {
+        const QMutexLocker locker(&mutex);
+        const auto         iterator = entries.constFind(key);
+
+        /* Pending changes win over the file on disk */
+        if (iterator != entries.cend() && iterator->removed) {
+            throw YAML::BadFile(filePath.toStdString());
+        }
+        if (iterator != entries.cend()
+            && (iterator->pending
+                || (iterator->size == size && iterator->lastModified == lastModified))) {
+            /* Callers modify what they load, never hand out the cached nodes */
+            cacheHits.add();
+            return YAML::Clone(iterator->document);
+        }
+    }
+
+    /* Parse without the lock, so other threads load other files meanwhile */
+    Entry entry;
+    entry.size         = size;
+    entry.lastModified = lastModified;
+    entry.document     = YAML::LoadFile(filePath.toStdString());
+    filesRead.add();
+    bytesRead.add(size);
+
+    const QMutexLocker locker(&mutex);
+    auto               iterator = entries.find(key);
+    if (iterator != entries.end() && iterator->removed) {
+        throw YAML::BadFile(filePath.toStdString());
+    }
+    if (iterator == entries.end() || !iterator->pending) {
+        entry.generation = ++lastGeneration;
+        iterator         = entries.insert(key, entry);
+        cacheEntries.set(entries.size());
+    }
+    return YAML::Clone(iterator->document);
+}
+
+quint64 QStaticYamlCache::generation(const QString &filePath)
+{
+    if (!isEnabled()) {
+        return 0;
+    }
+    const QFileInfo    fileInfo(filePath);
+    const QMutexLocker locker(&mutex);
+    const auto         iterator = entries.constFind(fileInfo.absoluteFilePath());
+    if (iterator == entries.cend() || iterator->removed) {
+        return 0;
+    }
+    if (iterator->pending
+        || (iterator->size == fileInfo.size()
+            && iterator->lastModified == fileInfo.lastModified())) {
+        return iterator->generation;
+    }
+    return 0;
+}
+
+bool QStaticYamlCache::save(const QString &filePath, const YAML::Node &document)
+{
+    const QMutexLocker locker(&mutex);
+    if (!deferred) {
+        entries.remove(QFileInfo(filePath).absoluteFilePath());
+        cacheEntries.set(entries.size());
+        return write(filePath, document);
+    }
+
+    Entry entry;
+    entry.document   = YAML::Clone(document);
+    entry.pending    = true;
+    entry.generation = ++lastGeneration;
+    entries.insert(QFileInfo(filePath).absoluteFilePath(), entry);
+    cacheEntries.set(entries.size());
+    return true;
+}
+
+bool QStaticYamlCache::remove(const QString &filePath)
+{
+    const QMutexLocker locker(&mutex);
+    if (!deferred) {
+        entries.remove(QFileInfo(filePath).absoluteFilePath());
+        cacheEntries.set(entries.size());
+        return QFile::remove(filePath);
+    }
+
+    if (!exists(filePath)) {
+        return false;
+    }
+    Entry entry;
+    entry.removed    = true;
+    entry.generation = ++lastGeneration;
+    entries.insert(QFileInfo(filePath).absoluteFilePath(), entry);
+    cacheEntries.set(entries.size());
+    return true;
+}
+
+bool QStaticYamlCache::exists(const QString &filePath)
+{
+    const QMutexLocker locker(&mutex);
+    const auto iterator = entries.constFind(QFileInfo(filePath).absoluteFilePath());
+    if (iterator != entries.cend() && (iterator->pending || iterator->removed)) {
+        return iterator->pending;
+    }
+    return QFile::exists(filePath);
+}
+
+QStringList QStaticYamlCache::listFiles(const QString &dirPath, const QString &suffix)
+{
+    const QDir  dir(dirPath, "*." + suffix, QDir::NoSort, QDir::Files | QDir::NoDotAndDotDot);
+    QStringList result = dir.entryList();
+
+    /* Merge pending changes of this directory */
+    const QString      dirKey = QFileInfo(dirPath).absoluteFilePath();
+    const QMutexLocker locker(&mutex);
+    for (auto iterator = entries.cbegin(); iterator != entries.cend(); ++iterator) {
+        if (!iterator->pending && !iterator->removed) {
+            continue;
+        }
+        const QFileInfo fileInfo(iterator.key());
+        if (fileInfo.absolutePath() != dirKey || fileInfo.suffix() != suffix) {
+            continue;
+        }
+        if (iterator->pending && !result.contains(fileInfo.fileName())) {
+            result.append(fileInfo.fileName());
+        } else if (iterator->removed) {
+            result.removeAll(fileInfo.fileName());
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](const QString &left, const QString &right) {
+        return QString::compare(left, right, Qt::CaseInsensitive) < 0;
+    });
+    return result;
+}
+
+bool QStaticYamlCache::flush()
+{
+    const QMutexLocker locker(&mutex);
+    bool allFlushed = true;
+    for (auto iterator = entries.begin(); iterator != entries.end();) {
+        if (iterator->pending) {
+            if (!write(iterator.key(), iterator->document)) {
+                allFlushed = false;
+            }
+        } else if (iterator->removed) {
+            if (QFile::exists(iterator.key()) && !QFile::remove(iterator.key())) {
+                qCritical() << "Error: Failed to remove file:" << iterator.key();
+                allFlushed = false;
+            }
+        } else {
+            ++iterator;
+            continue;
+        }
+        /* The file is reparsed on the next load */
+        iterator = entries.erase(iterator);
+    }
+    cacheEntries.set(entries.size());
+    return allFlushed;
+}
+
+void QStaticYamlCache::invalidate(const QString &filePath)
+{
+    const QMutexLocker locker(&mutex);
+    /* Pending changes are not a cache, only flush() applies them */
+    const auto iterator = entries.find(QFileInfo(filePath).absoluteFilePath());
+    if (iterator != entries.end() && !iterator->pending && !iterator->removed) {
+        entries.erase(iterator);
+        cacheEntries.set(entries.size());
+    }
+}
+
+void QStaticYamlCache::clear()
+{
+    const QMutexLocker locker(&mutex);
+    entries.clear();
+    cacheEntries.set(0);
+}
+
+bool QStaticYamlCache::write(const QString &filePath, const YAML::Node &document)
+{
+    const QStaticTrace::Span span("yaml.write", filePath);
+    std::ofstream outputFileStream(filePath.toStdString());
+    if (!outputFileStream.is_open()) {
+        qCritical() << "Error: Unable to open file for writing:" << filePath;
+        return false;
+    }
+    outputFileStream << document;
+    filesWritten.add();
+    bytesWritten.add(qMax<qint64>(0, outputFileStream.tellp()));
+    return true;
+}
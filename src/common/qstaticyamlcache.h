@@ -0,0 +1,199 @@
+#ifndef QSTATICYAMLCACHE_H
+#define QSTATICYAMLCACHE_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QObject>
+#include <QRecursiveMutex>
+#include <QString>
+#include <QStringList>
+
+#include <yaml-cpp/yaml.h>
+
+/**
+ * @brief The QStaticYamlCache class.
+ * @details Provides a process-wide cache of parsed YAML files for the
+ *          project, module and bus managers. It is disabled by default, so
+ *          a single CLI run parses every file exactly as before. Long running
+ *          sessions such as `qsoc serve` enable it to keep libraries resident
+ *          between commands. A cached document is reused only while the size
+ *          and modification time of its file are unchanged, and callers get a
+ *          deep copy they are free to modify. In deferred mode, used by
+ *          `qsoc batch`, writes and removals are kept in memory and applied by
+ *          flush(); exists(), listFiles() and load() already see them.
+ *          All functions are thread-safe, files are parsed outside the lock
+ *          so several threads can load libraries at the same time.
+ */
+class QStaticYamlCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Get the static instance of this object.
+     * @details This function returns the static instance of this object. It is
+     *          used to provide a singleton instance of the class, ensuring that
+     *          only one instance of the class exists throughout the
+     *          application.
+     * @return The static instance of QStaticYamlCache.
+     */
+    static QStaticYamlCache &instance()
+    {
+        static QStaticYamlCache instance;
+        return instance;
+    }
+
+    /**
+     * @brief Check if the cache is enabled.
+     * @retval true Parsed files are cached.
+     * @retval false Every load parses the file.
+     */
+    static bool isEnabled();
+
+    /**
+     * @brief Enable or disable the cache.
+     * @details Disabling the cache also drops all cached documents.
+     * @param enabled Whether parsed files are cached.
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * @brief Check if writes are deferred.
+     * @retval true Writes and removals are kept until flush().
+     * @retval false Writes and removals go to disk immediately.
+     */
+    static bool isDeferred();
+
+    /**
+     * @brief Defer writes and removals until flush().
+     * @details Deferring enables the cache. Pending changes are kept when
+     *          deferring is turned off, call flush() to apply them.
+     * @param deferred Whether writes and removals are deferred.
+     */
+    static void setDeferred(bool deferred);
+
+    /**
+     * @brief Load a YAML file.
+     * @details Returns the cached document if the file is unchanged since it
+     *          was parsed, otherwise parses the file. Parse errors are thrown
+     *          as YAML::Exception, like YAML::LoadFile().
+     * @param filePath Path of the YAML file.
+     * @return YAML::Node A copy of the document, owned by the caller.
+     */
+    static YAML::Node load(const QString &filePath);
+
+    /**
+     * @brief Get the generation of a cached document.
+     * @details A document gets a new generation whenever it is parsed,
+     *          saved or removed, so callers that keep what they loaded can
+     *          tell whether it is still current without loading it again.
+     *          The file is checked on disk like load() does.
+     * @param filePath Path of the YAML file.
+     * @return quint64 The generation of the document load() would return
+     *                 without parsing, 0 if it would parse the file or throw.
+     */
+    static quint64 generation(const QString &filePath);
+
+    /**
+     * @brief Save a YAML file.
+     * @details Writes the document, or keeps it until flush() when writes
+     *          are deferred.
+     * @param filePath Path of the YAML file.
+     * @param document The document to save.
+     * @retval true File saved or pending.
+     * @retval false Failed to write the file.
+     */
+    static bool save(const QString &filePath, const YAML::Node &document);
+
+    /**
+     * @brief Remove a YAML file.
+     * @details Removes the file, or keeps the removal until flush() when
+     *          writes are deferred.
+     * @param filePath Path of the YAML file.
+     * @retval true File removed or removal pending.
+     * @retval false Failed to remove the file.
+     */
+    static bool remove(const QString &filePath);
+
+    /**
+     * @brief Check if a YAML file exists, including pending changes.
+     * @param filePath Path of the YAML file.
+     * @retval true File exists on disk or is pending.
+     * @retval false File does not exist or its removal is pending.
+     */
+    static bool exists(const QString &filePath);
+
+    /**
+     * @brief List the YAML files of a directory, including pending changes.
+     * @param dirPath Path of the directory.
+     * @param suffix File name suffix, such as "soc_mod".
+     * @return QStringList File names sorted by name, case insensitive.
+     */
+    static QStringList listFiles(const QString &dirPath, const QString &suffix);
+
+    /**
+     * @brief Apply pending writes and removals.
+     * @details All pending changes are attempted, failures are reported.
+     * @retval true All pending changes were applied.
+     * @retval false Some file could not be written or removed.
+     */
+    static bool flush();
+
+    /**
+     * @brief Drop the cached document of a file.
+     * @details Call this after writing a file, the modification time may
+     *          not change when the file is rewritten quickly.
+     * @param filePath Path of the YAML file.
+     */
+    static void invalidate(const QString &filePath);
+
+    /**
+     * @brief Drop all cached documents.
+     * @details Pending changes are dropped as well.
+     */
+    static void clear();
+
+private:
+    /**
+     * @brief The Entry struct.
+     * @details A parsed file and the file state it was parsed from.
+     */
+    struct Entry
+    {
+        qint64     size = -1;          /* File size when parsed */
+        QDateTime  lastModified;       /* File modification time when parsed */
+        YAML::Node document;           /* Parsed document */
+        bool       pending    = false; /* Document is not written yet */
+        bool       removed    = false; /* File removal is not applied yet */
+        quint64    generation = 0;     /* Changes whenever the document changes */
+    };
+
+    /** Cache is enabled. */
+    static bool enabled;
+    /** Writes and removals are deferred. */
+    static bool deferred;
+    /** Cached documents by absolute file path. */
+    static QHash<QString, Entry> entries;
+    /** Generation of the last document parsed, saved or removed. */
+    static quint64 lastGeneration;
+    /** Guards the flags and entries, recursive since remove() calls exists(). */
+    static QRecursiveMutex mutex;
+
+    /**
+     * @brief Write a document to a file.
+     * @param filePath Path of the YAML file.
+     * @param document The document to write.
+     * @retval true File written.
+     * @retval false Failed to open the file.
+     */
+    static bool write(const QString &filePath, const YAML::Node &document);
+
+    /**
+     * @brief Constructor.
+     * @details This is a private constructor for QStaticYamlCache to prevent
+     *          instantiation.
+     */
+    QStaticYamlCache() {}
+};
+
+#endif // QSTATICYAMLCACHE_H
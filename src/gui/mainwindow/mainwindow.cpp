@@ -2,6 +2,8 @@
 
 #include "./ui_mainwindow.h"
 
+#include <QDir>
+
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
@@ -9,6 +11,34 @@ MainWindow::MainWindow(QWidget *parent)
     ui->setupUi(this);
     ui->toolButtonSchematicEditor->setDefaultAction(ui->actionSchematicEditor);
     ui->toolButtonModuleEditor->setDefaultAction(ui->actionModuleEditor);
+
+    /* Log messages reach the log view in batches, once per frame */
+    logSink.attach(ui->textBrowserLog);
+    QStaticLog::setSink(&logSink);
+
+    /* Libraries load in the background, the window is usable meanwhile */
+    connect(
+        &projectLoader,
+        &QSocProjectLoader::progress,
+        this,
+        [this](const QString &stage, int done, int total) {
+            ui->statusbar->showMessage(tr("Loading %1 %2/%3").arg(stage).arg(done).arg(total));
+        });
+    connect(
+        &projectLoader,
+        &QSocProjectLoader::loaded,
+        this,
+        [this](const QSocProjectLoader::SnapshotPointer &snapshot) {
+            schematicWindow.setLibrary(snapshot);
+            ui->statusbar->showMessage(tr("Loaded project %1: %2 modules, %3 buses")
+                                           .arg(snapshot->projectName)
+                                           .arg(snapshot->modules.size())
+                                           .arg(snapshot->buses.size()));
+        });
+    connect(&projectLoader, &QSocProjectLoader::failed, this, [this](const QString &message) {
+        ui->statusbar->showMessage(message);
+    });
+    projectLoader.load(QDir::currentPath());
 }
 
 MainWindow::~MainWindow()
@@ -1,6 +1,8 @@
 #ifndef MAINWINDOW_H
 #define MAINWINDOW_H
 
+#include "common/qsoclogsink.h"
+#include "common/qsocprojectloader.h"
 #include "gui/schematicwindow/schematicwindow.h"
 
 #include <QMainWindow>
@@ -52,5 +54,11 @@ private:
 
     /* Schematic window object. */
     SchematicWindow schematicWindow;
+
+    /* Batched log sink of the log view. */
+    QSocLogSink logSink;
+
+    /* Background loader of the project and its libraries. */
+    QSocProjectLoader projectLoader;
 };
 #endif // MAINWINDOW_H
@@ -0,0 +1,134 @@
+#include "gui/schematicwindow/schematicitems.h"
+
+#include <QColor>
+#include <QPainter>
+#include <QPen>
+#include <QPixmapCache>
+#include <QRectF>
+#include <QStyleOptionGraphicsItem>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+/* Zoom below which port names are not drawn */
+constexpr qreal kPortLabelDetail = 0.5;
+/* Zoom below which pins are not drawn, nodes come from pixmaps and wires are bundled */
+constexpr qreal kPinDetail = 0.25;
+/* Widest bundle in pixels */
+constexpr qreal kBundleMaxWidth = 6.0;
+
+qreal levelOfDetail(const QPainter *painter)
+{
+    return QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+}
+} // namespace
+
+SchematicNode::SchematicNode(const QString &instanceName, const QString &moduleName, int gridSize)
+    : instanceName(instanceName)
+    , moduleName(moduleName)
+    , gridSize(gridSize)
+{
+    setToolTip(instanceName + " : " + moduleName);
+}
+
+void SchematicNode::addPort(const QPoint &gridPoint, const QString &portName, bool right)
+{
+    addConnector(std::make_shared<SchematicConnector>(gridPoint));
+    portLabels.append({QPointF(gridPoint) * gridSize, portName, right});
+}
+
+void SchematicNode::paint(
+    QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    const qreal detail = levelOfDetail(painter);
+    if (detail < kPinDetail) {
+        const QPixmap pixmap = overviewPixmap();
+        painter->drawPixmap(QRectF(QPointF(0, 0), size()), pixmap, QRectF(pixmap.rect()));
+        return;
+    }
+
+    QSchematic::Items::Node::paint(painter, option, widget);
+
+    /* Instance name in the title rows */
+    const qreal width = size().width();
+    painter->setPen(Qt::black);
+    painter->drawText(
+        QRectF(0, 0, width, 2 * gridSize), Qt::AlignCenter | Qt::TextSingleLine, instanceName);
+    if (detail < kPortLabelDetail) {
+        return;
+    }
+
+    /* Port names next to their connectors, each side gets half the width */
+    const qreal inset = gridSize / 2.0;
+    for (const PortLabel &label : portLabels) {
+        const qreal         top = label.position.y() - gridSize / 2.0;
+        const QRectF        rect(label.right ? width / 2 : inset, top, width / 2 - inset, gridSize);
+        const Qt::Alignment alignment = label.right ? Qt::AlignRight : Qt::AlignLeft;
+        painter->drawText(rect, alignment | Qt::AlignVCenter | Qt::TextSingleLine, label.name);
+    }
+}
+
+QPixmap SchematicNode::overviewPixmap() const
+{
+    const QSize   pixels = (size() * kPinDetail).toSize().expandedTo(QSize(1, 1));
+    const QString key    = QString("qsoc-node:%1:%2x%3")
+                            .arg(moduleName)
+                            .arg(pixels.width())
+                            .arg(pixels.height());
+
+    QPixmap pixmap;
+    if (QPixmapCache::find(key, &pixmap)) {
+        return pixmap;
+    }
+
+    pixmap = QPixmap(pixels);
+    pixmap.fill(QColor(0xe0, 0xe0, 0xe0));
+    QPainter painter(&pixmap);
+    painter.setPen(Qt::black);
+    painter.drawRect(QRect(QPoint(0, 0), pixels - QSize(1, 1)));
+    painter.drawText(QRect(QPoint(0, 0), pixels), Qt::AlignCenter | Qt::TextWordWrap, moduleName);
+    painter.end();
+    QPixmapCache::insert(key, pixmap);
+    return pixmap;
+}
+
+SchematicConnector::SchematicConnector(const QPoint &gridPoint)
+    : QSchematic::Items::Connector(QSchematic::Items::Item::ConnectorType, gridPoint)
+{}
+
+void SchematicConnector::paint(
+    QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    if (levelOfDetail(painter) < kPinDetail) {
+        return;
+    }
+    QSchematic::Items::Connector::paint(painter, option, widget);
+}
+
+void SchematicWire::setBundle(const QPolygonF &scenePoints, bool lead, int weight)
+{
+    this->scenePoints = scenePoints;
+    this->lead        = lead;
+    this->weight      = std::max(weight, 1);
+}
+
+void SchematicWire::paint(
+    QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    if (levelOfDetail(painter) >= kPinDetail) {
+        QSchematic::Items::Wire::paint(painter, option, widget);
+        return;
+    }
+    if (!lead) {
+        return;
+    }
+
+    /* One polyline for the whole bundle, a cosmetic pen keeps its width on screen */
+    const qreal width = std::min(kBundleMaxWidth, 1.0 + std::log2(static_cast<qreal>(weight)));
+    QPen        pen(Qt::darkBlue, width);
+    pen.setCosmetic(true);
+    painter->setPen(pen);
+    painter->setBrush(Qt::NoBrush);
+    painter->drawPolyline(mapFromScene(scenePoints));
+}
@@ -0,0 +1,153 @@
+#ifndef SCHEMATICITEMS_H
+#define SCHEMATICITEMS_H
+
+#include <QList>
+#include <QPixmap>
+#include <QPoint>
+#include <QPointF>
+#include <QPolygonF>
+#include <QString>
+
+#include <qschematic/items/connector.hpp>
+#include <qschematic/items/node.hpp>
+#include <qschematic/items/wire.hpp>
+
+/**
+ * @brief The SchematicNode class.
+ * @details This class is an instance node of a netlist schematic with
+ *          level-of-detail painting. The instance and port names are drawn
+ *          by the node itself instead of one label item per connector, and
+ *          only when the view is zoomed in far enough to read them. Zoomed
+ *          out further, the node is drawn from a pixmap that is rendered
+ *          once per module and size and shared by all of its instances.
+ *          The pixmap saves the rendering, not the items: every visible node
+ *          is still painted on its own, so the cost of a fully zoomed out
+ *          view grows with the number of instances rather than with the
+ *          area of the view.
+ */
+class SchematicNode : public QSchematic::Items::Node
+{
+public:
+    /**
+     * @brief Constructor for SchematicNode.
+     * @details This constructor will initialize the instance node.
+     * @param[in] instanceName instance name
+     * @param[in] moduleName module name
+     * @param[in] gridSize grid size in scene units
+     */
+    SchematicNode(const QString &instanceName, const QString &moduleName, int gridSize);
+
+    /**
+     * @brief Add a port.
+     * @details This function adds a connector and the port name label.
+     * @param[in] gridPoint connector position in grid units
+     * @param[in] portName port name
+     * @param[in] right port is on the right side
+     */
+    void addPort(const QPoint &gridPoint, const QString &portName, bool right);
+
+    /**
+     * @brief Paint the node.
+     * @details This function paints the full node, the node without port
+     *          names, or the cached overview pixmap depending on the zoom.
+     * @param[in] painter painter
+     * @param[in] option style option
+     * @param[in] widget widget painted on
+     */
+    void paint(
+        QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+private:
+    /* Port name label. */
+    struct PortLabel
+    {
+        QPointF position; /* Connector position in item coordinates */
+        QString name;     /* Port name */
+        bool    right;    /* Port is on the right side */
+    };
+
+    /* Instance name. */
+    QString instanceName;
+
+    /* Module name. */
+    QString moduleName;
+
+    /* Grid size in scene units. */
+    int gridSize;
+
+    /* Port name labels. */
+    QList<PortLabel> portLabels;
+
+    /**
+     * @brief Get the overview pixmap.
+     * @details This function renders the pixmap on first use and keeps it
+     *          in QPixmapCache, keyed by module name and node size.
+     * @return QPixmap overview pixmap
+     */
+    QPixmap overviewPixmap() const;
+};
+
+/**
+ * @brief The SchematicConnector class.
+ * @details This class is a port connector that is not painted when the
+ *          view is zoomed out too far for pins to be told apart.
+ */
+class SchematicConnector : public QSchematic::Items::Connector
+{
+public:
+    /**
+     * @brief Constructor for SchematicConnector.
+     * @details This constructor will initialize the connector.
+     * @param[in] gridPoint position in grid units
+     */
+    explicit SchematicConnector(const QPoint &gridPoint);
+
+    /**
+     * @brief Paint the connector.
+     * @param[in] painter painter
+     * @param[in] option style option
+     * @param[in] widget widget painted on
+     */
+    void paint(
+        QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+};
+
+/**
+ * @brief The SchematicWire class.
+ * @details This class is a net wire that collapses into its bundle when the
+ *          view is zoomed out. Only the first wire of a bundle is painted
+ *          then, as a single polyline whose width grows with the number of
+ *          wires and bits it stands for.
+ */
+class SchematicWire : public QSchematic::Items::Wire
+{
+public:
+    /**
+     * @brief Set the bundle of the wire.
+     * @param[in] scenePoints wire polyline in scene coordinates
+     * @param[in] lead wire is the first of its bundle
+     * @param[in] weight wires times bits of the bundle, used by the lead
+     */
+    void setBundle(const QPolygonF &scenePoints, bool lead, int weight);
+
+    /**
+     * @brief Paint the wire.
+     * @param[in] painter painter
+     * @param[in] option style option
+     * @param[in] widget widget painted on
+     */
+    void paint(
+        QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+private:
+    /* Polyline in scene coordinates. */
+    QPolygonF scenePoints;
+
+    /* Wire is the first of its bundle. */
+    bool lead = true;
+
+    /* Wires times bits of the bundle. */
+    int weight = 1;
+};
+
+#endif // SCHEMATICITEMS_H
@@ -1,7 +1,28 @@
 #include "gui/schematicwindow/schematicwindow.h"
+#include "common/qsocbusmanager.h"
+#include "common/qsocgeneratemanager.h"
+#include "common/qsocmodulemanager.h"
+#include "common/qsocprojectmanager.h"
+#include "gui/schematicwindow/schematicitems.h"
 
 #include "./ui_schematicwindow.h"
 
+#include <QDir>
+#include <QEvent>
+#include <QFileInfo>
+#include <QMetaObject>
+#include <QMouseEvent>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace {
+/* Free grid cells around the netlist */
+constexpr int kSceneMargin = 4;
+} // namespace
+
 SchematicWindow::SchematicWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::SchematicWindow)
@@ -46,9 +67,180 @@ SchematicWindow::SchematicWindow(QWidget *parent)
 
     scene.clear();
     scene.setSceneRect(-500, -500, 3000, 3000);
+
+    /* One layout at a time, a newer request replaces a queued one */
+    layoutThreadPool.setMaxThreadCount(1);
+
+    /* Name what is under the cursor in the status bar */
+    ui->schematicView->viewport()->installEventFilter(this);
 }
 
 SchematicWindow::~SchematicWindow()
 {
+    /* A running layout posts its result to this window */
+    layoutThreadPool.clear();
+    layoutThreadPool.waitForDone();
     delete ui;
 }
+
+void SchematicWindow::showNetlist(const QSocNetlistGraph &graph)
+{
+    /* Copy the netlist now, the graph may change while the layout runs */
+    auto          layout     = std::make_shared<QSocSchematicLayout>(graph);
+    const quint64 generation = ++layoutGeneration;
+
+    layoutThreadPool.clear();
+    layoutThreadPool.start([this, layout, generation]() {
+        layout->run();
+        QMetaObject::invokeMethod(
+            this,
+            [this, layout, generation]() {
+                if (generation == layoutGeneration) {
+                    populateScene(layout);
+                }
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+bool SchematicWindow::openNetlist(const QString &netlistFilePath)
+{
+    /* The project of the shown libraries, the first one found before any were shown */
+    QSocProjectManager projectManager;
+    projectManager.setProjectPath(library ? library->projectPath : QDir::currentPath());
+    const bool projectLoaded = library && !library->projectName.isEmpty()
+                                   ? projectManager.load(library->projectName)
+                                   : projectManager.loadFirst();
+    if (!projectLoaded) {
+        ui->statusbar->showMessage(tr("No project found to open %1").arg(netlistFilePath));
+        return false;
+    }
+
+    /* Resolve and expand the netlist as `qsoc generate` does */
+    QSocBusManager      busManager(nullptr, &projectManager);
+    QSocModuleManager   moduleManager(nullptr, &projectManager, &busManager);
+    QSoCGenerateManager generateManager(nullptr, &projectManager, &moduleManager, &busManager);
+    if (!moduleManager.load(QRegularExpression(".*"))
+        || !busManager.load(QRegularExpression(".*"))) {
+        ui->statusbar->showMessage(tr("Failed to load the libraries of the project"));
+        return false;
+    }
+    if (!generateManager.loadNetlist(netlistFilePath) || !generateManager.processNetlist()) {
+        ui->statusbar->showMessage(tr("Failed to load netlist %1").arg(netlistFilePath));
+        return false;
+    }
+
+    /* The graph is copied before the managers go away */
+    showNetlist(generateManager.getNetlistGraph());
+    setWindowFilePath(netlistFilePath);
+    ui->statusbar->showMessage(
+        tr("Opened netlist %1").arg(QFileInfo(netlistFilePath).fileName()));
+    return true;
+}
+
+void SchematicWindow::setLibrary(const QSocProjectLoader::SnapshotPointer &snapshot)
+{
+    library = snapshot;
+
+    /* One batch for the whole list, sorting is done by the loader */
+    ui->listWidgetModuleList->setUpdatesEnabled(false);
+    ui->listWidgetModuleList->clear();
+    if (library) {
+        ui->listWidgetModuleList->addItems(library->modules);
+    }
+    ui->listWidgetModuleList->setUpdatesEnabled(true);
+}
+
+void SchematicWindow::populateScene(const std::shared_ptr<const QSocSchematicLayout> &layout)
+{
+    const int gridSize = settings.gridSize;
+    netlistLayout      = layout;
+
+    /* Build every item before the scene sees any of them */
+    const std::vector<QSocSchematicLayout::Wire>         &wires = layout->getWires();
+    std::vector<std::shared_ptr<QSchematic::Items::Item>> items;
+    items.reserve(layout->getNodes().size() + wires.size());
+    for (const QSocSchematicLayout::Node &node : layout->getNodes()) {
+        auto item = std::make_shared<SchematicNode>(
+            QString::fromStdString(node.name), QString::fromStdString(node.module), gridSize);
+        item->setSize(node.width * gridSize, node.height * gridSize);
+        item->setPos(node.x * gridSize, node.y * gridSize);
+        for (const QSocSchematicLayout::Port &port : node.ports) {
+            item->addPort(
+                QPoint(port.right ? node.width : 0, port.offset),
+                QString::fromStdString(port.name),
+                port.right);
+        }
+        items.push_back(std::move(item));
+    }
+    for (size_t index = 0; index < wires.size(); index++) {
+        const QSocSchematicLayout::Wire &wire = wires[index];
+        if (wire.points.size() < 2) {
+            continue;
+        }
+        QPolygonF scenePoints;
+        for (const QSocSchematicLayout::Point &point : wire.points) {
+            scenePoints.append(QPointF(point.x * gridSize, point.y * gridSize));
+        }
+        auto item = std::make_shared<SchematicWire>();
+        for (const QPointF &point : scenePoints) {
+            item->append_point(point);
+        }
+        /* Bundles weigh their wires by width, so buses draw thicker */
+        const int bits = std::max(wire.width, 1);
+        item->setBundle(
+            scenePoints, wire.bundle == static_cast<int>(index), wire.bundleSize * bits);
+        items.push_back(std::move(item));
+    }
+
+    /* Insert without maintaining the index, then index the scene once */
+    ui->schematicView->setUpdatesEnabled(false);
+    scene.clear();
+    scene.undoStack()->clear();
+    scene.setItemIndexMethod(QGraphicsScene::NoIndex);
+    for (const std::shared_ptr<QSchematic::Items::Item> &item : items) {
+        scene.addItem(item);
+    }
+    scene.setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+
+    const int margin = kSceneMargin * gridSize;
+    scene.setSceneRect(scene.itemsBoundingRect().adjusted(-margin, -margin, margin, margin));
+    ui->schematicView->setUpdatesEnabled(true);
+    ui->schematicView->fitInView(scene.sceneRect(), Qt::KeepAspectRatio);
+}
+
+bool SchematicWindow::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() == QEvent::MouseMove && netlistLayout) {
+        const auto   *mouseEvent = static_cast<QMouseEvent *>(event);
+        const QPointF scenePos   = ui->schematicView->mapToScene(mouseEvent->pos());
+        showItemAt(scenePos);
+    }
+    return QMainWindow::eventFilter(watched, event);
+}
+
+void SchematicWindow::showItemAt(const QPointF &scenePos)
+{
+    /* Hit-test in grid units against the R-trees of the layout */
+    const qreal gridSize = settings.gridSize;
+    const int   column   = static_cast<int>(std::lround(scenePos.x() / gridSize));
+    const int   row      = static_cast<int>(std::lround(scenePos.y() / gridSize));
+
+    std::vector<int> hits;
+    netlistLayout->getNodeIndex().query({column, row, column, row}, hits);
+    if (!hits.empty()) {
+        const QSocSchematicLayout::Node &node = netlistLayout->getNodes()[hits.front()];
+        ui->statusbar->showMessage(
+            tr("Instance %1 : %2")
+                .arg(QString::fromStdString(node.name), QString::fromStdString(node.module)));
+        return;
+    }
+    netlistLayout->getWireIndex().query({column, row, column, row}, hits);
+    if (!hits.empty()) {
+        const QSocSchematicLayout::Wire &wire = netlistLayout->getWires()[hits.front()];
+        ui->statusbar->showMessage(
+            tr("Net %1").arg(QString::fromStdString(netlistLayout->getNetName(wire.net))));
+        return;
+    }
+    ui->statusbar->clearMessage();
+}
@@ -1,7 +1,15 @@
 #ifndef SCHEMATICWINDOW_H
 #define SCHEMATICWINDOW_H
 
+#include "common/qsocnetlistgraph.h"
+#include "common/qsocprojectloader.h"
+#include "common/qsocschematiclayout.h"
+
 #include <QMainWindow>
+#include <QPointF>
+#include <QThreadPool>
+
+#include <memory>
 
 #include <qschematic/scene.hpp>
 #include <qschematic/settings.hpp>
@@ -35,7 +43,59 @@ public:
      */
     ~SchematicWindow();
 
+    /**
+     * @brief Show a netlist.
+     * @details This function replaces the schematic with the instances and
+     *          nets of a netlist. Instances and nets are copied out of the
+     *          graph right away, placement and routing run on a worker
+     *          thread, and the scene is filled in one batch when they are
+     *          done. Showing another netlist before that drops the earlier
+     *          one.
+     * @param[in] graph built connectivity graph, see
+     *            QSoCGenerateManager::getNetlistGraph()
+     */
+    void showNetlist(const QSocNetlistGraph &graph);
+
+    /**
+     * @brief Open a netlist file.
+     * @details This function loads the project of the shown libraries, or
+     *          the first project in the working directory before any were
+     *          shown, with all of its module and bus libraries. The netlist
+     *          is then loaded and expanded by QSoCGenerateManager and shown
+     *          with showNetlist(). The outcome is shown in the status bar.
+     * @param[in] netlistFilePath path of the netlist file
+     * @retval true netlist opened, its layout is on the way
+     * @retval false project, libraries or netlist failed to load
+     */
+    bool openNetlist(const QString &netlistFilePath);
+
+    /**
+     * @brief Show the libraries of a project.
+     * @details This function lists the modules of a loaded project in the
+     *          module list. The snapshot is kept, it is never changed.
+     * @param[in] snapshot loaded project, see QSocProjectLoader::loaded()
+     */
+    void setLibrary(const QSocProjectLoader::SnapshotPointer &snapshot);
+
+protected:
+    /**
+     * @brief Filter events of the schematic view.
+     * @details This function follows the mouse over the view to name the
+     *          instance or net under the cursor.
+     * @param[in] watched watched object
+     * @param[in] event event
+     * @return bool result of QMainWindow::eventFilter(), events are never
+     *         consumed
+     */
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
 private slots:
+    /**
+     * @brief Open netlist file.
+     * @details This function asks for a netlist file and opens it.
+     */
+    void on_actionOpen_triggered();
+
     /**
      * @brief Print schematic file.
      * @details This function will print the schematic file.
@@ -89,5 +149,33 @@ private:
 
     /* Schematic settings. */
     QSchematic::Settings settings;
+
+    /* Worker thread of the schematic layout. */
+    QThreadPool layoutThreadPool;
+
+    /* Number of the latest layout request, older results are dropped. */
+    quint64 layoutGeneration = 0;
+
+    /* Libraries of the loaded project. */
+    QSocProjectLoader::SnapshotPointer library;
+
+    /* Layout of the shown netlist, used for hit-testing. */
+    std::shared_ptr<const QSocSchematicLayout> netlistLayout;
+
+    /**
+     * @brief Fill the scene with a finished layout.
+     * @details This function builds all items first, then inserts them with
+     *          the scene index disabled and indexes the scene once.
+     * @param[in] layout placed and routed netlist
+     */
+    void populateScene(const std::shared_ptr<const QSocSchematicLayout> &layout);
+
+    /**
+     * @brief Show the item at a scene position in the status bar.
+     * @details This function looks the position up in the spatial indexes
+     *          of the layout, without asking the scene.
+     * @param[in] scenePos scene position
+     */
+    void showItemAt(const QPointF &scenePos);
 };
 #endif // SCHEMATICWINDOW_H
@@ -2,6 +2,8 @@
 
 #include "./ui_schematicwindow.h"
 
+#include <QDir>
+#include <QFileDialog>
 #include <QIcon>
 #include <QPrintDialog>
 #include <QPrinter>
@@ -47,6 +49,16 @@ void SchematicWindow::on_actionRedo_triggered()
     }
 }
 
+void SchematicWindow::on_actionOpen_triggered()
+{
+    const QString startPath       = library ? library->projectPath : QDir::currentPath();
+    const QString netlistFilePath = QFileDialog::getOpenFileName(
+        this, tr("Open Netlist"), startPath, tr("Netlist files (*.soc_net);;All files (*)"));
+    if (!netlistFilePath.isEmpty()) {
+        openNetlist(netlistFilePath);
+    }
+}
+
 void SchematicWindow::on_actionPrint_triggered()
 {
     QPrinter printer(QPrinter::HighResolution);
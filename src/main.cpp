@@ -1,10 +1,13 @@
 #include "cli/qsoccliworker.h"
 #include "common/qstaticicontheme.h"
 #include "common/qstaticlog.h"
+#include "common/qstaticmetrics.h"
+#include "common/qstatictrace.h"
 #include "common/qstatictranslator.h"
 #include "gui/mainwindow/mainwindow.h"
 
 #include <QApplication>
+#include <QDebug>
 
 bool isGui(int &argc, char *argv[])
 {
@@ -35,5 +38,15 @@ int main(int argc, char *argv[])
         socCliWorker.setup(app.arguments(), false);
         result = app.exec();
     }
+    /* Report metrics, write the trace, then the queued log file lines, before exit */
+    if (!QStaticMetrics::stop()) {
+        qCritical() << "Error: failed to write metrics file.";
+        result = 1;
+    }
+    if (!QStaticTrace::stop()) {
+        qCritical() << "Error: failed to write trace file.";
+        result = 1;
+    }
+    QStaticLog::setFile(QString());
     return result;
 }
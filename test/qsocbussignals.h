@@ -0,0 +1,138 @@
+#ifndef QSOCBUSSIGNALS_H
+#define QSOCBUSSIGNALS_H
+
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief Signal names of common buses.
+ * @details Shared by the string weaver test and benchmark, so both match
+ *          ports against the same corpora.
+ */
+namespace QSocBusSignals {
+/* AMBA APB signals */
+inline const QVector<QString> kApbSignals = {
+    "paddr",
+    "psel",
+    "penable",
+    "pwrite",
+    "pwdata",
+    "prdata",
+    "pready",
+    "pslverr",
+    "pprot",
+    "pstrb"};
+
+/* AMBA AHB signals */
+inline const QVector<QString> kAhbSignals = {
+    "hsel",
+    "haddr",
+    "htrans",
+    "hsize",
+    "hburst",
+    "hprot",
+    "hwrite",
+    "hwdata",
+    "hrdata",
+    "hready",
+    "hreadyout",
+    "hresp",
+    "hmastlock"};
+
+/* AMBA AXI4 signals */
+inline const QVector<QString> kAxi4Signals = {
+    "awid",
+    "awaddr",
+    "awlen",
+    "awsize",
+    "awburst",
+    "awlock",
+    "awcache",
+    "awprot",
+    "awqos",
+    "awregion",
+    "awvalid",
+    "awready",
+    "wdata",
+    "wstrb",
+    "wlast",
+    "wvalid",
+    "wready",
+    "bid",
+    "bresp",
+    "bvalid",
+    "bready",
+    "arid",
+    "araddr",
+    "arlen",
+    "arsize",
+    "arburst",
+    "arlock",
+    "arcache",
+    "arprot",
+    "arqos",
+    "arregion",
+    "arvalid",
+    "arready",
+    "rid",
+    "rdata",
+    "rresp",
+    "rlast",
+    "rvalid",
+    "rready"};
+
+/* AMBA CHI link signals of a request node */
+inline const QVector<QString> kChiSignals = {
+    "txsactive",
+    "rxsactive",
+    "txlinkactivereq",
+    "txlinkactiveack",
+    "rxlinkactivereq",
+    "rxlinkactiveack",
+    "txreqflitpend",
+    "txreqflitv",
+    "txreqflit",
+    "txreqlcrdv",
+    "rxrspflitpend",
+    "rxrspflitv",
+    "rxrspflit",
+    "rxrsplcrdv",
+    "rxdatflitpend",
+    "rxdatflitv",
+    "rxdatflit",
+    "rxdatlcrdv",
+    "txdatflitpend",
+    "txdatflitv",
+    "txdatflit",
+    "txdatlcrdv",
+    "rxsnpflitpend",
+    "rxsnpflitv",
+    "rxsnpflit",
+    "rxsnplcrdv",
+    "txrspflitpend",
+    "txrspflitv",
+    "txrspflit",
+    "txrsplcrdv"};
+
+/* DFI signals of a DDR PHY, without the dfi_ prefix */
+inline const QVector<QString> kDfiSignals = {
+    "address",
+    "bank",
+    "ras_n",
+    "cas_n",
+    "we_n",
+    "cs_n",
+    "cke",
+    "odt",
+    "reset_n",
+    "wrdata",
+    "wrdata_en",
+    "wrdata_mask",
+    "rddata",
+    "rddata_en",
+    "rddata_valid",
+    "init_start",
+    "init_complete"};
+} // namespace QSocBusSignals
+
+#endif // QSOCBUSSIGNALS_H
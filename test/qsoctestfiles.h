@@ -0,0 +1,38 @@
+#ifndef QSOCTESTFILES_H
+#define QSOCTESTFILES_H
+
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QString>
+
+/**
+ * @brief File helpers of the unit tests.
+ * @details Shared by the tests that lay out projects, libraries and file
+ *          lists on disk before running the code under test.
+ */
+namespace QSocTestFiles {
+/**
+ * @brief Write a text file.
+ * @details Creates the parent directories and replaces an existing file.
+ * @param filePath The file path.
+ * @param text The content, written as UTF-8.
+ * @retval true The file was written in full.
+ * @retval false The file could not be written.
+ */
+inline bool writeText(const QString &filePath, const QString &text)
+{
+    if (!QDir().mkpath(QFileInfo(filePath).absolutePath())) {
+        return false;
+    }
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    const QByteArray data = text.toUtf8();
+    return file.write(data) == data.size();
+}
+} // namespace QSocTestFiles
+
+#endif // QSOCTESTFILES_H
@@ -1,11 +1,70 @@
+#include "common/qslangdriver.h"
+#include "qsoctestfiles.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtCore>
 #include <QtTest>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace QSocTestFiles;
+
+namespace {
+/* Parses of each driver in the concurrent test */
+constexpr int kConcurrentParses = 20;
+} // namespace
+
 class Test : public QObject
 {
     Q_OBJECT
 
 private slots:
     void parseArgs() {};
+
+    void concurrentDrivers()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const QStringList modules = {"left_top", "right_top"};
+        QStringList       filePaths;
+        for (const QString &module : modules) {
+            filePaths.append(tempDir.filePath(module + ".sv"));
+            const QString text = "`define WIDTH 4\nmodule " + module
+                                 + "(input logic [`WIDTH-1:0] a);\nendmodule\n";
+            QVERIFY(writeText(filePaths.last(), text));
+        }
+
+        /* Each driver sees its own sources while another one fails on its command line */
+        std::atomic<int>         mismatches{0};
+        std::vector<std::thread> threads;
+        for (qsizetype index = 0; index < modules.size(); index++) {
+            threads.emplace_back([&, index]() {
+                for (int parse = 0; parse < kConcurrentParses; parse++) {
+                    QSlangDriver driver;
+                    if (!driver.parseFileList(QString(), {filePaths.at(index)})
+                        || driver.getModuleList() != QStringList{modules.at(index)}) {
+                        mismatches++;
+                    }
+                }
+            });
+        }
+        threads.emplace_back([&]() {
+            for (int parse = 0; parse < kConcurrentParses; parse++) {
+                QSlangDriver driver;
+                if (driver.parseArgs(QStringList{"--no-such-option"})) {
+                    mismatches++;
+                }
+            }
+        });
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        QCOMPARE(mismatches.load(), 0);
+    }
 };
 
 QTEST_APPLESS_MAIN(Test)
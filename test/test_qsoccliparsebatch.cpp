@@ -0,0 +1,166 @@
+#include "cli/qsoccliworker.h"
+#include "common/config.h"
+#include "common/qstaticyamlcache.h"
+#include "qsoctestfiles.h"
+
+#include <QDir>
+#include <QFile>
+#include <QSignalSpy>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QtCore>
+#include <QtTest>
+
+#include <yaml-cpp/yaml.h>
+
+using namespace QSocTestFiles;
+
+struct TestApp
+{
+    static auto &instance()
+    {
+        static auto                  argc      = 1;
+        static char                  appName[] = "qsoc";
+        static std::array<char *, 1> argv      = {{appName}};
+        /* Use QCoreApplication for cli test */
+        static const QCoreApplication app = QCoreApplication(argc, argv.data());
+        return app;
+    }
+};
+
+namespace {
+/* Bus definition imported by the scripts */
+const char *kBusCsv = "name,mode,direction,width,qualifier,description\n"
+                      "psel,master,output,1,,Select\n"
+                      "psel,slave,input,1,,Select\n"
+                      "pready,master,input,1,,Ready\n"
+                      "pready,slave,output,1,,Ready\n";
+
+/* Import, a line that fails, then another import into the same library */
+const char *kFailingScript = "# Failing line in the middle\n"
+                             "project create batch_project\n"
+                             "qsoc bus import -l batch_lib -b alpha_bus bus.csv\n"
+                             "no_such_command\n"
+                             "bus import -l batch_lib -b beta_bus bus.csv\n";
+
+/* Two imports into one library, then a list that reads the pending library */
+const char *kDeferredScript = "project create batch_project\n"
+                              "bus import -l batch_lib -b alpha_bus bus.csv\n"
+                              "\n"
+                              "bus import -l batch_lib -b beta_bus bus.csv\n"
+                              "bus list -l batch_lib\n";
+
+/* Buses of a library file on disk */
+QStringList libraryBuses(const QString &filePath)
+{
+    QStringList result;
+    if (!QFile::exists(filePath)) {
+        return result;
+    }
+    for (const auto &busPair : YAML::LoadFile(filePath.toStdString())) {
+        result.append(QString::fromStdString(busPair.first.as<std::string>()));
+    }
+    result.sort();
+    return result;
+}
+} // namespace
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private:
+    static QStringList messageList;
+    static void messageOutput(QtMsgType type, const QMessageLogContext &context, const QString &msg)
+    {
+        Q_UNUSED(type);
+        Q_UNUSED(context);
+        messageList << msg;
+    }
+
+    QTemporaryDir tempDir;
+
+    /* Run a batch script in a fresh project directory, return the exit code */
+    int runBatch(const QString &name, const char *script, const QStringList &options = {})
+    {
+        const QString workPath = tempDir.filePath(name);
+        if (!QDir().mkpath(workPath) || !QDir::setCurrent(workPath)
+            || !writeText("bus.csv", kBusCsv) || !writeText("script.qsoc", script)) {
+            return -1;
+        }
+
+        messageList.clear();
+        QSocCliWorker socCliWorker;
+        QSignalSpy    exitSpy(&socCliWorker, &QSocCliWorker::exit);
+        socCliWorker.setup(QStringList{"qsoc", "batch"} + options + QStringList{"script.qsoc"});
+        socCliWorker.run();
+        return exitSpy.isEmpty() ? -1 : exitSpy.first().first().toInt();
+    }
+
+    static bool hasMessage(const QString &text)
+    {
+        for (const QString &msg : messageList) {
+            if (msg.contains(text)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private slots:
+    void initTestCase()
+    {
+        TestApp::instance();
+        qInstallMessageHandler(messageOutput);
+        QVERIFY(tempDir.isValid());
+    }
+
+    void stopAtFailure()
+    {
+        QCOMPARE(runBatch("stop", kFailingScript), 1);
+        QVERIFY(hasMessage("Error: command at line 4 failed: no_such_command"));
+
+        /* Commands before the failure keep their effect, the ones after it do not run */
+        QCOMPARE(libraryBuses("bus/batch_lib.soc_bus"), QStringList{"alpha_bus"});
+        QVERIFY(!QStaticYamlCache::isDeferred());
+    }
+
+    void keepGoing()
+    {
+        QCOMPARE(runBatch("keep_going", kFailingScript, {"--keep-going"}), 1);
+        QVERIFY(hasMessage("Error: command at line 4 failed: no_such_command"));
+        QVERIFY(hasMessage("Error: 1 batch command(s) failed."));
+
+        /* The command after the failure ran */
+        const QStringList expected = {"alpha_bus", "beta_bus"};
+        QCOMPARE(libraryBuses("bus/batch_lib.soc_bus"), expected);
+    }
+
+    void deferredWrites()
+    {
+        QCOMPARE(runBatch("deferred", kDeferredScript), 0);
+
+        /* The list saw both buses before the library was written */
+        QVERIFY(hasMessage("alpha_bus\nbeta_bus"));
+
+        /* The library is written once at the end, with both imports */
+        const QStringList expected = {"alpha_bus", "beta_bus"};
+        QCOMPARE(libraryBuses("bus/batch_lib.soc_bus"), expected);
+        QVERIFY(QFile::exists("batch_project.soc_pro"));
+        QVERIFY(!QStaticYamlCache::isDeferred());
+    }
+
+    void tooManyScripts()
+    {
+        QCOMPARE(runBatch("too_many", "", {"other_script.qsoc"}), 1);
+        QVERIFY(hasMessage("Error: too many script files."));
+    }
+
+    void cleanupTestCase() { QDir::setCurrent(QDir::tempPath()); }
+};
+
+QStringList Test::messageList;
+
+QTEST_APPLESS_MAIN(Test)
+
+#include "test_qsoccliparsebatch.moc"
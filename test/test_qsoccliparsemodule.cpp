@@ -0,0 +1,194 @@
+#include "cli/qsoccliworker.h"
+#include "common/config.h"
+#include "qsoctestfiles.h"
+
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QtCore>
+#include <QtTest>
+
+using namespace QSocTestFiles;
+
+struct TestApp
+{
+    static auto &instance()
+    {
+        static auto                  argc      = 1;
+        static char                  appName[] = "qsoc";
+        static std::array<char *, 1> argv      = {{appName}};
+        /* Use QCoreApplication for cli test */
+        static const QCoreApplication app = QCoreApplication(argc, argv.data());
+        return app;
+    }
+};
+
+namespace {
+/* Content of a text file, empty if it does not exist */
+QString readText(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return QString();
+    }
+    return QString::fromUtf8(file.readAll());
+}
+} // namespace
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private:
+    static QStringList messageList;
+    static void messageOutput(QtMsgType type, const QMessageLogContext &context, const QString &msg)
+    {
+        Q_UNUSED(type);
+        Q_UNUSED(context);
+        messageList << msg;
+    }
+
+    QTemporaryDir tempDir;
+
+    /* Run a command in the project directory, return the exit code */
+    static int runCommand(const QStringList &appArguments)
+    {
+        messageList.clear();
+        QSocCliWorker socCliWorker;
+        QSignalSpy    exitSpy(&socCliWorker, &QSocCliWorker::exit);
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+        return exitSpy.isEmpty() ? -1 : exitSpy.first().first().toInt();
+    }
+
+    /* Import source files into a library, return the library text or empty on failure */
+    QString importLibrary(const QString &libraryName, int jobs, const QStringList &filePaths)
+    {
+        const QStringList appArguments
+            = QStringList{"qsoc", "module", "import", "-l", libraryName}
+              + QStringList{"-j", QString::number(jobs)} + filePaths;
+        if (runCommand(appArguments) != 0) {
+            return QString();
+        }
+        return readText(tempDir.filePath("module/" + libraryName + ".soc_mod"));
+    }
+
+private slots:
+    void initTestCase()
+    {
+        TestApp::instance();
+        qInstallMessageHandler(messageOutput);
+        QVERIFY(tempDir.isValid());
+        QVERIFY(QDir::setCurrent(tempDir.path()));
+        QCOMPARE(runCommand({"qsoc", "project", "create", "module_project"}), 0);
+    }
+
+    void importJobs_data()
+    {
+        QTest::addColumn<QStringList>("fileNames");
+        QTest::addColumn<QStringList>("contents");
+
+        QTest::newRow("independent")
+            << QStringList{"a.sv", "b.sv", "c.sv"}
+            << QStringList{
+                   "module a(input logic [7:0] x, output logic y); endmodule\n",
+                   "module b #(parameter int W = 4)(input logic [W-1:0] d); endmodule\n",
+                   "module c(output logic [1:0] q); endmodule\n"};
+        QTest::newRow("unit_scope")
+            << QStringList{"types.sv", "a.sv", "b.sv"}
+            << QStringList{
+                   "typedef logic [7:0] byte_t;\nparameter int UNIT_W = 3;\n",
+                   "module a(input byte_t x, output logic [UNIT_W-1:0] y); endmodule\n",
+                   "module b(output logic z); endmodule\n"};
+        QTest::newRow("timescale")
+            << QStringList{"a.sv", "b.sv", "c.sv"}
+            << QStringList{
+                   "`timescale 1ns/1ps\nmodule a(input logic x); endmodule\n",
+                   "module b(input logic y); endmodule\n",
+                   "`timescale 1ps/1ps\nmodule c(input logic z); endmodule\n"};
+        QTest::newRow("macros")
+            << QStringList{"a.sv", "b.sv", "c.sv"}
+            << QStringList{
+                   "`define WIDTH 6\nmodule a(input logic [`WIDTH-1:0] x); endmodule\n",
+                   "module b(input logic [`WIDTH-1:0] y); endmodule\n",
+                   "module c(input logic z); endmodule\n"};
+        QTest::newRow("package")
+            << QStringList{"p.sv", "a.sv", "b.sv"}
+            << QStringList{
+                   "package p;\n  parameter int PW = 5;\nendpackage\n",
+                   "module a import p::*; (input logic [PW-1:0] x); endmodule\n",
+                   "module b(input logic y); endmodule\n"};
+    }
+
+    void importJobs()
+    {
+        QFETCH(QStringList, fileNames);
+        QFETCH(QStringList, contents);
+
+        const QString tag = QTest::currentDataTag();
+        QVERIFY(QDir().mkpath(tempDir.filePath(tag)));
+        QStringList filePaths;
+        for (qsizetype index = 0; index < fileNames.size(); index++) {
+            filePaths.append(QDir(tempDir.filePath(tag)).filePath(fileNames.at(index)));
+            QVERIFY(writeText(filePaths.last(), contents.at(index)));
+        }
+
+        /* One compilation unit, then files split over threads */
+        const QString singleResult = importLibrary(tag + "_j1", 1, filePaths);
+        const QString multiResult  = importLibrary(tag + "_j4", 4, filePaths);
+        QVERIFY(!singleResult.isEmpty());
+        QCOMPARE(multiResult, singleResult);
+    }
+
+    void importDiagnostics()
+    {
+        const QString badPath  = tempDir.filePath("diagnostics/bad.sv");
+        const QString goodPath = tempDir.filePath("diagnostics/good.sv");
+        QVERIFY(QDir().mkpath(tempDir.filePath("diagnostics")));
+        QVERIFY(writeText(
+            badPath,
+            "module bad(input logic a, output logic y);\n"
+            "  assign y = a & missing;\n"
+            "endmodule\n"));
+        QVERIFY(writeText(goodPath, "module good(input logic a, output logic y);\nendmodule\n"));
+
+        /* Diagnostics are written when the import fails */
+        const QString badReport = tempDir.filePath("diagnostics/bad.json");
+        const QStringList importCommand = {"qsoc", "module", "import", "--diagnostics"};
+        QCOMPARE(runCommand(importCommand + QStringList{badReport, "-l", "bad_lib", badPath}), 1);
+        const QJsonObject bad = QJsonDocument::fromJson(readText(badReport).toUtf8()).object();
+        QCOMPARE(bad.value("errors").toInt(), 1);
+        QCOMPARE(bad.value("warnings").toInt(), 0);
+        const QJsonArray badRecords = bad.value("diagnostics").toArray();
+        QCOMPARE(badRecords.size(), 1);
+        const QJsonObject record = badRecords.first().toObject();
+        QVERIFY(record.value("file").toString().endsWith("bad.sv"));
+        QCOMPARE(record.value("line").toInt(), 2);
+        QVERIFY(record.value("column").toInt() > 0);
+        QCOMPARE(record.value("severity").toString(), QString("error"));
+        QCOMPARE(record.value("code").toString(), QString("UndeclaredIdentifier"));
+        QVERIFY(record.value("message").toString().contains("missing"));
+
+        /* A clean import writes an empty report */
+        const QString goodReport = tempDir.filePath("diagnostics/good.json");
+        QCOMPARE(runCommand(importCommand + QStringList{goodReport, "-l", "ok_lib", goodPath}), 0);
+        const QJsonObject good = QJsonDocument::fromJson(readText(goodReport).toUtf8()).object();
+        QCOMPARE(good.value("errors").toInt(), 0);
+        QCOMPARE(good.value("warnings").toInt(), 0);
+        QVERIFY(good.value("diagnostics").isArray());
+        QVERIFY(good.value("diagnostics").toArray().isEmpty());
+    }
+
+    void cleanupTestCase() { QDir::setCurrent(QDir::tempPath()); }
+};
+
+QStringList Test::messageList;
+
+QTEST_APPLESS_MAIN(Test)
+
+#include "test_qsoccliparsemodule.moc"
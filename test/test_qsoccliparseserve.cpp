@@ -0,0 +1,172 @@
+#include "cli/qsoccliserver.h"
+#include "cli/qsoccliworker.h"
+#include "common/config.h"
+
+#include <QDir>
+#include <QEventLoop>
+#include <QFile>
+#include <QMutex>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QtCore>
+#include <QtTest>
+
+struct TestApp
+{
+    static auto &instance()
+    {
+        static auto                  argc      = 1;
+        static char                  appName[] = "qsoc";
+        static std::array<char *, 1> argv      = {{appName}};
+        /* Use QCoreApplication for cli test */
+        static const QCoreApplication app = QCoreApplication(argc, argv.data());
+        return app;
+    }
+};
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private:
+    static QStringList messageList;
+    static QMutex      messageMutex;
+    static void messageOutput(QtMsgType type, const QMessageLogContext &context, const QString &msg)
+    {
+        Q_UNUSED(type);
+        Q_UNUSED(context);
+        const QMutexLocker locker(&messageMutex);
+        messageList << msg;
+    }
+
+    QTemporaryDir tempDir;
+    QSocCliServer server;
+
+    /* Forward a command from a client thread while this thread serves it */
+    static bool forward(const QStringList &appArguments, int &exitCode)
+    {
+        messageList.clear();
+        bool      forwarded = false;
+        QThread  *client    = QThread::create(
+            [&]() { forwarded = QSocCliServer::forward(appArguments, exitCode); });
+        QEventLoop loop;
+        connect(client, &QThread::finished, &loop, &QEventLoop::quit);
+        client->start();
+        loop.exec();
+        client->wait();
+        delete client;
+        return forwarded;
+    }
+
+    static bool hasMessage(const QString &text)
+    {
+        const QMutexLocker locker(&messageMutex);
+        for (const QString &msg : messageList) {
+            if (msg.contains(text)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private slots:
+    void initTestCase()
+    {
+        TestApp::instance();
+        qInstallMessageHandler(messageOutput);
+        QVERIFY(tempDir.isValid());
+        QVERIFY(QDir::setCurrent(tempDir.path()));
+
+        /* Clients find the server through the environment */
+        const QString serverName = QString("qsoc_test_%1").arg(QCoreApplication::applicationPid());
+        QVERIFY(server.listen(serverName));
+        qputenv("QSOC_SERVER", serverName.toLocal8Bit());
+    }
+
+    void forwardCommand()
+    {
+        int exitCode = -1;
+        QVERIFY(forward({"qsoc", "--version"}, exitCode));
+        QCOMPARE(exitCode, 0);
+        QVERIFY(hasMessage(QCoreApplication::applicationName()));
+    }
+
+    void forwardFailure()
+    {
+        int exitCode = -1;
+        QVERIFY(forward({"qsoc", "no_such_command"}, exitCode));
+        QCOMPARE(exitCode, 1);
+        QVERIFY(hasMessage("Error: unknown subcommand: no_such_command."));
+    }
+
+    void forwardArgumentNamedLikeLocalCommand()
+    {
+        /* Only the subcommand decides, a project may be named batch */
+        int exitCode = -1;
+        QVERIFY(forward({"qsoc", "--verbose", "3", "project", "create", "batch"}, exitCode));
+        QCOMPARE(exitCode, 0);
+        QVERIFY(QFile::exists(tempDir.filePath("batch.soc_pro")));
+    }
+
+    void listenTwice()
+    {
+        /* A second server on the same name fails, the first one stays reachable */
+        QSocCliServer second;
+        QVERIFY(!second.listen(qEnvironmentVariable("QSOC_SERVER")));
+        QVERIFY(second.errorString().contains("already running"));
+        int exitCode = -1;
+        QVERIFY(forward({"qsoc", "--version"}, exitCode));
+        QCOMPARE(exitCode, 0);
+    }
+
+    void listenStale()
+    {
+        /* A socket file nobody answers on is left by a crash and replaced */
+        const QString socketPath = tempDir.filePath("stale.sock");
+        QFile         staleFile(socketPath);
+        QVERIFY(staleFile.open(QIODevice::WriteOnly));
+        staleFile.close();
+        QSocCliServer staleServer;
+        QVERIFY(staleServer.listen(socketPath));
+    }
+
+    void localCommands_data()
+    {
+        QTest::addColumn<QStringList>("appArguments");
+
+        QTest::newRow("gui") << QStringList{"qsoc", "gui"};
+        QTest::newRow("batch") << QStringList{"qsoc", "batch", "script.qsoc"};
+        QTest::newRow("batch after option") << QStringList{"qsoc", "--verbose", "3", "batch"};
+        QTest::newRow("serve") << QStringList{"qsoc", "--", "serve"};
+
+        /* Process wide options are refused inside a session, they run here */
+        QTest::newRow("stats") << QStringList{"qsoc", "--stats", "--version"};
+        QTest::newRow("stats json") << QStringList{"qsoc", "--stats-json", "s.json", "--version"};
+        QTest::newRow("trace") << QStringList{"qsoc", "--trace", "t.json", "project", "list"};
+        QTest::newRow("log file after subcommand")
+            << QStringList{"qsoc", "project", "list", "--log-file=qsoc.log"};
+    }
+
+    void localCommands()
+    {
+        QFETCH(QStringList, appArguments);
+
+        int exitCode = -1;
+        QVERIFY(!forward(appArguments, exitCode));
+        QCOMPARE(exitCode, -1);
+    }
+
+    void cleanupTestCase()
+    {
+        qunsetenv("QSOC_SERVER");
+        QDir::setCurrent(QDir::tempPath());
+    }
+};
+
+QStringList Test::messageList;
+QMutex      Test::messageMutex;
+
+QTEST_APPLESS_MAIN(Test)
+
+#include "test_qsoccliparseserve.moc"
@@ -1,5 +1,8 @@
 #include "cli/qsoccliworker.h"
 #include "common/config.h"
+#include "common/qstaticlog.h"
+#include "common/qstaticmetrics.h"
+#include "common/qstatictrace.h"
 
 #include <QStringList>
 #include <QtCore>
@@ -85,6 +88,116 @@ private slots:
         QVERIFY(messageList.first().contains("Error: invalid log level: 10"));
     }
 
+    void optionLogFile()
+    {
+        messageList.clear();
+        QTemporaryDir     tempDir;
+        const QString     logFilePath = tempDir.filePath("qsoc.log");
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments = {
+            "qsoc",
+            "--verbose=5",
+            "--log-file=" + logFilePath,
+            "gui",
+        };
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+        /* Closing the log file writes the queued lines */
+        QStaticLog::setFile(QString());
+        QStaticLog::setLevel(QStaticLog::Level::Error);
+        QFile logFile(logFilePath);
+        QVERIFY(logFile.open(QIODevice::ReadOnly | QIODevice::Text));
+        const QString content = QString::fromUtf8(logFile.readAll());
+        QVERIFY(content.contains("[V]"));
+        QVERIFY(content.contains("Starting GUI ..."));
+    }
+
+    void optionStatsJson()
+    {
+        messageList.clear();
+        QTemporaryDir     tempDir;
+        const QString     statsFilePath = tempDir.filePath("stats.json");
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments = {
+            "qsoc",
+            "--stats-json=" + statsFilePath,
+            "gui",
+        };
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+        QVERIFY(QStaticMetrics::stop());
+        QFile statsFile(statsFilePath);
+        QVERIFY(statsFile.open(QIODevice::ReadOnly));
+        const QJsonObject stats = QJsonDocument::fromJson(statsFile.readAll()).object();
+        /* Every registered metric is exported, touched or not */
+        QVERIFY(stats.value("counters").toObject().contains("yaml.bytes.read"));
+        QVERIFY(stats.value("gauges").toObject().contains("yaml.cache.entries"));
+        QVERIFY(stats.value("histograms").toObject().contains("llm.request.ms"));
+    }
+
+    void optionTrace()
+    {
+        messageList.clear();
+        QTemporaryDir tempDir;
+        const QString traceFilePath = tempDir.filePath("trace.json");
+        {
+            QSocCliWorker     socCliWorker;
+            const QStringList appArguments
+                = {"qsoc", "project", "create", "-d", tempDir.path(), "trace_project"};
+            socCliWorker.setup(appArguments, false);
+            socCliWorker.run();
+        }
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments = {
+            "qsoc",
+            "--trace=" + traceFilePath,
+            "project",
+            "show",
+            "-d",
+            tempDir.path(),
+            "trace_project",
+        };
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+        QVERIFY(QStaticTrace::stop());
+        QFile traceFile(traceFilePath);
+        QVERIFY(traceFile.open(QIODevice::ReadOnly));
+        QJsonParseError   error;
+        const QJsonObject trace = QJsonDocument::fromJson(traceFile.readAll(), &error).object();
+        QCOMPARE(error.error, QJsonParseError::NoError);
+
+        /* Complete events by name */
+        QMap<QString, QJsonObject> spans;
+        for (const QJsonValue &value : trace.value("traceEvents").toArray()) {
+            const QJsonObject event = value.toObject();
+            if (event.value("ph").toString() == "X") {
+                spans.insert(event.value("name").toString(), event);
+            }
+        }
+        QVERIFY(spans.contains("cli.command"));
+        QVERIFY(spans.contains("project.load"));
+        QVERIFY(spans.contains("yaml.load"));
+        const QJsonObject command = spans.value("cli.command");
+        QCOMPARE(command.value("cat").toString(), QString("cli"));
+        QCOMPARE(command.value("args").toObject().value("detail").toString(), QString("project"));
+
+        /* Loading the project runs inside the command, on the same thread,
+           the margin covers adding up times printed in microseconds */
+        const double commandStart = command.value("ts").toDouble();
+        const double commandEnd   = commandStart + command.value("dur").toDouble() + 1e-6;
+        for (const QString &name : {QString("project.load"), QString("yaml.load")}) {
+            const QJsonObject span  = spans.value(name);
+            const double      start = span.value("ts").toDouble();
+            QCOMPARE(span.value("tid").toInt(), command.value("tid").toInt());
+            QVERIFY(start >= commandStart);
+            QVERIFY(start + span.value("dur").toDouble() <= commandEnd);
+        }
+        const QJsonObject project = spans.value("project.load");
+        QCOMPARE(
+            project.value("args").toObject().value("detail").toString(),
+            QString("trace_project"));
+    }
+
     void optionV()
     {
         messageList.clear();
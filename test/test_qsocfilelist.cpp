@@ -0,0 +1,175 @@
+#include "common/qsocfilelist.h"
+#include "qsoctestfiles.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QtCore>
+#include <QtTest>
+
+using namespace QSocTestFiles;
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir tempDir;
+
+    /* Absolute path of an entry below the temporary directory */
+    QString path(const QString &relativePath) const
+    {
+        return QDir::cleanPath(tempDir.filePath(relativePath));
+    }
+
+private slots:
+    void initTestCase() { QVERIFY(tempDir.isValid()); }
+
+    void quotesAndComments()
+    {
+        QSocFileList fileList;
+        QVERIFY(fileList.addText(
+            "a.sv // b.sv\n"
+            "/* c.sv\n"
+            "   d.sv */ \"e f.sv\" \"g\"h.sv\n"
+            "\"i//j.sv\" k/*x*/l.sv /* unterminated m.sv",
+            QDir(tempDir.path())));
+
+        const QStringList expected
+            = {path("a.sv"),
+               path("e f.sv"),
+               path("gh.sv"),
+               path("i/j.sv"),
+               path("k"),
+               path("l.sv")};
+        QCOMPARE(fileList.getSourceFiles(), expected);
+    }
+
+    void variables()
+    {
+        QSocFileList fileList({{"SRC", "src"}, {"EMPTY", ""}, {"Q", "\"q r\""}});
+        QVERIFY(fileList.addText(
+            "${SRC}/a.sv ${UNKNOWN}/b.sv $SRC/c.sv x${EMPTY}y.sv ${Q}.sv ${SRC",
+            QDir(tempDir.path())));
+
+        /* Unknown and malformed references are kept, values are not scanned again */
+        const QStringList expected
+            = {path("src/a.sv"),
+               path("${UNKNOWN}/b.sv"),
+               path("$SRC/c.sv"),
+               path("xy.sv"),
+               path("\"q r\".sv"),
+               path("${SRC")};
+        QCOMPARE(fileList.getSourceFiles(), expected);
+    }
+
+    void pathBases()
+    {
+        QVERIFY(writeText(path("top.f"), "top.sv -f sub/plain.f -F sub/own.f\n"));
+        QVERIFY(writeText(path("sub/plain.f"), "plain.sv +incdir+inc\n"));
+        QVERIFY(writeText(path("sub/own.f"), "own.sv +incdir+inc -f nested.f\n"));
+        QVERIFY(writeText(path("sub/nested.f"), "nested.sv\n"));
+
+        QSocFileList fileList;
+        QVERIFY(fileList.addFileList(path("top.f")));
+
+        /* -f keeps the base of the list naming it, -F uses its own directory */
+        const QStringList expectedFiles
+            = {path("top.sv"), path("plain.sv"), path("sub/own.sv"), path("sub/nested.sv")};
+        QCOMPARE(fileList.getSourceFiles(), expectedFiles);
+        const QStringList expectedDirs = {path("inc"), path("sub/inc")};
+        QCOMPARE(fileList.getIncludeDirs(), expectedDirs);
+    }
+
+    void options()
+    {
+        QSocFileList fileList;
+        QVERIFY(fileList.addText(
+            "+incdir+a+b+ -Ic -I d +define+X+Y=1+ -DZ -D W=2 "
+            "+libext+.v+.sv+ -y lib -v lib/cell.v -unknown +unknown+ top.sv",
+            QDir(tempDir.path())));
+
+        const QStringList includeDirs = {path("a"), path("b"), path("c"), path("d")};
+        QCOMPARE(fileList.getIncludeDirs(), includeDirs);
+        const QStringList defines = {"X", "Y=1", "Z", "W=2"};
+        QCOMPARE(fileList.getDefines(), defines);
+        const QStringList libraryExtensions = {".v", ".sv"};
+        QCOMPARE(fileList.getLibraryExtensions(), libraryExtensions);
+        QCOMPARE(fileList.getLibraryDirs(), QStringList{path("lib")});
+        QCOMPARE(fileList.getLibraryFiles(), QStringList{path("lib/cell.v")});
+        QCOMPARE(fileList.getSourceFiles(), QStringList{path("top.sv")});
+
+        const QStringList arguments
+            = {"+incdir+" + path("a"),
+               "+incdir+" + path("b"),
+               "+incdir+" + path("c"),
+               "+incdir+" + path("d"),
+               "+define+X",
+               "+define+Y=1",
+               "+define+Z",
+               "+define+W=2",
+               "+libext+.v+.sv",
+               "-y",
+               path("lib"),
+               "-v",
+               path("lib/cell.v"),
+               path("top.sv")};
+        QCOMPARE(fileList.toArguments(), arguments);
+        QCOMPARE(fileList.toArguments(false), arguments.mid(0, arguments.size() - 1));
+    }
+
+    void missingArgument()
+    {
+        QSocFileList fileList;
+        QVERIFY(fileList.addText("a.sv a.sv -y", QDir(tempDir.path())));
+        QCOMPARE(fileList.getSourceFiles(), QStringList{path("a.sv")});
+        QVERIFY(fileList.getLibraryDirs().isEmpty());
+
+        /* A nested list that cannot be opened fails the read, later entries still count */
+        QVERIFY(!fileList.addText("-f missing.f b.sv -f", QDir(tempDir.path())));
+        const QStringList expected = {path("a.sv"), path("b.sv")};
+        QCOMPARE(fileList.getSourceFiles(), expected);
+    }
+
+    void selfInclude()
+    {
+        QVERIFY(writeText(path("loop/top.f"), "a.sv -F top.f -F sub/back.f\n"));
+        QVERIFY(writeText(path("loop/sub/back.f"), "-F ../top.f b.sv\n"));
+
+        QSocFileList fileList;
+        QVERIFY(fileList.addFileList(path("loop/top.f")));
+        const QStringList expected = {path("loop/a.sv"), path("loop/sub/b.sv")};
+        QCOMPARE(fileList.getSourceFiles(), expected);
+
+        /* A list may be read again once it is closed */
+        QVERIFY(fileList.addText("-F loop/sub/back.f", QDir(tempDir.path())));
+        QCOMPARE(fileList.getSourceFiles(), expected);
+    }
+
+    void resolve()
+    {
+        QVERIFY(writeText(path("resolve/a.sv"), "module a; endmodule\n"));
+        QVERIFY(QFile::link(path("resolve/a.sv"), path("resolve/link.sv")));
+        QVERIFY(QDir().mkpath(path("resolve/dir.sv")));
+
+        QSocFileList fileList;
+        QVERIFY(fileList.addText(
+            "a.sv missing.sv link.sv dir.sv ../resolve/a.sv", QDir(path("resolve"))));
+        QCOMPARE(fileList.getSourceFiles().size(), 4);
+
+        /* Missing files and directories are dropped, links to files are kept */
+        QCOMPARE(fileList.resolve(), 2);
+        const QStringList expected = {path("resolve/a.sv"), path("resolve/link.sv")};
+        QCOMPARE(fileList.getSourceFiles(), expected);
+
+        /* Dropped files may be added again */
+        QVERIFY(fileList.addText("missing.sv", QDir(path("resolve"))));
+        QCOMPARE(fileList.getSourceFiles().size(), 3);
+    }
+};
+
+QTEST_APPLESS_MAIN(Test)
+
+#include "test_qsocfilelist.moc"
@@ -0,0 +1,181 @@
+#include "common/qllmservice.h"
+#include "common/qsocbusmanager.h"
+#include "common/qsocconfig.h"
+#include "common/qsocgeneratemanager.h"
+#include "common/qsocmodulemanager.h"
+#include "common/qsocprojectmanager.h"
+#include "qsoctestfiles.h"
+
+#include <QtCore>
+#include <QtTest>
+
+#include <yaml-cpp/yaml.h>
+
+using namespace QSocTestFiles;
+
+struct TestApp
+{
+    static auto &instance()
+    {
+        static auto                  argc      = 1;
+        static char                  appName[] = "qsoc";
+        static std::array<char *, 1> argv      = {{appName}};
+        /* Use QCoreApplication for cli test */
+        static const QCoreApplication app = QCoreApplication(argc, argv.data());
+        return app;
+    }
+};
+
+namespace {
+/* Bus with a signal that no module maps */
+const char *kBusLibrary = R"(toy:
+  port:
+    sel:
+      master: {direction: out}
+      slave: {direction: in}
+    addr:
+      master: {direction: out}
+      slave: {direction: in}
+    write:
+      master: {direction: out}
+      slave: {direction: in}
+    none:
+      master: {direction: out}
+      slave: {direction: in}
+)";
+
+/* The master splits its interface, the pad_ interface maps what the other lacks */
+const char *kModuleLibrary = R"(master:
+  port:
+    a_psel: {type: logic, direction: output}
+    a_paddr: {type: logic, direction: output}
+    pad_a_pwrite: {type: logic, direction: output}
+  bus:
+    a:
+      bus: toy
+      mode: master
+      mapping: {sel: a_psel}
+    pad_a:
+      bus: toy
+      mode: master
+      mapping: {sel: pad_a_unused, addr: a_paddr, write: pad_a_pwrite}
+slave:
+  port:
+    s_sel: {type: logic, direction: input}
+    s_addr: {type: logic, direction: input}
+    s_write: {type: logic, direction: input}
+  bus:
+    s:
+      bus: toy
+      mode: slave
+      mapping: {sel: s_sel, addr: s_addr, write: s_write}
+)";
+
+/* Explicit nets named like bus nets, and one that is not */
+const char *kNetlist = R"(instance:
+  u_m: {module: master}
+  u_s: {module: slave}
+  u_x: {module: slave}
+net:
+  toybus_sel:
+    - {instance: u_x, port: s_sel}
+  other:
+    - {instance: u_x, port: s_addr}
+    - {instance: u_x, port: s_write}
+  toybus_none:
+    - {instance: u_x, port: s_write}
+bus:
+  toybus:
+    u_m: {port: a}
+    u_s: {port: s}
+)";
+
+/* Instance and port of a pin */
+using Pin = QPair<QString, QString>;
+} // namespace
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir      tempDir;
+    QSocProjectManager projectManager;
+
+    /* Net names of an expanded netlist in file order */
+    static QStringList netNames(const YAML::Node &netlist)
+    {
+        QStringList result;
+        for (const auto &netPair : netlist["net"]) {
+            result.append(QString::fromStdString(netPair.first.as<std::string>()));
+        }
+        return result;
+    }
+
+    /* Pins of one net of an expanded netlist in file order */
+    static QList<Pin> netPins(const YAML::Node &netlist, const std::string &netName)
+    {
+        QList<Pin> result;
+        for (const auto &pin : netlist["net"][netName]) {
+            result.append(
+                {QString::fromStdString(pin["instance"].as<std::string>()),
+                 QString::fromStdString(pin["port"].as<std::string>())});
+        }
+        return result;
+    }
+
+private slots:
+    void initTestCase()
+    {
+        TestApp::instance();
+        QVERIFY(tempDir.isValid());
+        const QString workPath = tempDir.path();
+        projectManager.setProjectPath(workPath);
+        projectManager.setBusPath(workPath + "/bus");
+        projectManager.setModulePath(workPath + "/module");
+        projectManager.setSchematicPath(workPath + "/schematic");
+        projectManager.setOutputPath(workPath + "/output");
+        QVERIFY(projectManager.save("test"));
+        QVERIFY(writeText(workPath + "/bus/toy_lib.soc_bus", kBusLibrary));
+        QVERIFY(writeText(workPath + "/module/toy_lib.soc_mod", kModuleLibrary));
+        QVERIFY(writeText(workPath + "/toy.soc_net", kNetlist));
+    }
+
+    void processNetlistBus()
+    {
+        QSocConfig          socConfig(nullptr, &projectManager);
+        QLLMService         llmService(nullptr, &socConfig);
+        QSocBusManager      busManager(nullptr, &projectManager);
+        QSocModuleManager   moduleManager(nullptr, &projectManager, &busManager, &llmService);
+        QSoCGenerateManager generateManager(nullptr, &projectManager, &moduleManager, &busManager);
+        QVERIFY(busManager.load(QRegularExpression(".*")));
+        QVERIFY(moduleManager.load(QRegularExpression(".*")));
+
+        const QString workPath     = tempDir.path();
+        const QString expandedPath = workPath + "/toy_expanded.soc_net";
+        QVERIFY(generateManager.loadNetlist(workPath + "/toy.soc_net"));
+        QVERIFY(generateManager.processNetlist());
+        QVERIFY(generateManager.saveExpandedNetlist(expandedPath));
+        const YAML::Node netlist = YAML::LoadFile(expandedPath.toStdString());
+
+        /* A bus net replaces the explicit net of its name in place, an empty one removes it */
+        const QStringList expectedNets = {"toybus_sel", "other", "toybus_addr", "toybus_write"};
+        QCOMPARE(netNames(netlist), expectedNets);
+
+        /* The exact interface maps sel, the pad_ interface maps the signals it lacks */
+        const QList<Pin> expectedSel = {{"u_m", "a_psel"}, {"u_s", "s_sel"}};
+        QCOMPARE(netPins(netlist, "toybus_sel"), expectedSel);
+        const QList<Pin> expectedAddr = {{"u_m", "a_paddr"}, {"u_s", "s_addr"}};
+        QCOMPARE(netPins(netlist, "toybus_addr"), expectedAddr);
+        const QList<Pin> expectedWrite = {{"u_m", "pad_a_pwrite"}, {"u_s", "s_write"}};
+        QCOMPARE(netPins(netlist, "toybus_write"), expectedWrite);
+
+        /* Other explicit nets are kept as they are */
+        const QList<Pin> expectedOther = {{"u_x", "s_addr"}, {"u_x", "s_write"}};
+        QCOMPARE(netPins(netlist, "other"), expectedOther);
+    }
+};
+
+QTEST_APPLESS_MAIN(Test)
+
+#include "test_qsocgeneratemanager.moc"
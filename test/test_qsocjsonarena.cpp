@@ -0,0 +1,206 @@
+#include "common/qsocjsonarena.h"
+
+#include <QtCore>
+#include <QtTest>
+
+#include <cstdint>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+namespace {
+/* JSON document with all memory from the arena of the current scope */
+using ArenaJson = nlohmann::basic_json<
+    std::map,
+    std::vector,
+    QSocJsonArenaString,
+    bool,
+    std::int64_t,
+    std::uint64_t,
+    double,
+    QSocJsonArenaAllocator>;
+
+/* Long enough to never fit inside the string object */
+const char *kLongText = "a string that is far too long for the small string buffer";
+
+bool isAligned(const void *pointer)
+{
+    return reinterpret_cast<std::uintptr_t>(pointer) % alignof(std::max_align_t) == 0;
+}
+
+/* Document with nested containers, long keys and long strings */
+ArenaJson makeDocument()
+{
+    ArenaJson document;
+    document["members"] = ArenaJson::array();
+    for (int index = 0; index < 100; index++) {
+        document["members"].push_back(
+            {{"kind", "Instance"},
+             {"name", "instance_with_a_long_name_" + std::to_string(index)},
+             {"text", kLongText}});
+    }
+    return document;
+}
+} // namespace
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void heapOutsideScope()
+    {
+        QSocJsonArena arena;
+        void         *pointer = QSocJsonArena::allocate(100);
+        QVERIFY(pointer != nullptr);
+        QVERIFY(isAligned(pointer));
+        QCOMPARE(arena.getReservedBytes(), std::size_t(0));
+        QSocJsonArena::deallocate(pointer);
+        QSocJsonArena::deallocate(nullptr);
+    }
+
+    void arenaInsideScope()
+    {
+        QSocJsonArena arena;
+        char         *first  = nullptr;
+        char         *second = nullptr;
+        {
+            const QSocJsonArena::Scope scope(arena);
+            first  = static_cast<char *>(QSocJsonArena::allocate(1));
+            second = static_cast<char *>(QSocJsonArena::allocate(3));
+        }
+        QVERIFY(isAligned(first));
+        QVERIFY(isAligned(second));
+        QVERIFY(arena.getReservedBytes() > 0);
+
+        /* Bumped out of one block, each behind its own tag header */
+        QVERIFY(second > first);
+        QVERIFY(second - first <= static_cast<std::ptrdiff_t>(2 * alignof(std::max_align_t)));
+
+        /* Arena memory is kept until clear(), whichever scope frees it */
+        const std::size_t reserved = arena.getReservedBytes();
+        QSocJsonArena::deallocate(first);
+        {
+            const QSocJsonArena::Scope scope(arena);
+            QSocJsonArena::deallocate(second);
+        }
+        QCOMPARE(arena.getReservedBytes(), reserved);
+    }
+
+    void tagDecidesNotScope()
+    {
+        /* Heap memory freed inside a scope goes back to the heap */
+        QSocJsonArena arena;
+        void         *heap = QSocJsonArena::allocate(64);
+        {
+            const QSocJsonArena::Scope scope(arena);
+            QSocJsonArena::deallocate(heap);
+        }
+        QCOMPARE(arena.getReservedBytes(), std::size_t(0));
+    }
+
+    void nestedScopes()
+    {
+        QSocJsonArena outer;
+        QSocJsonArena inner;
+        {
+            const QSocJsonArena::Scope outerScope(outer);
+            {
+                const QSocJsonArena::Scope innerScope(inner);
+                QSocJsonArena::allocate(16);
+            }
+            QCOMPARE(outer.getReservedBytes(), std::size_t(0));
+            QVERIFY(inner.getReservedBytes() > 0);
+            QSocJsonArena::allocate(16);
+            QVERIFY(outer.getReservedBytes() > 0);
+        }
+        const std::size_t reserved = outer.getReservedBytes();
+        QSocJsonArena::deallocate(QSocJsonArena::allocate(16));
+        QCOMPARE(outer.getReservedBytes(), reserved);
+    }
+
+    void largeAllocation()
+    {
+        QSocJsonArena     arena;
+        const std::size_t size = 64 * 1024 * 1024;
+        {
+            const QSocJsonArena::Scope scope(arena);
+            QSocJsonArena::allocate(1);
+            QSocJsonArena::allocate(size);
+        }
+        QVERIFY(arena.getReservedBytes() > size);
+    }
+
+    void clearReleasesBlocks()
+    {
+        QSocJsonArena arena;
+        {
+            const QSocJsonArena::Scope scope(arena);
+            QSocJsonArena::allocate(1000);
+        }
+        QVERIFY(arena.getReservedBytes() > 0);
+        arena.clear();
+        QCOMPARE(arena.getReservedBytes(), std::size_t(0));
+        {
+            const QSocJsonArena::Scope scope(arena);
+            QVERIFY(isAligned(QSocJsonArena::allocate(1000)));
+        }
+        QVERIFY(arena.getReservedBytes() > 0);
+    }
+
+    void stringsInArena()
+    {
+        QSocJsonArena arena;
+        {
+            const QSocJsonArena::Scope scope(arena);
+            const QSocJsonArenaString  text(kLongText);
+            QVERIFY(arena.getReservedBytes() > 0);
+            QCOMPARE(std::string(text), std::string(kLongText));
+        }
+    }
+
+    void arenaToHeap()
+    {
+        QSocJsonArena arena;
+        ArenaJson     document;
+        {
+            const QSocJsonArena::Scope scope(arena);
+            document = makeDocument();
+        }
+        QVERIFY(arena.getReservedBytes() > 0);
+
+        /* Copies made outside the scope are heap documents */
+        const ArenaJson      member = document["members"][7];
+        const nlohmann::json plain(document["members"][8]);
+        document = nullptr;
+        arena.clear();
+
+        QCOMPARE(
+            QString::fromStdString(member["name"].get<std::string>()),
+            QString("instance_with_a_long_name_7"));
+        QCOMPARE(
+            QString::fromStdString(plain["name"].get<std::string>()),
+            QString("instance_with_a_long_name_8"));
+        QVERIFY(member["text"] == std::string(kLongText));
+    }
+
+    void heapToArena()
+    {
+        /* Heap values moved into an arena document are freed with it */
+        ArenaJson     heapDocument = makeDocument();
+        QSocJsonArena arena;
+        {
+            const QSocJsonArena::Scope scope(arena);
+            ArenaJson                  document = makeDocument();
+            document["heap"]                    = std::move(heapDocument["members"]);
+            document["members"][0]              = heapDocument;
+            QCOMPARE(document["heap"].size(), std::size_t(100));
+            QVERIFY(document["heap"][99]["text"] == std::string(kLongText));
+        }
+        QVERIFY(arena.getReservedBytes() > 0);
+    }
+};
+
+QTEST_APPLESS_MAIN(Test)
+
+#include "test_qsocjsonarena.moc"
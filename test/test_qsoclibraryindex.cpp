@@ -0,0 +1,184 @@
+#include "common/qsocbusmanager.h"
+#include "common/qsoclibraryindex.h"
+#include "common/qsocprojectmanager.h"
+#include "qsoctestfiles.h"
+
+#include <QFile>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QtCore>
+#include <QtTest>
+
+using namespace QSocTestFiles;
+
+struct TestApp
+{
+    static auto &instance()
+    {
+        static auto                  argc      = 1;
+        static char                  appName[] = "qsoc";
+        static std::array<char *, 1> argv      = {{appName}};
+        /* Use QCoreApplication for cli test */
+        static const QCoreApplication app = QCoreApplication(argc, argv.data());
+        return app;
+    }
+};
+
+namespace {
+/* Loaded first, zeta and beta are listed out of order */
+const char *kAlphaLibrary = R"(zeta:
+  port:
+    sel: {master: {direction: out}, slave: {direction: in}}
+beta:
+  port:
+    sel: {master: {direction: out}, slave: {direction: in}}
+)";
+
+/* Loaded second, takes beta over and has a bus named like the first library */
+const char *kGammaLibrary = R"(beta:
+  port:
+    sel: {master: {direction: out}, slave: {direction: in}}
+alpha:
+  port:
+    sel: {master: {direction: out}, slave: {direction: in}}
+)";
+} // namespace
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void lazySorting()
+    {
+        QSocLibraryIndex index;
+        index.insert("lib_b", "c");
+        index.insert("lib_b", "a");
+        index.insert("lib_a", "d");
+        index.insert("lib_b", "b");
+
+        const QStringList libraryNames = {"a", "b", "c"};
+        QCOMPARE(index.getNames("lib_b"), libraryNames);
+        const QStringList allNames = {"a", "b", "c", "d"};
+        QCOMPARE(index.getNames(), allNames);
+        const QStringList libraries = {"lib_a", "lib_b"};
+        QCOMPARE(index.getLibraries(), libraries);
+
+        /* Names after a read are sorted again on the next read */
+        index.insert("lib_b", "0");
+        const QStringList resorted = {"0", "a", "b", "c"};
+        QCOMPARE(index.getNames("lib_b"), resorted);
+        QVERIFY(index.getNames("missing").isEmpty());
+    }
+
+    void moveOnReinsert()
+    {
+        QSocLibraryIndex index;
+        index.insert("lib_a", "x");
+        index.insert("lib_a", "y");
+        index.insert("lib_a", "x");
+        QCOMPARE(index.getNames("lib_a"), QStringList({"x", "y"}));
+
+        index.insert("lib_b", "x");
+        QCOMPARE(index.getLibrary("x"), QString("lib_b"));
+        QCOMPARE(index.getNames("lib_a"), QStringList{"y"});
+        QCOMPARE(index.getNames("lib_b"), QStringList{"x"});
+        QCOMPARE(index.getNames(), QStringList({"x", "y"}));
+
+        /* A library left without names is dropped */
+        index.insert("lib_b", "y");
+        QVERIFY(!index.containsLibrary("lib_a"));
+        QCOMPARE(index.getLibraries(), QStringList{"lib_b"});
+    }
+
+    void remove()
+    {
+        QSocLibraryIndex index;
+        index.insert("sorted", "a");
+        index.insert("sorted", "b");
+        index.insert("sorted", "c");
+        index.insert("unsorted", "z");
+        index.insert("unsorted", "x");
+        index.insert("unsorted", "y");
+
+        /* Removal before any read works on the unsorted list */
+        QCOMPARE(index.remove("x"), QString("unsorted"));
+        QCOMPARE(index.remove("b"), QString("sorted"));
+        QCOMPARE(index.remove("missing"), QString());
+        QVERIFY(!index.containsName("x"));
+        QCOMPARE(index.getNames("unsorted"), QStringList({"y", "z"}));
+        QCOMPARE(index.getNames("sorted"), QStringList({"a", "c"}));
+        QCOMPARE(index.getNames(), QStringList({"a", "c", "y", "z"}));
+
+        /* Removing the last names drops the library */
+        QCOMPARE(index.remove("y"), QString("unsorted"));
+        QCOMPARE(index.remove("z"), QString("unsorted"));
+        QVERIFY(!index.containsLibrary("unsorted"));
+        index.insert("unsorted", "w");
+        QCOMPARE(index.getNames("unsorted"), QStringList{"w"});
+    }
+
+    void removeLibrary()
+    {
+        QSocLibraryIndex index;
+        index.insert("lib_a", "b");
+        index.insert("lib_a", "a");
+        index.insert("lib_b", "c");
+
+        /* Names come back sorted, even if the library was never read */
+        QCOMPARE(index.removeLibrary("lib_a"), QStringList({"a", "b"}));
+        QVERIFY(index.removeLibrary("lib_a").isEmpty());
+        QVERIFY(!index.containsLibrary("lib_a"));
+        QVERIFY(!index.containsName("a"));
+        QCOMPARE(index.getLibrary("b"), QString());
+        QCOMPARE(index.getNames(), QStringList{"c"});
+        QCOMPARE(index.getLibraries(), QStringList{"lib_b"});
+
+        /* The library starts over when names are added again */
+        index.insert("lib_a", "z");
+        index.insert("lib_a", "y");
+        QCOMPARE(index.getNames("lib_a"), QStringList({"y", "z"}));
+
+        index.clear();
+        QVERIFY(index.getNames().isEmpty());
+        QVERIFY(index.getLibraries().isEmpty());
+    }
+
+    void busManager()
+    {
+        TestApp::instance();
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const QString      workPath = tempDir.path();
+        QSocProjectManager projectManager;
+        projectManager.setProjectPath(workPath);
+        projectManager.setBusPath(workPath + "/bus");
+        projectManager.setModulePath(workPath + "/module");
+        projectManager.setSchematicPath(workPath + "/schematic");
+        projectManager.setOutputPath(workPath + "/output");
+        QVERIFY(projectManager.save("test"));
+        QVERIFY(writeText(workPath + "/bus/alpha.soc_bus", kAlphaLibrary));
+        QVERIFY(writeText(workPath + "/bus/gamma.soc_bus", kGammaLibrary));
+
+        QSocBusManager busManager(nullptr, &projectManager);
+        QVERIFY(busManager.load(QRegularExpression(".*")));
+
+        /* Buses are listed by name across libraries, a bus loaded twice moves */
+        QCOMPARE(busManager.listBus(), QStringList({"alpha", "beta", "zeta"}));
+        QCOMPARE(busManager.getBusLibrary("beta"), QString("gamma"));
+        QCOMPARE(busManager.getBusLibrary("zeta"), QString("alpha"));
+
+        /* Removing a library drops its buses, not the bus named like the library */
+        QVERIFY(busManager.remove(QString("alpha")));
+        QVERIFY(!busManager.isBusExist("zeta"));
+        QVERIFY(busManager.isBusExist("alpha"));
+        QVERIFY(busManager.isBusExist("beta"));
+        QCOMPARE(busManager.listBus(), QStringList({"alpha", "beta"}));
+        QVERIFY(!busManager.isExist("alpha"));
+        QVERIFY(busManager.isExist("gamma"));
+    }
+};
+
+QTEST_APPLESS_MAIN(Test)
+
+#include "test_qsoclibraryindex.moc"
@@ -0,0 +1,152 @@
+#include "common/qsoclogsink.h"
+#include "common/qstaticlog.h"
+
+#include <QSignalSpy>
+#include <QStringList>
+#include <QtCore>
+#include <QtTest>
+
+struct TestApp
+{
+    static auto &instance()
+    {
+        static auto                  argc      = 1;
+        static char                  appName[] = "qsoc";
+        static std::array<char *, 1> argv      = {{appName}};
+        /* Use QCoreApplication for cli test */
+        static const QCoreApplication app = QCoreApplication(argc, argv.data());
+        return app;
+    }
+};
+
+namespace {
+/* Flush a sink and return the lines it emitted, empty if it emitted nothing */
+QStringList flushLines(QSocLogSink &sink)
+{
+    QSignalSpy spy(&QStaticLog::instance(), &QStaticLog::log);
+    sink.flush();
+    if (spy.isEmpty()) {
+        return {};
+    }
+    return spy.takeFirst().first().toString().split("<br>");
+}
+} // namespace
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase() { TestApp::instance(); }
+
+    void emptyFlush()
+    {
+        QSocLogSink sink;
+        QVERIFY(flushLines(sink).isEmpty());
+    }
+
+    void coalesceRepeats()
+    {
+        QSocLogSink sink;
+        for (int index = 0; index < 3; index++) {
+            QVERIFY(sink.push(QStaticLog::Level::Info, "func", "same"));
+        }
+        QVERIFY(sink.push(QStaticLog::Level::Info, "func", "other"));
+        QVERIFY(sink.push(QStaticLog::Level::Info, "func", "same"));
+
+        /* Only runs in a row are coalesced */
+        const QStringList lines = flushLines(sink);
+        QCOMPARE(lines.size(), 3);
+        QVERIFY(lines.at(0).endsWith("func:same (x3)"));
+        QVERIFY(lines.at(1).endsWith("func:other"));
+        QVERIFY(lines.at(2).endsWith("func:same"));
+        QVERIFY(flushLines(sink).isEmpty());
+    }
+
+    void coalesceSameRecordOnly()
+    {
+        QSocLogSink sink;
+        QVERIFY(sink.push(QStaticLog::Level::Info, "func", "message"));
+        QVERIFY(sink.push(QStaticLog::Level::Warning, "func", "message"));
+        QVERIFY(sink.push(QStaticLog::Level::Warning, "other", "message"));
+
+        const QStringList lines = flushLines(sink);
+        QCOMPARE(lines.size(), 3);
+        for (const QString &line : lines) {
+            QVERIFY(!line.contains("(x"));
+        }
+    }
+
+    void dropWhenFull()
+    {
+        /* Five is rounded up to a ring of eight */
+        QSocLogSink sink(nullptr, 5);
+        for (int index = 0; index < 8; index++) {
+            QVERIFY(sink.push(QStaticLog::Level::Info, "func", QString::number(index)));
+        }
+        QVERIFY(!sink.push(QStaticLog::Level::Info, "func", "8"));
+        QVERIFY(!sink.push(QStaticLog::Level::Info, "func", "9"));
+
+        QStringList lines = flushLines(sink);
+        QCOMPARE(lines.size(), 9);
+        QVERIFY(lines.at(7).endsWith("func:7"));
+        QVERIFY(lines.last().contains("2 messages dropped"));
+
+        /* Flushing frees the ring and resets the count */
+        QVERIFY(sink.push(QStaticLog::Level::Info, "func", "10"));
+        lines = flushLines(sink);
+        QCOMPARE(lines.size(), 1);
+        QVERIFY(lines.first().endsWith("func:10"));
+    }
+
+    void smallestRing()
+    {
+        /* The ring holds at least two messages */
+        QSocLogSink sink(nullptr, 1);
+        QVERIFY(sink.push(QStaticLog::Level::Info, "func", "0"));
+        QVERIFY(sink.push(QStaticLog::Level::Info, "func", "1"));
+        QVERIFY(!sink.push(QStaticLog::Level::Info, "func", "2"));
+        QCOMPARE(flushLines(sink).size(), 3);
+        QVERIFY(flushLines(sink).isEmpty());
+    }
+
+    void historyLimit()
+    {
+        QSocLogSink sink;
+        sink.setHistoryLimit(3);
+        for (int index = 0; index < 10; index++) {
+            QVERIFY(sink.push(QStaticLog::Level::Info, "func", QString::number(index)));
+        }
+
+        /* Only the newest lines are formatted */
+        const QStringList lines = flushLines(sink);
+        QCOMPARE(lines.size(), 3);
+        QVERIFY(lines.at(0).endsWith("func:7"));
+        QVERIFY(lines.at(1).endsWith("func:8"));
+        QVERIFY(lines.at(2).endsWith("func:9"));
+
+        /* At least one line is kept */
+        sink.setHistoryLimit(0);
+        QVERIFY(sink.push(QStaticLog::Level::Info, "func", "a"));
+        QVERIFY(sink.push(QStaticLog::Level::Info, "func", "b"));
+        const QStringList kept = flushLines(sink);
+        QCOMPARE(kept.size(), 1);
+        QVERIFY(kept.first().endsWith("func:b"));
+    }
+
+    void levelFilter()
+    {
+        QSocLogSink sink;
+        QCOMPARE(sink.getLevel(), QStaticLog::Level::Verbose);
+        QVERIFY(sink.accepts(QStaticLog::Level::Verbose));
+        sink.setLevel(QStaticLog::Level::Warning);
+        QCOMPARE(sink.getLevel(), QStaticLog::Level::Warning);
+        QVERIFY(sink.accepts(QStaticLog::Level::Error));
+        QVERIFY(sink.accepts(QStaticLog::Level::Warning));
+        QVERIFY(!sink.accepts(QStaticLog::Level::Info));
+    }
+};
+
+QTEST_APPLESS_MAIN(Test)
+
+#include "test_qsoclogsink.moc"
@@ -0,0 +1,178 @@
+#include "common/qsocnamematcher.h"
+#include "common/qstaticregex.h"
+
+#include <QRegularExpression>
+#include <QStringList>
+#include <QtCore>
+#include <QtTest>
+
+namespace {
+/* Names every pattern is checked against, sorted by QString::operator<() */
+QStringList sortedNames()
+{
+    QStringList names
+        = {"",
+           " ",
+           "ABC",
+           "Abc",
+           "a.b",
+           "aXb",
+           "aa",
+           "ab",
+           "abab",
+           "abc",
+           "abc$",
+           "abc.def",
+           "abcabc",
+           "abcd",
+           "abd",
+           "b",
+           "cab",
+           "xabc",
+           "xabcx",
+           "xyz"};
+    names.sort();
+    return names;
+}
+
+/* Names matched by QStaticRegex::isNameExactMatch() with any of the expressions */
+QStringList exactMatches(const QStringList &names, const QList<QRegularExpression> &regexes)
+{
+    QStringList result;
+    for (const QString &name : names) {
+        for (const QRegularExpression &regex : regexes) {
+            if (QStaticRegex::isNameExactMatch(name, regex)) {
+                result.append(name);
+                break;
+            }
+        }
+    }
+    return result;
+}
+} // namespace
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void singlePattern_data()
+    {
+        QTest::addColumn<QString>("pattern");
+        QTest::addColumn<bool>("caseInsensitive");
+        QTest::addColumn<bool>("valid");
+
+        QTest::newRow("plain") << "abc" << false << true;
+        QTest::newRow("plain whitespace") << " " << false << true;
+        QTest::newRow("prefix") << "^abc" << false << true;
+        QTest::newRow("suffix") << "abc$" << false << true;
+        QTest::newRow("leading wildcard") << ".*abc" << false << true;
+        QTest::newRow("trailing wildcard") << "abc.*$" << false << true;
+        QTest::newRow("prefix wildcard") << "^ab.*" << false << true;
+        QTest::newRow("anchored literal") << "^abc$" << false << true;
+        QTest::newRow("match all") << ".*" << false << true;
+        QTest::newRow("anchored match all") << "^.*$" << false << true;
+        QTest::newRow("empty name") << "^$" << false << true;
+        QTest::newRow("escaped dot") << "a\\.b" << false << true;
+        QTest::newRow("escaped dollar") << "abc\\$" << false << true;
+        QTest::newRow("escaped dot wildcard") << "^abc\\.*" << false << true;
+        QTest::newRow("unescaped dot") << "a.b" << false << true;
+        QTest::newRow("alternation") << "ab|xyz" << false << true;
+        QTest::newRow("class") << "^[ab]+$" << false << true;
+        QTest::newRow("back reference") << "^(ab)\\1$" << false << true;
+        QTest::newRow("named group") << "^(?<pair>ab)\\k<pair>$" << false << true;
+        QTest::newRow("python named group") << "(?P<first>a)b(?P=first)" << false << true;
+        QTest::newRow("lookbehind") << "(?<=a)bc" << false << true;
+        QTest::newRow("case insensitive plain") << "abc" << true << true;
+        QTest::newRow("case insensitive prefix") << "^abc" << true << true;
+        QTest::newRow("case insensitive suffix") << "abc$" << true << true;
+        QTest::newRow("case insensitive regex") << "^a.c$" << true << true;
+        QTest::newRow("inline case insensitive") << "(?i)^abc$" << false << true;
+        QTest::newRow("invalid") << "a(b" << false << false;
+        QTest::newRow("invalid anchored") << "^[ab" << false << false;
+    }
+
+    void singlePattern()
+    {
+        QFETCH(QString, pattern);
+        QFETCH(bool, caseInsensitive);
+        QFETCH(bool, valid);
+
+        const QRegularExpression regex(
+            pattern,
+            caseInsensitive ? QRegularExpression::CaseInsensitiveOption
+                            : QRegularExpression::NoPatternOption);
+        const QStringList names    = sortedNames();
+        const QStringList expected = exactMatches(names, {regex});
+
+        const QSocNameMatcher matcher(regex);
+        QCOMPARE(matcher.isValid(), valid);
+        QCOMPARE(matcher.getInvalidPattern(), valid ? QString() : pattern);
+        for (const QString &name : names) {
+            QVERIFY2(
+                matcher.matches(name) == expected.contains(name),
+                qPrintable(QString("pattern %1, name '%2'").arg(pattern, name)));
+        }
+        QCOMPARE(matcher.filter(names), expected);
+        QCOMPARE(matcher.filterSorted(names), expected);
+
+        /* Without options the pattern list constructor agrees */
+        if (!caseInsensitive) {
+            const QSocNameMatcher listMatcher(QStringList{pattern});
+            QCOMPARE(listMatcher.isValid(), valid);
+            QCOMPARE(listMatcher.filter(names), expected);
+            QCOMPARE(listMatcher.filterSorted(names), expected);
+        }
+    }
+
+    void patternList_data()
+    {
+        QTest::addColumn<QStringList>("patterns");
+
+        QTest::newRow("literals") << QStringList{"abc", "b", "missing"};
+        QTest::newRow("literal and prefix") << QStringList{"xyz", "^ab"};
+        QTest::newRow("shapes") << QStringList{"^cab", "abc$", ".*bcd", "^$"};
+        QTest::newRow("joined regexes") << QStringList{"^a.b$", "x.z", "^(ab)+$"};
+        QTest::newRow("groups in several") << QStringList{"^(a)b$", "^(ab)\\1$", "(?<n>c)ab"};
+        QTest::newRow("named groups twice")
+            << QStringList{"^(?<n>ab)\\k<n>$", "^(?<n>abc)\\k<n>$"};
+        QTest::newRow("with invalid") << QStringList{"abc", "a(b", "^x"};
+        QTest::newRow("with match all") << QStringList{"abc", "^.*$"};
+        QTest::newRow("empty pattern") << QStringList{"", "ab"};
+    }
+
+    void patternList()
+    {
+        QFETCH(QStringList, patterns);
+
+        QList<QRegularExpression> regexes;
+        QString                   invalidPattern;
+        for (const QString &pattern : patterns) {
+            regexes.append(QRegularExpression(pattern));
+            if (!regexes.last().isValid() && invalidPattern.isEmpty()) {
+                invalidPattern = pattern;
+            }
+        }
+        const QStringList names    = sortedNames();
+        const QStringList expected = exactMatches(names, regexes);
+
+        const QSocNameMatcher matcher(patterns);
+        QCOMPARE(matcher.getInvalidPattern(), invalidPattern);
+        QCOMPARE(matcher.filter(names), expected);
+        QCOMPARE(matcher.filterSorted(names), expected);
+    }
+
+    void empty()
+    {
+        const QSocNameMatcher matcher;
+        QVERIFY(matcher.isEmpty());
+        QVERIFY(matcher.isValid());
+        QVERIFY(matcher.filter(sortedNames()).isEmpty());
+        QVERIFY(QSocNameMatcher(QStringList{""}).isEmpty());
+        QVERIFY(!QSocNameMatcher(QStringList{"^$"}).isEmpty());
+    }
+};
+
+QTEST_APPLESS_MAIN(Test)
+
+#include "test_qsocnamematcher.moc"
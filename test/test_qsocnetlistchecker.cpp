@@ -0,0 +1,183 @@
+#include "common/qsocnetlistchecker.h"
+#include "common/qsocnetlistgraph.h"
+#include "common/qsocnetlistloader.h"
+
+#include <QtCore>
+#include <QtTest>
+
+#include <sstream>
+#include <string>
+
+#include <yaml-cpp/yaml.h>
+
+namespace {
+/* Module with a port of each direction, the input n is narrower */
+const char *kModuleLibrary = R"(drv:
+  port:
+    o: {direction: output, width: 8}
+    io: {direction: inout, width: 8}
+    i: {direction: input, width: 8}
+    n: {direction: input, width: 4}
+)";
+
+/* Instances of the netlists, u_missing only where the row needs it */
+const char *kInstances = R"(instance:
+  u0: {module: drv}
+  u1: {module: drv}
+)";
+
+/* Nets checked on more than one shard, the checker splits from 4096 nets per shard */
+constexpr int kShardedNetCount = 5 * 4096;
+
+/* Look modules up in a library */
+QSocNetlistGraph::ModuleLookup libraryLookup(const YAML::Node &library)
+{
+    return [library](const std::string &moduleName) {
+        const YAML::Node moduleData = library[moduleName];
+        return moduleData ? moduleData : YAML::Node();
+    };
+}
+
+/* Report as text, so two reports compare in full */
+std::string reportText(const YAML::Node &report)
+{
+    YAML::Emitter emitter;
+    emitter << report;
+    return emitter.c_str();
+}
+} // namespace
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void rule_data()
+    {
+        QTest::addColumn<QString>("netlist");
+        QTest::addColumn<QString>("rule");
+        QTest::addColumn<QString>("severity");
+
+        /* Each netlist breaks exactly one rule */
+        QTest::newRow("unresolved-module") << "instance:\n"
+                                              "  u0: {module: drv}\n"
+                                              "  u_missing: {module: nothing}\n"
+                                              "net:\n"
+                                              "  a:\n"
+                                              "    - {instance: u0, port: o}\n"
+                                           << "unresolved-module" << "error";
+        QTest::newRow("unresolved-instance") << QString(kInstances)
+                                                    + "net:\n"
+                                                      "  a:\n"
+                                                      "    - {instance: u0, port: o}\n"
+                                                      "    - {instance: u_ghost, port: i}\n"
+                                             << "unresolved-instance" << "error";
+        QTest::newRow("unresolved-port") << QString(kInstances)
+                                                + "net:\n"
+                                                  "  a:\n"
+                                                  "    - {instance: u0, port: o}\n"
+                                                  "    - {instance: u1, port: nope}\n"
+                                         << "unresolved-port" << "error";
+        QTest::newRow("multiple-connections") << QString(kInstances)
+                                                     + "net:\n"
+                                                       "  a:\n"
+                                                       "    - {instance: u0, port: o}\n"
+                                                       "  b:\n"
+                                                       "    - {instance: u0, port: o}\n"
+                                              << "multiple-connections" << "error";
+        QTest::newRow("multiple-drivers") << QString(kInstances)
+                                                 + "net:\n"
+                                                   "  a:\n"
+                                                   "    - {instance: u0, port: o}\n"
+                                                   "    - {instance: u1, port: o}\n"
+                                          << "multiple-drivers" << "error";
+        QTest::newRow("direction-conflict") << QString(kInstances)
+                                                   + "net:\n"
+                                                     "  a:\n"
+                                                     "    - {instance: u0, port: o}\n"
+                                                     "    - {instance: u1, port: io}\n"
+                                            << "direction-conflict" << "error";
+        QTest::newRow("undriven") << QString(kInstances)
+                                         + "net:\n"
+                                           "  a:\n"
+                                           "    - {instance: u0, port: i}\n"
+                                           "    - {instance: u1, port: i}\n"
+                                  << "undriven" << "warning";
+        QTest::newRow("width-mismatch") << QString(kInstances)
+                                               + "net:\n"
+                                                 "  a:\n"
+                                                 "    - {instance: u0, port: o}\n"
+                                                 "    - {instance: u1, port: n}\n"
+                                        << "width-mismatch" << "warning";
+    }
+
+    void rule()
+    {
+        QFETCH(QString, netlist);
+        QFETCH(QString, rule);
+        QFETCH(QString, severity);
+
+        QSocNetlistGraph   graph;
+        QSocNetlistLoader  loader(graph);
+        std::istringstream input(netlist.toStdString());
+        QVERIFY(loader.load(input));
+        graph.build(libraryLookup(YAML::Load(kModuleLibrary)));
+
+        QSocNetlistChecker checker(graph);
+        checker.run(1);
+        const auto &violations = checker.getViolations();
+        QCOMPARE(violations.size(), size_t(1));
+        QCOMPARE(QString::fromStdString(violations.front().rule), rule);
+        QCOMPARE(QString(QSocNetlistChecker::severityName(violations.front().severity)), severity);
+        QCOMPARE(checker.getErrorCount() + checker.getWarningCount(), 1);
+
+        /* The report carries the same rule and severity */
+        const YAML::Node report = checker.getReport();
+        QCOMPARE(QString::fromStdString(report["violation"][0]["rule"].as<std::string>()), rule);
+        QCOMPARE(
+            QString::fromStdString(report["violation"][0]["severity"].as<std::string>()),
+            severity);
+    }
+
+    void shards()
+    {
+        /* Nets cycle through the rules, each net on instances of its own */
+        QSocNetlistGraph graph;
+        const char      *patterns[][2] = {
+            {"o", "i"},  /* Clean */
+            {"o", "o"},  /* multiple-drivers */
+            {"o", "io"}, /* direction-conflict */
+            {"i", "i"},  /* undriven */
+            {"o", "n"},  /* width-mismatch */
+            {"o", "x"},  /* unresolved-port */
+        };
+        for (int net = 0; net < kShardedNetCount; net++) {
+            const auto        &pattern = patterns[net % std::size(patterns)];
+            const std::string  suffix  = std::to_string(net);
+            const int          netId   = graph.addNet("n" + suffix);
+            graph.addInstance("a" + suffix, "drv");
+            graph.addInstance("b" + suffix, net % 7 == 0 ? "nothing" : "drv");
+            graph.addPin(netId, "a" + suffix, pattern[0]);
+            graph.addPin(netId, net % 11 == 0 ? "ghost" + suffix : "b" + suffix, pattern[1]);
+        }
+        graph.build(libraryLookup(YAML::Load(kModuleLibrary)));
+
+        QSocNetlistChecker checker(graph);
+        checker.run(1);
+        const std::string singleShard = reportText(checker.getReport());
+        const int         errorCount  = checker.getErrorCount();
+        QVERIFY(errorCount > 0);
+        QVERIFY(checker.getWarningCount() > 0);
+
+        /* The report is the same on any number of shards */
+        for (const int threadCount : {2, 4, 5}) {
+            checker.run(threadCount);
+            QCOMPARE(checker.getErrorCount(), errorCount);
+            QCOMPARE(reportText(checker.getReport()), singleShard);
+        }
+    }
+};
+
+QTEST_APPLESS_MAIN(Test)
+
+#include "test_qsocnetlistchecker.moc"
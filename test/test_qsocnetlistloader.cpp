@@ -0,0 +1,362 @@
+#include "common/qsocnetlistgraph.h"
+#include "common/qsocnetlistloader.h"
+
+#include <QtCore>
+#include <QtTest>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <yaml-cpp/yaml.h>
+
+namespace {
+/* Netlist in the documented layout, with parameters, nets and buses */
+const char *kBasicNetlist = R"(instance:
+  u_cpu:
+    module: cpu
+    parameter:
+      ADDR_WIDTH: 32
+      DATA_WIDTH: 64
+  u_ram:
+    module: ram
+  u_uart:
+    module: uart
+net:
+  clk:
+    - instance: u_cpu
+      port: clk
+    - instance: u_ram
+      port: clk
+    - instance: u_uart
+      port: clk
+  irq:
+    - instance: u_uart
+      port: irq
+    - instance: u_cpu
+      port: irq0
+bus:
+  apb:
+    u_cpu:
+      port: m_apb
+    u_uart:
+      port: s_apb
+)";
+
+/* Entries the loader reports and skips */
+const char *kInvalidNetlist = R"(instance:
+  u0:
+    module: drv
+    parameter:
+      GOOD: 1
+      BAD: [1, 2]
+      EMPTY: ~
+  u1: not a map
+  u2:
+  u3:
+    parameter: 4
+net:
+  not_a_sequence:
+    instance: u0
+    port: o
+  empty: []
+  partial:
+    - instance: u0
+    - port: o
+    - instance: u0
+      port: ""
+    - just a scalar
+    - instance: u0
+      port: o
+bus:
+  scalar_bus: apb
+  apb:
+    u0:
+      port: s
+    u1: no port
+    u2:
+      port: [s]
+)";
+
+/* Anchors on scalars, maps, sequences and keys, with aliases after them */
+const char *kAnchorNetlist = R"(instance:
+  &name u0:
+    module: &module drv
+    parameter: &parameters
+      WIDTH: &width 8
+      DEPTH: 16
+  u1:
+    module: *module
+    parameter: *parameters
+  u2:
+    module: other
+    parameter:
+      WIDTH: *width
+net:
+  a: &connections
+    - &first {instance: *name, port: o}
+    - instance: u1
+      port: i
+  b: *connections
+  c:
+    - *first
+    - {instance: u2, port: *width}
+bus:
+  apb: &bus
+    *name : {port: s}
+  ahb: *bus
+)";
+
+/* The whole netlist in flow style */
+const char *kFlowNetlist = R"({instance: {u0: {module: drv, parameter: {W: 8}}, u1: {module: drv}},
+ net: {a: [{instance: u0, port: o}, {instance: u1, port: i}], b: [{port: x, instance: u1}]},
+ bus: {apb: {u0: {port: s}, u1: {}}}})";
+
+/* Sequences inside sequences where entries are expected, and in unknown sections */
+const char *kNestedNetlist = R"(extra:
+  - [1, [2, [3]]]
+  - {instance: [[u9]]}
+instance:
+  u0:
+    module: drv
+    parameter:
+      W: [[8]]
+    extra: [[1], [2]]
+  u1: [[module, drv]]
+net:
+  a:
+    - [{instance: u0, port: o}]
+    - {instance: u0, port: o, extra: [[1]]}
+    - [[{instance: u1, port: i}]]
+    - {instance: [u1], port: i}
+  b: [[]]
+bus:
+  apb:
+    u0: [[{port: s}]]
+    u1: {port: s, extra: [[1]]}
+)";
+
+/* Instances named twice, only the first entry of each name counts */
+const char *kDuplicateNetlist = R"(instance:
+  u0:
+    module: first
+    parameter:
+      W: 8
+  u1: not a map
+  u0:
+    module: second
+    parameter:
+      D: 4
+  u1:
+    module: late
+  u2:
+    module: drv
+  u2: again
+net:
+  a:
+    - instance: u0
+      port: o
+    - instance: u2
+      port: i
+)";
+
+/* Whether a map entry exists and is a scalar */
+bool isScalar(const YAML::Node &map, const char *key)
+{
+    const YAML::Node value = map[key];
+    return value && value.IsScalar();
+}
+
+/* Fill a graph from a node tree, with the rules the streaming loader follows */
+void loadTree(
+    const YAML::Node                     &netlist,
+    QSocNetlistGraph                     &graph,
+    std::vector<QSocNetlistLoader::Bus> &buses)
+{
+    graph.clear();
+    buses.clear();
+
+    for (const auto &instancePair : netlist["instance"]) {
+        if (!instancePair.first.IsScalar()) {
+            continue;
+        }
+        const std::string name = instancePair.first.as<std::string>();
+        const YAML::Node &data = instancePair.second;
+        if (graph.findInstance(name) >= 0) {
+            continue;
+        }
+        if (!data.IsMap()) {
+            graph.addInstance(name, std::string());
+            continue;
+        }
+        const int instance = graph.addInstance(
+            name, isScalar(data, "module") ? data["module"].as<std::string>() : std::string());
+        if (!data["parameter"] || !data["parameter"].IsMap()) {
+            continue;
+        }
+        for (const auto &paramPair : data["parameter"]) {
+            if (paramPair.first.IsScalar() && paramPair.second.IsScalar()) {
+                graph.addParameter(
+                    instance,
+                    paramPair.first.as<std::string>(),
+                    paramPair.second.as<std::string>());
+            }
+        }
+    }
+
+    for (const auto &netPair : netlist["net"]) {
+        if (!netPair.first.IsScalar() || !netPair.second.IsSequence()) {
+            continue;
+        }
+        int net = -1;
+        for (const YAML::Node &connection : netPair.second) {
+            if (!connection.IsMap() || !isScalar(connection, "instance")
+                || !isScalar(connection, "port")) {
+                continue;
+            }
+            const std::string instanceName = connection["instance"].as<std::string>();
+            const std::string portName     = connection["port"].as<std::string>();
+            if (instanceName.empty() || portName.empty()) {
+                continue;
+            }
+            if (net < 0) {
+                net = graph.addNet(netPair.first.as<std::string>());
+            }
+            graph.addPin(net, instanceName, portName);
+        }
+    }
+
+    for (const auto &busPair : netlist["bus"]) {
+        if (!busPair.first.IsScalar()) {
+            continue;
+        }
+        QSocNetlistLoader::Bus bus{busPair.first.as<std::string>(), busPair.second.IsMap(), {}};
+        if (bus.valid) {
+            for (const auto &connectionPair : busPair.second) {
+                if (!connectionPair.first.IsScalar()) {
+                    continue;
+                }
+                const YAML::Node &connection = connectionPair.second;
+                bus.connections.push_back(
+                    {connectionPair.first.as<std::string>(),
+                     connection.IsMap() && isScalar(connection, "port")
+                         ? connection["port"].as<std::string>()
+                         : std::string()});
+            }
+        }
+        buses.push_back(std::move(bus));
+    }
+}
+
+/* Graph and buses as text, one line per entry, so two netlists compare in full */
+QStringList netlistText(QSocNetlistGraph &graph, const std::vector<QSocNetlistLoader::Bus> &buses)
+{
+    graph.build(nullptr);
+    QStringList result;
+    for (int instance = 0; instance < graph.instanceCount(); instance++) {
+        const QSocNetlistGraph::Instance &data = graph.instance(instance);
+        std::string line = "instance " + graph.symbolName(data.name);
+        if (data.module >= 0) {
+            line += " module " + graph.symbolName(graph.module(data.module).name);
+        }
+        for (const auto &[paramName, paramValue] : data.parameters) {
+            line += " " + paramName + "=" + paramValue;
+        }
+        result.append(QString::fromStdString(line));
+    }
+    for (int net = 0; net < graph.netCount(); net++) {
+        std::string line = "net " + graph.netName(net);
+        for (const int pin : graph.netPins(net)) {
+            const QSocNetlistGraph::Pin &data = graph.pin(pin);
+            line += " " + graph.symbolName(data.instanceName) + "."
+                    + graph.symbolName(data.portName);
+        }
+        result.append(QString::fromStdString(line));
+    }
+    for (const QSocNetlistLoader::Bus &bus : buses) {
+        std::string line = "bus " + bus.name + (bus.valid ? "" : " invalid");
+        for (const QSocNetlistLoader::BusConnection &connection : bus.connections) {
+            line += " " + connection.instanceName + ":" + connection.portName;
+        }
+        result.append(QString::fromStdString(line));
+    }
+    return result;
+}
+} // namespace
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir tempDir;
+
+private slots:
+    void load_data()
+    {
+        QTest::addColumn<QString>("netlist");
+
+        QTest::newRow("basic") << QString(kBasicNetlist);
+        QTest::newRow("invalid entries") << QString(kInvalidNetlist);
+        QTest::newRow("anchor alias") << QString(kAnchorNetlist);
+        QTest::newRow("flow style") << QString(kFlowNetlist);
+        QTest::newRow("nested sequences") << QString(kNestedNetlist);
+        QTest::newRow("duplicate instances") << QString(kDuplicateNetlist);
+    }
+
+    void load()
+    {
+        QFETCH(QString, netlist);
+
+        QVERIFY(tempDir.isValid());
+        const std::string filePath = tempDir.filePath("netlist.soc_net").toStdString();
+        {
+            std::ofstream output(filePath, std::ios::binary | std::ios::trunc);
+            output << netlist.toStdString();
+        }
+
+        /* Streaming path */
+        QSocNetlistGraph  streamGraph;
+        QSocNetlistLoader loader(streamGraph);
+        std::ifstream     input(filePath, std::ios::binary);
+        QVERIFY(loader.load(input));
+
+        /* Node tree path */
+        QSocNetlistGraph                    treeGraph;
+        std::vector<QSocNetlistLoader::Bus> treeBuses;
+        loadTree(YAML::LoadFile(filePath), treeGraph, treeBuses);
+
+        const QStringList streamText = netlistText(streamGraph, loader.getBuses());
+        const QStringList treeText   = netlistText(treeGraph, treeBuses);
+        /* Compare line by line, so a failure names the entry */
+        for (int line = 0; line < qMin(streamText.size(), treeText.size()); line++) {
+            QCOMPARE(streamText[line], treeText[line]);
+        }
+        QCOMPARE(streamText.size(), treeText.size());
+        QVERIFY(streamGraph.instanceCount() > 0);
+    }
+
+    void duplicateInstance()
+    {
+        QSocNetlistGraph   graph;
+        QSocNetlistLoader  loader(graph);
+        std::istringstream input(kDuplicateNetlist);
+        QVERIFY(loader.load(input));
+
+        QCOMPARE(graph.instanceCount(), 3);
+        QCOMPARE(graph.moduleCount(), 2);
+        const QSocNetlistGraph::Instance &first = graph.instance(graph.findInstance("u0"));
+        QCOMPARE(
+            QString::fromStdString(graph.symbolName(graph.module(first.module).name)),
+            QString("first"));
+        QCOMPARE(first.parameters.size(), size_t(1));
+        QCOMPARE(QString::fromStdString(first.parameters.front().first), QString("W"));
+        QCOMPARE(graph.instance(graph.findInstance("u1")).module, -1);
+        QVERIFY(graph.instance(graph.findInstance("u2")).module >= 0);
+    }
+};
+
+QTEST_APPLESS_MAIN(Test)
+
+#include "test_qsocnetlistloader.moc"
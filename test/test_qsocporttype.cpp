@@ -0,0 +1,184 @@
+#include "common/qsocporttype.h"
+
+#include <QtCore>
+#include <QtTest>
+
+namespace {
+/* Parameters visible to every expression and type of the tests */
+const QSocPortType::ParameterMap kParameters = {{"WIDTH", 32}, {"DEPTH", 1024}, {"N", -3}};
+
+/* Parameter name and expression pairs */
+using Definitions = std::vector<std::pair<std::string, std::string>>;
+} // namespace
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void evaluate_data()
+    {
+        QTest::addColumn<QString>("expression");
+        QTest::addColumn<bool>("valid");
+        QTest::addColumn<qlonglong>("value");
+
+        /* Precedence */
+        QTest::newRow("mul before add") << "1 + 2 * 3" << true << 7LL;
+        QTest::newRow("parentheses") << "(1 + 2) * 3" << true << 9LL;
+        QTest::newRow("add before shift") << "1 << 2 + 1" << true << 8LL;
+        QTest::newRow("add before equality") << "1 + 2 == 3" << true << 1LL;
+        QTest::newRow("power before mul") << "2 * 3 ** 2" << true << 18LL;
+        QTest::newRow("unary before power") << "-2 ** 2" << true << 4LL;
+        QTest::newRow("and before or") << "1 || 0 && 0" << true << 1LL;
+        QTest::newRow("bitwise") << "12 & 10 | 1 ^ 3" << true << 10LL;
+        QTest::newRow("parameters") << "WIDTH / 8 - N" << true << 7LL;
+
+        /* Power is right associative */
+        QTest::newRow("power right assoc") << "2 ** 3 ** 2" << true << 512LL;
+        QTest::newRow("power of minus one") << "(-1) ** 1001" << true << -1LL;
+        QTest::newRow("negative exponent") << "2 ** -1" << false << 0LL;
+
+        /* Ternary, nested in the false branch */
+        QTest::newRow("ternary") << "WIDTH > 16 ? 1 : 0" << true << 1LL;
+        QTest::newRow("ternary nested") << "0 ? 1 : 1 ? 2 : 3" << true << 2LL;
+        QTest::newRow("ternary incomplete") << "1 ? 2" << false << 0LL;
+
+        /* Sized and based literals */
+        QTest::newRow("hex") << "8'hFF" << true << 255LL;
+        QTest::newRow("binary") << "4'b1010" << true << 10LL;
+        QTest::newRow("octal") << "16'o17" << true << 15LL;
+        QTest::newRow("signed decimal") << "32'sd5" << true << 5LL;
+        QTest::newRow("unsized unbased") << "'1" << true << 1LL;
+        QTest::newRow("underscores") << "1_000 + 'h1_0" << true << 1016LL;
+        QTest::newRow("unknown digits") << "8'hxz" << false << 0LL;
+        QTest::newRow("digits outside base") << "4'b102" << false << 0LL;
+
+        /* $clog2 */
+        QTest::newRow("clog2 parameter") << "$clog2(DEPTH)" << true << 10LL;
+        QTest::newRow("clog2 one") << "$clog2(1)" << true << 0LL;
+        QTest::newRow("clog2 round up") << "$clog2(5)" << true << 3LL;
+        QTest::newRow("clog2 negative") << "$clog2(-1)" << false << 0LL;
+
+        /* Division by zero */
+        QTest::newRow("divide by zero") << "1 / 0" << false << 0LL;
+        QTest::newRow("modulo by zero") << "1 % (WIDTH - 32)" << false << 0LL;
+
+        /* Overflow does not fold */
+        QTest::newRow("power overflow") << "10 ** 40" << false << 0LL;
+        QTest::newRow("power limit") << "2 ** 62" << true << 4611686018427387904LL;
+        QTest::newRow("power beyond limit") << "2 ** 63" << false << 0LL;
+        QTest::newRow("add overflow") << "9223372036854775807 + 1" << false << 0LL;
+        QTest::newRow("sub overflow") << "-9223372036854775807 - 2" << false << 0LL;
+        QTest::newRow("mul overflow") << "3037000500 * 3037000500" << false << 0LL;
+        QTest::newRow("divide overflow") << "64'h8000_0000_0000_0000 / -1" << false << 0LL;
+        QTest::newRow("modulo minus one") << "64'h8000_0000_0000_0000 % -1" << true << 0LL;
+        QTest::newRow("negate overflow") << "-64'h8000_0000_0000_0000" << false << 0LL;
+        QTest::newRow("decimal overflow") << "99999999999999999999" << false << 0LL;
+        QTest::newRow("based overflow") << "'h1_0000_0000_0000_0000" << false << 0LL;
+        QTest::newRow("shift overflow") << "1 << 64" << false << 0LL;
+
+        /* Unresolved parameters */
+        QTest::newRow("unknown parameter") << "UNKNOWN + 1" << false << 0LL;
+        QTest::newRow("package parameter") << "pkg::WIDTH" << false << 0LL;
+
+        /* Malformed */
+        QTest::newRow("empty") << "" << false << 0LL;
+        QTest::newRow("trailing text") << "1 2" << false << 0LL;
+        QTest::newRow("unbalanced") << "(1 + 2" << false << 0LL;
+    }
+
+    void evaluate()
+    {
+        QFETCH(QString, expression);
+        QFETCH(bool, valid);
+        QFETCH(qlonglong, value);
+
+        long long folded = 0;
+        QCOMPARE(QSocPortType::evaluate(expression.toStdString(), kParameters, folded), valid);
+        if (valid) {
+            QCOMPARE(static_cast<qlonglong>(folded), value);
+        }
+    }
+
+    void parseResolve_data()
+    {
+        QTest::addColumn<QString>("type");
+        QTest::addColumn<bool>("valid");
+        QTest::addColumn<bool>("parameterized");
+        QTest::addColumn<int>("width");
+        QTest::addColumn<QString>("resolved");
+
+        QTest::newRow("empty") << "" << true << false << 1 << "";
+        QTest::newRow("scalar") << "logic" << true << false << 1 << "logic";
+        QTest::newRow("base type") << "int unsigned" << true << false << 32 << "int unsigned";
+        QTest::newRow("constant") << "logic [7:0]" << true << false << 8 << "logic [7:0]";
+        QTest::newRow("size") << "logic [8]" << true << false << 8 << "logic [8]";
+        QTest::newRow("packed") << "logic [3:0][7:0]" << true << false << 32
+                                << "logic [3:0][7:0]";
+        QTest::newRow("ascending") << "bit [0:15]" << true << false << 16 << "bit [0:15]";
+        QTest::newRow("packed base type") << "byte [1:0]" << true << false << 16 << "byte [1:0]";
+        QTest::newRow("typedef") << "data_t" << true << false << 0 << "data_t";
+        QTest::newRow("packed typedef") << "data_t [3:0]" << true << false << 0 << "data_t [3:0]";
+        QTest::newRow("parameter") << "logic [WIDTH-1:0]" << true << true << 32 << "logic[31:0]";
+        QTest::newRow("signed parameter")
+            << "logic signed [WIDTH/2-1:0]" << true << true << 16 << "logic signed[15:0]";
+        QTest::newRow("clog2") << "logic [$clog2(DEPTH)-1:0]" << true << true << 10
+                               << "logic[9:0]";
+        QTest::newRow("unknown parameter")
+            << "logic [UNKNOWN-1:0]" << true << true << 0 << "logic [UNKNOWN-1:0]";
+        QTest::newRow("too wide") << "logic [64'h7FFF_FFFF_FFFF_FFFF:0]" << true << false << 0
+                                  << "logic [64'h7FFF_FFFF_FFFF_FFFF:0]";
+        QTest::newRow("bounds overflow") << "logic [64'h7FFF_FFFF_FFFF_FFFF:-1]" << true << false
+                                         << 0 << "logic [64'h7FFF_FFFF_FFFF_FFFF:-1]";
+        QTest::newRow("unbalanced") << "logic [7:0" << false << false << 0 << "logic [7:0";
+        QTest::newRow("trailing text") << "logic [7:0] x" << false << false << 0
+                                       << "logic [7:0] x";
+    }
+
+    void parseResolve()
+    {
+        QFETCH(QString, type);
+        QFETCH(bool, valid);
+        QFETCH(bool, parameterized);
+        QFETCH(int, width);
+        QFETCH(QString, resolved);
+
+        QSocPortType portType;
+        QCOMPARE(portType.parse(type.toStdString()), valid);
+        QCOMPARE(portType.isValid(), valid);
+        QCOMPARE(portType.isParameterized(), parameterized);
+        portType.resolve(kParameters);
+        QCOMPARE(portType.width(), width);
+        QCOMPARE(QString::fromStdString(portType.toString()), resolved);
+    }
+
+    void foldParameters()
+    {
+        /* Definitions reference each other in any order */
+        const Definitions definitions = {
+            {"B", "A * 2"},
+            {"C", "$clog2(B)"},
+            {"A", "4"},
+            {"D", "UNKNOWN"},
+            {"E", "10 ** 40"},
+        };
+        const QSocPortType::ParameterMap folded = QSocPortType::foldParameters(definitions);
+        QCOMPARE(folded.size(), size_t(3));
+        QCOMPARE(folded.at("A"), 4LL);
+        QCOMPARE(folded.at("B"), 8LL);
+        QCOMPARE(folded.at("C"), 3LL);
+
+        /* Overrides replace definitions and cannot see them */
+        const Definitions overrides = {{"A", "16"}, {"C", "B"}};
+        const QSocPortType::ParameterMap overridden
+            = QSocPortType::foldParameters(definitions, overrides);
+        QCOMPARE(overridden.size(), size_t(2));
+        QCOMPARE(overridden.at("A"), 16LL);
+        QCOMPARE(overridden.at("B"), 32LL);
+        QCOMPARE(overridden.count("C"), size_t(0));
+    }
+};
+
+QTEST_APPLESS_MAIN(Test)
+
+#include "test_qsocporttype.moc"
@@ -0,0 +1,179 @@
+#include "common/qsocprojectloader.h"
+#include "common/qsocprojectmanager.h"
+#include "qsoctestfiles.h"
+
+#include <QFile>
+#include <QSignalSpy>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QtCore>
+#include <QtTest>
+
+#include <yaml-cpp/yaml.h>
+
+using namespace QSocTestFiles;
+
+struct TestApp
+{
+    static auto &instance()
+    {
+        static auto                  argc      = 1;
+        static char                  appName[] = "qsoc";
+        static std::array<char *, 1> argv      = {{appName}};
+        /* Use QCoreApplication for cli test */
+        static const QCoreApplication app = QCoreApplication(argc, argv.data());
+        return app;
+    }
+};
+
+namespace {
+/* Library of two modules */
+const char *kModuleLibrary = R"(mod_b:
+  port:
+    clk: {direction: input}
+mod_a:
+  port:
+    clk: {direction: input}
+)";
+
+/* Library of one bus */
+const char *kBusLibrary = R"(apb:
+  port:
+    sel: {master: {direction: out}, slave: {direction: in}}
+)";
+
+/* Not a YAML document */
+const char *kBrokenLibrary = "mod_c: [unclosed\n";
+
+/* Create a project with one good and one broken library of each kind */
+bool createProject(const QString &projectPath, const QString &projectName)
+{
+    QSocProjectManager projectManager;
+    projectManager.setProjectPath(projectPath);
+    projectManager.setBusPath(projectPath + "/bus");
+    projectManager.setModulePath(projectPath + "/module");
+    projectManager.setSchematicPath(projectPath + "/schematic");
+    projectManager.setOutputPath(projectPath + "/output");
+    return projectManager.save(projectName)
+           && writeText(projectPath + "/module/good.soc_mod", kModuleLibrary)
+           && writeText(projectPath + "/module/broken.soc_mod", kBrokenLibrary)
+           && writeText(projectPath + "/bus/amba.soc_bus", kBusLibrary)
+           && writeText(projectPath + "/bus/bad.soc_bus", kBrokenLibrary);
+}
+
+/* Snapshot of the first loaded() signal of a spy */
+QSocProjectLoader::SnapshotPointer firstSnapshot(const QSignalSpy &spy)
+{
+    return spy.first().first().value<QSocProjectLoader::SnapshotPointer>();
+}
+} // namespace
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir tempDir;
+
+private slots:
+    void initTestCase()
+    {
+        TestApp::instance();
+        QVERIFY(tempDir.isValid());
+        QVERIFY(createProject(tempDir.filePath("alpha"), "alpha"));
+        QVERIFY(createProject(tempDir.filePath("beta"), "beta"));
+    }
+
+    void loadProject()
+    {
+        QSocProjectLoader loader;
+        QSignalSpy        loadedSpy(&loader, &QSocProjectLoader::loaded);
+        QSignalSpy        failedSpy(&loader, &QSocProjectLoader::failed);
+        loader.load(tempDir.filePath("alpha"), "alpha");
+        QVERIFY(loader.isLoading());
+        QVERIFY(loadedSpy.wait(10000));
+        QVERIFY(!loader.isLoading());
+        QVERIFY(failedSpy.isEmpty());
+
+        const QSocProjectLoader::SnapshotPointer snapshot = firstSnapshot(loadedSpy);
+        QVERIFY(snapshot);
+        QCOMPARE(loader.getSnapshot(), snapshot);
+        QCOMPARE(snapshot->projectName, QString("alpha"));
+        QCOMPARE(snapshot->moduleLibraries, QStringList({"broken", "good"}));
+        QCOMPARE(snapshot->busLibraries, QStringList({"amba", "bad"}));
+        QCOMPARE(snapshot->modules, QStringList({"mod_a", "mod_b"}));
+        QCOMPARE(snapshot->buses, QStringList({"apb"}));
+        QVERIFY(snapshot->moduleData["mod_a"].IsMap());
+        QVERIFY(snapshot->busData["apb"].IsMap());
+    }
+
+    void reportFailedLibraries()
+    {
+        QSocProjectLoader loader;
+        QSignalSpy        loadedSpy(&loader, &QSocProjectLoader::loaded);
+        loader.load(tempDir.filePath("alpha"));
+        QVERIFY(loadedSpy.wait(10000));
+
+        /* Broken libraries are listed, the project still loads */
+        const QSocProjectLoader::SnapshotPointer snapshot = firstSnapshot(loadedSpy);
+        QCOMPARE(snapshot->projectName, QString("alpha"));
+        QStringList failedLibraries = snapshot->failedLibraries;
+        failedLibraries.sort();
+        QCOMPARE(failedLibraries, QStringList({"bad", "broken"}));
+    }
+
+    void failWithoutProject()
+    {
+        QTemporaryDir emptyDir;
+        QVERIFY(emptyDir.isValid());
+        QSocProjectLoader loader;
+        QSignalSpy        loadedSpy(&loader, &QSocProjectLoader::loaded);
+        QSignalSpy        failedSpy(&loader, &QSocProjectLoader::failed);
+        loader.load(emptyDir.path());
+        QVERIFY(failedSpy.wait(10000));
+        QVERIFY(failedSpy.first().first().toString().contains(emptyDir.path()));
+        QVERIFY(loadedSpy.isEmpty());
+        QVERIFY(!loader.isLoading());
+        QVERIFY(!loader.getSnapshot());
+    }
+
+    void supersededLoad()
+    {
+        QSocProjectLoader loader;
+        QSignalSpy        loadedSpy(&loader, &QSocProjectLoader::loaded);
+        QSignalSpy        failedSpy(&loader, &QSocProjectLoader::failed);
+        loader.load(tempDir.filePath("alpha"), "alpha");
+        loader.load(tempDir.filePath("beta"), "beta");
+        QVERIFY(loadedSpy.wait(10000));
+
+        /* The first load is dropped, whether it had started or not */
+        QTest::qWait(200);
+        QCOMPARE(loadedSpy.count(), 1);
+        QVERIFY(failedSpy.isEmpty());
+        QCOMPARE(firstSnapshot(loadedSpy)->projectName, QString("beta"));
+        QCOMPARE(loader.getSnapshot()->projectName, QString("beta"));
+    }
+
+    void cancelledLoad()
+    {
+        QSocProjectLoader loader;
+        QSignalSpy        loadedSpy(&loader, &QSocProjectLoader::loaded);
+        QSignalSpy        failedSpy(&loader, &QSocProjectLoader::failed);
+        loader.load(tempDir.filePath("alpha"), "alpha");
+        loader.cancel();
+        QVERIFY(!loader.isLoading());
+        QTest::qWait(500);
+        QVERIFY(loadedSpy.isEmpty());
+        QVERIFY(failedSpy.isEmpty());
+        QVERIFY(!loader.getSnapshot());
+
+        /* The loader is usable again */
+        loader.load(tempDir.filePath("beta"), "beta");
+        QVERIFY(loadedSpy.wait(10000));
+        QCOMPARE(firstSnapshot(loadedSpy)->projectName, QString("beta"));
+    }
+};
+
+QTEST_APPLESS_MAIN(Test)
+
+#include "test_qsocprojectloader.moc"
@@ -0,0 +1,184 @@
+#include "common/qsocbusmanager.h"
+#include "common/qsocprojectmanager.h"
+#include "common/qsocresidentlibraries.h"
+#include "common/qstaticyamlcache.h"
+#include "qsoctestfiles.h"
+
+#include <QFile>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QtCore>
+#include <QtTest>
+
+#include <yaml-cpp/yaml.h>
+
+using namespace QSocTestFiles;
+
+struct TestApp
+{
+    static auto &instance()
+    {
+        static auto                  argc      = 1;
+        static char                  appName[] = "qsoc";
+        static std::array<char *, 1> argv      = {{appName}};
+        /* Use QCoreApplication for cli test */
+        static const QCoreApplication app = QCoreApplication(argc, argv.data());
+        return app;
+    }
+};
+
+namespace {
+/* Library of two buses */
+const char *kAlphaLibrary = R"(zeta:
+  port:
+    sel: {master: {direction: out}, slave: {direction: in}}
+beta:
+  port:
+    sel: {master: {direction: out}, slave: {direction: in}}
+)";
+
+/* Takes beta over when loaded after alpha */
+const char *kGammaLibrary = R"(beta:
+  port:
+    sel: {master: {direction: out}, slave: {direction: in}}
+alpha:
+  port:
+    sel: {master: {direction: out}, slave: {direction: in}}
+)";
+} // namespace
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir      tempDir;
+    QSocProjectManager projectManager;
+
+    /* Load a library in a fresh manager, like one command, and mark a bus
+       without saving it. Returns whether the mark of an earlier command was
+       still there, which only happens if the library was reused. */
+    bool commandSeesMark(const QString &libraryName, const QString &busName)
+    {
+        QSocBusManager busManager(nullptr, &projectManager);
+        if (!busManager.load(libraryName) || !busManager.isBusExist(busName)) {
+            return false;
+        }
+        YAML::Node busYaml = busManager.getBusYaml(busName);
+        const bool marked  = busYaml["mark"].IsDefined();
+        busYaml["mark"]    = true;
+        return marked;
+    }
+
+private slots:
+    void initTestCase()
+    {
+        TestApp::instance();
+        QVERIFY(tempDir.isValid());
+        const QString workPath = tempDir.path();
+        projectManager.setProjectPath(workPath);
+        projectManager.setBusPath(workPath + "/bus");
+        projectManager.setModulePath(workPath + "/module");
+        projectManager.setSchematicPath(workPath + "/schematic");
+        projectManager.setOutputPath(workPath + "/output");
+        QVERIFY(projectManager.save("test"));
+    }
+
+    void init()
+    {
+        QVERIFY(writeText(tempDir.filePath("bus/alpha.soc_bus"), kAlphaLibrary));
+        QVERIFY(writeText(tempDir.filePath("bus/gamma.soc_bus"), kGammaLibrary));
+        QStaticYamlCache::setEnabled(true);
+        QSocResidentLibraries::clear();
+    }
+
+    void cleanup()
+    {
+        QStaticYamlCache::setEnabled(false);
+        QSocResidentLibraries::clear();
+    }
+
+    void reuseUnchanged()
+    {
+        QVERIFY(!commandSeesMark("alpha", "zeta"));
+        QVERIFY(commandSeesMark("alpha", "zeta"));
+        QVERIFY(commandSeesMark("alpha", "zeta"));
+    }
+
+    void reloadEditedFile()
+    {
+        QVERIFY(!commandSeesMark("alpha", "beta"));
+
+        /* A different size is noticed whatever the timestamp resolution */
+        QVERIFY(writeText(tempDir.filePath("bus/alpha.soc_bus"), kGammaLibrary));
+        QVERIFY(!commandSeesMark("alpha", "beta"));
+        QVERIFY(commandSeesMark("alpha", "beta"));
+    }
+
+    void reloadSavedFile()
+    {
+        QVERIFY(!commandSeesMark("alpha", "zeta"));
+        const QString filePath = tempDir.filePath("bus/alpha.soc_bus");
+        QVERIFY(QStaticYamlCache::save(filePath, YAML::Load(kAlphaLibrary)));
+        QVERIFY(!commandSeesMark("alpha", "zeta"));
+    }
+
+    void dropAfterClear()
+    {
+        QVERIFY(!commandSeesMark("alpha", "zeta"));
+        QSocResidentLibraries::clear();
+        QVERIFY(!commandSeesMark("alpha", "zeta"));
+    }
+
+    void keepNothingWithoutCache()
+    {
+        QStaticYamlCache::setEnabled(false);
+        QVERIFY(!commandSeesMark("alpha", "zeta"));
+        QVERIFY(!commandSeesMark("alpha", "zeta"));
+    }
+
+    void onlyLoadedLibrariesVisible()
+    {
+        {
+            QSocBusManager busManager(nullptr, &projectManager);
+            QVERIFY(busManager.load(QRegularExpression(".*")));
+            QCOMPARE(busManager.getBusLibrary("beta"), QString("gamma"));
+        }
+
+        /* Gamma stays in the kept data, alpha gets beta back from its file */
+        QSocBusManager busManager(nullptr, &projectManager);
+        QVERIFY(busManager.load(QString("alpha")));
+        QCOMPARE(busManager.listBus(), QStringList({"beta", "zeta"}));
+        QCOMPARE(busManager.getBusLibrary("beta"), QString("alpha"));
+        QVERIFY(!busManager.isBusExist("alpha"));
+
+        QStringList busNames;
+        for (const auto &busPair : busManager.getBusYamls(QRegularExpression(".*"))) {
+            busNames.append(QString::fromStdString(busPair.first.as<std::string>()));
+            QCOMPARE(
+                QString::fromStdString(busPair.second["library"].as<std::string>()),
+                QString("alpha"));
+        }
+        busNames.sort();
+        QCOMPARE(busNames, QStringList({"beta", "zeta"}));
+    }
+
+    void otherDirectory()
+    {
+        QVERIFY(!commandSeesMark("alpha", "zeta"));
+
+        QTemporaryDir otherDir;
+        QVERIFY(otherDir.isValid());
+        QVERIFY(QDir().mkpath(otherDir.filePath("bus")));
+        QVERIFY(writeText(otherDir.filePath("bus/alpha.soc_bus"), kAlphaLibrary));
+        const QString busPath = projectManager.getBusPath();
+        projectManager.setBusPath(otherDir.filePath("bus"));
+        const bool otherMarked = commandSeesMark("alpha", "zeta");
+        projectManager.setBusPath(busPath);
+        QVERIFY(!otherMarked);
+    }
+};
+
+QTEST_APPLESS_MAIN(Test)
+
+#include "test_qsocresidentlibraries.moc"
@@ -0,0 +1,289 @@
+#include "common/qsocnetlistgraph.h"
+#include "common/qsocschematiclayout.h"
+
+#include <QtCore>
+#include <QtTest>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <yaml-cpp/yaml.h>
+
+namespace {
+/* Module with four inputs and three outputs, mod_missing is not in the library */
+YAML::Node lookupModule(const std::string &moduleName)
+{
+    if (moduleName == "mod_missing") {
+        return YAML::Node();
+    }
+    return YAML::Load(
+        "port:\n"
+        "  i0: {direction: input}\n"
+        "  i1: {direction: input}\n"
+        "  i2: {direction: input, width: 8}\n"
+        "  i3: {direction: input}\n"
+        "  o0: {direction: output}\n"
+        "  o1: {direction: output, width: 8}\n"
+        "  o2: {direction: output}\n");
+}
+
+/* Every instance drives three nets, sinks are mostly a few instances further
+   on, some anywhere, so the graph has cycles and nets that span layers */
+void buildNetlist(QSocNetlistGraph &graph, int instanceCount, unsigned seed)
+{
+    std::mt19937 generator(seed);
+    for (int instance = 0; instance < instanceCount; instance++) {
+        const std::string moduleName = instance % 11 == 10 ? "mod_missing" : "mod";
+        graph.addInstance("u" + std::to_string(instance), moduleName);
+    }
+    for (int instance = 0; instance < instanceCount; instance++) {
+        for (int output = 0; output < 3; output++) {
+            const int net = graph.addNet(
+                "n" + std::to_string(instance) + "_" + std::to_string(output));
+            graph.addPin(net, "u" + std::to_string(instance), "o" + std::to_string(output));
+            const int fanout = 1 + static_cast<int>(generator() % 3);
+            for (int sink = 0; sink < fanout; sink++) {
+                int target = (instance + 1 + static_cast<int>(generator() % 6)) % instanceCount;
+                if (generator() % 8 == 0) {
+                    target = static_cast<int>(generator() % instanceCount);
+                }
+                graph.addPin(
+                    net,
+                    "u" + std::to_string(target),
+                    "i" + std::to_string(generator() % 4));
+            }
+        }
+    }
+    /* A net of an instance that does not exist is dropped */
+    graph.addPin(graph.addNet("dangling"), "u_ghost", "x");
+    graph.build(lookupModule);
+}
+
+/* Position of a port on the outline of its node */
+QSocSchematicLayout::Point portPoint(
+    const QSocSchematicLayout &layout, const QSocSchematicLayout::Endpoint &endpoint)
+{
+    const QSocSchematicLayout::Node &node = layout.getNodes()[endpoint.node];
+    const QSocSchematicLayout::Port &port = node.ports[endpoint.port];
+    return {port.right ? node.x + node.width : node.x, node.y + port.offset};
+}
+
+/* A straight piece of wire, low and high are inclusive */
+struct Segment
+{
+    int line; /* Column of a vertical segment, row of a horizontal one */
+    int low;  /* First row or column */
+    int high; /* Last row or column */
+    int net;  /* Net ID */
+};
+
+/* Count pairs of segments of different nets that share a line and overlap */
+int countOverlaps(std::vector<Segment> segments)
+{
+    std::sort(segments.begin(), segments.end(), [](const Segment &left, const Segment &right) {
+        return left.line != right.line ? left.line < right.line : left.low < right.low;
+    });
+    int overlaps = 0;
+    for (size_t first = 0; first < segments.size(); first++) {
+        for (size_t second = first + 1;
+             second < segments.size() && segments[second].line == segments[first].line
+             && segments[second].low <= segments[first].high;
+             second++) {
+            if (segments[second].net != segments[first].net) {
+                overlaps++;
+            }
+        }
+    }
+    return overlaps;
+}
+
+/* Count nodes that overlap another node, the outline included */
+int countNodeOverlaps(const QSocSchematicLayout &layout)
+{
+    const std::vector<QSocSchematicLayout::Node> &nodes    = layout.getNodes();
+    int                                           overlaps = 0;
+    for (size_t first = 0; first < nodes.size(); first++) {
+        for (size_t second = first + 1; second < nodes.size(); second++) {
+            const QSocSchematicLayout::Node &left  = nodes[first];
+            const QSocSchematicLayout::Node &right = nodes[second];
+            if (left.x <= right.x + right.width && right.x <= left.x + left.width
+                && left.y <= right.y + right.height && right.y <= left.y + left.height) {
+                overlaps++;
+            }
+        }
+    }
+    return overlaps;
+}
+
+/* Count diagonal segments and wires that do not start at the driver port
+   or end at the sink port */
+int countBadWires(const QSocSchematicLayout &layout)
+{
+    int bad = 0;
+    for (const QSocSchematicLayout::Wire &wire : layout.getWires()) {
+        if (wire.points.size() < 2) {
+            bad++;
+            continue;
+        }
+        for (size_t index = 1; index < wire.points.size(); index++) {
+            const QSocSchematicLayout::Point &from = wire.points[index - 1];
+            const QSocSchematicLayout::Point &to   = wire.points[index];
+            if (from.x != to.x && from.y != to.y) {
+                bad++;
+            }
+        }
+        const QSocSchematicLayout::Point driver = portPoint(layout, wire.from);
+        const QSocSchematicLayout::Point sink   = portPoint(layout, wire.to);
+        if (driver.x != wire.points.front().x || driver.y != wire.points.front().y
+            || sink.x != wire.points.back().x || sink.y != wire.points.back().y) {
+            bad++;
+        }
+    }
+    return bad;
+}
+
+/* Count overlaps of the channel tracks and of the crossover rows above the nodes */
+int countTrackOverlaps(const QSocSchematicLayout &layout)
+{
+    std::vector<Segment> tracks;
+    std::vector<Segment> crossovers;
+    for (const QSocSchematicLayout::Wire &wire : layout.getWires()) {
+        for (size_t index = 1; index < wire.points.size(); index++) {
+            const QSocSchematicLayout::Point &from = wire.points[index - 1];
+            const QSocSchematicLayout::Point &to   = wire.points[index];
+            if (from.x == to.x && from.y != to.y) {
+                tracks.push_back(
+                    {from.x, std::min(from.y, to.y), std::max(from.y, to.y), wire.net});
+            } else if (from.y == to.y && from.y < 0) {
+                crossovers.push_back(
+                    {from.y, std::min(from.x, to.x), std::max(from.x, to.x), wire.net});
+            }
+        }
+    }
+    return countOverlaps(tracks) + countOverlaps(crossovers);
+}
+} // namespace
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void emptyNetlist()
+    {
+        QSocNetlistGraph graph;
+        graph.build(lookupModule);
+        QSocSchematicLayout layout(graph);
+        layout.run();
+        QVERIFY(layout.getNodes().empty());
+        QVERIFY(layout.getWires().empty());
+    }
+
+    void chain()
+    {
+        /* u0 drives u1 drives u2, one layer each from left to right */
+        QSocNetlistGraph graph;
+        graph.addInstance("u0", "mod");
+        graph.addInstance("u1", "mod");
+        graph.addInstance("u2", "mod");
+        const int first = graph.addNet("first");
+        graph.addPin(first, "u0", "o0");
+        graph.addPin(first, "u1", "i0");
+        const int second = graph.addNet("second");
+        graph.addPin(second, "u1", "o0");
+        graph.addPin(second, "u2", "i0");
+        graph.build(lookupModule);
+
+        QSocSchematicLayout layout(graph);
+        layout.run();
+        QCOMPARE(layout.getLayerCount(), 3);
+        const std::vector<QSocSchematicLayout::Node> &nodes = layout.getNodes();
+        QCOMPARE(nodes.size(), size_t(3));
+        QVERIFY(nodes[0].x + nodes[0].width < nodes[1].x);
+        QVERIFY(nodes[1].x + nodes[1].width < nodes[2].x);
+        QCOMPARE(layout.getWires().size(), size_t(2));
+        QCOMPARE(countBadWires(layout), 0);
+        QCOMPARE(
+            QString::fromStdString(layout.getNetName(layout.getWires().front().net)),
+            QString("first"));
+    }
+
+    void geometry_data()
+    {
+        QTest::addColumn<int>("instanceCount");
+        QTest::addColumn<int>("threadCount");
+
+        QTest::newRow("small") << 8 << 1;
+        QTest::newRow("medium") << 60 << 1;
+        QTest::newRow("large") << 400 << 1;
+        QTest::newRow("large threaded") << 400 << 4;
+    }
+
+    void geometry()
+    {
+        QFETCH(int, instanceCount);
+        QFETCH(int, threadCount);
+
+        QSocNetlistGraph graph;
+        buildNetlist(graph, instanceCount, 1);
+        QSocSchematicLayout layout(graph);
+        layout.run(threadCount);
+
+        QCOMPARE(layout.getNodes().size(), size_t(instanceCount));
+        for (const QSocSchematicLayout::Node &node : layout.getNodes()) {
+            QVERIFY(node.width > 0 && node.height > 0);
+            QVERIFY(node.x >= 0 && node.y >= 0);
+        }
+        QVERIFY(!layout.getWires().empty());
+        QCOMPARE(countNodeOverlaps(layout), 0);
+        QCOMPARE(countBadWires(layout), 0);
+        QCOMPARE(countTrackOverlaps(layout), 0);
+    }
+
+    void sameOnAnyThreadCount()
+    {
+        QSocNetlistGraph graph;
+        buildNetlist(graph, 200, 2);
+        QSocSchematicLayout single(graph);
+        single.run(1);
+        QSocSchematicLayout threaded(graph);
+        threaded.run(4);
+
+        QCOMPARE(threaded.getWires().size(), single.getWires().size());
+        for (size_t index = 0; index < single.getWires().size(); index++) {
+            const QSocSchematicLayout::Wire &left  = single.getWires()[index];
+            const QSocSchematicLayout::Wire &right = threaded.getWires()[index];
+            QCOMPARE(right.net, left.net);
+            QCOMPARE(right.points.size(), left.points.size());
+            for (size_t point = 0; point < left.points.size(); point++) {
+                QCOMPARE(right.points[point].x, left.points[point].x);
+                QCOMPARE(right.points[point].y, left.points[point].y);
+            }
+        }
+    }
+
+    void hitTesting()
+    {
+        QSocNetlistGraph graph;
+        buildNetlist(graph, 30, 3);
+        QSocSchematicLayout layout(graph);
+        layout.run();
+
+        /* The center of every node finds that node */
+        const std::vector<QSocSchematicLayout::Node> &nodes = layout.getNodes();
+        for (int index = 0; index < static_cast<int>(nodes.size()); index++) {
+            const int        column = nodes[index].x + nodes[index].width / 2;
+            const int        row    = nodes[index].y + nodes[index].height / 2;
+            std::vector<int> hits;
+            layout.getNodeIndex().query({column, row, column, row}, hits);
+            QCOMPARE(hits.size(), size_t(1));
+            QCOMPARE(hits.front(), index);
+        }
+    }
+};
+
+QTEST_APPLESS_MAIN(Test)
+
+#include "test_qsocschematiclayout.moc"
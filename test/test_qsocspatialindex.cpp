@@ -0,0 +1,149 @@
+#include "common/qsocspatialindex.h"
+
+#include <QtCore>
+#include <QtTest>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+/* Random boxes of up to 50 units on a 10000 unit square, IDs in order */
+std::vector<QSocSpatialIndex::Entry> randomEntries(int count, std::mt19937 &generator)
+{
+    std::vector<QSocSpatialIndex::Entry> entries;
+    for (int id = 0; id < count; id++) {
+        const int left = static_cast<int>(generator() % 10000);
+        const int top  = static_cast<int>(generator() % 10000);
+        entries.push_back(
+            {{left,
+              top,
+              left + static_cast<int>(generator() % 50),
+              top + static_cast<int>(generator() % 50)},
+             id});
+    }
+    return entries;
+}
+
+/* IDs of the entries that intersect a box, found by checking every entry */
+std::vector<int> scan(
+    const std::vector<QSocSpatialIndex::Entry> &entries, const QSocSpatialIndex::Box &box)
+{
+    std::vector<int> ids;
+    for (const QSocSpatialIndex::Entry &entry : entries) {
+        if (entry.box.left <= box.right && box.left <= entry.box.right
+            && entry.box.top <= box.bottom && box.top <= entry.box.bottom) {
+            ids.push_back(entry.id);
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+/* IDs the index finds for a box, sorted */
+std::vector<int> search(const QSocSpatialIndex &index, const QSocSpatialIndex::Box &box)
+{
+    std::vector<int> ids;
+    index.query(box, ids);
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+} // namespace
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void emptyIndex()
+    {
+        QSocSpatialIndex index;
+        QCOMPARE(index.size(), 0);
+        QVERIFY(search(index, {0, 0, 100, 100}).empty());
+
+        index.build({});
+        QCOMPARE(index.size(), 0);
+        QVERIFY(search(index, {0, 0, 100, 100}).empty());
+    }
+
+    void cornersInside()
+    {
+        QSocSpatialIndex index;
+        index.build({{{10, 10, 20, 20}, 7}});
+        QCOMPARE(index.size(), 1);
+        QCOMPARE(search(index, {20, 20, 30, 30}), std::vector<int>({7}));
+        QCOMPARE(search(index, {0, 0, 10, 10}), std::vector<int>({7}));
+        QCOMPARE(search(index, {15, 15, 15, 15}), std::vector<int>({7}));
+        QVERIFY(search(index, {21, 0, 30, 30}).empty());
+        QVERIFY(search(index, {0, 0, 30, 9}).empty());
+    }
+
+    void sameAsScan_data()
+    {
+        QTest::addColumn<int>("entryCount");
+
+        /* Around one full leaf and one full level of 16 children */
+        QTest::newRow("one") << 1;
+        QTest::newRow("leaf minus one") << 15;
+        QTest::newRow("leaf") << 16;
+        QTest::newRow("leaf plus one") << 17;
+        QTest::newRow("level") << 256;
+        QTest::newRow("level plus one") << 257;
+        QTest::newRow("small") << 300;
+        QTest::newRow("large") << 20000;
+    }
+
+    void sameAsScan()
+    {
+        QFETCH(int, entryCount);
+
+        std::mt19937                               generator(3);
+        const std::vector<QSocSpatialIndex::Entry> entries = randomEntries(entryCount, generator);
+        QSocSpatialIndex                           index;
+        index.build(entries);
+        QCOMPARE(index.size(), entryCount);
+
+        /* Every entry finds itself */
+        for (const QSocSpatialIndex::Entry &entry : entries) {
+            const std::vector<int> ids = search(index, entry.box);
+            QVERIFY(std::binary_search(ids.begin(), ids.end(), entry.id));
+        }
+        /* Boxes from a point to beyond the square */
+        for (int query = 0; query < 200; query++) {
+            const int                   left = static_cast<int>(generator() % 10000);
+            const int                   top  = static_cast<int>(generator() % 10000);
+            const int                   span = static_cast<int>(generator() % 800);
+            const QSocSpatialIndex::Box box{left, top, left + span, top + span};
+            QCOMPARE(search(index, box), scan(entries, box));
+        }
+        QCOMPARE(search(index, {0, 0, 20000, 20000}).size(), size_t(entryCount));
+    }
+
+    void duplicateIds()
+    {
+        /* One ID for several boxes, such as a wire of several segments */
+        QSocSpatialIndex index;
+        index.build(
+            {{{0, 0, 10, 0}, 1},
+             {{10, 0, 10, 10}, 1},
+             {{10, 10, 20, 10}, 1},
+             {{50, 50, 60, 60}, 2}});
+        QCOMPARE(index.size(), 4);
+        QCOMPARE(search(index, {10, 0, 10, 0}), std::vector<int>({1, 1}));
+        QCOMPARE(search(index, {15, 5, 55, 55}), std::vector<int>({1, 2}));
+    }
+
+    void rebuildReplaces()
+    {
+        QSocSpatialIndex index;
+        std::mt19937     generator(5);
+        index.build(randomEntries(1000, generator));
+        index.build({{{0, 0, 1, 1}, 42}});
+        QCOMPARE(index.size(), 1);
+        QCOMPARE(search(index, {0, 0, 20000, 20000}), std::vector<int>({42}));
+    }
+};
+
+QTEST_APPLESS_MAIN(Test)
+
+#include "test_qsocspatialindex.moc"
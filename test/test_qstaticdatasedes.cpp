@@ -0,0 +1,154 @@
+#include "common/qstaticdatasedes.h"
+
+#include <QRandomGenerator>
+#include <QString>
+#include <QtCore>
+#include <QtTest>
+
+#include <yaml-cpp/yaml.h>
+
+namespace {
+/* Random documents compared against the reference merge */
+constexpr int kRandomMerges = 2000;
+
+/* Merge as the bus and module managers did before QStaticDataSedes::mergeYaml() */
+YAML::Node referenceMerge(const YAML::Node &toYaml, const YAML::Node &fromYaml)
+{
+    if (!fromYaml.IsMap()) {
+        return fromYaml.IsNull() ? toYaml : fromYaml;
+    }
+    if (!toYaml.IsMap()) {
+        return fromYaml;
+    }
+    if (!fromYaml.size()) {
+        return toYaml;
+    }
+    YAML::Node resultYaml = YAML::Node(YAML::NodeType::Map);
+    for (auto iter : toYaml) {
+        if (iter.first.IsScalar()) {
+            const std::string &key      = iter.first.Scalar();
+            auto               tempYaml = YAML::Node(fromYaml[key]);
+            if (tempYaml) {
+                resultYaml[iter.first] = referenceMerge(iter.second, tempYaml);
+                continue;
+            }
+        }
+        resultYaml[iter.first] = iter.second;
+    }
+    for (auto iter : fromYaml) {
+        if (!iter.first.IsScalar() || !resultYaml[iter.first.Scalar()]) {
+            resultYaml[iter.first] = iter.second;
+        }
+    }
+    return resultYaml;
+}
+
+/* Emitted text of a node */
+QString emitYaml(const YAML::Node &node)
+{
+    YAML::Emitter emitter;
+    emitter << node;
+    return QString::fromStdString(emitter.c_str());
+}
+
+/* Flow style text of a random value, maps share a few keys and may repeat them */
+QString randomValue(QRandomGenerator &generator, int depth)
+{
+    const int choice = generator.bounded(10);
+    if (depth < 3 && choice < 5) {
+        QStringList entries;
+        const int   count = generator.bounded(5);
+        for (int index = 0; index < count; index++) {
+            const QString key = generator.bounded(10) == 0
+                                    ? QString("[x%1]").arg(generator.bounded(4))
+                                    : QString(QChar('a' + generator.bounded(4)));
+            entries.append(key + ": " + randomValue(generator, depth + 1));
+        }
+        return "{" + entries.join(", ") + "}";
+    }
+    if (choice < 6) {
+        return "~";
+    }
+    if (choice < 7) {
+        return QString("[%1, %2]").arg(generator.bounded(10)).arg(generator.bounded(10));
+    }
+    return QString::number(generator.bounded(10));
+}
+} // namespace
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private:
+    /* Compare both merge functions with the reference, inputs are left alone */
+    static void compareMerge(const QString &toText, const QString &fromText)
+    {
+        const YAML::Node toYaml     = YAML::Load(toText.toStdString());
+        const YAML::Node fromYaml   = YAML::Load(fromText.toStdString());
+        const QString    expected   = emitYaml(referenceMerge(toYaml, fromYaml));
+        const QString    toBefore   = emitYaml(toYaml);
+        const QString    fromBefore = emitYaml(fromYaml);
+        const QString    context    = QString("to %1, from %2").arg(toText, fromText);
+
+        const QString merged = emitYaml(QStaticDataSedes::mergeYaml(toYaml, fromYaml));
+        QVERIFY2(merged == expected, qPrintable(context));
+        QVERIFY2(emitYaml(toYaml) == toBefore, qPrintable(context));
+        QVERIFY2(emitYaml(fromYaml) == fromBefore, qPrintable(context));
+
+        YAML::Node intoYaml = YAML::Load(toText.toStdString());
+        QStaticDataSedes::mergeYamlInto(intoYaml, fromYaml);
+        QVERIFY2(emitYaml(intoYaml) == expected, qPrintable(context));
+    }
+
+private slots:
+    void mergeYaml_data()
+    {
+        QTest::addColumn<QString>("toText");
+        QTest::addColumn<QString>("fromText");
+
+        QTest::newRow("key order") << "c: 1\na: 2\nb: 3\n" << "d: 4\nb: 5\ne: 6\na: 7\n";
+        QTest::newRow("null keeps value") << "a: 1\nb: {x: 1}\n" << "a: ~\nb: ~\nc: ~\n";
+        QTest::newRow("null document") << "a: 1\n" << "~";
+        QTest::newRow("nested maps")
+            << "a:\n  x: 1\n  y:\n    p: 1\nb: 2\n"
+            << "a:\n  y:\n    q: 2\n  z: 3\nb: 4\n";
+        QTest::newRow("flow maps") << "a: {x: 1, y: {p: 1}}\nb: {z: 1}\n" << "a: {y: {q: 2}}\n";
+        QTest::newRow("empty from map") << "a: {x: 1}\n" << "a: {}\n";
+        QTest::newRow("empty to map") << "a: {}\n" << "a: {x: 1}\n";
+        QTest::newRow("scalar replaces map") << "a: {x: 1}\nb: 2\n" << "a: 3\n";
+        QTest::newRow("map replaces scalar") << "a: 1\nb: 2\n" << "a: {x: 3}\n";
+        QTest::newRow("sequence replaces") << "a: [1, 2]\nb: {x: 1}\n" << "a: [3]\nb: [4]\n";
+        QTest::newRow("scalar documents") << "1" << "{a: 2}";
+        QTest::newRow("duplicate from keys")
+            << "{a: {x: 1}, b: 2}" << "{a: {y: 2}, a: {z: 3}, c: 4, c: 5, b: 6, b: 7}";
+        QTest::newRow("duplicate to keys")
+            << "{a: {x: 1}, b: 2, a: {y: 2}, b: 3}" << "{a: {z: 3}, b: 4}";
+        QTest::newRow("non-scalar keys")
+            << "{[a]: 1, {b: 1}: 2, c: 3}" << "{[a]: 4, {b: 1}: 5, c: {x: 6}}";
+    }
+
+    void mergeYaml()
+    {
+        QFETCH(QString, toText);
+        QFETCH(QString, fromText);
+        compareMerge(toText, fromText);
+    }
+
+    void mergeYamlRandom()
+    {
+        QRandomGenerator generator(20240607);
+        for (int index = 0; index < kRandomMerges; index++) {
+            const QString toText   = randomValue(generator, 0);
+            const QString fromText = randomValue(generator, 0);
+            compareMerge(toText, fromText);
+            if (QTest::currentTestFailed()) {
+                return;
+            }
+        }
+    }
+};
+
+QTEST_APPLESS_MAIN(Test)
+
+#include "test_qstaticdatasedes.moc"
@@ -0,0 +1,146 @@
+#include "qsocbussignals.h"
+
+#include "common/qstaticstringweaver.h"
+
+#include <QtCore>
+#include <QtTest>
+
+#include <functional>
+
+namespace {
+using namespace QSocBusSignals;
+
+/* Bus signal to module port */
+using PortMapping = QMap<QString, QString>;
+
+/* Ports that belong to no bus interface */
+const QVector<QString> kOtherPorts = {"clk", "rst_n", "irq", "uart_tx", "uart_rx", "test_mode"};
+
+/* Port names of a bus interface */
+QVector<QString> portNames(
+    const QVector<QString> &busSignals, const std::function<QString(const QString &)> &portOf)
+{
+    QVector<QString> result;
+    for (const QString &busSignal : busSignals) {
+        result.append(portOf(busSignal));
+    }
+    return result;
+}
+
+/* Expected matching of a bus interface */
+PortMapping mappingOf(
+    const QVector<QString> &busSignals, const std::function<QString(const QString &)> &portOf)
+{
+    PortMapping result;
+    for (const QString &busSignal : busSignals) {
+        result.insert(busSignal, portOf(busSignal));
+    }
+    return result;
+}
+
+/* Port name made of a prefix and a suffix around the bus signal */
+std::function<QString(const QString &)> affixed(const QString &prefix, const QString &suffix = "")
+{
+    return [prefix, suffix](const QString &busSignal) { return prefix + busSignal + suffix; };
+}
+} // namespace
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void findOptimalMatching_data()
+    {
+        QTest::addColumn<QVector<QString>>("modulePorts");
+        QTest::addColumn<QVector<QString>>("busSignals");
+        QTest::addColumn<QString>("hint");
+        QTest::addColumn<PortMapping>("expected");
+
+        /* Module ports are the other interfaces, the bound one, then the ports of no bus */
+        const auto addRow = [](const char                                     *name,
+                               const QVector<QString>                         &busSignals,
+                               const QString                                  &hint,
+                               const std::function<QString(const QString &)> &portOf,
+                               const QVector<QString>                         &others = {}) {
+            QTest::newRow(name) << others + portNames(busSignals, portOf) + kOtherPorts
+                                << busSignals << hint << mappingOf(busSignals, portOf);
+        };
+
+        /* One interface, snake case with a prefix */
+        addRow("apb", kApbSignals, "s_apb", affixed("s_apb_"));
+        addRow("ahb", kAhbSignals, "ahb", affixed("ahb_"));
+        addRow("axi4", kAxi4Signals, "m_axi", affixed("m_axi_"));
+        addRow("chi", kChiSignals, "chi_rn", affixed("chi_rn_"));
+        addRow("phy dfi", kDfiSignals, "phy0_dfi", affixed("phy0_dfi_"));
+
+        /* Vendor PHY style, the bus keeps the dfi_ prefix and ports add the phase */
+        const QVector<QString> dfiSignals = portNames(kDfiSignals, affixed("dfi_"));
+        addRow("phy phase", dfiSignals, "dfi", affixed("", "_p0"));
+
+        /* Several interfaces, the hint picks one */
+        const QVector<QString> axi4Ports = portNames(kAxi4Signals, affixed("m_axi_"));
+        const QVector<QString> apbPorts  = portNames(kApbSignals, affixed("s_apb_"));
+        addRow("apb beside axi4", kApbSignals, "s_apb", affixed("s_apb_"), axi4Ports);
+        addRow("axi4 beside apb", kAxi4Signals, "m_axi", affixed("m_axi_"), apbPorts);
+        addRow(
+            "second of two axi4",
+            kAxi4Signals,
+            "m1_axi",
+            affixed("m1_axi_"),
+            portNames(kAxi4Signals, affixed("m0_axi_")));
+
+        /* Chisel style, the channel is split from the signal */
+        const auto chiselPort = [](const QString &busSignal) {
+            const int channel = busSignal.startsWith("aw") || busSignal.startsWith("ar") ? 2 : 1;
+            return "io_mem_" + busSignal.left(channel) + "_" + busSignal.mid(channel);
+        };
+        addRow("axi4 chisel", kAxi4Signals, "io_mem", chiselPort);
+
+        /* Camel case */
+        const auto camelPort = [](const QString &busSignal) {
+            return "apb" + busSignal.left(1).toUpper() + busSignal.mid(1);
+        };
+        addRow("apb camel case", kApbSignals, "apb", camelPort);
+
+        /* Direction suffixes */
+        const auto directedPort = [](const QString &busSignal) {
+            const bool output = busSignal == "prdata" || busSignal == "pready"
+                                || busSignal == "pslverr";
+            return "s_apb_" + busSignal + (output ? "_o" : "_i");
+        };
+        addRow("apb direction", kApbSignals, "s_apb", directedPort);
+    }
+
+    void findOptimalMatching()
+    {
+        QFETCH(QVector<QString>, modulePorts);
+        QFETCH(QVector<QString>, busSignals);
+        QFETCH(QString, hint);
+        QFETCH(PortMapping, expected);
+
+        const PortMapping matching
+            = QStaticStringWeaver::matchBusInterface(modulePorts, busSignals, hint);
+        /* Compare signal by signal, so a failure names the signal */
+        for (const QString &busSignal : busSignals) {
+            QCOMPARE(matching.value(busSignal), expected.value(busSignal));
+        }
+        QCOMPARE(matching.size(), expected.size());
+    }
+
+    void hungarianAlgorithm()
+    {
+        /* The diagonal is not optimal, the best assignment costs 1 + 2 + 2 */
+        const QVector<QVector<double>> costMatrix = {
+            {4.0, 1.0, 3.0},
+            {2.0, 0.0, 5.0},
+            {3.0, 2.0, 2.0},
+        };
+        const QVector<int> expected = {1, 0, 2};
+        QCOMPARE(QStaticStringWeaver::hungarianAlgorithm(costMatrix), expected);
+    }
+};
+
+QTEST_APPLESS_MAIN(Test)
+
+#include "test_qstaticstringweaver.moc"